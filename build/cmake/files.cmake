@@ -457,6 +457,7 @@ set(BASE_CMN_SRC
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
     src/common/tokenzr.cpp
+    src/common/tracezone.cpp
     src/common/translation.cpp
     src/common/txtstrm.cpp
     src/common/unichar.cpp
@@ -608,6 +609,7 @@ set(BASE_CMN_HDR
     wx/timer.h
     wx/tls.h
     wx/tokenzr.h
+    wx/tracezone.h
     wx/tracker.h
     wx/translation.h
     wx/txtstrm.h
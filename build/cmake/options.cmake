@@ -237,6 +237,7 @@ wx_option(wxUSE_TARSTREAM "use wxTar streams")
 wx_option(wxUSE_TEXTBUFFER "use wxTextBuffer class")
 wx_option(wxUSE_TEXTFILE "use wxTextFile class")
 wx_option(wxUSE_TIMER "use wxTimer class")
+wx_option(wxUSE_TRACE_ZONES "use wxTRACE_ZONE() in the library code" OFF)
 wx_option(wxUSE_VARIANT "use wxVariant class")
 
 # WebRequest options
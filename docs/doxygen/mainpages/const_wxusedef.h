@@ -238,6 +238,7 @@ library:
 @itemdef{wxUSE_TOOLBAR, Use wxToolBar class.}
 @itemdef{wxUSE_TOOLBAR_NATIVE, Use native wxToolBar class.}
 @itemdef{wxUSE_TOOLBOOK, Use wxToolbook class.}
+@itemdef{wxUSE_TRACE_ZONES, Record the time spent in some library functions using wxTraceZone, see wxTRACE_ZONE().}
 @itemdef{wxUSE_TOOLTIPS, Use wxToolTip class.}
 @itemdef{wxUSE_TREEBOOK, Use wxTreebook class.}
 @itemdef{wxUSE_TREECTRL, Use wxTreeCtrl class.}
@@ -346,6 +346,14 @@
 #   endif
 #endif /* !defined(wxUSE_TEXTFILE) */
 
+#ifndef wxUSE_TRACE_ZONES
+#   ifdef wxABORT_ON_CONFIG_ERROR
+#       error "wxUSE_TRACE_ZONES must be defined, please read comment near the top of this file."
+#   else
+#       define wxUSE_TRACE_ZONES 0
+#   endif
+#endif /* !defined(wxUSE_TRACE_ZONES) */
+
 #ifndef wxUSE_UNSAFE_WXSTRING_CONV
 #   ifdef wxABORT_ON_CONFIG_ERROR
 #       error "wxUSE_UNSAFE_WXSTRING_CONV must be defined, please read comment near the top of this file."
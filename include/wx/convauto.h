@@ -78,6 +78,8 @@ public:
 
     virtual size_t GetMBNulLen() const override { return m_conv->GetMBNulLen(); }
 
+    virtual size_t GetMaxMBLen(size_t srcLen) const override;
+
     virtual bool IsUTF8() const override { return m_conv && m_conv->IsUTF8(); }
 
     wxNODISCARD virtual wxMBConv *Clone() const override { return new wxConvAuto(*this); }
@@ -60,6 +60,7 @@ class WXDLLIMPEXP_FWD_CORE wxDataViewCtrl;
 class WXDLLIMPEXP_FWD_CORE wxDataViewColumn;
 class WXDLLIMPEXP_FWD_CORE wxDataViewRenderer;
 class WXDLLIMPEXP_FWD_CORE wxDataViewModelNotifier;
+class WXDLLIMPEXP_FWD_CORE wxDataViewIconText;
 #if wxUSE_ACCESSIBILITY
 class WXDLLIMPEXP_FWD_CORE wxDataViewCtrlAccessible;
 #endif // wxUSE_ACCESSIBILITY
@@ -208,6 +209,23 @@ public:
         return col == 0 || !IsContainer(item) || HasContainerColumns(item);
     }
 
+    // optional typed accessors which can be overridden to return the value
+    // without creating a wxVariant for it, they are used by the standard
+    // renderers when drawing the cells and must return false if the value
+    // can't be returned as the corresponding type
+    virtual bool GetValueAsString(wxString& WXUNUSED(value),
+                                  const wxDataViewItem& WXUNUSED(item),
+                                  unsigned int WXUNUSED(col)) const
+        { return false; }
+    virtual bool GetValueAsLong(long& WXUNUSED(value),
+                                const wxDataViewItem& WXUNUSED(item),
+                                unsigned int WXUNUSED(col)) const
+        { return false; }
+    virtual bool GetValueAsIconText(wxDataViewIconText& WXUNUSED(value),
+                                    const wxDataViewItem& WXUNUSED(item),
+                                    unsigned int WXUNUSED(col)) const
+        { return false; }
+
     // usually ValueChanged() should be called after changing the value in the
     // model to update the control, ChangeValue() does it on its own while
     // SetValue() does not -- so while you will override SetValue(), you should
@@ -272,6 +290,12 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // return true if the items can be sorted by the values of this column,
+    // i.e. Compare() is not overridden for it and just compares the values
+    // returned by GetValue() using the default logic
+    virtual bool CanSortByValues(unsigned int WXUNUSED(column)) const
+        { return false; }
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
@@ -398,6 +422,8 @@ public:
     void RowPrepended();
     void RowInserted( unsigned int before );
     void RowAppended();
+    void RowsInserted( unsigned int before, unsigned int count );
+    void RowsAppended( unsigned int count );
     void RowDeleted( unsigned int row );
     void RowsDeleted( const wxArrayInt &rows );
     void RowChanged( unsigned int row );
@@ -712,6 +738,18 @@ public:
     // sorting if using multiple columns is supported.
     virtual void ToggleSortByColumn(int WXUNUSED(column)) { }
 
+    // Sort the items in a background thread if there are at least the given
+    // number of them, or never do it if the threshold is 0, which is the
+    // default. Only implemented in the generic version, which returns true.
+    virtual bool SetBackgroundSortingThreshold(unsigned int WXUNUSED(minItems))
+        { return false; }
+
+    // Return true if the items are currently being sorted in the background.
+    virtual bool IsSortingInBackground() const { return false; }
+
+    // Stop sorting in the background, leaving the items in their old order.
+    virtual void CancelBackgroundSorting() { }
+
 
     // items management
     // ----------------
@@ -1020,6 +1058,7 @@ wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_DATAVIEW_COLUMN_HEADER_CLICK,
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_DATAVIEW_COLUMN_HEADER_RIGHT_CLICK, wxDataViewEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_DATAVIEW_COLUMN_SORTED, wxDataViewEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_DATAVIEW_COLUMN_REORDERED, wxDataViewEvent );
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_DATAVIEW_SORTING_PROGRESS, wxDataViewEvent );
 
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_DATAVIEW_CACHE_HINT, wxDataViewEvent );
 
@@ -1053,6 +1092,7 @@ typedef void (wxEvtHandler::*wxDataViewEventFunction)(wxDataViewEvent&);
 #define EVT_DATAVIEW_COLUMN_HEADER_RIGHT_CLICK(id, fn) wx__DECLARE_DATAVIEWEVT(COLUMN_HEADER_RIGHT_CLICK, id, fn)
 #define EVT_DATAVIEW_COLUMN_SORTED(id, fn) wx__DECLARE_DATAVIEWEVT(COLUMN_SORTED, id, fn)
 #define EVT_DATAVIEW_COLUMN_REORDERED(id, fn) wx__DECLARE_DATAVIEWEVT(COLUMN_REORDERED, id, fn)
+#define EVT_DATAVIEW_SORTING_PROGRESS(id, fn) wx__DECLARE_DATAVIEWEVT(SORTING_PROGRESS, id, fn)
 #define EVT_DATAVIEW_CACHE_HINT(id, fn) wx__DECLARE_DATAVIEWEVT(CACHE_HINT, id, fn)
 
 #define EVT_DATAVIEW_ITEM_BEGIN_DRAG(id, fn) wx__DECLARE_DATAVIEWEVT(ITEM_BEGIN_DRAG, id, fn)
@@ -1086,6 +1126,12 @@ public:
         m_data = data;
     }
 
+    wxDataViewListStoreLine( wxVector<wxVariant>&& values, wxUIntPtr data = 0 )
+        : m_values(std::move(values))
+    {
+        m_data = data;
+    }
+
     void SetData( wxUIntPtr data )
         { m_data = data; }
     wxUIntPtr GetData() const
@@ -1111,6 +1157,8 @@ public:
     void AppendItem( const wxVector<wxVariant> &values, wxUIntPtr data = 0 );
     void PrependItem( const wxVector<wxVariant> &values, wxUIntPtr data = 0 );
     void InsertItem(  unsigned int row, const wxVector<wxVariant> &values, wxUIntPtr data = 0 );
+    void AppendItems( wxVector< wxVector<wxVariant> > rows );
+    void InsertItems( unsigned int row, wxVector< wxVector<wxVariant> > rows );
     void DeleteItem( unsigned int pos );
     void DeleteAllItems();
     void ClearColumns();
@@ -1128,6 +1176,13 @@ public:
     virtual bool SetValueByRow( const wxVariant &value,
                            unsigned int row, unsigned int col ) override;
 
+    virtual bool GetValueAsString( wxString &value,
+                           const wxDataViewItem &item, unsigned int col ) const override;
+    virtual bool GetValueAsLong( long &value,
+                           const wxDataViewItem &item, unsigned int col ) const override;
+    virtual bool GetValueAsIconText( wxDataViewIconText &value,
+                           const wxDataViewItem &item, unsigned int col ) const override;
+
 
 public:
     wxVector<wxDataViewListStoreLine*> m_data;
@@ -1199,6 +1254,10 @@ public:
         { GetStore()->PrependItem( values, data ); }
     void InsertItem(  unsigned int row, const wxVector<wxVariant> &values, wxUIntPtr data = 0 )
         { GetStore()->InsertItem( row, values, data ); }
+    void AppendItems( wxVector< wxVector<wxVariant> > rows )
+        { GetStore()->AppendItems( std::move(rows) ); }
+    void InsertItems( unsigned int row, wxVector< wxVector<wxVariant> > rows )
+        { GetStore()->InsertItems( row, std::move(rows) ); }
     void DeleteItem( unsigned row )
         { GetStore()->DeleteItem( row ); }
     void DeleteAllItems()
@@ -1341,6 +1400,13 @@ public:
         const wxBitmapBundle &icon = wxBitmapBundle(),
         wxClientData *data = nullptr );
 
+    wxDataViewItemArray AppendItems( const wxDataViewItem& parent,
+        const wxVector<wxString> &texts,
+        const wxBitmapBundle &icon = wxBitmapBundle() );
+    wxDataViewItemArray InsertItems( const wxDataViewItem& parent, const wxDataViewItem& previous,
+        const wxVector<wxString> &texts,
+        const wxBitmapBundle &icon = wxBitmapBundle() );
+
     wxDataViewItem PrependContainer( const wxDataViewItem& parent,
         const wxString &text,
         const wxBitmapBundle &icon = wxBitmapBundle(),
@@ -1379,6 +1445,8 @@ public:
 
     virtual void GetValue( wxVariant &variant,
                            const wxDataViewItem &item, unsigned int col ) const override;
+    virtual bool GetValueAsIconText( wxDataViewIconText &value,
+                                     const wxDataViewItem &item, unsigned int col ) const override;
     virtual bool SetValue( const wxVariant &variant,
                            const wxDataViewItem &item, unsigned int col ) override;
     virtual wxDataViewItem GetParent( const wxDataViewItem &item ) const override;
@@ -1395,6 +1463,12 @@ public:
     wxDataViewTreeStoreContainerNode *FindContainerNode( const wxDataViewItem &item ) const;
     wxDataViewTreeStoreNode *GetRoot() const { return m_root; }
 
+private:
+    // get the icon and text of the item, used by GetValue() and, unless it
+    // was overridden in a derived class, GetValueAsIconText() too
+    bool DoGetIconText( wxDataViewIconText &value,
+                        const wxDataViewItem &item, unsigned int col ) const;
+
 public:
     wxDataViewTreeStoreNode *m_root;
 };
@@ -1438,6 +1512,11 @@ public:
     wxDataViewItem InsertItem( const wxDataViewItem& parent, const wxDataViewItem& previous,
         const wxString &text, int icon = NO_IMAGE, wxClientData *data = nullptr );
 
+    wxDataViewItemArray AppendItems( const wxDataViewItem& parent,
+        const wxVector<wxString> &texts, int icon = NO_IMAGE );
+    wxDataViewItemArray InsertItems( const wxDataViewItem& parent, const wxDataViewItem& previous,
+        const wxVector<wxString> &texts, int icon = NO_IMAGE );
+
     wxDataViewItem PrependContainer( const wxDataViewItem& parent,
         const wxString &text, int icon = NO_IMAGE, int expanded = NO_IMAGE,
         wxClientData *data = nullptr );
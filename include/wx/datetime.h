@@ -1559,6 +1559,87 @@ private:
 
 using wxDateTimeArray = wxBaseArray<wxDateTime>;
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormatter: formats and parses dates using the given format string
+// which is analysed only once, when the object is created, and not each time
+// it is used, as wxDateTime::Format() and ParseFormat() do.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxDateTimeFormatter
+{
+public:
+    // the locale-dependent strings, such as month names, are taken from the
+    // locale which is current when this object is created
+    explicit wxDateTimeFormatter(const wxString& format =
+                                    wxASCII_STR(wxDefaultDateTimeFormat));
+
+    const wxString& GetFormat() const { return m_format; }
+
+    // append the date formatted using our format to the provided string, this
+    // allows reusing the same buffer for formatting many dates
+    void FormatTo(wxString& out,
+                  const wxDateTime& dt,
+                  const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    // same as wxDateTime::Format() with our format
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const
+    {
+        wxString s;
+        FormatTo(s, dt, tz);
+        return s;
+    }
+
+    // same as wxDateTime::ParseFormat() with our format
+    bool Parse(const wxString& date,
+               wxDateTime& dt,
+               const wxDateTime& dateDef,
+               wxString::const_iterator *end) const;
+    bool Parse(const wxString& date,
+               wxDateTime& dt,
+               wxString::const_iterator *end) const
+    {
+        return Parse(date, dt, wxDefaultDateTime, end);
+    }
+
+private:
+    // add the items corresponding to the given part of the format string
+    void Compile(const wxString& format);
+
+    // the format is split into items which are either literal strings or
+    // single format specifications
+    struct Item
+    {
+        // the literal text or the entire format specification
+        wxString text;
+
+        // the format character or 0 for the literal text
+        wxChar spec;
+
+        // the width specified in the format or 0 if none
+        int width;
+
+        // true if any flags or the width were specified, such specifications
+        // are not handled by us but forwarded to wxDateTime::Format()
+        bool hasFlags;
+    };
+
+    std::vector<Item> m_items;
+
+    wxString m_format;
+
+    // the names for the specifications using them, filled in only if needed,
+    // the first index is 0 for the full names and 1 for the abbreviated ones
+    wxString m_weekDayNames[2][7],
+             m_monthNames[2][12],
+             m_am,
+             m_pm;
+
+    // false if the format uses specifications not supported by our Parse(),
+    // which then simply forwards to wxDateTime::ParseFormat()
+    bool m_canParse;
+};
+
 // ----------------------------------------------------------------------------
 // wxDateTimeHolidayAuthority: an object of this class will decide whether a
 // given date is a holiday and is used by all functions working with "work
@@ -266,6 +266,19 @@ protected:
     // (typically selection with dark background). For internal use only.
     virtual bool IsHighlighted() const = 0;
 
+    // Called from PrepareForItem() to set the value using one of the typed
+    // wxDataViewModel::GetValueAsXXX() accessors, avoiding the use of
+    // wxVariant. Return false if the value couldn't be retrieved in this way,
+    // in which case SetValue() is called with the value returned by the
+    // model GetValue() instead, which must be done if SetValue() could be
+    // overridden in a derived class.
+    virtual bool SetValueFromModel(const wxDataViewModel* WXUNUSED(model),
+                                   const wxDataViewItem& WXUNUSED(item),
+                                   unsigned WXUNUSED(column))
+    {
+        return false;
+    }
+
     // Helper of PrepareForItem() also used in StartEditing(): returns the
     // value checking that its type matches our GetVariantType().
     wxVariant CheckedGetValue(const wxDataViewModel* model,
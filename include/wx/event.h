@@ -46,6 +46,9 @@
 class WXDLLIMPEXP_FWD_BASE wxList;
 class WXDLLIMPEXP_FWD_BASE wxEvent;
 class WXDLLIMPEXP_FWD_BASE wxEventFilter;
+class wxQueuedEvents;
+class wxCoalescedEvents;
+class wxDynamicEventIndex;
 #if wxUSE_GUI
     class WXDLLIMPEXP_FWD_CORE wxDC;
     class WXDLLIMPEXP_FWD_CORE wxMenu;
@@ -3843,6 +3846,10 @@ public:
 
     void DeletePendingEvents();
 
+    // Only keep the last queued event with the given type and id, replacing
+    // the previously queued one if it hadn't been processed yet.
+    void CoalesceQueuedEvents(wxEventType eventType, bool coalesce = true);
+
 #if wxUSE_THREADS
     bool ProcessThreadEvent(const wxEvent& event);
         // NOTE: uses AddPendingEvent(); call only from secondary threads
@@ -4103,6 +4110,23 @@ private:
                       const wxEventFunctor& func,
                       wxObject *userData = nullptr);
 
+    // move the events queued by QueueEvent() to m_pendingEvents, must be
+    // called with m_pendingEventsLock held
+    void MoveQueuedEventsToPending();
+
+    // remove this handler from the list of handlers with pending events kept
+    // by wxApp if it doesn't have any of them, must be called with
+    // m_pendingEventsLock held
+    void RemoveFromPendingHandlersIfEmpty();
+
+    // must be called after removing this handler from the list of handlers
+    // with pending events kept by wxApp, with m_pendingEventsLock held
+    void OnRemovedFromPendingHandlers();
+
+    // events queued by QueueEvent(), possibly from other threads, which were
+    // not moved to m_pendingEvents yet, never null
+    wxQueuedEvents* const m_queuedEvents;
+
     static const wxEventTableEntry sm_eventTableEntries[];
 
 protected:
@@ -4155,8 +4179,28 @@ protected:
 
     struct DynamicEvents
     {
+        DynamicEvents() = default;
+        ~DynamicEvents();
+
+        // mark the entry at the given position as removed, it will be really
+        // erased from m_entries later
+        void RemoveEntry(size_t n)
+        {
+            m_entries[n] = nullptr;
+            m_numRemoved++;
+        }
+
         wxVector<wxDynamicEventTableEntry*> m_entries;
         wxRecursionGuardFlag m_flag = 0;
+
+        // number of null (i.e. removed) elements in m_entries
+        size_t m_numRemoved = 0;
+
+        // index of m_entries by event type, only created on demand if there
+        // are many entries
+        wxDynamicEventIndex* m_index = nullptr;
+
+        wxDECLARE_NO_COPY_CLASS(DynamicEvents);
     };
     // use wxSharedPtr so that SearchDynamicEventTable() can use another
     // instance of wxSharedPtr to extend the life of the wxRecursionGuardFlag
@@ -4165,6 +4209,10 @@ protected:
 
     wxList*             m_pendingEvents;
 
+    // information about the event types for which CoalesceQueuedEvents() was
+    // called and their pending events, only allocated if it was
+    wxCoalescedEvents* m_coalescedEvents;
+
 #if wxUSE_THREADS
     // critical section protecting m_pendingEvents
     wxCriticalSection m_pendingEventsLock;
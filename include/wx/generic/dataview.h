@@ -282,6 +282,10 @@ public:
     virtual bool IsMultiColumnSortAllowed() const override { return m_allowMultiColumnSort; }
     virtual void ToggleSortByColumn(int column) override;
 
+    virtual bool SetBackgroundSortingThreshold(unsigned int minItems) override;
+    virtual bool IsSortingInBackground() const override;
+    virtual void CancelBackgroundSorting() override;
+
 #if wxUSE_DRAG_AND_DROP
     virtual bool EnableDragSource( const wxDataFormat &format ) override;
     virtual bool DoEnableDropTarget(const wxVector<wxDataFormat>& formats) override;
@@ -79,6 +79,10 @@ public:
     virtual bool GetValueFromEditorCtrl( wxWindow* editor, wxVariant &value ) override;
 
 protected:
+    virtual bool SetValueFromModel(const wxDataViewModel* model,
+                                   const wxDataViewItem& item,
+                                   unsigned column) override;
+
     wxString   m_text;
 
 private:
@@ -188,6 +192,10 @@ private:
     int         m_value;
 
 protected:
+    virtual bool SetValueFromModel(const wxDataViewModel* model,
+                                   const wxDataViewItem& item,
+                                   unsigned column) override;
+
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxDataViewProgressRenderer);
 };
 
@@ -222,6 +230,10 @@ private:
     wxDataViewIconText   m_value;
 
 protected:
+    virtual bool SetValueFromModel(const wxDataViewModel* model,
+                                   const wxDataViewItem& item,
+                                   unsigned column) override;
+
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxDataViewIconTextRenderer);
 };
 
@@ -95,6 +95,7 @@ enum wxGridRenderStyle
 class WXDLLIMPEXP_FWD_CORE wxGrid;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttr;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttrProviderData;
+class WXDLLIMPEXP_FWD_CORE wxGridBlockCoords;
 class WXDLLIMPEXP_FWD_CORE wxGridColLabelWindow;
 class WXDLLIMPEXP_FWD_CORE wxGridCornerLabelWindow;
 class WXDLLIMPEXP_FWD_CORE wxGridEvent;
@@ -121,6 +122,13 @@ class wxGridOperations;
 class wxGridRowOperations;
 class wxGridColumnOperations;
 class wxGridDirectionOperations;
+class wxGridLineEnds;
+
+// Deleter used for wxGridLineEnds, which is only declared in this header.
+struct WXDLLIMPEXP_CORE wxGridLineEndsDeleter
+{
+    void operator()(wxGridLineEnds* ends) const;
+};
 
 #if wxUSE_ACCESSIBILITY
 class WXDLLIMPEXP_FWD_CORE wxGridAccessible;
@@ -982,6 +990,7 @@ public:
     // all these functions take ownership of the pointer, don't call DecRef()
     // on it
     virtual void SetAttr(wxGridCellAttr *attr, int row, int col);
+    virtual void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
@@ -1376,6 +1385,7 @@ public:
 
     // these functions take ownership of the pointer
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
+    virtual void SetAttr(wxGridCellAttr* attr, const wxGridBlockCoords& block);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
@@ -1769,6 +1779,18 @@ public:
     // Refresh one or more areas (a combination of wxGridArea enums) entirely.
     void RefreshArea(int areas);
 
+    // Mark the cell or block of cells as needing to be redrawn: unlike
+    // RefreshBlock(), this doesn't invalidate them immediately but remembers
+    // them and invalidates all of them at once, merging adjacent blocks, when
+    // the control gets back to the event loop or RefreshDirtyCells() is
+    // called.
+    void MarkCellDirty(int row, int col)
+        { MarkBlockDirty(wxGridBlockCoords(row, col, row, col)); }
+    void MarkBlockDirty(const wxGridBlockCoords& block);
+
+    // Invalidate all the cells marked as dirty since the last call.
+    void RefreshDirtyCells();
+
 
     // ------
     // Code that does a lot of grid modification can be enclosed
@@ -2087,6 +2109,7 @@ public:
 
     // this sets the specified attribute for this cell or in this row/col
     void     SetAttr(int row, int col, wxGridCellAttr *attr);
+    void     SetAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr);
     void     SetRowAttr(int row, wxGridCellAttr *attr);
     void     SetColAttr(int col, wxGridCellAttr *attr);
 
@@ -2250,10 +2273,17 @@ public:
     void     AutoSizeRow( int row, bool setAsMin = true )
         { AutoSizeColOrRow(row, setAsMin, wxGRID_ROW); }
 
-    // auto size all columns (very ineffective for big grids!)
+    // auto size all columns (very ineffective for big grids, unless sampling
+    // is enabled!)
     void     AutoSizeColumns( bool setAsMin = true );
     void     AutoSizeRows( bool setAsMin = true );
 
+    // measure only the visible cells and as many others as can be done
+    // quickly when auto sizing instead of all of them
+    void     EnableAutoSizeSampling( bool enable = true )
+        { m_autoSizeSampling = enable; }
+    bool     IsAutoSizeSamplingEnabled() const { return m_autoSizeSampling; }
+
     // auto size the grid, that is make the columns/rows of the "right" size
     // and also set the grid size to just fit its contents
     void     AutoSize();
@@ -2595,25 +2625,26 @@ protected:
     // NB: *never* access m_row/col arrays directly because they are created
     //     on demand, *always* use accessor functions instead!
 
-    // init the m_rowHeights/Bottoms arrays with default values
+    // init the m_rowHeights array with default values
     void InitRowHeights();
 
     int        m_defaultRowHeight;
     int        m_minAcceptableRowHeight;
     wxArrayInt m_rowHeights;
-    wxArrayInt m_rowBottoms;
 
-    // init the m_colWidths/Rights arrays
+    // init the m_colWidths array
     void InitColWidths();
 
     int        m_defaultColWidth;
     int        m_minAcceptableColWidth;
     wxArrayInt m_colWidths;
-    wxArrayInt m_colRights;
 
     int m_sortCol;
     bool m_sortIsAscending;
 
+    // if true, AutoSizeColOrRow() doesn't measure all cells
+    bool m_autoSizeSampling = false;
+
     bool m_useNativeHeader,
          m_nativeColumnLabels;
 
@@ -2722,6 +2753,11 @@ protected:
 
     int  m_batchCount;
 
+    // the blocks marked as dirty by MarkBlockDirty() but not refreshed yet
+    // and whether RefreshDirtyCells() is already going to be called for them
+    wxGridBlockCoordsVector m_dirtyBlocks;
+    bool m_dirtyRefreshPending = false;
+
 
     wxGridTypeRegistry*    m_typeRegistry;
 
@@ -2913,6 +2949,18 @@ private:
     // the values in pixels, which depend on the current DPI.
     void InitPixelFields();
 
+    // update m_rowEnds or m_colEnds after changing m_rowHeights or
+    // m_colWidths or the order of the rows or columns
+    void UpdateRowEnds();
+    void UpdateColEnds();
+
+    // the ends of the rows and columns in their display order: notice that
+    // m_rowHeights is indexed by the row index while m_rowEnds uses row
+    // positions, i.e. takes the rows order into account, and the same is true
+    // for the columns
+    std::unique_ptr<wxGridLineEnds, wxGridLineEndsDeleter> m_rowEnds,
+                                                           m_colEnds;
+
     // Event handler for DPI change event recomputes pixel values and relays
     // out the grid.
     void OnDPIChanged(wxDPIChangedEvent& event);
@@ -115,6 +115,9 @@ public:
     bool IsItemChecked(long item) const override;
     void CheckItem(long item, bool check) override;
 
+    bool HasVariableLineHeight() const override;
+    bool EnableVariableLineHeight(bool enable = true) override;
+
     void ShowSortIndicator(int idx, bool ascending = true) override;
     int GetSortIndicator() const override;
     bool IsAscendingSortIndicator() const override;
@@ -24,10 +24,13 @@
 // for wxGridOperations
 #include "wx/generic/gridsel.h"
 
+#include "wx/private/lineends.h"
+
 #include <algorithm>
 #include <iterator>
 #include <set>
 #include <map>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // array classes
@@ -442,10 +445,202 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxGridWindow);
 };
 
+// ----------------------------------------------------------------------------
+// wxGridLineEnds: end positions of the rows or columns
+// ----------------------------------------------------------------------------
+
+// The sizes of the rows or columns in their display order, see wxLineEnds.
+class wxGridLineEnds : public wxLineEnds
+{
+};
+
 // ----------------------------------------------------------------------------
 // the internal data representation used by wxGridCellAttrProvider
 // ----------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+// wxGridRuns: run-length storage of the values for rows or columns
+// ----------------------------------------------------------------------------
+
+template <typename T> class wxGridRuns;
+
+// This function must be defined for all types used with wxGridRuns and return
+// true if the value is empty, i.e. there is no need to store it.
+inline bool wxGridIsEmptyRunValue(const wxGridCellAttrPtr& attr)
+{
+    return !attr;
+}
+
+template <typename T>
+inline bool wxGridIsEmptyRunValue(const wxGridRuns<T>& runs)
+{
+    return runs.IsEmpty();
+}
+
+// This class stores the values for ranges of consecutive rows or columns as
+// runs, so that the memory used by them and the time needed to look them up
+// or update them depends on the number of distinct ranges and not on the
+// number of rows or columns in them.
+//
+// T must be copyable and default-constructible, with the default value being
+// empty, i.e. meaning that there is no value.
+template <typename T>
+class wxGridRuns
+{
+public:
+    bool IsEmpty() const { return m_runs.empty(); }
+
+    // Return the value for the given index or null if there is none.
+    const T* Find(int index) const
+    {
+        auto it = m_runs.upper_bound(index);
+        if ( it == m_runs.begin() )
+            return nullptr;
+
+        --it;
+        return index <= it->second.last ? &it->second.value : nullptr;
+    }
+
+    // Set the value for all indices in the given range, setting it to an
+    // empty value removes the values for this range.
+    void Set(int first, int last, const T& value)
+    {
+        Erase(first, last);
+
+        if ( !wxGridIsEmptyRunValue(value) )
+            m_runs.emplace(first, Run{last, value});
+    }
+
+    // Call the given function to modify the value of all runs in the given
+    // range, including the new runs created for the indices without any
+    // value, and remove the runs whose value becomes empty.
+    template <typename F>
+    void Modify(int first, int last, F func)
+    {
+        SplitAt(first);
+        SplitAt(last + 1);
+
+        auto it = m_runs.lower_bound(first);
+        for ( int next = first; next <= last; )
+        {
+            if ( it == m_runs.end() || it->first > next )
+            {
+                // Create a run for the indices until the next existing run.
+                const int gapLast = it == m_runs.end() || it->first > last
+                                        ? last
+                                        : it->first - 1;
+                it = m_runs.emplace_hint(it, next, Run{gapLast, T()});
+            }
+
+            func(it->second.value);
+
+            next = it->second.last + 1;
+
+            if ( wxGridIsEmptyRunValue(it->second.value) )
+                it = m_runs.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    // Call the given function to modify the values of all runs and remove
+    // the runs whose value becomes empty.
+    template <typename F>
+    void ModifyAll(F func)
+    {
+        for ( auto it = m_runs.begin(); it != m_runs.end(); )
+        {
+            func(it->second.value);
+
+            if ( wxGridIsEmptyRunValue(it->second.value) )
+                it = m_runs.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    // Must be called after inserting (if count > 0) or deleting (if count is
+    // negative) the given number of rows or columns at the given position.
+    //
+    // This takes time proportional to the number of runs after the position.
+    void Update(int pos, int count)
+    {
+        if ( count > 0 )
+        {
+            // The inserted indices don't have any value, even if they are
+            // inside an existing run.
+            SplitAt(pos);
+
+            // Shift all the runs after the insertion point, starting from
+            // the last one to avoid collisions between the keys.
+            for ( auto it = m_runs.end(); it != m_runs.begin(); )
+            {
+                auto prev = std::prev(it);
+                if ( prev->first < pos )
+                    break;
+
+                Run run = std::move(prev->second);
+                run.last += count;
+                const int first = prev->first + count;
+                m_runs.erase(prev);
+                it = m_runs.emplace_hint(it, first, run);
+            }
+        }
+        else if ( count < 0 )
+        {
+            const int end = pos - count;
+
+            Erase(pos, end - 1);
+
+            // Shift all the runs after the deleted ones, there can be no
+            // collisions as there are no more runs in [pos, end) range.
+            for ( auto it = m_runs.lower_bound(end); it != m_runs.end(); )
+            {
+                Run run = std::move(it->second);
+                run.last += count;
+                const int first = it->first + count;
+                it = m_runs.erase(it);
+                m_runs.emplace_hint(it, first, run);
+            }
+        }
+    }
+
+private:
+    // Ensure that there is no run containing both index - 1 and index.
+    void SplitAt(int index)
+    {
+        auto it = m_runs.upper_bound(index);
+        if ( it == m_runs.begin() )
+            return;
+
+        --it;
+        if ( it->first < index && index <= it->second.last )
+        {
+            m_runs.emplace_hint(std::next(it), index,
+                                Run{it->second.last, it->second.value});
+            it->second.last = index - 1;
+        }
+    }
+
+    // Remove the values for all indices in the given range.
+    void Erase(int first, int last)
+    {
+        SplitAt(first);
+        SplitAt(last + 1);
+
+        m_runs.erase(m_runs.lower_bound(first), m_runs.lower_bound(last + 1));
+    }
+
+    struct Run
+    {
+        int last;
+        T value;
+    };
+
+    // Runs indexed by their first index.
+    std::map<int, Run> m_runs;
+};
+
 // this class stores attributes set for cells
 class WXDLLIMPEXP_ADV wxGridCellAttrData
 {
@@ -453,6 +648,7 @@ public:
     ~wxGridCellAttrData();
 
     void SetAttr(wxGridCellAttr *attr, int row, int col);
+    void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
     wxGridCellAttr *GetAttr(int row, int col) const;
     void UpdateAttrRows( size_t pos, int numRows );
     void UpdateAttrCols( size_t pos, int numCols );
@@ -461,24 +657,25 @@ private:
     // Tries to search for the attr for given cell.
     wxGridCoordsToAttrMap::iterator FindIndex(int row, int col) const;
 
+    // Attributes of the individual cells, these have priority over the ones
+    // in m_blockAttrs.
     mutable wxGridCoordsToAttrMap m_attrs;
+
+    // Attributes set for the blocks of cells: runs of rows with the same
+    // runs of columns attributes.
+    wxGridRuns<wxGridRuns<wxGridCellAttrPtr>> m_blockAttrs;
 };
 
 // this class stores attributes set for rows or columns
 class WXDLLIMPEXP_ADV wxGridRowOrColAttrData
 {
 public:
-    // empty ctor to suppress warnings
-    wxGridRowOrColAttrData() = default;
-    ~wxGridRowOrColAttrData();
-
     void SetAttr(wxGridCellAttr *attr, int rowOrCol);
     wxGridCellAttr *GetAttr(int rowOrCol) const;
     void UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols );
 
 private:
-    wxArrayInt m_rowsOrCols;
-    wxArrayAttrs m_attrs;
+    wxGridRuns<wxGridCellAttrPtr> m_attrs;
 };
 
 // NB: this is just a wrapper around 3 objects: one which stores cell
@@ -587,8 +784,8 @@ public:
     // Get the height/width of the given row/column
     virtual int GetLineSize(const wxGrid *grid, int line) const = 0;
 
-    // Get wxGrid::m_rowBottoms/m_colRights array
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const = 0;
+    // Get wxGrid::m_rowEnds/m_colEnds object
+    virtual const wxGridLineEnds& GetLineEnds(const wxGrid *grid) const = 0;
 
     // Get default height row height or column width
     virtual int GetDefaultLineSize(const wxGrid *grid) const = 0;
@@ -747,8 +944,8 @@ public:
         { return grid->GetRowBottom(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const override
         { return grid->GetRowHeight(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const override
-        { return grid->m_rowBottoms; }
+    virtual const wxGridLineEnds& GetLineEnds(const wxGrid *grid) const override
+        { return *grid->m_rowEnds; }
     virtual int GetDefaultLineSize(const wxGrid *grid) const override
         { return grid->GetDefaultRowSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const override
@@ -903,8 +1100,8 @@ public:
         { return grid->GetColRight(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const override
         { return grid->GetColWidth(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const override
-        { return grid->m_colRights; }
+    virtual const wxGridLineEnds& GetLineEnds(const wxGrid *grid) const override
+        { return *grid->m_colEnds; }
     virtual int GetDefaultLineSize(const wxGrid *grid) const override
         { return grid->GetDefaultColSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const override
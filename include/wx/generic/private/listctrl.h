@@ -18,6 +18,7 @@
 #include "wx/selstore.h"
 #include "wx/timer.h"
 #include "wx/settings.h"
+#include "wx/generic/private/rowheightcache.h"
 
 #include <memory>
 
@@ -723,7 +724,7 @@ public:
         if ( !wxWindow::SetFont(font) )
             return false;
 
-        m_lineHeight = 0;
+        ResetLineHeight();
 
         return true;
     }
@@ -733,6 +734,14 @@ public:
         m_extendRulesAndAlternateColour = extend;
     }
 
+    // enable or disable using different heights for the lines containing
+    // multiple lines of text in report view
+    void EnableVariableLineHeight(bool enable);
+    bool HasVariableLineHeight() const { return m_hasVariableLineHeight; }
+
+    // recompute the height of the given line after its contents changed
+    void UpdateLineHeight(size_t line);
+
 
     // these are for wxListLineData usage only
 
@@ -742,12 +751,20 @@ public:
         return wxStaticCast(GetParent(), wxGenericListCtrl);
     }
 
-    // get the height of all lines (assuming they all do have the same height)
+    // get the height of a line containing a single line of text, which is
+    // the height of all lines unless variable line height is used
     wxCoord GetLineHeight() const;
 
+    // get the height of the given line (only for report view)
+    wxCoord GetLineHeight(size_t line) const;
+
     // get the y position of the given line (only for report view)
     wxCoord GetLineY(size_t line) const;
 
+    // get the line at the given y position, may return GetItemCount() if
+    // there is no line there (only for report view)
+    size_t GetLineAt(wxCoord y) const;
+
     // get the brush to use for the item highlighting
     wxBrush *GetHighlightBrush() const
     {
@@ -918,9 +935,32 @@ private:
     // Always returns false if there are no checkboxes.
     bool IsInsideCheckBox(long item, int x, int y) const;
 
+    // forget the cached line heights, e.g. because the font has changed
+    void ResetLineHeight();
+
+    // forget the cached heights of all lines starting from the given one
+    void InvalidateLineHeights(size_t from);
+
+    // compute the height of the given line when using variable line height
+    wxCoord ComputeLineHeight(size_t line) const;
+
     // the height of one line using the current font
     wxCoord m_lineHeight;
 
+    // the height of a single line of text, computed with m_lineHeight
+    wxCoord m_textHeight;
+
+    // true if the lines can have different heights
+    bool m_hasVariableLineHeight;
+
+    // the heights of the lines already computed if variable line height is
+    // used, the default height is used for all the other lines
+    mutable HeightCache m_lineHeightCache;
+
+    // set if the heights of some lines computed since the last call to
+    // RecalculatePositions() are different from the default line height
+    mutable bool m_lineHeightsChanged;
+
     // the total header width or 0 if not calculated yet
     wxCoord m_headerWidth;
 
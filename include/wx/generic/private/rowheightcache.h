@@ -84,6 +84,12 @@ private:
     * the y-coordinate where a row starts (GetLineStart)
     * and vice versa (GetLineAt)
 
+    The last two functions only work if the heights of all the rows before
+    the given one are in the cache. GetEstimatedLineStart() and
+    GetEstimatedLineAt() can be used instead to avoid computing the heights
+    of all these rows: they use the given default height for the rows which
+    are not in the cache.
+
     The layout of the cache is a hashmap where the keys are all existing row
     heights in pixels. The values are RowRange objects that represent all rows
     having the specified height.
@@ -134,6 +140,21 @@ public:
     bool GetLineAt(int y, unsigned int& row);
     bool GetLineInfo(unsigned int row, int &start, int &height);
 
+    /**
+        Returns the y-coordinate where the given row starts using the cached
+        heights of the preceding rows and the default height for those of
+        them that are not in the cache.
+    */
+    int GetEstimatedLineStart(unsigned int row, int defaultHeight) const;
+
+    /**
+        Returns the row containing the given y-coordinate, computed using the
+        same heights as GetEstimatedLineStart(), or @a count if it is after
+        the last row.
+    */
+    unsigned int
+    GetEstimatedLineAt(int y, unsigned int count, int defaultHeight) const;
+
     void Put(unsigned int row, int height);
 
     /**
@@ -11,7 +11,7 @@
 
 #include "wx/defs.h"
 
-#if wxUSE_DATAVIEWCTRL || wxUSE_LISTCTRL
+#if wxUSE_DATAVIEWCTRL || wxUSE_LISTCTRL || wxUSE_GRID
 
 #include "wx/log.h"
 #include "wx/timer.h"
@@ -118,6 +118,6 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxMaxWidthCalculatorBase);
 };
 
-#endif // wxUSE_DATAVIEWCTRL || wxUSE_LISTCTRL
+#endif // wxUSE_DATAVIEWCTRL || wxUSE_LISTCTRL || wxUSE_GRID
 
 #endif // _WX_GENERIC_PRIVATE_WIDTHCALC_H_
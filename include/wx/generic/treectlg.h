@@ -171,6 +171,10 @@ public:
 
     virtual void SortChildren(const wxTreeItemId& item) override;
 
+    virtual bool SetItemVirtualChildren(const wxTreeItemId& item,
+                                        size_t count) override;
+    virtual int GetVirtualItemIndex(const wxTreeItemId& item) const override;
+
     // items geometry
     // --------------
 
@@ -328,6 +332,13 @@ protected:
     void PaintLevel( wxGenericTreeItem *item, wxDC& dc, int level, int &y );
     void PaintItem( wxGenericTreeItem *item, wxDC& dc);
 
+    // paint the visible virtual children of the given item and return the
+    // position of the last one
+    int  PaintVirtualChildren( wxGenericTreeItem *item, wxDC& dc, int level, int &y );
+
+    // return the virtual child with the given index, creating it if necessary
+    wxGenericTreeItem *GetVirtualChild(wxGenericTreeItem *parent, size_t n) const;
+
     void CalculateLevel( wxGenericTreeItem *item, wxReadOnlyDC &dc, int level, int &y );
     void CalculatePositions();
 
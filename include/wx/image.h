@@ -83,6 +83,17 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+// Formats of the interleaved pixel data, see wxImage::CreateRGBA().
+enum wxImageRGBAFormat
+{
+    // R, G, B and A bytes in this order, without alpha pre-multiplication.
+    wxIMAGE_RGBA_STRAIGHT,
+
+    // 32-bit native endian 0xAARRGGBB values with pre-multiplied alpha, as
+    // used by Cairo and other graphics libraries.
+    wxIMAGE_ARGB32_PREMULTIPLIED
+};
+
 // alpha channel values: fully transparent, default threshold separating
 // transparent pixels from opaque for a few functions dealing with alpha and
 // fully opaque
@@ -98,6 +109,36 @@ class WXDLLIMPEXP_FWD_CORE wxImageHandler;
 class WXDLLIMPEXP_FWD_CORE wxImage;
 class WXDLLIMPEXP_FWD_CORE wxPalette;
 
+//-----------------------------------------------------------------------------
+// wxImageRowSink: receives image data row by row from wxImageHandler
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageRowSink
+{
+public:
+    wxImageRowSink() = default;
+    virtual ~wxImageRowSink() = default;
+
+    // Called before any rows with the size of the image, which may be smaller
+    // than its real size if GetMaxSize() is used and the handler supports
+    // reducing the image size during decoding. Return false to cancel.
+    virtual bool OnStart(int width, int height, bool hasAlpha) = 0;
+
+    // Called for each row, from top to bottom: rgb contains 3*width bytes and
+    // alpha is either null or contains width bytes. Return false to stop
+    // loading without loading the remaining rows.
+    virtual bool OnRow(int y,
+                       const unsigned char* rgb,
+                       const unsigned char* alpha) = 0;
+
+    // Can be overridden to return the maximal size of the image to produce:
+    // handlers supporting it use a smaller (but still at least this) size
+    // for decoding the image if possible.
+    virtual wxSize GetMaxSize() const { return wxDefaultSize; }
+
+    wxDECLARE_NO_COPY_CLASS(wxImageRowSink);
+};
+
 //-----------------------------------------------------------------------------
 // wxImageHandler
 //-----------------------------------------------------------------------------
@@ -125,6 +166,12 @@ public:
                            bool WXUNUSED(verbose)=true )
         { return false; }
 
+    // Load the image data row by row, passing it to the sink. The default
+    // implementation loads the entire image using LoadFile() first, but the
+    // handlers for which it is possible override it to avoid doing this.
+    virtual bool LoadRows( wxImageRowSink& sink, wxInputStream& stream,
+                           bool verbose=true, int index=-1 );
+
     int GetImageCount( wxInputStream& stream );
         // save the stream position, call DoGetImageCount() and restore the position
 
@@ -325,6 +372,13 @@ public:
     bool Create( const wxSize& sz, unsigned char* data, unsigned char* alpha, bool static_data = false )
         { return Create(sz.GetWidth(), sz.GetHeight(), data, alpha, static_data); }
 
+    // create the image using interleaved RGBA data in the given format
+    bool CreateRGBA( int width, int height, unsigned char* rgba,
+                     wxImageRGBAFormat format = wxIMAGE_RGBA_STRAIGHT );
+    bool CreateRGBA( const wxSize& sz, unsigned char* rgba,
+                     wxImageRGBAFormat format = wxIMAGE_RGBA_STRAIGHT )
+        { return CreateRGBA(sz.GetWidth(), sz.GetHeight(), rgba, format); }
+
     void Destroy();
 
     // initialize the image data with zeroes
@@ -369,6 +423,12 @@ public:
     wxImage BlurHorizontal(int radius) const;
     wxImage BlurVertical(int radius) const;
 
+    // Set or get the maximal number of threads used by Scale() and Blur()
+    // functions: 1 (default) means not to use any additional threads and 0
+    // means to use as many threads as there are CPUs.
+    static void SetMaxThreads(int count);
+    static int GetMaxThreads();
+
     wxImage ShrinkBy( int xFactor , int yFactor ) const ;
 
     // rescales the image in place
@@ -510,8 +570,15 @@ public:
     void SetData( unsigned char *data, int new_width, int new_height, bool static_data=false );
     void SetDataRGBA(const unsigned char* data);
 
+    // interleaved RGBA data is only available if the image was created with
+    // CreateRGBA() or converted with ConvertToRGBA() and neither modified nor
+    // accessed using GetData() or GetAlpha() since then
+    const unsigned char* GetDataRGBA() const;  // may return nullptr!
+    wxImageRGBAFormat GetRGBAFormat() const;
+    void ConvertToRGBA(wxImageRGBAFormat format = wxIMAGE_RGBA_STRAIGHT);
+
     unsigned char *GetAlpha() const;    // may return nullptr!
-    bool HasAlpha() const { return GetAlpha() != nullptr; }
+    bool HasAlpha() const;
     void SetAlpha(unsigned char *alpha = nullptr, bool static_data=false);
     void InitAlpha();
     void ClearAlpha();
@@ -613,6 +680,10 @@ protected:
     virtual wxObjectRefData* CreateRefData() const override;
     wxNODISCARD virtual wxObjectRefData* CloneRefData(const wxObjectRefData* data) const override;
 
+    // this hides the base class function to also replace the interleaved RGBA
+    // data, if any, with separate RGB and alpha buffers before modifying them
+    void AllocExclusive();
+
 private:
     friend class WXDLLIMPEXP_FWD_CORE wxImageHandler;
 
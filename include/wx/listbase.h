@@ -445,6 +445,11 @@ public:
     virtual bool IsItemChecked(long WXUNUSED(item)) const { return false; }
     virtual void CheckItem(long WXUNUSED(item), bool WXUNUSED(check)) { }
 
+    // Lines with different heights support: only implemented in the generic
+    // version currently.
+    virtual bool HasVariableLineHeight() const { return false; }
+    virtual bool EnableVariableLineHeight(bool WXUNUSED(enable) = true) { return false; }
+
     // Sort indicator in header.
     virtual void ShowSortIndicator(int WXUNUSED(col), bool WXUNUSED(ascending) = true) { }
     void RemoveSortIndicator() { ShowSortIndicator(-1); }
@@ -168,6 +168,16 @@
 //                         is no overhead if you don't use it
 #define wxUSE_DEBUGREPORT 1
 
+// Set this to 1 to compile in the wxTRACE_ZONE() markers used in the library
+// code itself, allowing to record the time spent in it using wxTraceZone. The
+// class itself is always available and may be used in the application code
+// independently of this option.
+//
+// Default is 0
+//
+// Recommended setting: 0, unless you are profiling the library code.
+#define wxUSE_TRACE_ZONES 0
+
 
 // ----------------------------------------------------------------------------
 // global features
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/lineends.h
+// Purpose:     wxLineEnds class storing the positions of the lines
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_LINEENDS_H_
+#define _WX_PRIVATE_LINEENDS_H_
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// wxLineEnds: end positions of the lines of possibly different sizes
+// ----------------------------------------------------------------------------
+
+// This class stores the sizes of the lines (e.g. rows or columns) in their
+// display order in a Fenwick tree, which allows both changing the size of a
+// line and finding the end of a line or the line containing the given
+// coordinate in O(log(N)) time.
+class wxLineEnds
+{
+public:
+    wxLineEnds() = default;
+
+    bool IsEmpty() const { return m_tree.empty(); }
+    void Clear() { m_tree.clear(); }
+
+    // Initialize the object with the given number of lines, calling the
+    // provided function to get the size of the line at each position.
+    template <typename F>
+    void Init(int numLines, F getSizeAt)
+    {
+        m_tree.assign(numLines ? numLines + 1 : 0, 0);
+        for ( int n = 1; n <= numLines; n++ )
+        {
+            m_tree[n] += getSizeAt(n - 1);
+
+            const int parent = n + (n & -n);
+            if ( parent <= numLines )
+                m_tree[parent] += m_tree[n];
+        }
+    }
+
+    int GetNumberOfLines() const
+    {
+        return m_tree.empty() ? 0 : static_cast<int>(m_tree.size()) - 1;
+    }
+
+    // Change the size of the line at the given position by the given amount.
+    void Add(int pos, int diff)
+    {
+        const int numLines = GetNumberOfLines();
+        for ( int n = pos + 1; n <= numLines; n += n & -n )
+            m_tree[n] += diff;
+    }
+
+    // Return the start, i.e. the sum of sizes of all the preceding lines, or
+    // the end of the line at the given position.
+    int GetStart(int pos) const
+    {
+        int sum = 0;
+        for ( int n = pos; n > 0; n -= n & -n )
+            sum += m_tree[n];
+        return sum;
+    }
+
+    int GetEnd(int pos) const { return GetStart(pos + 1); }
+
+    // Return the position of the first line ending after the given
+    // coordinate, i.e. the line containing it, or the number of lines if the
+    // coordinate is beyond the end of the last one.
+    int FindPos(int coord) const
+    {
+        const int numLines = GetNumberOfLines();
+
+        int highestBit = 1;
+        while ( highestBit <= numLines / 2 )
+            highestBit *= 2;
+
+        int pos = 0;
+        for ( int bit = highestBit; bit && numLines; bit /= 2 )
+        {
+            const int next = pos + bit;
+            if ( next <= numLines && m_tree[next] <= coord )
+            {
+                pos = next;
+                coord -= m_tree[next];
+            }
+        }
+
+        return pos;
+    }
+
+private:
+    // Fenwick tree with 1-based indices, its element 0 is unused.
+    std::vector<int> m_tree;
+};
+
+#endif // _WX_PRIVATE_LINEENDS_H_
@@ -100,7 +100,23 @@ public:
     // may only be called after successful call to Compile()
     bool Matches(const wxString& text, int flags = 0) const;
     bool Matches(const wxChar *text, int flags, size_t len) const
-        { return Matches(wxString(text, len), flags); }
+    {
+#if wxUSE_UNICODE_WCHAR
+        if ( len == wxString::npos )
+            len = wxStrlen(text);
+
+        return MatchesRange(text, text + len, flags);
+#else
+        return Matches(wxString(text, len), flags);
+#endif
+    }
+
+    // matches the regular expression against the given range of characters
+    // in the same encoding as used by wxString internally, i.e. wchar_t or
+    // UTF-8 char, without copying them
+    bool MatchesRange(const wxStringCharType* begin,
+                      const wxStringCharType* end,
+                      int flags = 0) const;
 
     // get the start index and the length of the match of the expression
     // (index 0) or a bracketed subexpression (index != 0)
@@ -114,6 +114,19 @@ public:
     // single character in this encoding, e.g. 4 for UTF-8
     virtual size_t GetMaxCharLen() const { return 1; }
 
+    // return the maximal length of the output of ToWChar() or FromWChar()
+    // when converting srcLen bytes or wide characters respectively, where
+    // srcLen includes the trailing NUL(s), if any, and is never wxNO_LEN
+    //
+    // if the conversion can produce any number of characters, which is the
+    // default, wxCONV_FAILED is returned; otherwise cMB2WC() and cWC2MB() use
+    // the value returned by these functions to convert the input in a single
+    // pass instead of calling ToWChar() or FromWChar() twice
+    virtual size_t GetMaxWCLen(size_t WXUNUSED(srcLen)) const
+        { return wxCONV_FAILED; }
+    virtual size_t GetMaxMBLen(size_t WXUNUSED(srcLen)) const
+        { return wxCONV_FAILED; }
+
     // this function is used in the implementation of cMB2WC() to distinguish
     // between the following cases:
     //
@@ -166,6 +179,18 @@ private:
     // Common part of single argument cWC2MB() and cMB2WC() overloads above.
     wxCharBuffer DoConvertWC2MB(const wchar_t* pwz, size_t srcLen) const;
     wxWCharBuffer DoConvertMB2WC(const char* psz, size_t srcLen) const;
+
+    // Common part of all cWC2MB() and cMB2WC() overloads: convert the input
+    // into the provided buffer, in a single pass if possible, and return the
+    // value returned by ToWChar() or FromWChar() or wxCONV_FAILED.
+    //
+    // The buffer length is set to the returned value in the MB2WC case, but
+    // is bigger by GetMBNulLen() - 1 in the WC2MB one as the buffer always
+    // contains GetMBNulLen() NULs after the converted string.
+    size_t DoConvertWC2MB(wxCharBuffer& buf,
+                          const wchar_t* pwz, size_t srcLen) const;
+    size_t DoConvertMB2WC(wxWCharBuffer& wbuf,
+                          const char* psz, size_t srcLen) const;
 };
 
 // ----------------------------------------------------------------------------
@@ -340,6 +365,8 @@ public:
                              const wchar_t *src, size_t srcLen = wxNO_LEN) const override;
 
     virtual size_t GetMaxCharLen() const override { return 4; }
+    virtual size_t GetMaxWCLen(size_t srcLen) const override;
+    virtual size_t GetMaxMBLen(size_t srcLen) const override;
 
     wxNODISCARD virtual wxMBConv *Clone() const override { return new wxMBConvStrictUTF8(); }
 
@@ -366,6 +393,8 @@ public:
                              const wchar_t *src, size_t srcLen = wxNO_LEN) const override;
 
     virtual size_t GetMaxCharLen() const override { return 4; }
+    virtual size_t GetMaxWCLen(size_t srcLen) const override;
+    virtual size_t GetMaxMBLen(size_t srcLen) const override;
 
     wxNODISCARD virtual wxMBConv *Clone() const override { return new wxMBConvUTF8(m_options); }
 
@@ -387,6 +416,8 @@ public:
     enum { BYTES_PER_CHAR = 2 };
 
     virtual size_t GetMBNulLen() const override { return BYTES_PER_CHAR; }
+    virtual size_t GetMaxWCLen(size_t srcLen) const override;
+    virtual size_t GetMaxMBLen(size_t srcLen) const override;
 
 protected:
     // return the length of the buffer using srcLen if it's not wxNO_LEN and
@@ -436,6 +467,8 @@ public:
     enum { BYTES_PER_CHAR = 4 };
 
     virtual size_t GetMBNulLen() const override { return BYTES_PER_CHAR; }
+    virtual size_t GetMaxWCLen(size_t srcLen) const override;
+    virtual size_t GetMaxMBLen(size_t srcLen) const override;
 
 protected:
     // this is similar to wxMBConvUTF16Base method with the same name except
@@ -498,6 +531,8 @@ public:
     virtual size_t FromWChar(char *dst, size_t dstLen,
                              const wchar_t *src, size_t srcLen = wxNO_LEN) const override;
     virtual size_t GetMBNulLen() const override;
+    virtual size_t GetMaxWCLen(size_t srcLen) const override;
+    virtual size_t GetMaxMBLen(size_t srcLen) const override;
 
     virtual bool IsUTF8() const override;
 
@@ -1794,20 +1794,8 @@ public:
         if ( len == npos )
             len = strlen(utf8);
 
-        wxMBConvStrictUTF8 conv;
-        if ( m_impl.size() > len )
-        {
-            // We can be sure that the conversion result fits into the
-            // existing buffer, so use it directly.
-            m_impl.resize(conv.ToWChar(ImplData(), m_impl.size(), utf8, len));
-        }
-        else
-        {
-            // We can't be sure that the conversion result fits into the
-            // existing buffer, so compute the length we need.
-            m_impl.resize(conv.ToWChar(nullptr, 0, utf8, len));
-            conv.ToWChar(ImplData(), m_impl.size(), utf8, len);
-        }
+        if ( !DoAssignFromUTF8(utf8, len) )
+            clear();
     }
     void AssignFromUTF8(const char *utf8, size_t len = npos)
     {
@@ -1820,23 +1808,8 @@ public:
         if ( len == npos )
             len = strlen(utf8);
 
-        wxMBConvStrictUTF8 conv;
-        if ( m_impl.size() > len )
-        {
-            m_impl.resize(conv.ToWChar(ImplData(), m_impl.size(), utf8, len));
-        }
-        else
-        {
-            const auto needed = conv.ToWChar(nullptr, 0, utf8, len);
-            if ( needed == wxCONV_FAILED )
-            {
-                clear();
-                return;
-            }
-
-            m_impl.resize(needed);
-            conv.ToWChar(ImplData(), m_impl.size(), utf8, len);
-        }
+        if ( !DoAssignFromUTF8(utf8, len) )
+            clear();
     }
 
     std::string utf8_string() const { return ToStdString(wxMBConvUTF8()); }
@@ -2525,6 +2498,27 @@ public:
     // as vprintf(), returns the number of characters written or < 0 on error
   int PrintfV(const wxString& format, va_list argptr);
 
+    // as Printf(), but appends to the string instead of replacing it
+  template <typename... Targs>
+  int AppendFormat(const wxFormatString& format, Targs... args)
+  {
+    format.Validate({wxFormatStringSpecifier<Targs>::value...});
+
+#if wxUSE_UNICODE_UTF8
+    #if !wxUSE_UTF8_LOCALE_ONLY
+      if ( wxLocaleIsUtf8 )
+    #endif
+        return DoAppendFormatUtf8(format, wxArgNormalizerUtf8<Targs>{args, nullptr, 0}.get()...);
+#endif // wxUSE_UNICODE_UTF8
+
+#if !wxUSE_UTF8_LOCALE_ONLY
+      return DoAppendFormatWchar(format, wxArgNormalizerWchar<Targs>{args, nullptr, 0}.get()...);
+#endif // !wxUSE_UTF8_LOCALE_ONLY
+  }
+
+    // as PrintfV(), but appends to the string instead of replacing it
+  int AppendFormatV(const wxString& format, va_list argptr);
+
     // returns the string containing the result of Printf() to it
   template <typename... Targs>
   static wxString Format(const wxFormatString& format, Targs... args)
@@ -3732,9 +3726,11 @@ public:
 private:
   #if !wxUSE_UTF8_LOCALE_ONLY
   int DoPrintfWchar(const wxChar *format, ...);
+  int DoAppendFormatWchar(const wxChar *format, ...);
   #endif
   #if wxUSE_UNICODE_UTF8
   int DoPrintfUtf8(const char *format, ...);
+  int DoAppendFormatUtf8(const char *format, ...);
   #endif
 
 private:
@@ -3748,6 +3744,31 @@ private:
       return const_cast<wxStringCharType*>(m_impl.data());
   }
 
+#if wxUSE_UNICODE_WCHAR
+  // Common part of AssignFromUTF8() and AssignFromUTF8Unchecked(): decode the
+  // string directly into m_impl in a single pass, using the fact that the
+  // result can't be longer than the input. Returns false if the input is not
+  // valid UTF-8, leaving the contents of the string unspecified.
+  bool DoAssignFromUTF8(const char *utf8, size_t len)
+  {
+      const bool grow = m_impl.capacity() < len;
+
+      m_impl.resize(len);
+      const size_t
+        dstLen = wxMBConvStrictUTF8().ToWChar(ImplData(), len, utf8, len);
+      if ( dstLen == wxCONV_FAILED )
+          return false;
+
+      m_impl.resize(dstLen);
+
+      // Don't keep too much unused memory if we had to allocate it.
+      if ( grow && dstLen < len / 2 )
+          m_impl.shrink_to_fit();
+
+      return true;
+  }
+#endif // wxUSE_UNICODE_WCHAR
+
   // buffers for compatibility conversion from (char*)c_str() and
   // (wchar_t*)c_str(): the pointers returned by these functions should remain
   // valid until the string itself is modified for compatibility with the
@@ -3772,11 +3793,31 @@ private:
               return false;
 
           m_str = static_cast<T *>(str);
-          m_len = len;
+          m_len =
+          m_size = len;
 
           return true;
       }
 
+      // Set the length of the string in the buffer after converting it into
+      // a buffer allocated for the maximal possible length, freeing the
+      // unused memory if there is a lot of it.
+      void Shrink(size_t len)
+      {
+          if ( m_size - len > len / 4 + 16 )
+          {
+              void * const str = realloc(m_str, sizeof(T)*(len + 1));
+              if ( str )
+              {
+                  m_str = static_cast<T *>(str);
+                  m_size = len;
+              }
+          }
+
+          m_str[len] = 0;
+          m_len = len;
+      }
+
       const wxScopedCharTypeBuffer<T> AsScopedBuffer() const
       {
           return wxScopedCharTypeBuffer<T>::CreateNonOwned(m_str, m_len);
@@ -3784,6 +3825,7 @@ private:
 
       T *m_str{nullptr};     // pointer to the string data
       size_t m_len{0}; // length, not size, i.e. in chars and without last NUL
+      size_t m_size{0}; // allocated length, also without the last NUL
   };
 
 
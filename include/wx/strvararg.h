@@ -29,6 +29,7 @@
 #include "wx/buffer.h"
 #include "wx/unichar.h"
 
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -211,6 +212,10 @@ public:
     // format specifiers corresponding to the actually given arguments.
     void Validate(const std::vector<int>& argTypes) const;
 
+    // Same as above, but avoids allocating memory: this overload is used by
+    // all the vararg functions.
+    void Validate(std::initializer_list<int> argTypes) const;
+
     // returns the type of format specifier for n-th variadic argument (this is
     // not necessarily n-th format specifier if positional specifiers are used);
     // called by wxArgNormalizer<> specializations to get information about
@@ -221,6 +226,13 @@ public:
     // to other InputAsXXX() methods
     wxString InputAsString() const;
 
+private:
+#if wxDEBUG_LEVEL
+    // Common part of both Validate() overloads.
+    void DoValidate(const int* argTypes, size_t numArgTypes) const;
+#endif // wxDEBUG_LEVEL
+
+public:
 #if !wxUSE_UNICODE_WCHAR && !defined wxNO_IMPLICIT_WXSTRING_ENCODING
     operator const char*() const
         { return const_cast<wxFormatString*>(this)->AsChar(); }
@@ -358,6 +370,11 @@ struct wxFormatStringArgumentFinder<wxWCharBuffer>
     wxFormatString::Validate(const std::vector<int>& WXUNUSED(argTypes)) const
     {
     }
+
+    inline void
+    wxFormatString::Validate(std::initializer_list<int> WXUNUSED(argTypes)) const
+    {
+    }
 #endif // wxDEBUG_LEVEL/!wxDEBUG_LEVEL
 
 
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/tracezone.h
+// Purpose:     wxTraceZone class and wxTRACE_ZONE() macro
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_TRACEZONE_H_
+#define _WX_TRACEZONE_H_
+
+#include "wx/defs.h"
+#include "wx/cpp.h"
+#include "wx/string.h"
+
+#include <atomic>
+
+// ----------------------------------------------------------------------------
+// wxTraceZone: records the time spent in the current scope
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxTraceZone
+{
+public:
+    // The name must be a string literal or, more generally, a string which
+    // remains valid until the trace is retrieved.
+    explicit wxTraceZone(const char* name)
+        : m_name(IsEnabled() ? name : nullptr),
+          m_start(m_name ? GetTimestamp() : 0)
+    {
+    }
+
+    ~wxTraceZone()
+    {
+        if ( m_name )
+            Record(m_name, m_start);
+    }
+
+    // Start or stop recording the zones, this is off by default.
+    static void Enable(bool enable = true);
+    static bool IsEnabled() { return ms_enabled.load(std::memory_order_relaxed); }
+
+    // Return all zones recorded so far in Chrome trace event JSON format.
+    static wxString GetChromeTrace();
+
+    // Save the result of GetChromeTrace() to the given file.
+    static bool SaveChromeTrace(const wxString& filename);
+
+    // Forget all the zones recorded so far.
+    static void Clear();
+
+private:
+    // Return the current time in nanoseconds since some unspecified moment.
+    static wxInt64 GetTimestamp();
+
+    // Record the zone with the given name started at the given time and
+    // ending now.
+    static void Record(const char* name, wxInt64 start);
+
+    static std::atomic<bool> ms_enabled;
+
+    const char* const m_name;
+    const wxInt64 m_start;
+
+    wxDECLARE_NO_COPY_CLASS(wxTraceZone);
+};
+
+#if wxUSE_TRACE_ZONES
+    #define wxTRACE_ZONE(name) \
+        wxTraceZone wxMAKE_UNIQUE_NAME(wxTraceZoneInScope)(name)
+#else
+    #define wxTRACE_ZONE(name)
+#endif
+
+#endif // _WX_TRACEZONE_H_
@@ -357,6 +357,32 @@ public:
         // Only implemented in the generic version currently.
     virtual void EnableBellOnNoMatch(bool WXUNUSED(on) = true) { }
 
+    // virtual children
+    // ----------------
+
+        // Make the item have the given number of children which are not
+        // stored in the control but whose text and image are provided by
+        // OnGetVirtualItemText() and OnGetVirtualItemImage() when needed.
+        // Only implemented in the generic version currently, returns false
+        // if not supported.
+    virtual bool SetItemVirtualChildren(const wxTreeItemId& WXUNUSED(item),
+                                        size_t WXUNUSED(count))
+        { return false; }
+
+        // Return the index of a virtual item among its siblings or
+        // wxNOT_FOUND if the item is not virtual.
+    virtual int GetVirtualItemIndex(const wxTreeItemId& WXUNUSED(item)) const
+        { return wxNOT_FOUND; }
+
+        // These functions are called to get the text and the image of the
+        // virtual children of the given item, the first one must be
+        // overridden if SetItemVirtualChildren() is used.
+    virtual wxString OnGetVirtualItemText(const wxTreeItemId& parent,
+                                          size_t index) const;
+    virtual int OnGetVirtualItemImage(const wxTreeItemId& WXUNUSED(parent),
+                                      size_t WXUNUSED(index)) const
+        { return -1; }
+
     // sorting
     // -------
 
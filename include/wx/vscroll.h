@@ -16,6 +16,7 @@
 #include "wx/scrolwin.h"
 
 class WXDLLIMPEXP_FWD_CORE wxVarScrollHelperEvtHandler;
+class wxVarScrollSizeCache;
 
 
 // Using the same techniques as the wxScrolledWindow class      |
@@ -82,6 +83,12 @@ public:
     void EnablePhysicalScrolling(bool scrolling = true)
         { m_physicalScrolling = scrolling; }
 
+    // with the size cache on, the positions of the units are computed only
+    // once and remembered, making scrolling to any position fast even with a
+    // huge number of units, but RefreshUnit[s]() or RefreshAll() must be
+    // called whenever the size of any unit changes
+    void EnableSizeCache(bool enable = true);
+
     // wxNOT_FOUND if none, i.e. if it is below the last item
     int VirtualHitTest(wxCoord coord) const;
 
@@ -211,6 +218,13 @@ protected:
     // unitMax (exclusive)
     wxCoord GetUnitsSize(size_t unitMin, size_t unitMax) const;
 
+    // get the total size of all units before the given one using the size
+    // cache, which must be enabled, and filling it if necessary
+    wxCoord GetCachedUnitOffset(size_t unit) const;
+
+    // update the cached sizes of the units in the given inclusive range
+    void UpdateCachedUnitsSize(size_t from, size_t to);
+
     // get the offset of the first visible unit
     wxCoord GetScrollOffset() const
         { return GetUnitsSize(0, GetVisibleBegin()); }
@@ -279,6 +293,9 @@ private:
     // do child scrolling (used in DoPrepareDC())
     bool m_physicalScrolling;
 
+    // the cached unit sizes if EnableSizeCache() was called, null otherwise
+    wxVarScrollSizeCache *m_sizeCache;
+
     // handler injected into target window to forward some useful events to us
     wxVarScrollHelperEvtHandler *m_handler;
 };
@@ -478,6 +495,13 @@ public:
         wxVarHScrollHelper::EnablePhysicalScrolling(hscrolling);
     }
 
+    // enable caching of the row and/or column sizes
+    void EnableSizeCache(bool vcache = true, bool hcache = true)
+    {
+        wxVarVScrollHelper::EnableSizeCache(vcache);
+        wxVarHScrollHelper::EnableSizeCache(hcache);
+    }
+
     // scroll to the specified row/column: it will become the first visible
     // cell in the window
     //
@@ -269,6 +269,67 @@ public:
     virtual void GetValue(wxVariant& variant, const wxDataViewItem& item,
                           unsigned int col) const = 0;
 
+    /**
+        Override this to return string values without using wxVariant.
+
+        This function is called by the generic version of
+        wxDataViewTextRenderer before calling GetValue(). If it is overridden
+        to return @true, the value is used directly, which avoids allocating
+        memory for wxVariant when drawing each cell and makes scrolling
+        through big controls faster.
+
+        Note that this function is not used for the renderers of the classes
+        deriving from wxDataViewTextRenderer, as they could override its
+        SetValue(), which is always called for them with the value returned
+        by GetValue().
+
+        It must return @false, which is done by the default implementation,
+        if the item has no string value in the given column, in which case
+        GetValue() is used as usual. Note that the returned value must be the
+        same as the one returned by GetValue().
+
+        @param value Receives the value if @true is returned. Note that this
+            string may contain the value of another cell, which allows to
+            reuse its buffer.
+        @param item The item to get the value of.
+        @param col The column to get the value of.
+        @return @true if the value was returned.
+
+        @see GetValueAsLong(), GetValueAsIconText()
+
+        @since 3.3.4
+    */
+    virtual bool GetValueAsString(wxString& value,
+                                  const wxDataViewItem& item,
+                                  unsigned int col) const;
+
+    /**
+        Override this to return integer values without using wxVariant.
+
+        This is similar to GetValueAsString() but is used by the generic
+        version of wxDataViewProgressRenderer.
+
+        @since 3.3.4
+    */
+    virtual bool GetValueAsLong(long& value,
+                                const wxDataViewItem& item,
+                                unsigned int col) const;
+
+    /**
+        Override this to return wxDataViewIconText values without using
+        wxVariant.
+
+        This is similar to GetValueAsString() but is used by the generic
+        version of wxDataViewIconTextRenderer.
+
+        wxDataViewListStore and wxDataViewTreeStore override this function.
+
+        @since 3.3.4
+    */
+    virtual bool GetValueAsIconText(wxDataViewIconText& value,
+                                    const wxDataViewItem& item,
+                                    unsigned int col) const;
+
     /**
         Override this method to indicate if a container item merely acts as a
         headline (or for categorisation) or if it also acts a normal item with
@@ -295,6 +356,37 @@ public:
     */
     virtual bool HasDefaultCompare() const;
 
+    /**
+        Override this to indicate that the items can be sorted by the values
+        of the given column, as done by the default implementation of
+        Compare().
+
+        The model can return @true from this function if it doesn't override
+        Compare() or if its overridden version simply calls the base class
+        version for this column. In this case, the generic wxDataViewCtrl
+        implementation can sort the items much faster, by retrieving the value
+        of each item only once, instead of calling Compare() which retrieves
+        both values for each comparison.
+
+        Note that the generic implementation doesn't call Compare() at all for
+        the columns for which this function returns @true, so a class deriving
+        from a model returning @true and overriding Compare() must override
+        this function to return @false too.
+
+        Returning @true from this function is also necessary for sorting the
+        items in the background, see
+        wxDataViewCtrl::SetBackgroundSortingThreshold().
+
+        By default returns @false. This is also the case for
+        wxDataViewListStore, as the existing classes deriving from it may
+        override Compare(). If you use wxDataViewListStore without overriding
+        Compare(), you can derive from it and override this function to
+        return @true to make sorting faster.
+
+        @since 3.3.4
+    */
+    virtual bool CanSortByValues(unsigned int column) const;
+
     /**
         Return true if there is a value in the given column of this item.
 
@@ -589,6 +681,28 @@ public:
     */
     void RowPrepended();
 
+    /**
+        Call this after @a count rows have been inserted at the given position.
+
+        This is equivalent to calling RowInserted() @a count times, but
+        notifies the control about all the new rows at once using
+        wxDataViewModel::ItemsAdded(), which is much more efficient when
+        adding many rows.
+
+        @since 3.3.4
+    */
+    void RowsInserted(unsigned int before, unsigned int count);
+
+    /**
+        Call this after @a count rows have been appended to the model.
+
+        This is the same as calling RowsInserted() with the current number
+        of rows in the model as position, see its description.
+
+        @since 3.3.4
+    */
+    void RowsAppended(unsigned int count);
+
     /**
         Call this after a value has been changed.
     */
@@ -882,6 +996,7 @@ wxEventType wxEVT_DATAVIEW_COLUMN_HEADER_CLICK;
 wxEventType wxEVT_DATAVIEW_COLUMN_HEADER_RIGHT_CLICK;
 wxEventType wxEVT_DATAVIEW_COLUMN_SORTED;
 wxEventType wxEVT_DATAVIEW_COLUMN_REORDERED;
+wxEventType wxEVT_DATAVIEW_SORTING_PROGRESS;
 wxEventType wxEVT_DATAVIEW_CACHE_HINT;
 
 wxEventType wxEVT_DATAVIEW_ITEM_BEGIN_DRAG;
@@ -986,6 +1101,15 @@ wxEventType wxEVT_DATAVIEW_ITEM_DROP;
            Process a @c wxEVT_DATAVIEW_COLUMN_SORTED event.
     @event{EVT_DATAVIEW_COLUMN_REORDERED(id, func)}
            Process a @c wxEVT_DATAVIEW_COLUMN_REORDERED event.
+    @event{EVT_DATAVIEW_SORTING_PROGRESS(id, func)}
+           Process a @c wxEVT_DATAVIEW_SORTING_PROGRESS event generated
+           while sorting the items in the background, see
+           SetBackgroundSortingThreshold(). wxDataViewEvent::GetInt() returns
+           the percentage of work done, with the last event, sent after the
+           items are reordered, having 100 for it. Calling
+           wxDataViewEvent::Veto() from the handler of the other events
+           cancels sorting, as CancelBackgroundSorting() does.
+           Only generated by the generic version. @since 3.3.4
     @event{EVT_DATAVIEW_ITEM_BEGIN_DRAG(id, func)}
            Process a @c wxEVT_DATAVIEW_ITEM_BEGIN_DRAG event which is generated
            when the user starts dragging a valid item. This event must be
@@ -1349,6 +1473,20 @@ public:
     */
     virtual bool AssociateModel(wxDataViewModel* model);
 
+    /**
+        Stops sorting the items in the background.
+
+        The items remain in the order they were in before sorting started and
+        the columns used for sorting are reset to correspond to this order.
+
+        Does nothing if the items are not being sorted in the background.
+
+        @see SetBackgroundSortingThreshold(), IsSortingInBackground()
+
+        @since 3.3.4
+    */
+    virtual void CancelBackgroundSorting();
+
     /**
         Removes all columns.
     */
@@ -1616,6 +1754,15 @@ public:
      */
     bool IsMultiColumnSortAllowed() const;
 
+    /**
+        Return @true if the items are currently being sorted in the background.
+
+        @see SetBackgroundSortingThreshold(), CancelBackgroundSorting()
+
+        @since 3.3.4
+     */
+    virtual bool IsSortingInBackground() const;
+
     /**
         Return @true if the item is selected.
     */
@@ -1650,6 +1797,33 @@ public:
      */
     bool SetAlternateRowColour(const wxColour& colour);
 
+    /**
+        Sort the items in a background thread if there are many of them.
+
+        When the items are sorted by the values of a column, for which the
+        model CanSortByValues(), and the control shows a list model with at
+        least @a minItems items, the values are retrieved in the main thread,
+        but sorting them is done in a worker thread, so that the program
+        remains responsive while sorting. The items are reordered only when
+        sorting is done and @c wxEVT_DATAVIEW_SORTING_PROGRESS events are
+        generated while it is in progress, allowing to cancel it.
+
+        If the model changes while sorting, the control waits until sorting
+        finishes before updating the items.
+
+        @param minItems Minimal number of items to sort in the background or
+            0, which is the default, to always sort them synchronously.
+        @return @true if sorting in the background is supported (currently
+            only in the generic version and only if wxUSE_THREADS is 1),
+            @false if this method is not implemented under this platform.
+
+        @see IsSortingInBackground(), CancelBackgroundSorting(),
+            wxDataViewModel::CanSortByValues()
+
+        @since 3.3.4
+     */
+    virtual bool SetBackgroundSortingThreshold(unsigned int minItems);
+
     /**
         Set which column shall contain the tree-like expanders.
     */
@@ -3133,6 +3307,35 @@ public:
     */
     void InsertItem( unsigned int row, const wxVector<wxVariant> &values, wxUIntPtr data = 0 );
 
+    /**
+        Appends several items (i.e.\ rows) to the control at once.
+
+        This is equivalent to calling AppendItem() for each element of @a
+        rows, but is much faster when adding many items, as the control is
+        notified about all of them at once. The values are moved from @a
+        rows, so passing it using @c std::move() avoids copying them.
+
+        See remarks for AppendItem() for preconditions of this method, which
+        apply to all the elements of @a rows.
+
+        @see wxDataViewListStore::AppendItems()
+
+        @since 3.3.4
+    */
+    void AppendItems( wxVector< wxVector<wxVariant> > rows );
+
+    /**
+        Inserts several items (i.e.\ rows) to the control at once.
+
+        The first new item is inserted at position @a row, which must be
+        less than or equal to the current number of items in the control.
+
+        See AppendItems() for more details.
+
+        @since 3.3.4
+    */
+    void InsertItems( unsigned int row, wxVector< wxVector<wxVariant> > rows );
+
     /**
         Delete the row at position @a row.
     */
@@ -3383,6 +3586,34 @@ public:
                               int icon = -1,
                               wxClientData* data = nullptr);
 
+    /**
+        Appends several items with the given texts and icon to @a parent.
+
+        Calls the same method of wxDataViewTreeStore and notifies the control
+        about all the new items at once, which is much faster than calling
+        AppendItem() for each of them when adding many items.
+
+        Returns the new items or an empty array if @a parent is invalid.
+
+        @since 3.3.4
+    */
+    wxDataViewItemArray AppendItems(const wxDataViewItem& parent,
+                                    const wxVector<wxString>& texts,
+                                    int icon = -1);
+
+    /**
+        Inserts several items with the given texts and icon at the position
+        of @a previous.
+
+        See AppendItems() for more details.
+
+        @since 3.3.4
+    */
+    wxDataViewItemArray InsertItems(const wxDataViewItem& parent,
+                                    const wxDataViewItem& previous,
+                                    const wxVector<wxString>& texts,
+                                    int icon = -1);
+
     /**
         Returns true if item is a container.
     */
@@ -3523,6 +3754,33 @@ public:
     */
     void InsertItem(  unsigned int row, const wxVector<wxVariant> &values, wxUIntPtr data = 0 );
 
+    /**
+        Appends several items (=rows) and fills them with @a rows.
+
+        Each element of @a rows must satisfy the same requirements as the
+        values passed to AppendItem(). If any of them doesn't, nothing is
+        added at all.
+
+        The values are moved into the store, so pass @a rows using
+        @c std::move() to avoid copying them. All the new rows are reported
+        to the control with a single wxDataViewModel::ItemsAdded() call, so
+        this is much faster than calling AppendItem() repeatedly when adding
+        many rows.
+
+        @since 3.3.4
+    */
+    void AppendItems( wxVector< wxVector<wxVariant> > rows );
+
+    /**
+        Inserts several items (=rows) at position @a row and fills them with
+        @a rows.
+
+        See AppendItems() for more details.
+
+        @since 3.3.4
+    */
+    void InsertItems( unsigned int row, wxVector< wxVector<wxVariant> > rows );
+
     /**
         Delete the item (=row) at position @a pos.
     */
@@ -3572,6 +3830,44 @@ public:
     */
     virtual bool SetValueByRow( const wxVariant &value,
                            unsigned int row, unsigned int col );
+
+    /**
+        Overridden from wxDataViewModel to return the stored string values
+        without copying them into a wxVariant.
+
+        Notice that this function only returns the stored values for the
+        objects of this class itself and always returns @false for the
+        objects of the classes deriving from it, which could override
+        GetValueByRow() or GetValue(), so that these functions are used
+        instead. Derived classes may override this function, as well as
+        GetValueAsLong() and GetValueAsIconText(), if they can return their
+        values more efficiently.
+
+        @since 3.3.4
+    */
+    virtual bool GetValueAsString( wxString &value,
+                           const wxDataViewItem &item, unsigned int col ) const;
+
+    /**
+        Overridden from wxDataViewModel to return the stored integer values.
+
+        @see GetValueAsString()
+
+        @since 3.3.4
+    */
+    virtual bool GetValueAsLong( long &value,
+                           const wxDataViewItem &item, unsigned int col ) const;
+
+    /**
+        Overridden from wxDataViewModel to return the stored
+        wxDataViewIconText values.
+
+        @see GetValueAsString()
+
+        @since 3.3.4
+    */
+    virtual bool GetValueAsIconText( wxDataViewIconText &value,
+                           const wxDataViewItem &item, unsigned int col ) const;
 };
 
 
@@ -3691,6 +3987,32 @@ public:
                               const wxBitmapBundle& icon = wxBitmapBundle(),
                               wxClientData* data = nullptr);
 
+    /**
+        Append several items with the given texts and icon.
+
+        Returns the new items, which can be passed to
+        wxDataViewModel::ItemsAdded() to notify the control about all of
+        them at once, or an empty array if @a parent is invalid.
+
+        @since 3.3.4
+    */
+    wxDataViewItemArray AppendItems(const wxDataViewItem& parent,
+                                    const wxVector<wxString>& texts,
+                                    const wxBitmapBundle& icon = wxBitmapBundle());
+
+    /**
+        Inserts several items with the given texts and icon at the same
+        position as InsertItem().
+
+        See AppendItems() for the return value.
+
+        @since 3.3.4
+    */
+    wxDataViewItemArray InsertItems(const wxDataViewItem& parent,
+                                    const wxDataViewItem& previous,
+                                    const wxVector<wxString>& texts,
+                                    const wxBitmapBundle& icon = wxBitmapBundle());
+
     /**
         Inserts a container before the first child item or @a parent.
     */
@@ -3869,6 +4191,9 @@ public:
            Process a @c wxEVT_DATAVIEW_COLUMN_REORDERED event.
            Currently this event is not generated when using the native GTK+
            version of the control.
+    @event{EVT_DATAVIEW_SORTING_PROGRESS(id, func)}
+           Process a @c wxEVT_DATAVIEW_SORTING_PROGRESS event, see
+           wxDataViewCtrl::SetBackgroundSortingThreshold().
     @event{EVT_DATAVIEW_ITEM_BEGIN_DRAG(id, func)}
            Process a @c wxEVT_DATAVIEW_ITEM_BEGIN_DRAG event which is generated
            when the user starts dragging a valid item. This event must be
@@ -934,6 +934,9 @@ public:
         and the format specification @c "%l" can be used to get the number of
         milliseconds.
 
+        If the same format is used for many dates, consider using
+        wxDateTimeFormatter instead, as it is much more efficient.
+
         @see ParseFormat()
     */
     wxString Format(const wxString& format = wxDefaultDateTimeFormat,
@@ -1676,6 +1679,124 @@ const wxDateTime wxDefaultDateTime;
 #define wxInvalidDateTime wxDefaultDateTime
 
 
+/**
+    @class wxDateTimeFormatter
+
+    Formats and parses dates using a fixed format.
+
+    This class provides the same functionality as wxDateTime::Format() and
+    wxDateTime::ParseFormat() and uses the same format specifications, but
+    analyses the format string only once, when the object is created, instead
+    of doing it every time a date is formatted or parsed. It also allows
+    appending the formatted date to an existing string, avoiding creating a
+    new string for each date. This makes it much faster when many dates need
+    to be formatted, e.g. when showing timestamps in a log:
+
+    @code
+    const wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S.%l");
+
+    wxString line;
+    for ( const auto& entry : entries )
+    {
+        line.clear();
+        formatter.FormatTo(line, entry.timestamp);
+        line << ' ' << entry.message;
+
+        ...
+    }
+    @endcode
+
+    Locale-dependent strings, such as the week day and month names and the
+    AM/PM indicators, are retrieved from the locale which is current when the
+    formatter is created and are not updated if it changes later. Format
+    specifications which depend on the locale in a more complicated way, such
+    as @c "%c" or @c "%x", are still handled by wxDateTime::Format().
+
+    All methods of this class are @c const and a single formatter can be used
+    by several threads simultaneously.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.4
+*/
+class wxDateTimeFormatter
+{
+public:
+    /**
+        Create the formatter using the given format.
+
+        See wxDateTime::Format() for the description of the format, which
+        must not be empty.
+    */
+    explicit wxDateTimeFormatter(const wxString& format = wxDefaultDateTimeFormat);
+
+    /**
+        Return the format used by this formatter.
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Append the representation of the given date to the provided string.
+
+        The result is the same as the string returned by wxDateTime::Format()
+        when called with the format used by this object, but is appended to
+        @a out, which allows reusing the same buffer for formatting many
+        dates.
+
+        @param out The string to append the formatted date to.
+        @param dt The date to format, must be valid.
+        @param tz The time zone to use for formatting.
+    */
+    void FormatTo(wxString& out,
+                  const wxDateTime& dt,
+                  const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Return the representation of the given date.
+
+        This is the same as wxDateTime::Format() called with the format used
+        by this object.
+    */
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Parse the string using the format of this object.
+
+        This is the same as calling wxDateTime::ParseFormat() on @a dt with
+        the format used by this object and returns @true if the string could
+        be parsed and @false otherwise.
+
+        Most numeric fields, week day and month names, AM/PM indicators and
+        literal text are handled by this class itself, while the formats
+        using any other specifications are passed to
+        wxDateTime::ParseFormat().
+
+        @param date The string to parse.
+        @param dt The object to store the result in. If @a dateDef is invalid
+            and this object is valid, its existing value is used for the
+            fields not present in the string.
+        @param dateDef The date to use for the fields not present in the
+            string, see wxDateTime::ParseFormat().
+        @param end Receives the iterator pointing just after the end of the
+            parsed part of @a date, must be non-null.
+    */
+    bool Parse(const wxString& date,
+               wxDateTime& dt,
+               const wxDateTime& dateDef,
+               wxString::const_iterator *end) const;
+
+    /**
+        Parse the string using the format of this object.
+
+        This overload uses wxDefaultDateTime for the default date.
+    */
+    bool Parse(const wxString& date,
+               wxDateTime& dt,
+               wxString::const_iterator *end) const;
+};
+
 /**
     @class wxDateTimeWorkDays
 
@@ -690,6 +690,43 @@ public:
     */
     void DeletePendingEvents();
 
+    /**
+        Enables or disables coalescing of the queued events of the given type.
+
+        When coalescing is enabled for an event type, queuing an event of this
+        type using QueueEvent() or AddPendingEvent() while another event of the
+        same type and with the same ID is still pending, i.e. hadn't been
+        processed yet, replaces the pending event with the new one instead of
+        adding a new event to the queue. The new event takes the position of
+        the event it replaces, so the order of the events of different types
+        or with different IDs is preserved.
+
+        This is useful for the events such as progress notifications which
+        are sent from worker threads: if they are sent faster than they can be
+        processed, only the latest of them is handled, instead of handling all
+        of them one after another.
+
+        Note that this doesn't limit the number of queued events: each of
+        them is still stored until the next time the pending events of this
+        handler are processed, and only replaces the previous one then. So if
+        the main thread doesn't process the events at all for some time, e.g.
+        because it is busy, the events queued during this time still use
+        memory proportional to their number.
+
+        Disabling coalescing doesn't affect the events which are already
+        pending, but the events queued after doing it are not merged with them.
+
+        This function is thread-safe, but would typically be called once
+        before starting to queue events of the given type.
+
+        @param eventType The type of events to coalesce, e.g. @c wxEVT_THREAD.
+        @param coalesce If @true, enable coalescing for this event type, if
+            @false, disable it if it had been previously enabled.
+
+        @since 3.3.4
+    */
+    void CoalesceQueuedEvents(wxEventType eventType, bool coalesce = true);
+
     ///@}
 
 
@@ -1776,6 +1776,18 @@ public:
     /// Set attribute for the specified cell.
     virtual void SetAttr(wxGridCellAttr *attr, int row, int col);
 
+    /**
+        Set attribute for all cells in the specified block.
+
+        This is equivalent to calling SetAttr() for all cells of the block,
+        but takes time and memory independent of the number of cells in it.
+        Any attributes previously set for the individual cells inside the
+        block are removed.
+
+        @since 3.3.4
+     */
+    virtual void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
+
     /// Set attribute for the specified row.
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
 
@@ -2682,6 +2694,18 @@ public:
      */
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
 
+    /**
+        Set attribute of all cells in the specified block.
+
+        By default this function is simply forwarded to
+        wxGridCellAttrProvider::SetAttr().
+
+        The table takes ownership of @a attr, i.e. will call DecRef() on it.
+
+        @since 3.3.4
+     */
+    virtual void SetAttr(wxGridCellAttr* attr, const wxGridBlockCoords& block);
+
     /**
         Set attribute of the specified row.
 
@@ -4065,9 +4089,41 @@ public:
         Automatically sizes all columns to fit their contents. If @a setAsMin
         is @true the calculated widths will also be set as the minimal widths
         for the columns.
+
+        Note that this function can be very slow for grids with many rows, as
+        it measures all cells by default, consider using
+        EnableAutoSizeSampling() for such grids.
     */
     void AutoSizeColumns(bool setAsMin = true);
 
+    /**
+        Enable or disable measuring only some of the cells when auto sizing.
+
+        By default, AutoSizeColumn() and AutoSizeRow() and the functions
+        using them, such as AutoSizeColumns(), measure all cells of the column
+        or row, which can take a long time for big grids. When sampling is
+        enabled, they measure only the cells at the beginning and at the end
+        of the column or row, as many of them as can be measured quickly,
+        and all the currently visible cells, similarly to what
+        wxDataViewCtrl does. The result may be too small if some of the cells
+        not measured need more space than the others, but auto sizing takes
+        a short, bounded, time.
+
+        @see IsAutoSizeSamplingEnabled()
+
+        @since 3.3.4
+    */
+    void EnableAutoSizeSampling(bool enable = true);
+
+    /**
+        Return @true if sampling is used when auto sizing.
+
+        @see EnableAutoSizeSampling()
+
+        @since 3.3.4
+    */
+    bool IsAutoSizeSamplingEnabled() const;
+
     /**
         Automatically sizes the row to fit its contents. If @a setAsMin is
         @true the calculated height will also be set as the minimal height for
@@ -5966,6 +6022,49 @@ public:
     void RefreshBlock(int topRow, int leftCol,
                       int bottomRow, int rightCol);
 
+    /**
+        Mark the given cell as needing to be redrawn later.
+
+        This is similar to calling RefreshBlock() for this cell, but more
+        efficient when many cells are updated, e.g. when their values change
+        in the table, as the cells are not refreshed immediately. Instead, all
+        the cells marked dirty are remembered and refreshed together when the
+        control returns to the event loop, with the adjacent cells and blocks
+        merged into as few rectangles as possible. Only the cells in these
+        rectangles are redrawn, unlike when using ForceRefresh() which redraws
+        the entire grid.
+
+        @see MarkBlockDirty(), RefreshDirtyCells()
+
+        @since 3.3.4
+     */
+    void MarkCellDirty(int row, int col);
+
+    /**
+        Mark all cells in the given block as needing to be redrawn later.
+
+        See MarkCellDirty() for more details.
+
+        @since 3.3.4
+     */
+    void MarkBlockDirty(const wxGridBlockCoords& block);
+
+    /**
+        Refresh all cells marked as dirty immediately.
+
+        This function is called automatically after marking some cells dirty
+        with MarkCellDirty() or MarkBlockDirty(), so it usually doesn't need to
+        be called explicitly, but it can be used to refresh the cells without
+        waiting for the control to return to the event loop.
+
+        Note that, as with the other functions refreshing the grid, nothing
+        is done while inside BeginBatch() and EndBatch() calls as the entire
+        grid is refreshed by the latter anyhow.
+
+        @since 3.3.4
+     */
+    void RefreshDirtyCells();
+
     /**
         Draws part or all of a wxGrid on a wxDC for printing or display.
 
@@ -6009,6 +6108,24 @@ public:
     */
     void SetAttr(int row, int col, wxGridCellAttr *attr);
 
+    /**
+        Sets the cell attributes for all cells in the specified block.
+
+        The grid takes ownership of the attribute pointer.
+
+        This is equivalent to calling SetAttr() for every cell of the block,
+        but is much more efficient for big blocks, as the attribute is stored
+        only once for the entire block. Notice that this also means that the
+        attribute is shared by all cells of the block, so modifying it, e.g.
+        by calling SetCellBackgroundColour() for one of them, affects all of
+        them. The attributes previously set for the individual cells inside
+        the block are removed, while the ones set for the cells outside of it
+        are not affected.
+
+        @since 3.3.4
+    */
+    void SetAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr);
+
     /**
         Sets the cell attributes for all cells in the specified column.
 
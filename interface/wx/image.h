@@ -104,6 +104,29 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+/**
+    Formats of the interleaved pixel data used by wxImage::CreateRGBA().
+
+    @since 3.3.4
+*/
+enum wxImageRGBAFormat
+{
+    /**
+        R, G, B and A bytes in this order, without alpha pre-multiplication.
+
+        This is the format used by GdkPixbuf and by wxImage::SetDataRGBA().
+     */
+    wxIMAGE_RGBA_STRAIGHT,
+
+    /**
+        32-bit 0xAARRGGBB values in native byte order with pre-multiplied
+        alpha.
+
+        This is the format used by Cairo @c CAIRO_FORMAT_ARGB32 surfaces.
+     */
+    wxIMAGE_ARGB32_PREMULTIPLIED
+};
+
 /**
     Possible values for PNG image type option.
 
@@ -175,6 +198,117 @@ enum
 };
 
 
+/**
+    @class wxImageRowSink
+
+    Interface for receiving image data row by row from
+    wxImageHandler::LoadRows().
+
+    Loading an image in this way allows to process it without ever creating a
+    wxImage containing all of its pixels, which is useful for the very big
+    images, e.g. to create a thumbnail or to extract a part of the image.
+
+    Example of a sink computing the average colour of an image:
+    @code
+    class AverageColourSink : public wxImageRowSink
+    {
+    public:
+        bool OnStart(int width, int WXUNUSED(height), bool WXUNUSED(hasAlpha)) override
+        {
+            m_width = width;
+            return true;
+        }
+
+        bool OnRow(int WXUNUSED(y), const unsigned char* rgb,
+                   const unsigned char* WXUNUSED(alpha)) override
+        {
+            for ( int x = 0; x < m_width; x++ )
+            {
+                m_sumR += *rgb++;
+                m_sumG += *rgb++;
+                m_sumB += *rgb++;
+            }
+
+            m_count += m_width;
+            return true;
+        }
+
+        ...
+    };
+    @endcode
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.4
+*/
+class wxImageRowSink
+{
+public:
+    /**
+        Default constructor.
+    */
+    wxImageRowSink();
+
+    /**
+        Virtual destructor for the base class.
+    */
+    virtual ~wxImageRowSink();
+
+    /**
+        Called once before any rows are passed to OnRow().
+
+        The size of the image may be smaller than its real size if
+        GetMaxSize() is overridden and the handler supports decoding the image
+        at a reduced size.
+
+        @param width Width of the image, in pixels.
+        @param height Height of the image, in pixels.
+        @param hasAlpha If @true, alpha channel values will be passed to
+            OnRow(), otherwise its @a alpha parameter is always @NULL. Note
+            that this parameter is @true for all images with alpha channel
+            information, even if all of their pixels turn out to be opaque,
+            while wxImage::LoadFile() doesn't create the alpha channel for
+            the images without any transparent pixels.
+        @return @true to continue loading or @false to cancel it, in which
+            case wxImageHandler::LoadRows() returns @false.
+    */
+    virtual bool OnStart(int width, int height, bool hasAlpha) = 0;
+
+    /**
+        Called for each row of the image, in top to bottom order.
+
+        The pointers are only valid during the call of this function, the
+        data must be copied if needed later.
+
+        @param y Index of the row, from 0 to height-1.
+        @param rgb RGB data of the row, containing 3*width bytes.
+        @param alpha Alpha channel values for the row, containing width
+            bytes, or @NULL if the image has no alpha channel.
+        @return @true to continue loading or @false to stop it without
+            loading the remaining rows. Stopping is not considered to be an
+            error and doesn't make wxImageHandler::LoadRows() return @false.
+    */
+    virtual bool OnRow(int y,
+                       const unsigned char* rgb,
+                       const unsigned char* alpha) = 0;
+
+    /**
+        Return the maximal size of the image to produce.
+
+        This function can be overridden to allow the handlers supporting it
+        to decode the image at a reduced size, which is much faster than
+        decoding it at full size and scaling it down later. Currently only
+        wxJPEGHandler supports this: it uses the smallest scale factor which
+        still results in an image at least as big as the returned size.
+
+        Either component of the returned size may be -1 to indicate that
+        there is no limit in this direction. Default implementation returns
+        ::wxDefaultSize, i.e. doesn't limit the size at all.
+    */
+    virtual wxSize GetMaxSize() const;
+};
+
 /**
     @class wxImageHandler
 
@@ -330,6 +464,38 @@ public:
     virtual bool LoadFile(wxImage* image, wxInputStream& stream,
                           bool verbose = true, int index = -1);
 
+    /**
+        Loads an image from a stream, passing its data to the sink row by row.
+
+        The base class implementation of this function loads the entire image
+        using LoadFile() and then passes it to the sink, so it doesn't save
+        any memory, but the handlers for PNG, JPEG and TIFF formats override
+        it to decode the image progressively, without ever keeping all of it
+        in memory (with the exception of interlaced PNG images and TIFF images
+        stored as a single strip, which still need to be decoded at once).
+
+        If the image has a mask, it is converted to alpha channel.
+
+        @param sink
+            The object receiving the image data.
+        @param stream
+            Opened input stream for reading image data.
+        @param verbose
+            If set to @true, errors reported by the image handler will produce
+            wxLogMessages.
+        @param index
+            The index of the image in the file (starting from zero).
+
+        @return @true if the image was loaded successfully or if loading was
+            stopped by wxImageRowSink::OnRow() returning @false, @false if
+            an error occurred or if wxImageRowSink::OnStart() returned
+            @false.
+
+        @since 3.3.4
+    */
+    virtual bool LoadRows(wxImageRowSink& sink, wxInputStream& stream,
+                          bool verbose = true, int index = -1);
+
     /**
         Saves an image in the output stream.
 
@@ -807,6 +973,45 @@ public:
     */
     bool Create( const wxSize& sz, unsigned char* data, unsigned char* alpha, bool static_data = false );
 
+    /**
+        Creates an image using interleaved pixel data in the given format.
+
+        The image keeps the data in the specified format and only creates
+        the usual separate RGB and alpha buffers from it when they are needed,
+        e.g. when GetData() is called. This is useful to avoid converting the
+        pixels when the image is converted to wxBitmap or wxGraphicsBitmap
+        later, as these conversions can use this data directly if the format
+        is compatible with the native one (e.g. ::wxIMAGE_RGBA_STRAIGHT for
+        wxGTK wxBitmap and ::wxIMAGE_ARGB32_PREMULTIPLIED for Cairo
+        wxGraphicsBitmap).
+
+        The image always has alpha channel when created using this function.
+        The interleaved data is discarded when the image is modified, see
+        GetDataRGBA().
+
+        @param width
+            The width of the image.
+        @param height
+            The height of the image.
+        @param rgba
+            Pointer to the data of size width*height*4 bytes allocated with
+            @c malloc(), the image takes ownership of it.
+        @param format
+            The format of the data.
+
+        @return @true if the call succeeded, @false otherwise.
+
+        @since 3.3.4
+    */
+    bool CreateRGBA( int width, int height, unsigned char* rgba,
+                     wxImageRGBAFormat format = wxIMAGE_RGBA_STRAIGHT );
+
+    /**
+        @overload
+    */
+    bool CreateRGBA( const wxSize& sz, unsigned char* rgba,
+                     wxImageRGBAFormat format = wxIMAGE_RGBA_STRAIGHT );
+
     /**
         Initialize the image data with zeroes (the default) or with the
         byte value given as @a value.
@@ -1252,6 +1457,36 @@ public:
     */
     unsigned char* GetAlpha() const;
 
+    /**
+        Returns the interleaved pixel data, if the image uses it.
+
+        The image has interleaved data only if it was created by CreateRGBA()
+        or converted by ConvertToRGBA() and hasn't been modified since then,
+        as all wxImage functions changing the image discard this data.
+
+        As the pixels may be modified using the pointers returned by GetData()
+        and GetAlpha(), calling either of these functions also makes this
+        function return @NULL, until ConvertToRGBA() is called again.
+
+        The returned pointer may only be used for reading the data, which is
+        in the format returned by GetRGBAFormat().
+
+        @return Pointer to width*height*4 bytes of data or @NULL if the image
+            doesn't use interleaved data.
+
+        @since 3.3.4
+    */
+    const unsigned char* GetDataRGBA() const;
+
+    /**
+        Returns the format of the data returned by GetDataRGBA().
+
+        The return value is meaningless if GetDataRGBA() returns @NULL.
+
+        @since 3.3.4
+    */
+    wxImageRGBAFormat GetRGBAFormat() const;
+
     /**
         Returns the image data as an array.
 
@@ -1375,8 +1610,11 @@ public:
             one right now) support rescaling the image during loading which is
             vastly more efficient than loading the entire huge image and
             rescaling it later (if these options are not supported by the
-            handler, this is still what happens however). These options must be
-            set before calling LoadFile() to have any effect.
+            handler, this is still what happens however). JPEG handler can
+            decode the image directly at 1/2, 1/4 or 1/8 of its size and only
+            needs to rescale it after loading if an even smaller size is
+            required. These options must be set before calling LoadFile() to
+            have any effect.
 
         @li @c wxIMAGE_OPTION_ORIGINAL_WIDTH and @c wxIMAGE_OPTION_ORIGINAL_HEIGHT:
             These options will return the original size of the image if either
@@ -1822,6 +2060,26 @@ public:
     */
     void SetDataRGBA(const unsigned char* data);
 
+    /**
+        Converts the image to use interleaved pixel data in the given format.
+
+        After calling this function, GetDataRGBA() returns the pixel data in
+        the specified format until the image is modified. The interleaved data
+        replaces the separate RGB and alpha buffers, which are recreated from
+        it when needed, so any pointers previously returned by GetData() and
+        GetAlpha() become invalid. If the image didn't have alpha channel, it
+        is added to it and is fully opaque for all pixels.
+
+        This can be useful to convert the image to the format used by the
+        platform only once if it is going to be converted to wxBitmap or
+        wxGraphicsBitmap many times.
+
+        @see CreateRGBA()
+
+        @since 3.3.4
+    */
+    void ConvertToRGBA(wxImageRGBAFormat format = wxIMAGE_RGBA_STRAIGHT);
+
     /**
         Sets the default value for the flags used for loading image files.
 
@@ -1837,6 +2095,46 @@ public:
      */
     static void SetDefaultLoadFlags(int flags);
 
+    /**
+        Sets the maximal number of threads used for image processing.
+
+        By default, all image processing functions run in the calling thread
+        only. Calling this function with @a count greater than 1 allows Scale(),
+        Rescale(), Blur(), BlurHorizontal() and BlurVertical() to split the
+        image into horizontal (or, for BlurVertical(), vertical) bands and
+        process them in parallel using up to @a count threads, including the
+        calling one. The special value of 0 means to use as many threads as
+        there are CPUs in the system.
+
+        The worker threads are created when they are needed for the first time
+        and reused by all the subsequent operations. As the calling thread is
+        used too, there is one worker thread less than the number of CPUs, so
+        no more threads than there are CPUs are used even if @a count is
+        greater.
+
+        The results of these functions are exactly the same whichever number
+        of threads is used. Small images are always processed in the calling
+        thread only, as using multiple threads would make it slower for them.
+
+        This function changes a global setting and is not thread-safe itself,
+        so it should be called during the program initialization.
+
+        @see GetMaxThreads()
+
+        @since 3.3.4
+     */
+    static void SetMaxThreads(int count);
+
+    /**
+        Returns the maximal number of threads used for image processing.
+
+        See SetMaxThreads() for the meaning of the returned value, by default
+        it is 1.
+
+        @since 3.3.4
+     */
+    static int GetMaxThreads();
+
     /**
         Sets the flags used for loading image files by this object.
 
@@ -1440,6 +1440,49 @@ public:
     */
     void CheckItem(long item, bool check);
 
+    /**
+        Enable or disable using different heights for different lines.
+
+        By default, all lines of the control have the same height and any new
+        line characters in the items text are replaced with spaces when
+        displaying it. After calling this function, the items containing
+        multiple lines of text are shown in their entirety in report view and
+        the height of each line is adjusted to fit the item with the most text
+        lines in it.
+
+        The heights of the lines are computed when they're needed for the
+        first time and then cached, so that using this function is possible
+        even with big virtual controls. The total height of the control, used
+        for the scrollbars, is estimated using the default height for the
+        lines which haven't been shown yet and updated when their heights
+        become known. For virtual controls, RefreshItem() or RefreshItems()
+        must be called when the text of the items changes to update their
+        height.
+
+        Note that this function is currently only implemented in the generic
+        version and does nothing and returns @false in the native wxMSW and
+        wxQt ones.
+
+        @param enable If @true, enable variable line height, otherwise
+            disable it.
+        @return @true if the variable line height is supported, @false
+            otherwise.
+
+        @see HasVariableLineHeight()
+
+        @since 3.3.4
+    */
+    bool EnableVariableLineHeight(bool enable = true);
+
+    /**
+        Return @true if variable line height was enabled.
+
+        @see EnableVariableLineHeight()
+
+        @since 3.3.4
+    */
+    bool HasVariableLineHeight() const;
+
     /**
         Extend rules and alternate rows background to the entire client area.
 
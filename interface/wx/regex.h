@@ -98,6 +98,13 @@ enum
     for the discussion of the changes if you're upgrading from an older
     version.
 
+    Since wxWidgets 3.3.4, the regular expressions are compiled to machine
+    code using PCRE JIT compiler, if it's available, which makes matching them
+    significantly faster, at the price of making compiling them slower, so
+    it's better to reuse the same wxRegEx object for matching many strings.
+    The data used for matching is shared by all wxRegEx objects used by the
+    same thread.
+
     Note that while C++11 and later provides @c std::regex and related classes,
     this class is still useful as it provides the following important
     advantages:
@@ -308,6 +315,29 @@ public:
     */
     bool Matches(const wxString& text, int flags = 0) const;
 
+    /**
+        Matches the precompiled regular expression against the characters in
+        the range from @a begin to @a end, not including the latter.
+
+        The characters must use the same representation as wxString uses
+        internally, i.e. be @c wchar_t in the default build or UTF-8 encoded
+        @c char when @c wxUSE_UNICODE_UTF8 is 1. Unlike the other overloads,
+        this one never copies the text, which makes it more efficient when
+        looking for matches in a big buffer, e.g. the entire contents of a log
+        file. The positions returned by GetMatch() after calling this function
+        are relative to @a begin.
+
+        @e Flags may be combination of @c wxRE_NOTBOL, @c wxRE_NOTEOL and
+        @c wxRE_NOTEMPTY, see @ref wxRE_NOT_FLAGS.
+
+        May only be called after successful call to Compile().
+
+        @since 3.3.4
+    */
+    bool MatchesRange(const wxStringCharType* begin,
+                      const wxStringCharType* end,
+                      int flags = 0) const;
+
     /**
         Replaces the current regular expression in the string pointed to by
         @a text, with the text in @a replacement and return number of matches
@@ -68,6 +68,43 @@ public:
      */
     virtual size_t GetMaxCharLen() const;
 
+    /**
+        Returns the maximal number of wide characters which ToWChar() can
+        produce when converting the given number of bytes.
+
+        The @a srcLen parameter is the exact length of the input, including
+        the trailing @c NUL(s) if the input is @c NUL-terminated, and can't be
+        ::wxNO_LEN.
+
+        This function is used by cMB2WC() and the other functions returning
+        the conversion result in a newly allocated buffer: if it doesn't return
+        @c wxCONV_FAILED, they allocate the buffer of the returned size and
+        convert the input directly into it, shrinking it afterwards, instead
+        of calling ToWChar() twice, first to find the size of the output and
+        then to actually convert it. Because of this, the value returned by
+        this function must never be smaller than the actual length of the
+        output, but it should also not be much bigger than it, as this would
+        waste memory.
+
+        The default implementation returns @c wxCONV_FAILED, meaning that the
+        length of the output is unknown. wxWidgets overrides it for UTF-8,
+        UTF-16 and UTF-32 conversions and for wxCSConv when it uses Latin-1.
+
+        @since 3.3.4
+     */
+    virtual size_t GetMaxWCLen(size_t srcLen) const;
+
+    /**
+        Returns the maximal number of bytes which FromWChar() can produce when
+        converting the given number of wide characters.
+
+        This is the same as GetMaxWCLen(), but for the conversion in the other
+        direction, used by cWC2MB().
+
+        @since 3.3.4
+     */
+    virtual size_t GetMaxMBLen(size_t srcLen) const;
+
     /**
         This function returns 1 for most of the multibyte encodings in which the
         string is terminated by a single @c NUL, 2 for UTF-16 and 4 for UTF-32 for
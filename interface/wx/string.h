@@ -1560,6 +1560,37 @@ public:
     */
     int PrintfV(const wxString& pszFormat, va_list argPtr);
 
+    /**
+        Appends the formatted string to this one.
+
+        This function is similar to Printf() but appends its output to the
+        existing string contents instead of replacing them. It is more
+        efficient than using
+        @code
+        str += wxString::Format(...);
+        @endcode
+        as it avoids creating a temporary string, which makes it a good choice
+        for building long strings piece by piece, e.g.
+        @code
+        wxString report;
+        for ( const auto& item : items )
+            report.AppendFormat("%s: %d\n", item.name, item.count);
+        @endcode
+
+        Returns the number of characters appended, or an integer less than zero
+        on error, in which case the string is left unchanged.
+
+        @since 3.3.4
+    */
+    int AppendFormat(const wxString& format, ...);
+
+    /**
+        Same as AppendFormat() but takes a @c va_list.
+
+        @since 3.3.4
+    */
+    int AppendFormatV(const wxString& format, va_list argPtr);
+
     ///@}
 
 
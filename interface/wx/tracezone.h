@@ -0,0 +1,122 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tracezone.h
+// Purpose:     interface of wxTraceZone
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxTraceZone
+
+    Records the time spent in the current scope for profiling.
+
+    Objects of this class are normally not created directly but by using
+    wxTRACE_ZONE() macro at the beginning of a function or a block. When
+    recording is enabled by calling Enable(), each such zone records its name
+    and the times when it was entered and exited into a buffer specific to the
+    current thread. When recording is disabled, which is the default, the
+    overhead of the zone consists in checking whether it is enabled only.
+
+    The recorded zones can then be retrieved in the Chrome trace event
+    format, which can be viewed using e.g. @c chrome://tracing page in the
+    browser or https://ui.perfetto.dev/, by calling GetChromeTrace() or
+    SaveChromeTrace().
+
+    Note that each thread keeps only a limited number of the most recent
+    zones, the older ones are discarded. The zones recorded by a thread remain
+    available after it terminates, but only until another thread starts
+    recording zones, as it reuses the memory of the terminated thread.
+
+    @code
+    void MyFrame::UpdateEverything()
+    {
+        wxTRACE_ZONE("MyFrame::UpdateEverything");
+
+        ...
+    }
+
+    wxTraceZone::Enable();
+    frame->UpdateEverything();
+    wxTraceZone::Enable(false);
+
+    wxTraceZone::SaveChromeTrace("trace.json");
+    @endcode
+
+    wxWidgets itself uses trace zones in some performance-critical functions,
+    such as wxEvtHandler::ProcessEvent(), wxSizer::Layout(), painting the
+    windows and wxImage::LoadFile(), but only if it was built with
+    @c wxUSE_TRACE_ZONES defined as 1.
+
+    @library{wxbase}
+    @category{debugging}
+
+    @since 3.3.4
+*/
+class wxTraceZone
+{
+public:
+    /**
+        Start recording a zone with the given name if recording is enabled.
+
+        The zone ends when this object is destroyed.
+
+        @param name The name of the zone, which must remain valid until the
+            trace is retrieved, i.e. should normally be a string literal.
+    */
+    explicit wxTraceZone(const char* name);
+
+    /**
+        Record the zone if it had been started.
+    */
+    ~wxTraceZone();
+
+    /**
+        Enable or disable recording the zones.
+
+        Recording is disabled by default.
+
+        This function can be called from any thread.
+    */
+    static void Enable(bool enable = true);
+
+    /**
+        Return @true if recording the zones is enabled.
+    */
+    static bool IsEnabled();
+
+    /**
+        Return all zones recorded in all threads in Chrome trace event format.
+
+        The zones recorded by the other threads while this function is running
+        may or not be included in the result, so it's better to call it after
+        disabling recording.
+    */
+    static wxString GetChromeTrace();
+
+    /**
+        Save the string returned by GetChromeTrace() to the given file.
+
+        Returns @true if the file was written successfully.
+    */
+    static bool SaveChromeTrace(const wxString& filename);
+
+    /**
+        Discard all zones recorded so far.
+    */
+    static void Clear();
+};
+
+/**
+    Record the time spent in the current scope using wxTraceZone.
+
+    This macro does nothing unless @c wxUSE_TRACE_ZONES is set to 1 in
+    wx/setup.h, which is not the case by default. It can also be enabled
+    using @c --enable-trace_zones configure option or @c wxUSE_TRACE_ZONES
+    CMake option.
+
+    @param name Name of the zone, must be a string literal.
+
+    @header{wx/tracezone.h}
+
+    @since 3.3.4
+*/
+#define wxTRACE_ZONE(name)
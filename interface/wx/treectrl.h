@@ -782,6 +782,17 @@ public:
                             int selImage = -1,
                             wxTreeItemData* data = nullptr);
 
+    /**
+        Returns the index of a virtual item among the children of its parent.
+
+        If the item is not virtual, i.e. it was not created by the control
+        for one of the children specified by SetItemVirtualChildren(),
+        returns @c wxNOT_FOUND.
+
+        @since 3.3.4
+    */
+    virtual int GetVirtualItemIndex(const wxTreeItemId& item) const;
+
     /**
         Returns @true if the given item is in bold state.
 
@@ -833,6 +844,37 @@ public:
     virtual int OnCompareItems(const wxTreeItemId& item1,
                                const wxTreeItemId& item2);
 
+    /**
+        Override this function in the derived class to return the label of
+        the virtual children of the given item.
+
+        This function must be overridden if SetItemVirtualChildren() is used.
+        It is called only when the item needs to be shown or when its id is
+        needed, and not for all virtual children at once.
+
+        @param parent The item whose child label is needed.
+        @param index The index of the child, from 0 to the number of virtual
+            children of the parent item.
+
+        @since 3.3.4
+    */
+    virtual wxString OnGetVirtualItemText(const wxTreeItemId& parent,
+                                          size_t index) const;
+
+    /**
+        Override this function in the derived class to return the image of
+        the virtual children of the given item.
+
+        The default version returns -1, meaning that the virtual items don't
+        have any images.
+
+        @see OnGetVirtualItemText()
+
+        @since 3.3.4
+    */
+    virtual int OnGetVirtualItemImage(const wxTreeItemId& parent,
+                                      size_t index) const;
+
     /**
         Appends an item as the first child of @a parent, return a new item id.
 
@@ -986,6 +1028,52 @@ public:
     virtual void SetItemTextColour(const wxTreeItemId& item,
                                    const wxColour& col);
 
+    /**
+        Makes the item have the given number of virtual children.
+
+        Virtual children are not stored in the control, their labels and
+        images are obtained by calling OnGetVirtualItemText() and
+        OnGetVirtualItemImage() only when they need to be shown, which allows
+        showing items with a huge number of children, e.g. directories with
+        hundreds of thousands of files, using a bounded amount of memory.
+
+        The control creates the items for the virtual children only when
+        their ids are needed, e.g. because they're returned from the
+        navigation functions such as GetFirstChild() or GetNextSibling(), or
+        because the user clicked on them. These items can be used like the
+        normal items, e.g. selected or have data associated with them, and
+        their ids remain valid until the virtual children of their parent are
+        deleted, which happens when the parent item children are deleted or
+        this function is called again. Note that this means that the memory
+        used by the control grows with the number of virtual children whose
+        ids were needed, so iterating over all of them should be avoided if
+        there are many of them. Deleting the individual virtual items is not
+        supported.
+
+        Virtual children never have any children of their own and always have
+        the same height as the other items, even when using
+        @c wxTR_HAS_VARIABLE_ROW_HEIGHT style. The item using them can't have
+        any normal children, so any existing children of the item are deleted
+        by this function and no new children can be added to it after calling
+        it.
+
+        Calling this function with @a count of 0 removes all the virtual
+        children of the item.
+
+        Note that this function is currently only implemented in the generic
+        version and does nothing and returns @false in the native wxMSW and
+        wxQt ones. wxGenericTreeCtrl can be used instead of wxTreeCtrl to use
+        virtual items under all platforms.
+
+        @param item The item which should have virtual children.
+        @param count The number of virtual children.
+        @return @true if virtual children are supported, @false otherwise.
+
+        @since 3.3.4
+    */
+    virtual bool SetItemVirtualChildren(const wxTreeItemId& item,
+                                        size_t count);
+
     /**
         If @true is passed, specifies that the control will use a quick
         calculation for the best size, looking only at the first and last items.
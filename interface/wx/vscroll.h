@@ -73,6 +73,29 @@ public:
     */
     void EnablePhysicalScrolling(bool scrolling = true);
 
+    /**
+        Enable or disable caching the sizes of the units.
+
+        By default, the sizes of the units are not cached and OnGetRowHeight()
+        or OnGetColumnWidth() are called every time they're needed. Notably,
+        this means that finding the scroll position in pixels requires calling
+        them for all the units before the first visible one, which may be
+        slow when there are millions of them.
+
+        When the cache is enabled, the position of each unit is computed only
+        once, when it's needed for the first time, and remembered, making
+        scrolling and hit testing fast even with a huge number of units. The
+        price to pay is that the cache must be kept up to date: whenever the
+        size of some unit changes, RefreshRow(), RefreshRows() (or
+        RefreshColumn(), RefreshColumns() for horizontally scrolled windows)
+        or RefreshAll() must be called. Refreshing a unit only takes time
+        logarithmic in the number of units, while RefreshAll() and changing
+        the number of units discard the cache.
+
+        @since 3.3.4
+    */
+    void EnableSizeCache(bool enable = true);
+
     /**
         This function needs to be overridden in the in the derived class to
         return the window size with respect to the opposing orientation. If
@@ -520,6 +543,20 @@ public:
     void EnablePhysicalScrolling(bool vscrolling = true,
                                  bool hscrolling = true);
 
+    /**
+        Enable or disable caching the sizes of the rows and columns.
+
+        See wxVarScrollHelperBase::EnableSizeCache() for more details.
+
+        @param vcache
+            Specifies if the heights of the rows should be cached.
+        @param hcache
+            Specifies if the widths of the columns should be cached.
+
+        @since 3.3.4
+    */
+    void EnableSizeCache(bool vcache = true, bool hcache = true);
+
     /**
         Returns the number of columns and rows the target window contains.
 
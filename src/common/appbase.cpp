@@ -609,11 +609,14 @@ void wxAppConsoleBase::DeletePendingEvents()
     wxCHECK_RET( m_handlersWithPendingDelayedEvents.IsEmpty(),
                  "this helper list should be empty" );
 
-    for (unsigned int i=0; i<m_handlersWithPendingEvents.GetCount(); i++)
-        m_handlersWithPendingEvents[i]->DeletePendingEvents();
-
+    // Empty the list before deleting the events, as the handlers can add
+    // themselves to it again if new events are queued for them meanwhile.
+    const wxEvtHandlerArray handlers(m_handlersWithPendingEvents);
     m_handlersWithPendingEvents.Clear();
 
+    for (unsigned int i=0; i<handlers.GetCount(); i++)
+        handlers[i]->DeletePendingEvents();
+
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 }
 
@@ -370,6 +370,17 @@ wxConvAuto::FromWChar(char *dst, size_t dstLen,
     return m_conv->FromWChar(dst, dstLen, src, srcLen);
 }
 
+size_t wxConvAuto::GetMaxMBLen(size_t srcLen) const
+{
+    // we can't know what will ToWChar() produce before detecting the input
+    // encoding, but FromWChar() always uses UTF-8 if it's not known yet, so
+    // do the same thing here
+    if ( !m_conv )
+        const_cast<wxConvAuto *>(this)->InitWithUTF8();
+
+    return m_conv->GetMaxMBLen(srcLen);
+}
+
 wxFontEncoding wxConvAuto::GetEncoding() const
 {
     switch ( m_bomType )
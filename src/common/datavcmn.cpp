@@ -36,6 +36,8 @@
 
 #include "wx/private/safecall.h"
 
+#include <typeinfo>
+
 // Uncomment this line to, for custom renderers, visually show the extent
 // of both a cell and its item.
 //#define DEBUG_RENDER_EXTENTS
@@ -80,6 +82,21 @@ private:
     wxDECLARE_EVENT_TABLE();
 };
 
+// Return true if the model is exactly of the given type and not of a class
+// deriving from it, which could override GetValue() or GetValueByRow() and so
+// must be always asked for the values by calling them.
+template <typename T>
+bool IsModelOfExactType(const T& model)
+{
+#ifndef wxNO_RTTI
+    return typeid(model) == typeid(T);
+#else
+    // We can't check it, so assume the worst.
+    wxUnusedVar(model);
+    return false;
+#endif
+}
+
 } // anonymous namespace
 
 // ---------------------------------------------------------
@@ -503,6 +520,35 @@ void wxDataViewIndexListModel::RowAppended()
     ItemAdded( wxDataViewItem(nullptr), item );
 }
 
+void wxDataViewIndexListModel::RowsInserted( unsigned int before, unsigned int count )
+{
+    wxCHECK_RET( before <= m_hash.size(), wxS("invalid index") );
+
+    if ( !count )
+        return;
+
+    // Inserting at the end doesn't break the IDs order.
+    if ( before != m_hash.size() )
+        m_ordered = false;
+
+    wxDataViewItemArray items;
+    items.reserve( count );
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        items.push_back( wxDataViewItem(wxUIntToPtr(m_nextFreeID)) );
+        m_nextFreeID++;
+    }
+
+    m_hash.insert( m_hash.begin() + before, items.begin(), items.end() );
+
+    /* wxDataViewModel:: */ ItemsAdded( wxDataViewItem(nullptr), items );
+}
+
+void wxDataViewIndexListModel::RowsAppended( unsigned int count )
+{
+    RowsInserted( m_hash.size(), count );
+}
+
 void wxDataViewIndexListModel::RowDeleted( unsigned int row )
 {
     m_ordered = false;
@@ -894,18 +940,28 @@ wxDataViewRendererBase::PrepareForItem(const wxDataViewModel *model,
     return wxSafeCall<bool>([&, this]()
     {
 
-    // Now check if we have a value and remember it if we do.
-    wxVariant value = CheckedGetValue(model, item, column);
+    // Try to get the value without using wxVariant first, unless we need to
+    // adjust it, which can only be done with wxVariant.
+    bool hasValue = (!m_valueAdjuster || !IsHighlighted()) &&
+                        model->HasValue(item, column) &&
+                            SetValueFromModel(model, item, column);
 
-    if ( !value.IsNull() )
+    // Otherwise check if we have a value and remember it if we do.
+    if ( !hasValue )
     {
-        if ( m_valueAdjuster )
+        wxVariant value = CheckedGetValue(model, item, column);
+
+        if ( !value.IsNull() )
         {
-            if ( IsHighlighted() )
-                value = m_valueAdjuster->MakeHighlighted(value);
-        }
+            if ( m_valueAdjuster )
+            {
+                if ( IsHighlighted() )
+                    value = m_valueAdjuster->MakeHighlighted(value);
+            }
 
-        SetValue(value);
+            SetValue(value);
+            hasValue = true;
+        }
     }
 
     // Also set up the attributes: note that we need to do this even for the
@@ -918,7 +974,7 @@ wxDataViewRendererBase::PrepareForItem(const wxDataViewModel *model,
     // empty cells.
     SetEnabled(model->IsEnabled(item, column));
 
-    return !value.IsNull();
+    return hasValue;
     }, []()
     {
         // There is not much we can do about it here, just log it and don't
@@ -1802,6 +1858,7 @@ wxDEFINE_EVENT( wxEVT_DATAVIEW_COLUMN_HEADER_CLICK, wxDataViewEvent );
 wxDEFINE_EVENT( wxEVT_DATAVIEW_COLUMN_HEADER_RIGHT_CLICK, wxDataViewEvent );
 wxDEFINE_EVENT( wxEVT_DATAVIEW_COLUMN_SORTED, wxDataViewEvent );
 wxDEFINE_EVENT( wxEVT_DATAVIEW_COLUMN_REORDERED, wxDataViewEvent );
+wxDEFINE_EVENT( wxEVT_DATAVIEW_SORTING_PROGRESS, wxDataViewEvent );
 
 wxDEFINE_EVENT( wxEVT_DATAVIEW_CACHE_HINT, wxDataViewEvent );
 
@@ -2422,6 +2479,43 @@ void wxDataViewListStore::InsertItem(  unsigned int row, const wxVector<wxVarian
     RowInserted( row );
 }
 
+void wxDataViewListStore::AppendItems( wxVector< wxVector<wxVariant> > rows )
+{
+    InsertItems( m_data.size(), std::move(rows) );
+}
+
+void wxDataViewListStore::InsertItems( unsigned int row,
+                                       wxVector< wxVector<wxVariant> > rows )
+{
+    wxCHECK_RET( row <= m_data.size(), "invalid row" );
+
+    if ( rows.empty() )
+        return;
+
+    const size_t numValues = m_data.empty() ? rows[0].size()
+                                            : m_data[0]->m_values.size();
+
+    wxVector<wxDataViewListStoreLine*> lines;
+    lines.reserve( rows.size() );
+    for ( size_t n = 0; n < rows.size(); n++ )
+    {
+        if ( rows[n].size() != numValues )
+        {
+            for ( size_t i = 0; i < lines.size(); i++ )
+                delete lines[i];
+
+            wxFAIL_MSG( "wrong number of values" );
+            return;
+        }
+
+        lines.push_back( new wxDataViewListStoreLine( std::move(rows[n]) ) );
+    }
+
+    m_data.insert( m_data.begin() + row, lines.begin(), lines.end() );
+
+    RowsInserted( row, lines.size() );
+}
+
 void wxDataViewListStore::DeleteItem( unsigned int row )
 {
     wxVector<wxDataViewListStoreLine*>::iterator it = m_data.begin() + row;
@@ -2480,6 +2574,51 @@ bool wxDataViewListStore::SetValueByRow( const wxVariant &value, unsigned int ro
     return true;
 }
 
+bool wxDataViewListStore::GetValueAsString( wxString &value,
+                                            const wxDataViewItem &item,
+                                            unsigned int col ) const
+{
+    if ( !IsModelOfExactType(*this) )
+        return false;
+
+    const wxVariant& variant = m_data[GetRow(item)]->m_values[col];
+    if ( variant.GetType() != wxS("string") )
+        return false;
+
+    value = variant.GetString();
+    return true;
+}
+
+bool wxDataViewListStore::GetValueAsLong( long &value,
+                                          const wxDataViewItem &item,
+                                          unsigned int col ) const
+{
+    if ( !IsModelOfExactType(*this) )
+        return false;
+
+    const wxVariant& variant = m_data[GetRow(item)]->m_values[col];
+    if ( variant.GetType() != wxS("long") )
+        return false;
+
+    value = variant.GetLong();
+    return true;
+}
+
+bool wxDataViewListStore::GetValueAsIconText( wxDataViewIconText &value,
+                                              const wxDataViewItem &item,
+                                              unsigned int col ) const
+{
+    if ( !IsModelOfExactType(*this) )
+        return false;
+
+    const wxVariant& variant = m_data[GetRow(item)]->m_values[col];
+    if ( variant.GetType() != wxS("wxDataViewIconText") )
+        return false;
+
+    value << variant;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // wxDataViewListCtrl
 //-----------------------------------------------------------------------------
@@ -2723,6 +2862,62 @@ wxDataViewTreeStore::InsertItem(const wxDataViewItem& parent,
     return node->GetItem();
 }
 
+wxDataViewItemArray
+wxDataViewTreeStore::AppendItems(const wxDataViewItem& parent,
+                                 const wxVector<wxString>& texts,
+                                 const wxBitmapBundle& icon)
+{
+    wxDataViewItemArray items;
+
+    wxDataViewTreeStoreContainerNode *parent_node = FindContainerNode( parent );
+    if (!parent_node) return items;
+
+    wxDataViewTreeStoreNodes& children = parent_node->GetChildren();
+    children.reserve( children.size() + texts.size() );
+    items.reserve( texts.size() );
+    for ( size_t n = 0; n < texts.size(); n++ )
+    {
+        wxDataViewTreeStoreNode *node =
+            new wxDataViewTreeStoreNode( parent_node, texts[n], icon );
+        children.push_back( node );
+        items.push_back( node->GetItem() );
+    }
+
+    return items;
+}
+
+wxDataViewItemArray
+wxDataViewTreeStore::InsertItems(const wxDataViewItem& parent,
+                                 const wxDataViewItem& previous,
+                                 const wxVector<wxString>& texts,
+                                 const wxBitmapBundle& icon)
+{
+    wxDataViewItemArray items;
+
+    wxDataViewTreeStoreContainerNode *parent_node = FindContainerNode( parent );
+    if (!parent_node) return items;
+
+    wxDataViewTreeStoreNode *previous_node = FindNode( previous );
+    wxDataViewTreeStoreNodes& children = parent_node->GetChildren();
+    const wxDataViewTreeStoreNodes::iterator iter = parent_node->FindChild( previous_node );
+    if (iter == children.end()) return items;
+
+    wxDataViewTreeStoreNodes nodes;
+    nodes.reserve( texts.size() );
+    items.reserve( texts.size() );
+    for ( size_t n = 0; n < texts.size(); n++ )
+    {
+        wxDataViewTreeStoreNode *node =
+            new wxDataViewTreeStoreNode( parent_node, texts[n], icon );
+        nodes.push_back( node );
+        items.push_back( node->GetItem() );
+    }
+
+    children.insert(iter, nodes.begin(), nodes.end());
+
+    return items;
+}
+
 wxDataViewItem wxDataViewTreeStore::PrependContainer( const wxDataViewItem& parent,
         const wxString &text, const wxBitmapBundle &icon, const wxBitmapBundle &expanded,
         wxClientData *data )
@@ -2908,12 +3103,35 @@ void wxDataViewTreeStore::DeleteAllItems()
 void
 wxDataViewTreeStore::GetValue(wxVariant &variant,
                               const wxDataViewItem &item,
-                              unsigned int WXUNUSED(col)) const
+                              unsigned int col) const
 {
-    // if (col != 0) return;
+    wxDataViewIconText data;
+    if ( !DoGetIconText(data, item, col) )
+        return;
+
+    variant << data;
+}
+
+bool
+wxDataViewTreeStore::GetValueAsIconText(wxDataViewIconText &value,
+                                        const wxDataViewItem &item,
+                                        unsigned int col) const
+{
+    if ( !IsModelOfExactType(*this) )
+        return false;
+
+    return DoGetIconText(value, item, col);
+}
+
+bool
+wxDataViewTreeStore::DoGetIconText(wxDataViewIconText &value,
+                                   const wxDataViewItem &item,
+                                   unsigned int WXUNUSED(col)) const
+{
+    // if (col != 0) return false;
 
     wxDataViewTreeStoreNode *node = FindNode( item );
-    if (!node) return;
+    if (!node) return false;
 
     wxBitmapBundle bb;
     if (node->IsContainer())
@@ -2926,9 +3144,10 @@ wxDataViewTreeStore::GetValue(wxVariant &variant,
     if (!bb.IsOk())
         bb = node->GetBitmapBundle();
 
-    wxDataViewIconText data( node->GetText(), bb );
+    value.SetText(node->GetText());
+    value.SetBitmapBundle(bb);
 
-    variant << data;
+    return true;
 }
 
 bool
@@ -3105,6 +3324,30 @@ wxDataViewItem wxDataViewTreeCtrl::InsertItem( const wxDataViewItem& parent, con
     return res;
 }
 
+wxDataViewItemArray wxDataViewTreeCtrl::AppendItems( const wxDataViewItem& parent,
+        const wxVector<wxString> &texts, int iconIndex )
+{
+    wxDataViewItemArray res = GetStore()->
+        AppendItems( parent, texts, GetBitmapBundle(iconIndex) );
+
+    if ( !res.empty() )
+        GetStore()->ItemsAdded( parent, res );
+
+    return res;
+}
+
+wxDataViewItemArray wxDataViewTreeCtrl::InsertItems( const wxDataViewItem& parent,
+        const wxDataViewItem& previous, const wxVector<wxString> &texts, int iconIndex )
+{
+    wxDataViewItemArray res = GetStore()->
+        InsertItems( parent, previous, texts, GetBitmapBundle(iconIndex) );
+
+    if ( !res.empty() )
+        GetStore()->ItemsAdded( parent, res );
+
+    return res;
+}
+
 wxDataViewItem wxDataViewTreeCtrl::PrependContainer( const wxDataViewItem& parent,
         const wxString &text, int iconIndex, int expandedIndex, wxClientData *data )
 {
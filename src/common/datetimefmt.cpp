@@ -43,6 +43,7 @@
 #include "wx/thread.h"
 
 #include <ctype.h>
+#include <limits.h>
 
 #ifdef __WINDOWS__
     #include <winnls.h>
@@ -96,11 +97,24 @@ bool GetNumericToken(size_t len,
                      unsigned long *number,
                      size_t *numScannedDigits = nullptr)
 {
+    // accumulate the value directly instead of collecting the digits in a
+    // string first, this function is used for every numeric field
     size_t n = 1;
-    wxString s;
+    unsigned long value = 0;
+    bool ok = true;
     while ( p != end && wxIsdigit(*p) )
     {
-        s += *p++;
+        const wxChar ch = *p++;
+
+        // wxIsdigit() may accept non-ASCII digits, which we don't handle
+        if ( ch < wxT('0') || ch > wxT('9') )
+            ok = false;
+
+        const unsigned long digit = ch - wxT('0');
+        if ( value > (ULONG_MAX - digit) / 10 )
+            ok = false;
+
+        value = value*10 + digit;
 
         if ( len && ++n > len )
             break;
@@ -111,7 +125,11 @@ bool GetNumericToken(size_t len,
         *numScannedDigits = n - 1;
     }
 
-    return !s.empty() && s.ToULong(number);
+    if ( n == 1 || !ok )
+        return false;
+
+    *number = value;
+    return true;
 }
 
 // scans all alphabetic characters and returns the resulting string
@@ -306,6 +324,143 @@ ParseFormatAt(wxString::const_iterator& p,
     return dt;
 }
 
+// the fields found in the string by the parsing code and their values
+struct ParsedFields
+{
+    // combine the fields found with the default date, which is used if valid,
+    // or the existing value of dt, if it is, or today's date otherwise
+    bool ApplyTo(wxDateTime& dt, const wxDateTime& dateDef) const;
+
+    // what fields have we found?
+    bool haveWDay = false,
+         haveYDay = false,
+         haveDay = false,
+         haveMon = false,
+         haveYear = false,
+         haveHour = false,
+         haveMin = false,
+         haveSec = false,
+         haveMsec = false;
+
+    bool hourIsIn12hFormat = false, // or in 24h one?
+         isPM = false;              // AM by default
+
+    bool haveTimeZone = false;
+
+    // and the value of the items we have
+    wxDateTime::wxDateTime_t msec = 0,
+                             sec = 0,
+                             min = 0,
+                             hour = 0;
+    wxDateTime::WeekDay wday = wxDateTime::Inv_WeekDay;
+    wxDateTime::wxDateTime_t yday = 0,
+                             mday = 0;
+    wxDateTime::Month mon = wxDateTime::Inv_Month;
+    int year = 0;
+    long timeZone = 0;  // time zone in seconds as expected in Tm structure
+};
+
+bool ParsedFields::ApplyTo(wxDateTime& dt, const wxDateTime& dateDef) const
+{
+    // format matched, try to construct a date from what we have now
+    wxDateTime::Tm tmDef;
+    if ( dateDef.IsValid() )
+    {
+        // take this date as default
+        tmDef = dateDef.GetTm();
+    }
+    else if ( dt.IsValid() )
+    {
+        // if this date is valid, don't change it
+        tmDef = dt.GetTm();
+    }
+    else if ( haveYear && ((haveMon && haveDay) || haveYDay) )
+    {
+        // all date fields are going to be overwritten below and the time
+        // ones are 0 in the default Tm, just as they would be for Today(),
+        // so avoid calling it as it's relatively expensive
+    }
+    else
+    {
+        // no default and this date is invalid - fall back to Today()
+        tmDef = wxDateTime::Today().GetTm();
+    }
+
+    wxDateTime::Tm tm = tmDef;
+
+    // set the date
+    if ( haveMon )
+    {
+        tm.mon = mon;
+    }
+
+    if ( haveYear )
+    {
+        tm.year = year;
+    }
+
+    // TODO we don't check here that the values are consistent, if both year
+    //      day and month/day were found, we just ignore the year day and we
+    //      also always ignore the week day
+    if ( haveDay )
+    {
+        if ( mday > wxDateTime::GetNumberOfDays(tm.mon, tm.year) )
+            return false;
+
+        tm.mday = mday;
+    }
+    else if ( haveYDay )
+    {
+        if ( yday > wxDateTime::GetNumberOfDays(tm.year) )
+            return false;
+
+        wxDateTime::Tm tm2 = wxDateTime(1, wxDateTime::Jan, tm.year).
+                                SetToYearDay(yday).GetTm();
+
+        tm.mon = tm2.mon;
+        tm.mday = tm2.mday;
+    }
+
+    // deal with AM/PM
+    wxDateTime::wxDateTime_t hour24 = hour;
+    if ( haveHour && hourIsIn12hFormat && isPM )
+    {
+        // translate to 24hour format
+        hour24 += 12;
+    }
+    //else: either already in 24h format or no translation needed
+
+    // set the time
+    if ( haveHour )
+    {
+        tm.hour = hour24;
+    }
+
+    if ( haveMin )
+    {
+        tm.min = min;
+    }
+
+    if ( haveSec )
+    {
+        tm.sec = sec;
+    }
+
+    if ( haveMsec )
+        tm.msec = msec;
+
+    dt.Set(tm);
+
+    if ( haveTimeZone )
+        dt.MakeFromTimezone(timeZone);
+
+    // finally check that the week day is consistent -- if we had it
+    if ( haveWDay && dt.GetWeekDay() != wday )
+        return false;
+
+    return true;
+}
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -1059,33 +1214,7 @@ wxDateTime::ParseFormat(const wxString& date,
 
     unsigned long num;
 
-    // what fields have we found?
-    bool haveWDay = false,
-         haveYDay = false,
-         haveDay = false,
-         haveMon = false,
-         haveYear = false,
-         haveHour = false,
-         haveMin = false,
-         haveSec = false,
-         haveMsec = false;
-
-    bool hourIsIn12hFormat = false, // or in 24h one?
-         isPM = false;              // AM by default
-
-    bool haveTimeZone = false;
-
-    // and the value of the items we have (init them to get rid of warnings)
-    wxDateTime_t msec = 0,
-                 sec = 0,
-                 min = 0,
-                 hour = 0;
-    WeekDay wday = Inv_WeekDay;
-    wxDateTime_t yday = 0,
-                 mday = 0;
-    wxDateTime::Month mon = Inv_Month;
-    int year = 0;
-    long timeZone = 0;  // time zone in seconds as expected in Tm structure
+    ParsedFields fields;
 
     wxString::const_iterator input = date.begin();
     const wxString::const_iterator end = date.end();
@@ -1164,37 +1293,37 @@ wxDateTime::ParseFormat(const wxString& date,
             case wxT('a'):       // a weekday name
             case wxT('A'):
                 {
-                    wday = GetWeekDayFromName
+                    fields.wday = GetWeekDayFromName
                            (
                             input, end,
                             *fmt == 'a' ? Name_Abbr : Name_Full,
                             DateLang_Local
                            );
-                    if ( wday == Inv_WeekDay )
+                    if ( fields.wday == Inv_WeekDay )
                     {
                         // no match
                         return false;
                     }
                 }
-                haveWDay = true;
+                fields.haveWDay = true;
                 break;
 
             case wxT('b'):       // a month name
             case wxT('B'):
                 {
-                    mon = GetMonthFromName
+                    fields.mon = GetMonthFromName
                           (
                             input, end,
                             *fmt == 'b' ? Name_Abbr : Name_Full,
                             DateLang_Local
                           );
-                    if ( mon == Inv_Month )
+                    if ( fields.mon == Inv_Month )
                     {
                         // no match
                         return false;
                     }
                 }
-                haveMon = true;
+                fields.haveMon = true;
                 break;
 
             case wxT('c'):       // locale default date and time  representation
@@ -1225,16 +1354,16 @@ wxDateTime::ParseFormat(const wxString& date,
 
                     const Tm tm = dt.GetTm();
 
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                    fields.year = tm.year;
+                    fields.mon = tm.mon;
+                    fields.mday = tm.mday;
 
-                    haveDay = haveMon = haveYear =
-                    haveHour = haveMin = haveSec = true;
+                    fields.haveDay = fields.haveMon = fields.haveYear =
+                    fields.haveHour = fields.haveMin = fields.haveSec = true;
                 }
                 break;
 
@@ -1249,8 +1378,8 @@ wxDateTime::ParseFormat(const wxString& date,
 
                 // we can't check whether the day range is correct yet, will
                 // do it later - assume ok for now
-                haveDay = true;
-                mday = (wxDateTime_t)num;
+                fields.haveDay = true;
+                fields.mday = (wxDateTime_t)num;
                 break;
 
             case wxT('F'):       // ISO 8601 date
@@ -1261,11 +1390,11 @@ wxDateTime::ParseFormat(const wxString& date,
 
                     const Tm tm = dt.GetTm();
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                    fields.year = tm.year;
+                    fields.mon = tm.mon;
+                    fields.mday = tm.mday;
 
-                    haveDay = haveMon = haveYear = true;
+                    fields.haveDay = fields.haveMon = fields.haveYear = true;
                 }
                 break;
 
@@ -1276,8 +1405,8 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveHour = true;
-                hour = (wxDateTime_t)num;
+                fields.haveHour = true;
+                fields.hour = (wxDateTime_t)num;
                 break;
 
             case wxT('I'):       // hour in 12h format (01-12)
@@ -1288,9 +1417,9 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveHour = true;
-                hourIsIn12hFormat = true;
-                hour = (wxDateTime_t)(num % 12);        // 12 should be 0
+                fields.haveHour = true;
+                fields.hourIsIn12hFormat = true;
+                fields.hour = (wxDateTime_t)(num % 12);        // 12 should be 0
                 break;
 
             case wxT('j'):       // day of the year
@@ -1301,16 +1430,16 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveYDay = true;
-                yday = (wxDateTime_t)num;
+                fields.haveYDay = true;
+                fields.yday = (wxDateTime_t)num;
                 break;
 
             case wxT('l'):       // milliseconds (0-999)
                 if ( !GetNumericToken(width, input, end, &num) )
                     return false;
 
-                haveMsec = true;
-                msec = (wxDateTime_t)num;
+                fields.haveMsec = true;
+                fields.msec = (wxDateTime_t)num;
                 break;
 
             case wxT('m'):       // month as a number (01-12)
@@ -1321,8 +1450,8 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveMon = true;
-                mon = (Month)(num - 1);
+                fields.haveMon = true;
+                fields.mon = (Month)(num - 1);
                 break;
 
             case wxT('M'):       // minute as a decimal number (00-59)
@@ -1333,8 +1462,8 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveMin = true;
-                min = (wxDateTime_t)num;
+                fields.haveMin = true;
+                fields.min = (wxDateTime_t)num;
                 break;
 
             case wxT('p'):       // AM or PM string
@@ -1349,7 +1478,7 @@ wxDateTime::ParseFormat(const wxString& date,
                     const size_t pos = input - date.begin();
                     if ( date.compare(pos, pm.length(), pm) == 0 )
                     {
-                        isPM = true;
+                        fields.isPM = true;
                         input += pm.length();
                     }
                     else if ( date.compare(pos, am.length(), am) == 0 )
@@ -1370,12 +1499,12 @@ wxDateTime::ParseFormat(const wxString& date,
                                          wxS("%I:%M:%S %p"), &input) )
                         return false;
 
-                    haveHour = haveMin = haveSec = true;
+                    fields.haveHour = fields.haveMin = fields.haveSec = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
                 }
                 break;
 
@@ -1386,12 +1515,12 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( !dt.IsValid() )
                         return false;
 
-                    haveHour =
-                    haveMin = true;
+                    fields.haveHour =
+                    fields.haveMin = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
                 }
                 break;
 
@@ -1403,8 +1532,8 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveSec = true;
-                sec = (wxDateTime_t)num;
+                fields.haveSec = true;
+                fields.sec = (wxDateTime_t)num;
                 break;
 
             case wxT('T'):       // time as %H:%M:%S
@@ -1414,27 +1543,27 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( !dt.IsValid() )
                         return false;
 
-                    haveHour =
-                    haveMin =
-                    haveSec = true;
+                    fields.haveHour =
+                    fields.haveMin =
+                    fields.haveSec = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
                 }
                 break;
 
             case wxT('w'):       // weekday as a number (0-6), Sunday = 0
                 if ( !GetNumericToken(width, input, end, &num) ||
-                        (wday > 6) )
+                        (fields.wday > 6) )
                 {
                     // no match
                     return false;
                 }
 
-                haveWDay = true;
-                wday = (WeekDay)num;
+                fields.haveWDay = true;
+                fields.wday = (WeekDay)num;
                 break;
 
             case wxT('x'):       // locale default date representation
@@ -1477,13 +1606,13 @@ wxDateTime::ParseFormat(const wxString& date,
 
                     const Tm tm = dt.GetTm();
 
-                    haveDay =
-                    haveMon =
-                    haveYear = true;
+                    fields.haveDay =
+                    fields.haveMon =
+                    fields.haveYear = true;
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                    fields.year = tm.year;
+                    fields.mon = tm.mon;
+                    fields.mday = tm.mday;
                 }
 
                 break;
@@ -1510,14 +1639,14 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( !dt.IsValid() )
                         return false;
 
-                    haveHour =
-                    haveMin =
-                    haveSec = true;
+                    fields.haveHour =
+                    fields.haveMin =
+                    fields.haveSec = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
                 }
                 break;
 
@@ -1529,11 +1658,11 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveYear = true;
+                fields.haveYear = true;
 
                 // TODO should have an option for roll over date instead of
                 //      hard coding it here
-                year = (num > 30 ? 1900 : 2000) + (wxDateTime_t)num;
+                fields.year = (num > 30 ? 1900 : 2000) + (wxDateTime_t)num;
                 break;
 
             case wxT('Y'):       // year with century
@@ -1543,8 +1672,8 @@ wxDateTime::ParseFormat(const wxString& date,
                     return false;
                 }
 
-                haveYear = true;
-                year = (wxDateTime_t)num;
+                fields.haveYear = true;
+                fields.year = (wxDateTime_t)num;
                 break;
 
             case wxT('z'):
@@ -1557,7 +1686,7 @@ wxDateTime::ParseFormat(const wxString& date,
                     {
                         // Time is in UTC.
                         ++input;
-                        haveTimeZone = true;
+                        fields.haveTimeZone = true;
                         break;
                     }
 
@@ -1621,11 +1750,11 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( hours > 15 || minutes > 59 )
                         return false;   // bad format
 
-                    timeZone = 3600*hours + 60*minutes;
+                    fields.timeZone = 3600*hours + 60*minutes;
                     if ( minusFound )
-                        timeZone = -timeZone;
+                        fields.timeZone = -fields.timeZone;
 
-                    haveTimeZone = true;
+                    fields.haveTimeZone = true;
                 }
                 break;
 
@@ -1653,92 +1782,7 @@ wxDateTime::ParseFormat(const wxString& date,
         }
     }
 
-    // format matched, try to construct a date from what we have now
-    Tm tmDef;
-    if ( dateDef.IsValid() )
-    {
-        // take this date as default
-        tmDef = dateDef.GetTm();
-    }
-    else if ( IsValid() )
-    {
-        // if this date is valid, don't change it
-        tmDef = GetTm();
-    }
-    else
-    {
-        // no default and this date is invalid - fall back to Today()
-        tmDef = Today().GetTm();
-    }
-
-    Tm tm = tmDef;
-
-    // set the date
-    if ( haveMon )
-    {
-        tm.mon = mon;
-    }
-
-    if ( haveYear )
-    {
-        tm.year = year;
-    }
-
-    // TODO we don't check here that the values are consistent, if both year
-    //      day and month/day were found, we just ignore the year day and we
-    //      also always ignore the week day
-    if ( haveDay )
-    {
-        if ( mday > GetNumberOfDays(tm.mon, tm.year) )
-            return false;
-
-        tm.mday = mday;
-    }
-    else if ( haveYDay )
-    {
-        if ( yday > GetNumberOfDays(tm.year) )
-            return false;
-
-        Tm tm2 = wxDateTime(1, Jan, tm.year).SetToYearDay(yday).GetTm();
-
-        tm.mon = tm2.mon;
-        tm.mday = tm2.mday;
-    }
-
-    // deal with AM/PM
-    if ( haveHour && hourIsIn12hFormat && isPM )
-    {
-        // translate to 24hour format
-        hour += 12;
-    }
-    //else: either already in 24h format or no translation needed
-
-    // set the time
-    if ( haveHour )
-    {
-        tm.hour = hour;
-    }
-
-    if ( haveMin )
-    {
-        tm.min = min;
-    }
-
-    if ( haveSec )
-    {
-        tm.sec = sec;
-    }
-
-    if ( haveMsec )
-        tm.msec = msec;
-
-    Set(tm);
-
-    if ( haveTimeZone )
-        MakeFromTimezone(timeZone);
-
-    // finally check that the week day is consistent -- if we had it
-    if ( haveWDay && GetWeekDay() != wday )
+    if ( !fields.ApplyTo(*this, dateDef) )
         return false;
 
     *endParse = input;
@@ -2331,6 +2375,512 @@ bool wxDateTime::IsWorkDay(Country WXUNUSED(country)) const
     return !wxDateTimeHolidayAuthority::IsHoliday(*this);
 }
 
+// ============================================================================
+// wxDateTimeFormatter
+// ============================================================================
+
+namespace
+{
+
+// append the number padded with zeroes to the given width, as "%0*d" would do
+void AppendNumber(wxString& out, int value, int width)
+{
+    wxChar buf[16];
+    wxChar* const end = buf + WXSIZEOF(buf);
+    wxChar* p = end;
+
+    unsigned n = value < 0 ? 0u - static_cast<unsigned>(value)
+                           : static_cast<unsigned>(value);
+    do
+    {
+        *--p = static_cast<wxChar>(wxT('0') + n % 10);
+        n /= 10;
+    } while ( n );
+
+    // the sign counts towards the width, as with printf()
+    if ( value < 0 )
+        width--;
+
+    while ( end - p < width )
+        *--p = wxT('0');
+
+    if ( value < 0 )
+        *--p = wxT('-');
+
+    out.append(p, end - p);
+}
+
+} // anonymous namespace
+
+wxDateTimeFormatter::wxDateTimeFormatter(const wxString& format)
+    : m_format(format),
+      m_canParse(true)
+{
+    wxASSERT_MSG( !format.empty(), wxT("format can't be empty") );
+
+    Compile(format);
+}
+
+void wxDateTimeFormatter::Compile(const wxString& format)
+{
+    for ( wxString::const_iterator p = format.begin(); p != format.end(); )
+    {
+        if ( *p != wxT('%') )
+        {
+            // merge consecutive literal characters into a single item
+            if ( m_items.empty() || m_items.back().spec )
+            {
+                const Item item = { wxString(), 0, 0, false };
+                m_items.push_back(item);
+            }
+
+            m_items.back().text += *p++;
+            continue;
+        }
+
+        const wxString::const_iterator start = p++;
+
+        // the flags and the width: we accept everything that either
+        // wxDateTime::Format() or ParseFormat() could accept here and check
+        // whether the flags are supported by the latter below
+        bool hasFlags = false;
+        bool canParse = true;
+        int width = 0;
+        for ( ; p != format.end(); ++p )
+        {
+            const wxChar ch = *p;
+            if ( ch >= wxT('0') && ch <= wxT('9') )
+            {
+                // a leading zero is a flag and not part of the width
+                if ( hasFlags || ch != wxT('0') )
+                    width = width*10 + ch - wxT('0');
+            }
+            else if ( ch == wxT('-') || ch == wxT('_') ||
+                        ch == wxT('+') || ch == wxT(' ') )
+            {
+                // only a single leading flag can be parsed and only some of
+                // them
+                if ( hasFlags || ch == wxT('+') || ch == wxT(' ') )
+                    canParse = false;
+            }
+            else
+            {
+                break;
+            }
+
+            hasFlags = true;
+        }
+
+        if ( p == format.end() )
+        {
+            // incomplete specification at the end of the format, just output
+            // it as is, as wxDateTime::Format() does
+            const Item item = { wxString(start, p), 0, 0, false };
+            m_items.push_back(item);
+
+            m_canParse = false;
+            break;
+        }
+
+        const wxChar spec = *p++;
+
+        if ( !hasFlags )
+        {
+            // expand the composite specifications to make both formatting and
+            // parsing them simpler
+            switch ( spec )
+            {
+                case wxT('F'):
+                    Compile(wxS("%Y-%m-%d"));
+                    continue;
+
+                case wxT('T'):
+                    Compile(wxS("%H:%M:%S"));
+                    continue;
+            }
+        }
+
+        switch ( spec )
+        {
+            case wxT('a'):
+            case wxT('A'):
+                if ( m_weekDayNames[spec == wxT('a')][0].empty() )
+                {
+                    const wxDateTime::NameFlags
+                        form = spec == wxT('a') ? wxDateTime::Name_Abbr
+                                                : wxDateTime::Name_Full;
+
+                    for ( int wd = 0; wd < 7; wd++ )
+                    {
+                        m_weekDayNames[spec == wxT('a')][wd] =
+                            wxDateTime::GetWeekDayName(
+                                static_cast<wxDateTime::WeekDay>(wd), form);
+                    }
+                }
+                break;
+
+            case wxT('b'):
+            case wxT('B'):
+                if ( m_monthNames[spec == wxT('b')][0].empty() )
+                {
+                    const wxDateTime::NameFlags
+                        form = spec == wxT('b') ? wxDateTime::Name_Abbr
+                                                : wxDateTime::Name_Full;
+
+                    for ( int mon = 0; mon < 12; mon++ )
+                    {
+                        m_monthNames[spec == wxT('b')][mon] =
+                            wxDateTime::GetMonthName(
+                                static_cast<wxDateTime::Month>(mon), form);
+                    }
+                }
+                break;
+
+            case wxT('p'):
+                if ( m_am.empty() && m_pm.empty() )
+                    wxDateTime::GetAmPmStrings(&m_am, &m_pm);
+                break;
+
+            case wxT('d'):
+            case wxT('e'):
+            case wxT('H'):
+            case wxT('I'):
+            case wxT('j'):
+            case wxT('l'):
+            case wxT('m'):
+            case wxT('M'):
+            case wxT('S'):
+            case wxT('y'):
+            case wxT('Y'):
+            case wxT('%'):
+                break;
+
+            default:
+                // we don't parse this specification ourselves
+                canParse = false;
+        }
+
+        if ( !canParse )
+            m_canParse = false;
+
+        const Item item = { wxString(start, p), spec, width, hasFlags };
+        m_items.push_back(item);
+    }
+}
+
+void wxDateTimeFormatter::FormatTo(wxString& out,
+                                   const wxDateTime& dt,
+                                   const wxDateTime::TimeZone& tz) const
+{
+    wxCHECK_RET( dt.IsValid(), wxT("invalid wxDateTime") );
+
+    wxDateTime::Tm tm = dt.GetTm(tz);
+
+    for ( const Item& item : m_items )
+    {
+        if ( !item.spec )
+        {
+            out += item.text;
+            continue;
+        }
+
+        if ( item.hasFlags )
+        {
+            out += dt.Format(item.text, tz);
+            continue;
+        }
+
+        switch ( item.spec )
+        {
+            case wxT('a'):
+            case wxT('A'):
+                out += m_weekDayNames[item.spec == wxT('a')][tm.GetWeekDay()];
+                break;
+
+            case wxT('b'):
+            case wxT('B'):
+                out += m_monthNames[item.spec == wxT('b')][tm.mon];
+                break;
+
+            case wxT('d'):
+                AppendNumber(out, tm.mday, 2);
+                break;
+
+            case wxT('H'):
+                AppendNumber(out, tm.hour, 2);
+                break;
+
+            case wxT('I'):
+                // 24h -> 12h, 0h -> 12h too
+                AppendNumber(out, tm.hour > 12 ? tm.hour - 12
+                                               : tm.hour ? tm.hour : 12, 2);
+                break;
+
+            case wxT('j'):
+                AppendNumber(out, dt.GetDayOfYear(tz), 3);
+                break;
+
+            case wxT('l'):
+                AppendNumber(out, tm.msec, 3);
+                break;
+
+            case wxT('m'):
+                AppendNumber(out, tm.mon + 1, 2);
+                break;
+
+            case wxT('M'):
+                AppendNumber(out, tm.min, 2);
+                break;
+
+            case wxT('p'):
+                out += tm.hour < 12 ? m_am : m_pm;
+                break;
+
+            case wxT('S'):
+                AppendNumber(out, tm.sec, 2);
+                break;
+
+            case wxT('y'):
+                AppendNumber(out, tm.year % 100, 2);
+                break;
+
+            case wxT('Y'):
+                AppendNumber(out, tm.year, 4);
+                break;
+
+            case wxT('%'):
+                out += wxT('%');
+                break;
+
+            default:
+                // all the other specifications are either locale-dependent
+                // or rarely used, so just let wxDateTime deal with them
+                out += dt.Format(item.text, tz);
+        }
+    }
+}
+
+bool wxDateTimeFormatter::Parse(const wxString& date,
+                                wxDateTime& dt,
+                                const wxDateTime& dateDef,
+                                wxString::const_iterator *endParse) const
+{
+    wxCHECK_MSG( endParse, false, "end iterator pointer must be specified" );
+
+    if ( !m_canParse )
+        return dt.ParseFormat(date, m_format, dateDef, endParse);
+
+    // this is a simplified version of wxDateTime::ParseFormat() handling only
+    // the specifications for which m_canParse is true, see there for the
+    // explanation of what is done here
+    unsigned long num;
+
+    ParsedFields fields;
+
+    wxString::const_iterator input = date.begin();
+    const wxString::const_iterator end = date.end();
+    for ( const Item& item : m_items )
+    {
+        if ( !item.spec )
+        {
+            for ( wxString::const_iterator fmt = item.text.begin();
+                  fmt != item.text.end();
+                  ++fmt )
+            {
+                if ( wxIsspace(*fmt) )
+                {
+                    while ( input != end && wxIsspace(*input) )
+                    {
+                        ++input;
+                    }
+                }
+                else if ( input == end || *input++ != *fmt )
+                {
+                    return false;
+                }
+            }
+
+            continue;
+        }
+
+        size_t width = item.width;
+        if ( !width )
+        {
+            switch ( item.spec )
+            {
+                case wxT('Y'):
+                    width = 4;
+                    break;
+
+                case wxT('j'):
+                case wxT('l'):
+                    width = 3;
+                    break;
+
+                default:
+                    width = 2;
+            }
+        }
+
+        switch ( item.spec )
+        {
+            case wxT('a'):
+            case wxT('A'):
+                fields.wday = GetWeekDayFromName
+                              (
+                                input, end,
+                                item.spec == wxT('a') ? wxDateTime::Name_Abbr
+                                                      : wxDateTime::Name_Full,
+                                DateLang_Local
+                              );
+                if ( fields.wday == wxDateTime::Inv_WeekDay )
+                    return false;
+
+                fields.haveWDay = true;
+                break;
+
+            case wxT('b'):
+            case wxT('B'):
+                fields.mon = GetMonthFromName
+                             (
+                                input, end,
+                                item.spec == wxT('b') ? wxDateTime::Name_Abbr
+                                                      : wxDateTime::Name_Full,
+                                DateLang_Local
+                             );
+                if ( fields.mon == wxDateTime::Inv_Month )
+                    return false;
+
+                fields.haveMon = true;
+                break;
+
+            case wxT('d'):
+            case wxT('e'):
+                if ( !GetNumericToken(width, input, end, &num) ||
+                        (num > 31) || (num < 1) )
+                    return false;
+
+                fields.haveDay = true;
+                fields.mday = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('H'):
+                if ( !GetNumericToken(width, input, end, &num) || (num > 23) )
+                    return false;
+
+                fields.haveHour = true;
+                fields.hour = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('I'):
+                if ( !GetNumericToken(width, input, end, &num) ||
+                        !num || (num > 12) )
+                    return false;
+
+                fields.haveHour = true;
+                fields.hourIsIn12hFormat = true;
+                fields.hour = (wxDateTime::wxDateTime_t)(num % 12);
+                break;
+
+            case wxT('j'):
+                if ( !GetNumericToken(width, input, end, &num) ||
+                        !num || (num > 366) )
+                    return false;
+
+                fields.haveYDay = true;
+                fields.yday = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('l'):
+                if ( !GetNumericToken(width, input, end, &num) )
+                    return false;
+
+                fields.haveMsec = true;
+                fields.msec = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('m'):
+                if ( !GetNumericToken(width, input, end, &num) ||
+                        !num || (num > 12) )
+                    return false;
+
+                fields.haveMon = true;
+                fields.mon = (wxDateTime::Month)(num - 1);
+                break;
+
+            case wxT('M'):
+                if ( !GetNumericToken(width, input, end, &num) || (num > 59) )
+                    return false;
+
+                fields.haveMin = true;
+                fields.min = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('p'):
+                {
+                    if ( m_am.empty() || m_pm.empty() )
+                        return false;
+
+                    const size_t pos = input - date.begin();
+                    if ( date.compare(pos, m_pm.length(), m_pm) == 0 )
+                    {
+                        fields.isPM = true;
+                        input += m_pm.length();
+                    }
+                    else if ( date.compare(pos, m_am.length(), m_am) == 0 )
+                    {
+                        input += m_am.length();
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                break;
+
+            case wxT('S'):
+                if ( !GetNumericToken(width, input, end, &num) || (num > 61) )
+                    return false;
+
+                fields.haveSec = true;
+                fields.sec = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('y'):
+                if ( !GetNumericToken(width, input, end, &num) || (num > 99) )
+                    return false;
+
+                fields.haveYear = true;
+                fields.year = (num > 30 ? 1900 : 2000) + (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('Y'):
+                if ( !GetNumericToken(width, input, end, &num) )
+                    return false;
+
+                fields.haveYear = true;
+                fields.year = (wxDateTime::wxDateTime_t)num;
+                break;
+
+            case wxT('%'):
+                if ( input == end || *input++ != wxT('%') )
+                    return false;
+                break;
+
+            default:
+                wxFAIL_MSG( wxT("unexpected format specification") );
+                return false;
+        }
+    }
+
+    if ( !fields.ApplyTo(dt, dateDef) )
+        return false;
+
+    *endParse = input;
+
+    return true;
+}
+
 // ============================================================================
 // wxDateSpan
 // ============================================================================
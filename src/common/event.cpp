@@ -42,11 +42,15 @@
 #endif
 
 #include "wx/thread.h"
+#include "wx/tracezone.h"
 
 #include "wx/private/safecall.h"
 
 #if wxUSE_BASE
+    #include <atomic>
     #include <memory>
+    #include <new>
+    #include <unordered_map>
 #endif // wxUSE_BASE
 
 #if wxUSE_GUI
@@ -1190,17 +1194,163 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxPendingEventNode
+// ----------------------------------------------------------------------------
+
+// Element of the list of events queued by wxEvtHandler::QueueEvent().
+class wxPendingEventNode
+{
+public:
+    explicit wxPendingEventNode(wxEvent* event)
+        : m_event(event),
+          m_next(nullptr)
+    {
+    }
+
+    wxEvent* const m_event;
+    wxPendingEventNode* m_next;
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventNode);
+};
+
+// ----------------------------------------------------------------------------
+// wxQueuedEvents
+// ----------------------------------------------------------------------------
+
+// Events queued by wxEvtHandler::QueueEvent() and not yet moved to its
+// m_pendingEvents. This is kept out of the header to avoid including <atomic>
+// from it.
+class wxQueuedEvents
+{
+public:
+    wxQueuedEvents()
+        : m_head(nullptr),
+          m_inPendingHandlers(false)
+    {
+    }
+
+    // Lock-free singly linked list with the most recently queued event at its
+    // head.
+    std::atomic<wxPendingEventNode*> m_head;
+
+    // True if the handler is in the list of handlers with pending events.
+    std::atomic<bool> m_inPendingHandlers;
+
+    wxDECLARE_NO_COPY_CLASS(wxQueuedEvents);
+};
+
+// ----------------------------------------------------------------------------
+// wxCoalescedEvents
+// ----------------------------------------------------------------------------
+
+// Data used by wxEvtHandler::CoalesceQueuedEvents(), all of it is protected by
+// wxEvtHandler::m_pendingEventsLock.
+class wxCoalescedEvents
+{
+public:
+    wxCoalescedEvents() = default;
+
+    bool IsCoalesced(wxEventType eventType) const
+    {
+        for ( const auto type : m_eventTypes )
+        {
+            if ( type == eventType )
+                return true;
+        }
+
+        return false;
+    }
+
+    // Combine the event type and id into a single key for m_pending.
+    static wxUint64 MakeKey(wxEventType eventType, int id)
+    {
+        return (static_cast<wxUint64>(static_cast<wxUint32>(eventType)) << 32) |
+                    static_cast<wxUint32>(id);
+    }
+
+    static wxUint64 MakeKey(const wxEvent& event)
+    {
+        return MakeKey(event.GetEventType(), event.GetId());
+    }
+
+    // Event types for which coalescing is enabled, there are typically very
+    // few of them, so just use a vector.
+    wxVector<wxEventType> m_eventTypes;
+
+    // Nodes of wxEvtHandler::m_pendingEvents containing the events of one of
+    // the types above indexed by their type and id.
+    std::unordered_map<wxUint64, wxList::compatibility_iterator> m_pending;
+
+    wxDECLARE_NO_COPY_CLASS(wxCoalescedEvents);
+};
+
+// ----------------------------------------------------------------------------
+// wxDynamicEventIndex
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Minimal number of dynamic event table entries for which we use the index:
+// for fewer entries, just iterating over all of them is fast enough.
+constexpr size_t DYNAMIC_EVENTS_INDEX_THRESHOLD = 16;
+
+} // anonymous namespace
+
+// Index of wxEvtHandler dynamic event table entries by their event type.
+class wxDynamicEventIndex
+{
+public:
+    explicit wxDynamicEventIndex(const wxVector<wxDynamicEventTableEntry*>& entries)
+    {
+        for ( size_t n = 0; n < entries.size(); n++ )
+        {
+            if ( entries[n] )
+                Add(entries[n]->m_eventType, n);
+        }
+    }
+
+    void Add(wxEventType eventType, size_t n)
+    {
+        m_entriesByType[eventType].push_back(n);
+    }
+
+    // Return the positions of the entries for the given type, in the order in
+    // which they were bound, or nullptr if there are none.
+    //
+    // Note that the returned pointer remains valid even if more entries are
+    // added while it is used, but the elements of the vector may move.
+    const wxVector<size_t>* Find(wxEventType eventType) const
+    {
+        const auto it = m_entriesByType.find(eventType);
+        return it == m_entriesByType.end() ? nullptr : &it->second;
+    }
+
+private:
+    std::unordered_map<wxEventType, wxVector<size_t>> m_entriesByType;
+
+    wxDECLARE_NO_COPY_CLASS(wxDynamicEventIndex);
+};
+
+wxEvtHandler::DynamicEvents::~DynamicEvents()
+{
+    delete m_index;
+}
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
 
 wxEvtHandler::wxEvtHandler()
+    : m_queuedEvents(new wxQueuedEvents)
 {
     m_nextHandler = nullptr;
     m_previousHandler = nullptr;
     m_enabled = true;
     m_dynamicEvents = nullptr;
     m_pendingEvents = nullptr;
+    m_coalescedEvents = nullptr;
 
     // no client data (yet)
     m_clientData = nullptr;
@@ -1243,6 +1393,9 @@ wxEvtHandler::~wxEvtHandler()
 
     DeletePendingEvents();
 
+    delete m_queuedEvents;
+    delete m_coalescedEvents;
+
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
         delete m_clientObject;
@@ -1338,37 +1491,169 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
-    // 1) Add this event to our list of pending events
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    // 1) Add this event to the list of queued events: this is done without
+    //    taking any locks as this function is often called from many worker
+    //    threads at once and they would contend for them. The events will be
+    //    moved to m_pendingEvents, in the same order, by the main thread.
+    wxPendingEventNode* const node = new wxPendingEventNode(event);
+    node->m_next = m_queuedEvents->m_head.load(std::memory_order_relaxed);
+    while ( !m_queuedEvents->m_head.compare_exchange_weak(node->m_next, node) )
+        ;
+
+    // 2) Add this event handler to list of event handlers that have pending
+    //    events, unless it's already there: only the thread which changes
+    //    m_inPendingHandlers from false to true needs to do it, the others
+    //    don't need to lock the list at all.
+    //
+    //    Note that this must be done after adding the event to the list, see
+    //    RemoveFromPendingHandlersIfEmpty().
+    if ( !m_queuedEvents->m_inPendingHandlers.exchange(true) )
+        wxTheApp->AppendPendingEventHandler(this);
+
+    // 3) Inform the system that new pending events are somewhere,
+    //    and that these should be processed in idle time.
+    wxWakeUpIdle();
+}
+
+void wxEvtHandler::MoveQueuedEventsToPending()
+{
+    wxPendingEventNode* node = m_queuedEvents->m_head.exchange(nullptr);
+    if ( !node )
+        return;
+
+    // The most recently queued event is at the head of the list, so reverse
+    // it first to preserve the order of the events.
+    wxPendingEventNode* first = nullptr;
+    while ( node )
+    {
+        wxPendingEventNode* const next = node->m_next;
+        node->m_next = first;
+        first = node;
+        node = next;
+    }
 
     if ( !m_pendingEvents )
         m_pendingEvents = new wxList;
 
-    m_pendingEvents->Append(event);
+    for ( node = first; node; )
+    {
+        wxEvent* const event = node->m_event;
+        if ( m_coalescedEvents &&
+                m_coalescedEvents->IsCoalesced(event->GetEventType()) )
+        {
+            wxList::compatibility_iterator&
+                pending = m_coalescedEvents->m_pending[wxCoalescedEvents::MakeKey(*event)];
+            if ( pending )
+            {
+                // Replace the previously queued event with the new one, but
+                // keep it at its position in the queue.
+                delete static_cast<wxEvent*>(pending->GetData());
+                pending->SetData(event);
+            }
+            else
+            {
+                pending = m_pendingEvents->Append(event);
+            }
+        }
+        else
+        {
+            m_pendingEvents->Append(event);
+        }
 
-    // 2) Add this event handler to list of event handlers that
-    //    have pending events.
+        wxPendingEventNode* const next = node->m_next;
+        delete node;
+        node = next;
+    }
+}
 
-    wxTheApp->AppendPendingEventHandler(this);
+void wxEvtHandler::RemoveFromPendingHandlersIfEmpty()
+{
+    if ( m_pendingEvents && !m_pendingEvents->IsEmpty() )
+        return;
 
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+    wxTheApp->RemovePendingEventHandler(this);
 
-    // 3) Inform the system that new pending events are somewhere,
-    //    and that these should be processed in idle time.
-    wxWakeUpIdle();
+    OnRemovedFromPendingHandlers();
+}
+
+void wxEvtHandler::OnRemovedFromPendingHandlers()
+{
+    // QueueEvent() could have been called after we were removed from the list
+    // but before we reset the flag below, in which case it didn't add us to
+    // the list again, so check for the queued events after resetting it and
+    // do it ourselves. As QueueEvent() does the same thing in the opposite
+    // order, either it or we must see the other thread changes and re-add
+    // this handler to the list.
+    m_queuedEvents->m_inPendingHandlers = false;
+    if ( m_queuedEvents->m_head.load() &&
+            !m_queuedEvents->m_inPendingHandlers.exchange(true) )
+        wxTheApp->AppendPendingEventHandler(this);
 }
 
 void wxEvtHandler::DeletePendingEvents()
 {
+    wxCRIT_SECT_LOCKER(locker, m_pendingEventsLock);
+
+    MoveQueuedEventsToPending();
+
     if (m_pendingEvents)
         m_pendingEvents->DeleteContents(true);
     wxDELETE(m_pendingEvents);
+
+    if ( m_coalescedEvents )
+        m_coalescedEvents->m_pending.clear();
+
+    // This handler is usually removed from the list of handlers with pending
+    // events before calling this function, but if any events were queued
+    // since then, it must be added back to it, as usual.
+    if ( wxTheApp )
+        OnRemovedFromPendingHandlers();
+}
+
+void wxEvtHandler::CoalesceQueuedEvents(wxEventType eventType, bool coalesce)
+{
+    wxCRIT_SECT_LOCKER(locker, m_pendingEventsLock);
+
+    // The change must only affect the events queued after this call, so deal
+    // with the already queued ones using the current settings first.
+    MoveQueuedEventsToPending();
+
+    if ( coalesce )
+    {
+        if ( !m_coalescedEvents )
+            m_coalescedEvents = new wxCoalescedEvents;
+        else if ( m_coalescedEvents->IsCoalesced(eventType) )
+            return;
+
+        m_coalescedEvents->m_eventTypes.push_back(eventType);
+    }
+    else // stop coalescing events of this type
+    {
+        if ( !m_coalescedEvents )
+            return;
+
+        wxVector<wxEventType>& types = m_coalescedEvents->m_eventTypes;
+        for ( size_t n = 0; n < types.size(); n++ )
+        {
+            if ( types[n] == eventType )
+            {
+                types.erase(types.begin() + n);
+                break;
+            }
+        }
+
+        // The already pending events of this type remain in the queue, but
+        // the new ones won't replace them any more.
+        auto& pending = m_coalescedEvents->m_pending;
+        for ( auto it = pending.begin(); it != pending.end(); )
+        {
+            if ( static_cast<wxEvent*>(it->second->GetData())->GetEventType()
+                    == eventType )
+                it = pending.erase(it);
+            else
+                ++it;
+        }
+    }
 }
 
 void wxEvtHandler::ProcessPendingEvents()
@@ -1387,10 +1672,19 @@ void wxEvtHandler::ProcessPendingEvents()
 
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+    MoveQueuedEventsToPending();
+
+    // this method is only called by wxApp if this handler does have pending
+    // events, but QueueEvent() running in another thread could have added it
+    // to the list after the event it had queued had been already processed
+    if ( !m_pendingEvents || m_pendingEvents->IsEmpty() )
+    {
+        RemoveFromPendingHandlersIfEmpty();
+
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+        return;
+    }
 
     wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
     wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
@@ -1410,6 +1704,11 @@ void wxEvtHandler::ProcessPendingEvents()
             // all our events are NOT processable now... signal this:
             wxTheApp->DelayPendingEventHandler(this);
 
+            // this removed us from the list of handlers with pending events,
+            // so let QueueEvent() add us back to it: the events queued later
+            // may be processable during this yield
+            OnRemovedFromPendingHandlers();
+
             // see the comment at the beginning of evtloop.h header for the
             // logic behind YieldFor() and behind DelayPendingEventHandler()
 
@@ -1421,17 +1720,23 @@ void wxEvtHandler::ProcessPendingEvents()
 
     std::unique_ptr<wxEvent> event(pEvent);
 
+    // this event can't be replaced by a newer one any more
+    if ( m_coalescedEvents && !m_coalescedEvents->m_pending.empty() )
+    {
+        auto& pending = m_coalescedEvents->m_pending;
+        const auto it = pending.find(wxCoalescedEvents::MakeKey(*pEvent));
+        if ( it != pending.end() && it->second == node )
+            pending.erase(it);
+    }
+
     // it's important we remove event from list before processing it, else a
     // nested event loop, for example from a modal dialog, might process the
     // same event again.
     m_pendingEvents->Erase(node);
 
-    if ( m_pendingEvents->IsEmpty() )
-    {
-        // if there are no more pending events left, we don't need to
-        // stay in this list
-        wxTheApp->RemovePendingEventHandler(this);
-    }
+    // if there are no more pending events left, we don't need to stay in this
+    // list
+    RemoveFromPendingHandlersIfEmpty();
 
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
@@ -1534,6 +1839,8 @@ bool wxEvtHandler::TryAfter(wxEvent& event)
 
 bool wxEvtHandler::ProcessEvent(wxEvent& event)
 {
+    wxTRACE_ZONE("wxEvtHandler::ProcessEvent");
+
     // The very first thing we do is to allow any registered filters to hook
     // into event processing in order to globally pre-process all events.
     //
@@ -1795,6 +2102,11 @@ void wxEvtHandler::DoBind(int id,
     // in reverse direction in GetNextDynamicEntry() as it's more efficient
     // than inserting the element at the front.
     m_dynamicEvents->m_entries.push_back(entry);
+    if ( m_dynamicEvents->m_index )
+    {
+        m_dynamicEvents->m_index->Add(eventType,
+                                      m_dynamicEvents->m_entries.size() - 1);
+    }
 
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
@@ -1848,7 +2160,7 @@ wxEvtHandler::DoUnbind(int id,
             // Notice that we rely on "cookie" being just the index into the
             // vector, which is not guaranteed by our API, but here we can use
             // this implementation detail.
-            m_dynamicEvents->m_entries[cookie] = nullptr;
+            m_dynamicEvents->RemoveEntry(cookie);
 
             delete entry;
             return true;
@@ -1905,53 +2217,73 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     DynamicEvents& dynamicEvents = *m_dynamicEvents;
 
     wxRecursionGuard guard(dynamicEvents.m_flag);
-    bool needToPruneDeleted = false;
 
-    // We can't use Get{First,Next}DynamicEntry() here as they hide the deleted
-    // but not yet pruned entries from the caller, but here we do want to know
-    // about them, so iterate directly. Remember to do it in the reverse order
-    // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.m_entries.size(); n; n-- )
+    // Call the handler if its id matches, return true if the event was
+    // processed.
+    const auto processEntry = [this, &event](const wxDynamicEventTableEntry& entry)
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents.m_entries[n - 1];
+        wxEvtHandler *handler = entry.m_fn->GetEvtHandler();
+        if ( !handler )
+           handler = this;
+
+        // Notice that if this function returns true, it's important to not
+        // access this object any more (including pruning the unbound entries
+        // below) because it could have been deleted by the event handler
+        // making m_dynamicEvents a dangling pointer.
+        //
+        // In practice, it hopefully shouldn't be a problem to wait until we
+        // get an event that we don't handle before pruning because this
+        // should happen soon enough and even if it doesn't the worst possible
+        // outcome is slightly increased memory consumption while not skipping
+        // pruning can result in hard to reproduce (because they require the
+        // disconnection and deletion happen at the same time which is not
+        // always the case) crashes.
+        return ProcessEventIfMatchesId(entry, handler, event);
+    };
+
+    if ( !dynamicEvents.m_index &&
+            dynamicEvents.m_entries.size() >= DYNAMIC_EVENTS_INDEX_THRESHOLD )
+    {
+        dynamicEvents.m_index = new wxDynamicEventIndex(dynamicEvents.m_entries);
+    }
 
-        if ( !entry )
+    // Iterate over the entries in the reverse order to honour the order of
+    // handlers connection. Notice that entries can be unbound (and hence
+    // become null) or bound (and added to the end of the vector) by the
+    // handlers called from here, but not pruned, as we only do it below and
+    // only if we're not called recursively, so the indices remain valid.
+    if ( dynamicEvents.m_index )
+    {
+        const wxVector<size_t>* const
+            positions = dynamicEvents.m_index->Find(event.GetEventType());
+        if ( positions )
         {
-            // This entry must have been unbound at some time in the past, so
-            // skip it now and really remove it from the vector below, once we
-            // finish iterating.
-            // N.B.:  If we are in a nested call, then we can't be done
-            // iterating during this call
-            needToPruneDeleted = !guard.IsInside();
-            continue;
+            for ( size_t n = positions->size(); n; n-- )
+            {
+                wxDynamicEventTableEntry* const
+                    entry = dynamicEvents.m_entries[(*positions)[n - 1]];
+                if ( entry && processEntry(*entry) )
+                    return true;
+            }
         }
-
-        if ( event.GetEventType() == entry->m_eventType )
+    }
+    else
+    {
+        for ( size_t n = dynamicEvents.m_entries.size(); n; n-- )
         {
-            wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
-            if ( !handler )
-               handler = this;
-            if ( ProcessEventIfMatchesId(*entry, handler, event) )
-            {
-                // It's important to skip pruning of the unbound event entries
-                // below because this object itself could have been deleted by
-                // the event handler making m_dynamicEvents a dangling pointer
-                // which can't be accessed any longer in the code below.
-                //
-                // In practice, it hopefully shouldn't be a problem to wait
-                // until we get an event that we don't handle before pruning
-                // because this should happen soon enough and even if it
-                // doesn't the worst possible outcome is slightly increased
-                // memory consumption while not skipping pruning can result in
-                // hard to reproduce (because they require the disconnection
-                // and deletion happen at the same time which is not always the
-                // case) crashes.
+            wxDynamicEventTableEntry* const entry = dynamicEvents.m_entries[n - 1];
+
+            if ( entry &&
+                    event.GetEventType() == entry->m_eventType &&
+                        processEntry(*entry) )
                 return true;
-            }
         }
     }
 
-    if ( needToPruneDeleted )
+    // Really remove the entries which were unbound before from the vector,
+    // unless we're in a nested call, as the outer one is still iterating
+    // over it then.
+    if ( dynamicEvents.m_numRemoved && !guard.IsInside() )
     {
         size_t nNew = 0;
         for ( size_t n = 0; n != dynamicEvents.m_entries.size(); n++ )
@@ -1960,8 +2292,13 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
                 dynamicEvents.m_entries[nNew++] = dynamicEvents.m_entries[n];
         }
 
-        wxASSERT( nNew != dynamicEvents.m_entries.size() );
+        wxASSERT( nNew + dynamicEvents.m_numRemoved == dynamicEvents.m_entries.size() );
         dynamicEvents.m_entries.resize(nNew);
+        dynamicEvents.m_numRemoved = 0;
+
+        // The positions of the entries have changed, so the index will need
+        // to be rebuilt.
+        wxDELETE(dynamicEvents.m_index);
     }
 
     return false;
@@ -2042,7 +2379,7 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
 
             // Just as in DoUnbind(), we use our knowledge of
             // GetNextDynamicEntry() implementation here.
-            m_dynamicEvents->m_entries[cookie] = nullptr;
+            m_dynamicEvents->RemoveEntry(cookie);
         }
     }
 }
@@ -24,13 +24,22 @@
     #include "wx/colour.h"
 #endif
 
+#include "wx/tracezone.h"
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif // wxUSE_THREADS
+
 // For memcpy
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <unordered_set>
+#include <vector>
 
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
 #define HAS_FILE_STREAMS (wxUSE_STREAMS && (wxUSE_FILE || wxUSE_FFILE))
@@ -77,6 +86,18 @@ public:
     // alpha channel data, may be null for the formats without alpha support
     unsigned char  *m_alpha;
 
+    // interleaved pixel data in m_rgbaFormat, see wxImage::CreateRGBA(): if
+    // it is non-null, m_data and m_alpha are only valid if m_planar is true
+    unsigned char  *m_rgba;
+    wxImageRGBAFormat m_rgbaFormat;
+
+    // false if m_data and m_alpha still need to be created from m_rgba
+    std::atomic<bool> m_planar;
+
+    // false if the pixels could have been modified using the pointers
+    // returned by wxImage::GetData() or GetAlpha(), making m_rgba stale
+    std::atomic<bool> m_rgbaValid;
+
     bool            m_ok;
 
     // if true, m_data is pointer to static data and shouldn't be freed
@@ -96,6 +117,31 @@ public:
     wxArrayString   m_optionNames;
     wxArrayString   m_optionValues;
 
+    // Return the data with m_data and m_alpha initialized from m_rgba, if
+    // necessary: this is used for all accesses to the pixel data as almost
+    // all of wxImage code works only with separate RGB and alpha buffers.
+    static wxImageRefData* GetPlanar(wxObjectRefData* refData)
+    {
+        wxImageRefData* const data = static_cast<wxImageRefData*>(refData);
+        if ( data && !data->m_planar.load(std::memory_order_acquire) )
+            data->SplitRGBA();
+
+        return data;
+    }
+
+    // Ensure that the planar data of the given image is available and return
+    // true if it is: this is not the case for an invalid image or if there is
+    // not enough memory for splitting m_rgba, which makes the image invalid.
+    static bool HasPlanar(const wxImage& image)
+    {
+        GetPlanar(image.GetRefData());
+
+        return image.IsOk();
+    }
+
+private:
+    void SplitRGBA();
+
     wxDECLARE_NO_COPY_CLASS(wxImageRefData);
 };
 
@@ -108,7 +154,11 @@ wxImageRefData::wxImageRefData()
     m_height = 0;
     m_type = wxBITMAP_TYPE_INVALID;
     m_data =
-    m_alpha = (unsigned char *) nullptr;
+    m_alpha =
+    m_rgba = (unsigned char *) nullptr;
+    m_rgbaFormat = wxIMAGE_RGBA_STRAIGHT;
+    m_planar = true;
+    m_rgbaValid = false;
 
     m_maskRed = 0;
     m_maskGreen = 0;
@@ -128,14 +178,405 @@ wxImageRefData::~wxImageRefData()
         free( m_data );
     if ( !m_staticAlpha )
         free( m_alpha );
+    free( m_rgba );
+}
+
+namespace
+{
+
+// Alpha pre-multiplication helpers using the same formulas as Cairo code.
+inline unsigned char PremultiplyAlpha(unsigned char alpha, unsigned char data)
+{
+    return (data * alpha) / 0xff;
+}
+
+inline unsigned char UnpremultiplyAlpha(unsigned char alpha, unsigned char data)
+{
+    return alpha ? wxMin((data * 0xff) / alpha, 0xff) : data;
+}
+
+} // anonymous namespace
+
+void wxImageRefData::SplitRGBA()
+{
+    // This is called from const functions, possibly for the data shared by
+    // the images used by different threads, so serialize doing it and check
+    // if it was already done by another thread while we were waiting.
+#if wxUSE_THREADS
+    static wxCriticalSection s_csSplit;
+    wxCriticalSectionLocker lock(s_csSplit);
+#endif // wxUSE_THREADS
+
+    if ( m_planar.load(std::memory_order_relaxed) )
+        return;
+
+    const size_t count = (size_t)m_width * (size_t)m_height;
+
+    unsigned char* const data = (unsigned char*)malloc(3 * count);
+    unsigned char* const alphaData = (unsigned char*)malloc(count);
+    if ( !data || !alphaData )
+    {
+        free(data);
+        free(alphaData);
+
+        // Don't try to do it again, the image is unusable now.
+        m_ok = false;
+        m_planar.store(true, std::memory_order_release);
+
+        wxFAIL_MSG( wxT("failed to allocate image data") );
+        return;
+    }
+
+    m_data = data;
+    m_alpha = alphaData;
+    m_static =
+    m_staticAlpha = false;
+
+    unsigned char* dst = m_data;
+    unsigned char* alpha = m_alpha;
+    switch ( m_rgbaFormat )
+    {
+        case wxIMAGE_RGBA_STRAIGHT:
+            for ( const unsigned char* src = m_rgba; alpha != m_alpha + count; src += 4 )
+            {
+                *dst++ = src[0];
+                *dst++ = src[1];
+                *dst++ = src[2];
+                *alpha++ = src[3];
+            }
+            break;
+
+        case wxIMAGE_ARGB32_PREMULTIPLIED:
+            for ( const wxUint32* src = reinterpret_cast<wxUint32*>(m_rgba);
+                  alpha != m_alpha + count;
+                  src++ )
+            {
+                const wxUint32 argb = *src;
+                const unsigned char a = argb >> 24;
+
+                *dst++ = UnpremultiplyAlpha(a, argb >> 16);
+                *dst++ = UnpremultiplyAlpha(a, argb >> 8);
+                *dst++ = UnpremultiplyAlpha(a, argb);
+                *alpha++ = a;
+            }
+            break;
+    }
+
+    m_planar.store(true, std::memory_order_release);
 }
 
 
+//-----------------------------------------------------------------------------
+// Parallel processing of image bands
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// Maximal number of threads used by the image processing functions, see
+// wxImage::SetMaxThreads().
+int gs_imageMaxThreads = 1;
+
+// Return the number of threads to actually use, taking into account the
+// special value of 0 meaning "as many as there are CPUs".
+int GetImageThreadsCount()
+{
+#if wxUSE_THREADS
+    if ( gs_imageMaxThreads == 0 )
+        return wxMax(wxThread::GetCPUCount(), 1);
+#endif // wxUSE_THREADS
+
+    return gs_imageMaxThreads;
+}
+
+#if wxUSE_THREADS
+
+// Simple pool of worker threads processing the bands of a single operation.
+//
+// The pool is created on first use and contains one thread less than the
+// number of CPUs, as the calling thread processes the bands too and waits
+// until all of them are done. The threads are kept until the library is shut
+// down, independently of the number of bands used by each operation.
+class wxImageThreadPool
+{
+public:
+    static wxImageThreadPool& Get()
+    {
+        static wxImageThreadPool s_pool;
+        return s_pool;
+    }
+
+    // Call func(band) for all bands in [0, numBands) range, using the worker
+    // threads and the current one, and return when all of them have been
+    // processed.
+    void Run(int numBands, const std::function<void (int)>& func)
+    {
+        // Only one operation at a time can use the pool.
+        wxMutexLocker lockRun(m_runMutex);
+
+        if ( !m_workersCreated )
+        {
+            // Don't try to create the workers again, even if we failed to do
+            // it or if they were destroyed by Shutdown(): in this case we
+            // just process all the bands in this thread.
+            m_workersCreated = true;
+
+            CreateWorkers(wxMax(wxThread::GetCPUCount(), 1) - 1);
+        }
+
+        {
+            wxMutexLocker lock(m_mutex);
+
+            m_func = &func;
+            m_nextBand = 0;
+            m_numBands = numBands;
+            m_pendingBands = numBands;
+
+            m_condWork.Broadcast();
+        }
+
+        // Process the bands in this thread too until there are none left.
+        for ( ;; )
+        {
+            int band;
+            {
+                wxMutexLocker lock(m_mutex);
+                if ( m_nextBand == m_numBands )
+                    break;
+
+                band = m_nextBand++;
+            }
+
+            DoProcessBand(band);
+        }
+
+        wxMutexLocker lock(m_mutex);
+        while ( m_pendingBands )
+            m_condDone.Wait();
+
+        m_func = nullptr;
+    }
+
+    // Stop all the worker threads, called when the library is shut down.
+    void Shutdown()
+    {
+        wxMutexLocker lockRun(m_runMutex);
+
+        DestroyWorkers();
+    }
+
+private:
+    class Worker : public wxThread
+    {
+    public:
+        explicit Worker(wxImageThreadPool& pool)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pool(pool)
+        {
+        }
+
+    protected:
+        virtual ExitCode Entry() override
+        {
+            m_pool.WorkerMain();
+            return nullptr;
+        }
+
+    private:
+        wxImageThreadPool& m_pool;
+    };
+
+    wxImageThreadPool()
+        : m_condWork(m_mutex),
+          m_condDone(m_mutex)
+    {
+        m_func = nullptr;
+        m_nextBand =
+        m_numBands =
+        m_pendingBands = 0;
+        m_exit = false;
+        m_workersCreated = false;
+    }
+
+    ~wxImageThreadPool()
+    {
+        // Normally Shutdown() has been already called by now.
+        DestroyWorkers();
+    }
+
+    void CreateWorkers(int numWorkers)
+    {
+        for ( int n = 0; n < numWorkers; n++ )
+        {
+            Worker* const worker = new Worker(*this);
+            if ( worker->Run() != wxTHREAD_NO_ERROR )
+            {
+                // Not a fatal problem, we just use fewer threads.
+                delete worker;
+                break;
+            }
+
+            m_workers.push_back(worker);
+        }
+    }
+
+    void DestroyWorkers()
+    {
+        if ( m_workers.empty() )
+            return;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            m_exit = true;
+            m_condWork.Broadcast();
+        }
+
+        for ( Worker* worker : m_workers )
+        {
+            worker->Wait();
+            delete worker;
+        }
+
+        m_workers.clear();
+        m_exit = false;
+    }
+
+    void WorkerMain()
+    {
+        wxMutexLocker lock(m_mutex);
+
+        for ( ;; )
+        {
+            while ( !m_exit && m_nextBand == m_numBands )
+                m_condWork.Wait();
+
+            if ( m_exit )
+                break;
+
+            const int band = m_nextBand++;
+
+            m_mutex.Unlock();
+            DoProcessBand(band);
+            m_mutex.Lock();
+        }
+    }
+
+    void DoProcessBand(int band)
+    {
+        (*m_func)(band);
+
+        wxMutexLocker lock(m_mutex);
+        if ( !--m_pendingBands )
+            m_condDone.Signal();
+    }
+
+    // Serializes the calls to Run() and Shutdown().
+    wxMutex m_runMutex;
+
+    // Protects all the fields below.
+    wxMutex m_mutex;
+    wxCondition m_condWork,
+                m_condDone;
+
+    // The function being currently executed, only non-null during Run().
+    const std::function<void (int)>* m_func;
+
+    // The next band to process, the total number of bands and the number of
+    // them which were not processed yet.
+    int m_nextBand,
+        m_numBands,
+        m_pendingBands;
+
+    // Set to tell the worker threads to exit.
+    bool m_exit;
+
+    // Set when the worker threads were created, only accessed while holding
+    // m_runMutex.
+    bool m_workersCreated;
+
+    std::vector<Worker*> m_workers;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+// Call func(start, end) for consecutive bands covering [0, count) range of
+// rows (or columns) of the image, processing each of which requires handling
+// approximately itemSize pixels.
+//
+// The bands may be processed in parallel if this was enabled by calling
+// wxImage::SetMaxThreads(), so func must only modify the data corresponding
+// to its band. The band boundaries depend only on the number of threads used,
+// and the functions using this helper produce the same results for any band
+// boundaries, so the output doesn't depend on the number of threads.
+void
+ForEachImageBand(int count, int itemSize,
+                 const std::function<void (int, int)>& func)
+{
+#if wxUSE_THREADS
+    // Don't bother with using threads for small images, the overhead of
+    // dispatching the work to them would be bigger than the gain.
+    static const wxLongLong_t MIN_PIXELS_PER_BAND = 16384;
+
+    int numBands = GetImageThreadsCount();
+    const wxLongLong_t
+        maxBands = static_cast<wxLongLong_t>(count) * itemSize / MIN_PIXELS_PER_BAND;
+    if ( numBands > maxBands )
+        numBands = static_cast<int>(maxBands);
+
+    if ( numBands > 1 )
+    {
+        const auto processBand = [&](int band)
+        {
+            const wxLongLong_t countLL = count;
+            func(static_cast<int>(countLL * band / numBands),
+                 static_cast<int>(countLL * (band + 1) / numBands));
+        };
+
+        wxImageThreadPool::Get().Run(numBands, processBand);
+        return;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(itemSize);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    func(0, count);
+}
+
+// Return the approximate number of source pixels used for computing a single
+// row of the resampled image, used as ForEachImageBand() itemSize argument.
+inline int
+GetResampleRowSize(int oldWidth, int oldHeight, int width, int height)
+{
+    return wxMax(oldWidth, width) * wxMax(oldHeight / height, 1);
+}
+
+} // anonymous namespace
+
+/* static */
+void wxImage::SetMaxThreads(int count)
+{
+    wxCHECK_RET( count >= 0, "invalid number of threads" );
+
+    gs_imageMaxThreads = count;
+}
+
+/* static */
+int wxImage::GetMaxThreads()
+{
+    return gs_imageMaxThreads;
+}
+
 //-----------------------------------------------------------------------------
 // wxImage
 //-----------------------------------------------------------------------------
 
-#define M_IMGDATA static_cast<wxImageRefData*>(m_refData)
+// Note that using M_IMGDATA creates separate RGB and alpha buffers from the
+// interleaved RGBA data, if necessary, use M_IMGDATA_RAW to access the fields
+// not related to the pixel data without doing it.
+#define M_IMGDATA wxImageRefData::GetPlanar(m_refData)
+#define M_IMGDATA_RAW static_cast<wxImageRefData*>(m_refData)
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxImage, wxObject);
 
@@ -202,6 +643,27 @@ bool wxImage::Create( int width, int height, unsigned char* data, bool static_da
     return true;
 }
 
+bool wxImage::CreateRGBA( int width, int height, unsigned char* rgba, wxImageRGBAFormat format )
+{
+    UnRef();
+
+    wxCHECK_MSG( rgba, false, wxT("null data in wxImage::CreateRGBA") );
+
+    m_refData = new wxImageRefData();
+
+    // Don't create the RGB and alpha buffers until they're really needed,
+    // this is done by M_IMGDATA.
+    M_IMGDATA_RAW->m_rgba = rgba;
+    M_IMGDATA_RAW->m_rgbaFormat = format;
+    M_IMGDATA_RAW->m_planar = false;
+    M_IMGDATA_RAW->m_rgbaValid = true;
+    M_IMGDATA_RAW->m_width = width;
+    M_IMGDATA_RAW->m_height = height;
+    M_IMGDATA_RAW->m_ok = true;
+
+    return true;
+}
+
 bool wxImage::Create( int width, int height, unsigned char* data, unsigned char* alpha, bool static_data )
 {
     UnRef();
@@ -228,7 +690,7 @@ void wxImage::Destroy()
 
 void wxImage::Clear(unsigned char value)
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
 
     AllocExclusive();
 
@@ -242,7 +704,10 @@ wxObjectRefData* wxImage::CreateRefData() const
 
 wxObjectRefData* wxImage::CloneRefData(const wxObjectRefData* that) const
 {
-    const wxImageRefData* refData = static_cast<const wxImageRefData*>(that);
+    // The clone is only used by AllocExclusive(), which discards the
+    // interleaved data anyhow, so copy just the RGB and alpha buffers.
+    const wxImageRefData* refData =
+        wxImageRefData::GetPlanar(const_cast<wxObjectRefData*>(that));
     wxCHECK_MSG(refData->m_ok, nullptr, wxT("invalid image") );
 
     wxImageRefData* refData_new = new wxImageRefData;
@@ -276,7 +741,7 @@ wxImage wxImage::MakeEmptyClone(int flags) const
 {
     wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, wxS("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), image, wxS("invalid image") );
 
     long height = M_IMGDATA->m_height;
     long width  = M_IMGDATA->m_width;
@@ -325,7 +790,7 @@ wxImage wxImage::ShrinkBy( int xFactor , int yFactor ) const
 
     wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), image, wxT("invalid image") );
 
     // can't scale to/from 0 size
     wxCHECK_MSG( (xFactor > 0) && (yFactor > 0), image,
@@ -444,7 +909,7 @@ wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
 {
     wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), image, wxT("invalid image") );
 
     // can't scale to/from 0 size
     wxCHECK_MSG( (width > 0) && (height > 0), image,
@@ -537,7 +1002,7 @@ wxImage wxImage::ResampleNearest(int width, int height) const
 {
     wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, "invalid image" );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), image, "invalid image" );
 
     // We use wxUIntPtr to rescale images of larger size in 64-bit builds:
     // using long wouldn't allow using images larger than 2^16 in either
@@ -661,7 +1126,7 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
 
 wxImage wxImage::ResampleBox(int width, int height) const
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), {}, "invalid image" );
 
     // This function implements a simple pre-blur/box averaging method for
     // downsampling that gives reasonably smooth results To scale the image
@@ -679,84 +1144,136 @@ wxImage wxImage::ResampleBox(int width, int height) const
 
     const unsigned char* src_data = M_IMGDATA->m_data;
     const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    unsigned char* dst_data_start = ret_image.GetData();
+    unsigned char* dst_alpha_start = nullptr;
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxCHECK_MSG( dst_data_start, ret_image, wxS("unable to create image") );
 
     if ( src_alpha )
     {
         ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        dst_alpha_start = ret_image.GetAlpha();
     }
 
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
+    const int srcWidth = M_IMGDATA->m_width;
+    const int channels = src_alpha ? 4 : 3;
 
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
+    // Process the destination image rows in [yStart, yEnd) range.
+    const auto processRows = [&](int yStart, int yEnd)
     {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
+        // Sums of the (alpha-weighted, if necessary) pixel values over the
+        // current vertical box for each column of the source image. They
+        // only ever contain integer values, so the order in which they're
+        // accumulated doesn't affect the result and we can process whole
+        // rows at once, which is much more cache friendly and allows the
+        // compiler to vectorize the inner loops.
+        wxVector<double> colSums(srcWidth * channels);
 
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
-        {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
+        // Bounds of the vertical box for which colSums was computed, it can
+        // be reused for several consecutive rows when enlarging the image.
+        int colSumsStart = -1,
+            colSumsEnd = -1;
 
-            // Box of pixels to average
-            averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
-                                * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
-            sum_r = sum_g = sum_b = sum_a = 0.0;
+        unsigned char* dst_data = dst_data_start + yStart * width * 3;
+        unsigned char* dst_alpha = dst_alpha_start ? dst_alpha_start + yStart * width
+                                                   : nullptr;
 
-            for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
+        for ( int y = yStart; y < yEnd; y++ )  // Destination image - Y direction
+        {
+            // Source pixel in the Y direction
+            const BoxPrecalc& vPrecalc = vPrecalcs[y];
+
+            if ( vPrecalc.boxStart != colSumsStart || vPrecalc.boxEnd != colSumsEnd )
             {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                colSumsStart = vPrecalc.boxStart;
+                colSumsEnd = vPrecalc.boxEnd;
+
+                double* const sums = &colSums[0];
+                std::fill(colSums.begin(), colSums.end(), 0.0);
+
+                for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
                 {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
+                    const unsigned char* const src = src_data + j * srcWidth * 3;
 
-                    if (src_alpha)
+                    if ( src_alpha )
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
+                        const unsigned char* const srcA = src_alpha + j * srcWidth;
+
+                        for ( int i = 0; i < srcWidth; ++i )
+                        {
+                            const unsigned a = srcA[i];
+                            sums[i * 4 + 0] += src[i * 3 + 0] * a;
+                            sums[i * 4 + 1] += src[i * 3 + 1] * a;
+                            sums[i * 4 + 2] += src[i * 3 + 2] * a;
+                            sums[i * 4 + 3] += a;
+                        }
                     }
                     else
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
+                        for ( int n = 0; n < srcWidth * 3; ++n )
+                            sums[n] += src[n];
                     }
                 }
             }
 
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
+            const int boxHeight = vPrecalc.boxEnd - vPrecalc.boxStart + 1;
+
+            for ( int x = 0; x < width; x++ )      // Destination image - X direction
             {
-                if (sum_a != 0)
+                // Source pixel in the X direction
+                const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+                // Box of pixels to average
+                const int averaged_pixels =
+                    boxHeight * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
+
+                double sum_r = 0.0, sum_g = 0.0, sum_b = 0.0, sum_a = 0.0;
+
+                const double* sums = &colSums[hPrecalc.boxStart * channels];
+                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
                 {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
+                    sum_r += sums[0];
+                    sum_g += sums[1];
+                    sum_b += sums[2];
+                    if ( src_alpha )
+                        sum_a += sums[3];
+
+                    sums += channels;
+                }
+
+                // Calculate the average from the sum and number of averaged
+                // pixels
+                if (src_alpha)
+                {
+                    if (sum_a != 0)
+                    {
+                        dst_data[0] = (unsigned char)(sum_r / sum_a);
+                        dst_data[1] = (unsigned char)(sum_g / sum_a);
+                        dst_data[2] = (unsigned char)(sum_b / sum_a);
+                    }
+                    else
+                    {
+                        dst_data[0] = 0;
+                        dst_data[1] = 0;
+                        dst_data[2] = 0;
+                    }
+                    *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
+                    dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
+                    dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
                 }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
+                dst_data += 3;
             }
-            dst_data += 3;
         }
-    }
+    };
+
+    ForEachImageBand(height,
+                     GetResampleRowSize(M_IMGDATA->m_width, M_IMGDATA->m_height,
+                                        width, height),
+                     processRows);
 
     return ret_image;
 }
@@ -819,25 +1336,63 @@ void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
     }
 }
 
+// Interpolate a single row of the source image horizontally, storing 3 or 4
+// (if alpha is used) values per destination pixel in the output buffer.
+void ResampleBilinearRow(const unsigned char* src_data,
+                         const unsigned char* src_alpha,
+                         const wxVector<BilinearPrecalc>& hPrecalcs,
+                         double* out)
+{
+    const int width = hPrecalcs.size();
+
+    for ( int dstx = 0; dstx < width; dstx++ )
+    {
+        // X-axis of pixel to interpolate from
+        const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
+
+        const int x_offset1 = hPrecalc.offset1;
+        const int x_offset2 = hPrecalc.offset2;
+        const double dx = hPrecalc.dd;
+        const double dx1 = hPrecalc.dd1;
+
+        const unsigned char* const src1 = src_data + x_offset1 * 3;
+        const unsigned char* const src2 = src_data + x_offset2 * 3;
+
+        out[0] = src1[0] * dx1 + src2[0] * dx;
+        out[1] = src1[1] * dx1 + src2[1] * dx;
+        out[2] = src1[2] * dx1 + src2[2] * dx;
+
+        if ( src_alpha )
+        {
+            out[3] = src_alpha[x_offset1] * dx1 + src_alpha[x_offset2] * dx;
+            out += 4;
+        }
+        else
+        {
+            out += 3;
+        }
+    }
+}
+
 } // anonymous namespace
 
 wxImage wxImage::ResampleBilinear(int width, int height) const
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), {}, "invalid image" );
 
     // This function implements a Bilinear algorithm for resampling.
     wxImage ret_image(width, height, false);
     const unsigned char* src_data = M_IMGDATA->m_data;
     const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    unsigned char* dst_data_start = ret_image.GetData();
+    unsigned char* dst_alpha_start = nullptr;
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxCHECK_MSG( dst_data_start, ret_image, wxS("unable to create image") );
 
     if ( src_alpha )
     {
         ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        dst_alpha_start = ret_image.GetAlpha();
     }
 
     wxVector<BilinearPrecalc> vPrecalcs(height);
@@ -845,61 +1400,97 @@ wxImage wxImage::ResampleBilinear(int width, int height) const
     ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
+    const int srcWidth = M_IMGDATA->m_width;
+    const int channels = src_alpha ? 4 : 3;
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    // Process the destination image rows in [dstyStart, dstyEnd) range.
+    const auto processRows = [&](int dstyStart, int dstyEnd)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
+        // The algorithm is separable, so we first interpolate the source
+        // rows horizontally and then interpolate between the two resulting
+        // rows. As the source row offsets only grow when going down the
+        // destination image, we keep the last two interpolated rows around
+        // and reuse them for the subsequent destination rows when possible,
+        // which is always the case when enlarging the image.
+        wxVector<double> row1(width * channels),
+                         row2(width * channels);
+        int row1Index = -1,
+            row2Index = -1;
 
+        unsigned char* dst_data = dst_data_start + dstyStart * width * 3;
+        unsigned char* dst_alpha = dst_alpha_start ? dst_alpha_start + dstyStart * width
+                                                   : nullptr;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dsty = dstyStart; dsty < dstyEnd; dsty++ )
         {
-            // X-axis of pixel to interpolate from
-            const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
-            const double dx = hPrecalc.dd;
-            const double dx1 = hPrecalc.dd1;
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
+            const int y_offset1 = vPrecalc.offset1;
+            const int y_offset2 = vPrecalc.offset2;
+            const double dy = vPrecalc.dd;
+            const double dy1 = vPrecalc.dd1;
 
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
+            if ( y_offset1 != row1Index )
+            {
+                if ( y_offset1 == row2Index )
+                {
+                    row1.swap(row2);
+                    row1Index = row2Index;
+                    row2Index = -1;
+                }
+                else
+                {
+                    ResampleBilinearRow(src_data + y_offset1 * srcWidth * 3,
+                                        src_alpha ? src_alpha + y_offset1 * srcWidth
+                                                  : nullptr,
+                                        hPrecalcs, &row1[0]);
+                    row1Index = y_offset1;
+                }
+            }
 
-            // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
+            if ( y_offset2 != row2Index )
+            {
+                ResampleBilinearRow(src_data + y_offset2 * srcWidth * 3,
+                                    src_alpha ? src_alpha + y_offset2 * srcWidth
+                                              : nullptr,
+                                    hPrecalcs, &row2[0]);
+                row2Index = y_offset2;
+            }
 
-            // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
+            // result lines
+            const double* line1 = &row1[0];
+            const double* line2 = &row2[0];
             if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
+            {
+                for ( int dstx = 0; dstx < width; dstx++ )
+                {
+                    dst_data[0] = static_cast<unsigned char>(line1[0] * dy1 + line2[0] * dy + .5);
+                    dst_data[1] = static_cast<unsigned char>(line1[1] * dy1 + line2[1] * dy + .5);
+                    dst_data[2] = static_cast<unsigned char>(line1[2] * dy1 + line2[2] * dy + .5);
+                    dst_data += 3;
 
-            // result lines
+                    *dst_alpha++ = static_cast<unsigned char>(line1[3] * dy1 + line2[3] * dy +.5);
 
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
+                    line1 += 4;
+                    line2 += 4;
+                }
+            }
+            else
+            {
+                for ( int n = 0; n < width * 3; n++ )
+                {
+                    dst_data[n] = static_cast<unsigned char>(line1[n] * dy1 + line2[n] * dy + .5);
+                }
 
-            if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+                dst_data += width * 3;
+            }
         }
-    }
+    };
+
+    ForEachImageBand(height,
+                     GetResampleRowSize(M_IMGDATA->m_width, M_IMGDATA->m_height,
+                                        width, height),
+                     processRows);
 
     return ret_image;
 }
@@ -978,7 +1569,7 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
 // This is the bicubic resampling algorithm
 wxImage wxImage::ResampleBicubic(int width, int height) const
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), {}, "invalid image" );
 
     // This function implements a Bicubic B-Spline algorithm for resampling.
     // This method is certainly a little slower than wxImage's default pixel
@@ -1012,15 +1603,15 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
 
     const unsigned char* src_data = M_IMGDATA->m_data;
     const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    unsigned char* dst_data_start = ret_image.GetData();
+    unsigned char* dst_alpha_start = nullptr;
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxCHECK_MSG( dst_data_start, ret_image, wxS("unable to create image") );
 
     if ( src_alpha )
     {
         ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        dst_alpha_start = ret_image.GetAlpha();
     }
 
     // Precalculate weights
@@ -1030,87 +1621,125 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
     ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    const int srcWidth = M_IMGDATA->m_width;
+
+    // Process the destination image rows in [dstyStart, dstyEnd) range.
+    const auto processRows = [&](int dstyStart, int dstyEnd)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+        unsigned char* dst_data = dst_data_start + dstyStart * width * 3;
+        unsigned char* dst_alpha = dst_alpha_start ? dst_alpha_start + dstyStart * width
+                                                   : nullptr;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dsty = dstyStart; dsty < dstyEnd; dsty++ )
         {
-            // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            // Sums for each color channel
-            double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+
+            // Source rows used for this destination row: computing them
+            // once here avoids recomputing the pixel index for each of the 16
+            // samples.
+            const unsigned char* srcRows[4];
+            const unsigned char* srcAlphaRows[4] = { nullptr };
+            for ( int k = 0; k < 4; k++ )
+            {
+                srcRows[k] = src_data + vPrecalc.offset[k] * srcWidth * 3;
+                if ( src_alpha )
+                    srcAlphaRows[k] = src_alpha + vPrecalc.offset[k] * srcWidth;
+            }
 
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
+            for ( int dstx = 0; dstx < width; dstx++ )
             {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+                // X-axis of pixel to interpolate from
+                const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+
+                // Sums for each color channel
+                double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
+                // Here we actually determine the RGBA values for the destination
+                // pixel. Note that the order of the operations here must be
+                // preserved as changing it would change the rounding of the
+                // results.
+                if ( src_alpha )
                 {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
+                    for ( int k = 0; k < 4; k++ )
+                    {
+                        const unsigned char* const srcRow = srcRows[k];
+                        const unsigned char* const srcAlphaRow = srcAlphaRows[k];
 
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
+                        for ( int i = 0; i < 4; i++ )
+                        {
+                            const int x_offset = hPrecalc.offset[i];
+
+                            // Calculate the weight for the specified pixel
+                            // according to the bicubic b-spline kernel we're
+                            // using for interpolation
+                            const double
+                                pixel_weight = vPrecalc.weight[k] * hPrecalc.weight[i];
+
+                            // Create a sum of all values for each color channel
+                            // adjusted for the pixel's calculated weight
+                            const unsigned char a = srcAlphaRow[x_offset];
+                            sum_r += srcRow[x_offset * 3 + 0] * pixel_weight * a;
+                            sum_g += srcRow[x_offset * 3 + 1] * pixel_weight * a;
+                            sum_b += srcRow[x_offset * 3 + 2] * pixel_weight * a;
+                            sum_a += a * pixel_weight;
+                        }
+                    }
+                }
+                else
+                {
+                    for ( int k = 0; k < 4; k++ )
+                    {
+                        const unsigned char* const srcRow = srcRows[k];
 
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
+                        for ( int i = 0; i < 4; i++ )
+                        {
+                            const unsigned char* const
+                                src_pixel = srcRow + hPrecalc.offset[i] * 3;
 
-                    // Create a sum of all values for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
+                            const double
+                                pixel_weight = vPrecalc.weight[k] * hPrecalc.weight[i];
+
+                            sum_r += src_pixel[0] * pixel_weight;
+                            sum_g += src_pixel[1] * pixel_weight;
+                            sum_b += src_pixel[2] * pixel_weight;
+                        }
+                    }
+                }
+
+                // Put the data into the destination image.  The summed values are
+                // of double data type and are rounded here for accuracy
+                if ( src_alpha )
+                {
+                    if (sum_a != 0)
                     {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
+                         dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
+                         dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
+                         dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
                     }
                     else
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
+                        dst_data[0] = 0;
+                        dst_data[1] = 0;
+                        dst_data[2] = 0;
                     }
-                }
-            }
-
-            // Put the data into the destination image.  The summed values are
-            // of double data type and are rounded here for accuracy
-            if ( src_alpha )
-            {
-                if (sum_a != 0)
-                {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
+                    *dst_alpha++ = (unsigned char)sum_a;
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    dst_data[0] = (unsigned char)(sum_r + 0.5);
+                    dst_data[1] = (unsigned char)(sum_g + 0.5);
+                    dst_data[2] = (unsigned char)(sum_b + 0.5);
                 }
-                *dst_alpha++ = (unsigned char)sum_a;
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
+                dst_data += 3;
             }
-            dst_data += 3;
         }
-    }
+    };
+
+    ForEachImageBand(height,
+                     GetResampleRowSize(M_IMGDATA->m_width, M_IMGDATA->m_height,
+                                        width, height),
+                     processRows);
 
     return ret_image;
 }
@@ -1131,89 +1760,95 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
     const int blurArea = blurRadius*2 + 1;
 
     // Horizontal blurring algorithm - average all pixels in the specified blur
-    // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in the blur radius for the first
-        // pixel of the row
-        for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
-        {
-            // To deal with the pixels at the start of a row so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous row
-            if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
-
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
-
-        dst = dst_data + y * M_IMGDATA->m_width*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
+    // radius in the X or horizontal direction, each row is processed
+    // independently of all the others
+    const auto processRows = [&](int yStart, int yEnd)
+    {
+        for ( int y = yStart; y < yEnd; y++ )
         {
-            // Take care of edge pixels on the left edge by essentially
-            // duplicating the edge pixel
-            if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the left side of the blur
-            // radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
-
-            // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
-
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+            // Variables used in the blurring algorithm
+            long sum_r = 0,
+                 sum_g = 0,
+                 sum_b = 0,
+                 sum_a = 0;
+
+            long pixel_idx;
+            const unsigned char *src;
+            unsigned char *dst;
+
+            // Calculate the average of all pixels in the blur radius for the first
+            // pixel of the row
+            for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
+            {
+                // To deal with the pixels at the start of a row so it's not
+                // grabbing GOK values from memory at negative indices of the
+                // image's data or grabbing from the previous row
+                if ( kernel_x < 0 )
+                    pixel_idx = y * M_IMGDATA->m_width;
+                else
+                    pixel_idx = kernel_x + y * M_IMGDATA->m_width;
+
+                src = src_data + pixel_idx*3;
+                sum_r += src[0];
+                sum_g += src[1];
+                sum_b += src[2];
+                if ( src_alpha )
+                    sum_a += src_alpha[pixel_idx];
+            }
 
-            // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
+            dst = dst_data + y * M_IMGDATA->m_width*3;
             dst[0] = (unsigned char)(sum_r / blurArea);
             dst[1] = (unsigned char)(sum_g / blurArea);
             dst[2] = (unsigned char)(sum_b / blurArea);
             if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+                dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+
+            // Now average the values of the rest of the pixels by just moving the
+            // blur radius box along the row
+            for ( int x = 1; x < M_IMGDATA->m_width; x++ )
+            {
+                // Take care of edge pixels on the left edge by essentially
+                // duplicating the edge pixel
+                if ( x - blurRadius - 1 < 0 )
+                    pixel_idx = y * M_IMGDATA->m_width;
+                else
+                    pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
+
+                // Subtract the value of the pixel at the left side of the blur
+                // radius box
+                src = src_data + pixel_idx*3;
+                sum_r -= src[0];
+                sum_g -= src[1];
+                sum_b -= src[2];
+                if ( src_alpha )
+                    sum_a -= src_alpha[pixel_idx];
+
+                // Take care of edge pixels on the right edge
+                if ( x + blurRadius > M_IMGDATA->m_width - 1 )
+                    pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
+                else
+                    pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
+
+                // Add the value of the pixel being added to the end of our box
+                src = src_data + pixel_idx*3;
+                sum_r += src[0];
+                sum_g += src[1];
+                sum_b += src[2];
+                if ( src_alpha )
+                    sum_a += src_alpha[pixel_idx];
+
+                // Save off the averaged data
+                dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
+                dst[0] = (unsigned char)(sum_r / blurArea);
+                dst[1] = (unsigned char)(sum_g / blurArea);
+                dst[2] = (unsigned char)(sum_b / blurArea);
+                if ( src_alpha )
+                    dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+            }
         }
-    }
+    };
+
+    ForEachImageBand(M_IMGDATA->m_height, M_IMGDATA->m_width, processRows);
 
     return ret_image;
 }
@@ -1234,89 +1869,94 @@ wxImage wxImage::BlurVertical(int blurRadius) const
     const int blurArea = blurRadius*2 + 1;
 
     // Vertical blurring algorithm - same as horizontal but switched the
-    // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
-        {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
-
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
-
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
+    // opposite direction, so here the columns are independent
+    const auto processColumns = [&](int xStart, int xEnd)
+    {
+        for ( int x = xStart; x < xEnd; x++ )
         {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
-
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
-
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+            // Variables used in the blurring algorithm
+            long sum_r = 0,
+                 sum_g = 0,
+                 sum_b = 0,
+                 sum_a = 0;
+
+            long pixel_idx;
+            const unsigned char *src;
+            unsigned char *dst;
+
+            // Calculate the average of all pixels in our blur radius box for the
+            // first pixel of the column
+            for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
+            {
+                // To deal with the pixels at the start of a column so it's not
+                // grabbing GOK values from memory at negative indices of the
+                // image's data or grabbing from the previous column
+                if ( kernel_y < 0 )
+                    pixel_idx = x;
+                else
+                    pixel_idx = x + kernel_y * M_IMGDATA->m_width;
+
+                src = src_data + pixel_idx*3;
+                sum_r += src[0];
+                sum_g += src[1];
+                sum_b += src[2];
+                if ( src_alpha )
+                    sum_a += src_alpha[pixel_idx];
+            }
 
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
+            dst = dst_data + x*3;
             dst[0] = (unsigned char)(sum_r / blurArea);
             dst[1] = (unsigned char)(sum_g / blurArea);
             dst[2] = (unsigned char)(sum_b / blurArea);
             if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+                dst_alpha[x] = (unsigned char)(sum_a / blurArea);
+
+            // Now average the values of the rest of the pixels by just moving the
+            // box along the column from top to bottom
+            for ( int y = 1; y < M_IMGDATA->m_height; y++ )
+            {
+                // Take care of pixels that would be beyond the top edge by
+                // duplicating the top edge pixel for the column
+                if ( y - blurRadius - 1 < 0 )
+                    pixel_idx = x;
+                else
+                    pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
+
+                // Subtract the value of the pixel at the top of our blur radius box
+                src = src_data + pixel_idx*3;
+                sum_r -= src[0];
+                sum_g -= src[1];
+                sum_b -= src[2];
+                if ( src_alpha )
+                    sum_a -= src_alpha[pixel_idx];
+
+                // Take care of the pixels that would be beyond the bottom edge of
+                // the image similar to the top edge
+                if ( y + blurRadius > M_IMGDATA->m_height - 1 )
+                    pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
+                else
+                    pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
+
+                // Add the value of the pixel being added to the end of our box
+                src = src_data + pixel_idx*3;
+                sum_r += src[0];
+                sum_g += src[1];
+                sum_b += src[2];
+                if ( src_alpha )
+                    sum_a += src_alpha[pixel_idx];
+
+                // Save off the averaged data
+                dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
+                dst[0] = (unsigned char)(sum_r / blurArea);
+                dst[1] = (unsigned char)(sum_g / blurArea);
+                dst[2] = (unsigned char)(sum_b / blurArea);
+                if ( src_alpha )
+                    dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+            }
         }
-    }
+    };
+
+    ForEachImageBand(M_IMGDATA->m_width, M_IMGDATA->m_height, processColumns);
 
     return ret_image;
 }
@@ -1562,7 +2202,7 @@ wxImage wxImage::GetSubImage( const wxRect &rect ) const
 {
     wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), image, wxT("invalid image") );
 
     wxCHECK_MSG( (rect.GetLeft()>=0) && (rect.GetTop()>=0) &&
                  (rect.GetRight()<=GetWidth()) && (rect.GetBottom()<=GetHeight()),
@@ -1573,7 +2213,7 @@ wxImage wxImage::GetSubImage( const wxRect &rect ) const
 
     image.Create( subwidth, subheight, false );
 
-    const unsigned char *src_data = GetData();
+    const unsigned char *src_data = M_IMGDATA->m_data;
     const unsigned char *src_alpha = M_IMGDATA->m_alpha;
     unsigned char *subdata = image.GetData();
     unsigned char *subalpha = nullptr;
@@ -1615,7 +2255,7 @@ wxImage wxImage::Size( const wxSize& size, const wxPoint& pos,
 {
     wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), image, wxT("invalid image") );
     wxCHECK_MSG( (size.GetWidth() > 0) && (size.GetHeight() > 0), image, wxT("invalid size") );
 
     int width = GetWidth(), height = GetHeight();
@@ -1665,8 +2305,8 @@ void
 wxImage::Paste(const wxImage & image, int x, int y,
                wxImageAlphaBlendMode alphaBlend)
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
-    wxCHECK_RET( image.IsOk(), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(image), wxT("invalid image") );
 
     AllocExclusive();
 
@@ -1863,7 +2503,7 @@ wxImage::Paste(const wxImage & image, int x, int y,
 void wxImage::Replace( unsigned char r1, unsigned char g1, unsigned char b1,
                        unsigned char r2, unsigned char g2, unsigned char b2 )
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
 
     AllocExclusive();
 
@@ -1951,21 +2591,21 @@ int wxImage::GetWidth() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_width;
+    return M_IMGDATA_RAW->m_width;
 }
 
 int wxImage::GetHeight() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_height;
+    return M_IMGDATA_RAW->m_height;
 }
 
 wxBitmapType wxImage::GetType() const
 {
     wxCHECK_MSG( IsOk(), wxBITMAP_TYPE_INVALID, wxT("invalid image") );
 
-    return M_IMGDATA->m_type;
+    return M_IMGDATA_RAW->m_type;
 }
 
 void wxImage::SetType(wxBitmapType type)
@@ -1980,11 +2620,11 @@ void wxImage::SetType(wxBitmapType type)
 
 long wxImage::XYToIndex(int x, int y) const
 {
-    if ( IsOk() &&
+    if ( wxImageRefData::HasPlanar(*this) &&
             x >= 0 && y >= 0 &&
-                x < M_IMGDATA->m_width && y < M_IMGDATA->m_height )
+                x < M_IMGDATA_RAW->m_width && y < M_IMGDATA_RAW->m_height )
     {
-        return y*M_IMGDATA->m_width + x;
+        return y*M_IMGDATA_RAW->m_width + x;
     }
 
     return -1;
@@ -2006,7 +2646,7 @@ void wxImage::SetRGB( int x, int y, unsigned char r, unsigned char g, unsigned c
 
 void wxImage::SetRGB( const wxRect& rect_, unsigned char r, unsigned char g, unsigned char b )
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
 
     AllocExclusive();
 
@@ -2076,15 +2716,21 @@ bool wxImage::IsOk() const
 {
     // image of 0 width or height can't be considered ok - at least because it
     // causes crashes in ConvertToBitmap() if we don't catch it in time
-    wxImageRefData *data = M_IMGDATA;
+    wxImageRefData *data = M_IMGDATA_RAW;
     return data && data->m_ok && data->m_width && data->m_height;
 }
 
 unsigned char *wxImage::GetData() const
 {
-    wxCHECK_MSG( IsOk(), (unsigned char *)nullptr, wxT("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), (unsigned char *)nullptr, wxT("invalid image") );
 
-    return M_IMGDATA->m_data;
+    wxImageRefData* const data = M_IMGDATA;
+
+    // The caller may modify the pixels using the returned pointer, so we
+    // can't rely on the interleaved data being up to date any more.
+    data->m_rgbaValid = false;
+
+    return data->m_data;
 }
 
 void wxImage::SetData( unsigned char *data, bool static_data  )
@@ -2093,14 +2739,14 @@ void wxImage::SetData( unsigned char *data, bool static_data  )
 
     wxImageRefData *newRefData = new wxImageRefData();
 
-    newRefData->m_width = M_IMGDATA->m_width;
-    newRefData->m_height = M_IMGDATA->m_height;
+    newRefData->m_width = M_IMGDATA_RAW->m_width;
+    newRefData->m_height = M_IMGDATA_RAW->m_height;
     newRefData->m_data = data;
     newRefData->m_ok = true;
-    newRefData->m_maskRed = M_IMGDATA->m_maskRed;
-    newRefData->m_maskGreen = M_IMGDATA->m_maskGreen;
-    newRefData->m_maskBlue = M_IMGDATA->m_maskBlue;
-    newRefData->m_hasMask = M_IMGDATA->m_hasMask;
+    newRefData->m_maskRed = M_IMGDATA_RAW->m_maskRed;
+    newRefData->m_maskGreen = M_IMGDATA_RAW->m_maskGreen;
+    newRefData->m_maskBlue = M_IMGDATA_RAW->m_maskBlue;
+    newRefData->m_hasMask = M_IMGDATA_RAW->m_hasMask;
     newRefData->m_static = static_data;
 
     UnRef();
@@ -2118,10 +2764,10 @@ void wxImage::SetData( unsigned char *data, int new_width, int new_height, bool
         newRefData->m_height = new_height;
         newRefData->m_data = data;
         newRefData->m_ok = true;
-        newRefData->m_maskRed = M_IMGDATA->m_maskRed;
-        newRefData->m_maskGreen = M_IMGDATA->m_maskGreen;
-        newRefData->m_maskBlue = M_IMGDATA->m_maskBlue;
-        newRefData->m_hasMask = M_IMGDATA->m_hasMask;
+        newRefData->m_maskRed = M_IMGDATA_RAW->m_maskRed;
+        newRefData->m_maskGreen = M_IMGDATA_RAW->m_maskGreen;
+        newRefData->m_maskBlue = M_IMGDATA_RAW->m_maskBlue;
+        newRefData->m_hasMask = M_IMGDATA_RAW->m_hasMask;
     }
     else
     {
@@ -2143,8 +2789,8 @@ void wxImage::SetDataRGBA(const unsigned char* data)
 
     wxImageRefData* newRefData = new wxImageRefData();
 
-    newRefData->m_width = M_IMGDATA->m_width;
-    newRefData->m_height = M_IMGDATA->m_height;
+    newRefData->m_width = M_IMGDATA_RAW->m_width;
+    newRefData->m_height = M_IMGDATA_RAW->m_height;
 
     size_t pixel_count = (size_t)newRefData->m_width * (size_t)newRefData->m_height;
     newRefData->m_data = (unsigned char*)malloc(3 * pixel_count);
@@ -2160,10 +2806,10 @@ void wxImage::SetDataRGBA(const unsigned char* data)
     }
 
     newRefData->m_ok = true;
-    newRefData->m_maskRed = M_IMGDATA->m_maskRed;
-    newRefData->m_maskGreen = M_IMGDATA->m_maskGreen;
-    newRefData->m_maskBlue = M_IMGDATA->m_maskBlue;
-    newRefData->m_hasMask = M_IMGDATA->m_hasMask;
+    newRefData->m_maskRed = M_IMGDATA_RAW->m_maskRed;
+    newRefData->m_maskGreen = M_IMGDATA_RAW->m_maskGreen;
+    newRefData->m_maskBlue = M_IMGDATA_RAW->m_maskBlue;
+    newRefData->m_hasMask = M_IMGDATA_RAW->m_hasMask;
     newRefData->m_static = false;
     newRefData->m_staticAlpha = false;
 
@@ -2172,6 +2818,106 @@ void wxImage::SetDataRGBA(const unsigned char* data)
     m_refData = newRefData;
 }
 
+const unsigned char* wxImage::GetDataRGBA() const
+{
+    wxCHECK_MSG( IsOk(), nullptr, wxT("invalid image") );
+
+    wxImageRefData* const data = M_IMGDATA_RAW;
+    return data->m_rgbaValid ? data->m_rgba : nullptr;
+}
+
+wxImageRGBAFormat wxImage::GetRGBAFormat() const
+{
+    wxCHECK_MSG( IsOk(), wxIMAGE_RGBA_STRAIGHT, wxT("invalid image") );
+
+    return M_IMGDATA_RAW->m_rgbaFormat;
+}
+
+void wxImage::ConvertToRGBA(wxImageRGBAFormat format)
+{
+    wxCHECK_RET( IsOk(), wxT("invalid image") );
+
+    wxImageRefData* data = M_IMGDATA_RAW;
+    if ( data->m_rgba && data->m_rgbaValid && data->m_rgbaFormat == format )
+        return;
+
+    // Note that this also discards the existing interleaved data, if any: it
+    // may be in another format or out of date.
+    AllocExclusive();
+
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
+
+    const unsigned char* src = M_IMGDATA->m_data;
+    const unsigned char* alpha = M_IMGDATA->m_alpha;
+
+    const size_t count = (size_t)M_IMGDATA->m_width * (size_t)M_IMGDATA->m_height;
+    unsigned char* const rgba = (unsigned char*)malloc(4 * count);
+    wxCHECK_RET( rgba, wxT("failed to allocate interleaved image data") );
+
+    switch ( format )
+    {
+        case wxIMAGE_RGBA_STRAIGHT:
+            for ( unsigned char* dst = rgba; dst != rgba + 4 * count; dst += 4 )
+            {
+                dst[0] = *src++;
+                dst[1] = *src++;
+                dst[2] = *src++;
+                dst[3] = alpha ? *alpha++ : wxALPHA_OPAQUE;
+            }
+            break;
+
+        case wxIMAGE_ARGB32_PREMULTIPLIED:
+            for ( wxUint32* dst = reinterpret_cast<wxUint32*>(rgba);
+                  dst != reinterpret_cast<wxUint32*>(rgba) + count;
+                  dst++ )
+            {
+                const unsigned char a = alpha ? *alpha++ : wxALPHA_OPAQUE;
+
+                *dst = wxUint32(a) << 24 |
+                       PremultiplyAlpha(a, src[0]) << 16 |
+                       PremultiplyAlpha(a, src[1]) <<  8 |
+                       PremultiplyAlpha(a, src[2]);
+                src += 3;
+            }
+            break;
+    }
+
+    // The interleaved data becomes the only copy of the pixels, so that it
+    // can't get out of sync with them. This is safe to do because we're the
+    // only owner of the data after calling AllocExclusive() above.
+    data = M_IMGDATA_RAW;
+    if ( !data->m_static )
+        free(data->m_data);
+    if ( !data->m_staticAlpha )
+        free(data->m_alpha);
+    data->m_data =
+    data->m_alpha = nullptr;
+    data->m_static =
+    data->m_staticAlpha = false;
+
+    data->m_rgba = rgba;
+    data->m_rgbaFormat = format;
+    data->m_planar = false;
+    data->m_rgbaValid = true;
+}
+
+void wxImage::AllocExclusive()
+{
+    wxObject::AllocExclusive();
+
+    // The caller is going to modify the pixels, so make sure that they're in
+    // the RGB and alpha buffers and get rid of the interleaved data which
+    // would become out of date. This is safe to do because we're the only
+    // owner of the data now.
+    wxImageRefData* const data = M_IMGDATA;
+    if ( data && data->m_rgba )
+    {
+        free(data->m_rgba);
+        data->m_rgba = nullptr;
+        data->m_rgbaValid = false;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // alpha channel support
 // ----------------------------------------------------------------------------
@@ -2225,7 +2971,7 @@ wxImage::ConvertColourToAlpha(unsigned char r, unsigned char g, unsigned char b)
 
 void wxImage::SetAlpha( unsigned char *alpha, bool static_data )
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
 
     AllocExclusive();
 
@@ -2243,14 +2989,28 @@ void wxImage::SetAlpha( unsigned char *alpha, bool static_data )
 
 unsigned char *wxImage::GetAlpha() const
 {
-    wxCHECK_MSG( IsOk(), (unsigned char *)nullptr, wxT("invalid image") );
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), (unsigned char *)nullptr, wxT("invalid image") );
+
+    wxImageRefData* const data = M_IMGDATA;
+
+    // As in GetData(), the alpha values may be modified by the caller.
+    data->m_rgbaValid = false;
 
-    return M_IMGDATA->m_alpha;
+    return data->m_alpha;
+}
+
+bool wxImage::HasAlpha() const
+{
+    wxCHECK_MSG( IsOk(), false, wxT("invalid image") );
+
+    // Interleaved data always has alpha, so there is no need to split it.
+    const wxImageRefData* const data = M_IMGDATA_RAW;
+    return data->m_rgba || data->m_alpha;
 }
 
 void wxImage::InitAlpha()
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
+    wxCHECK_RET( wxImageRefData::HasPlanar(*this), wxT("invalid image") );
 
     wxCHECK_RET( !HasAlpha(), wxT("image already has an alpha channel") );
 
@@ -2337,21 +3097,21 @@ unsigned char wxImage::GetMaskRed() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_maskRed;
+    return M_IMGDATA_RAW->m_maskRed;
 }
 
 unsigned char wxImage::GetMaskGreen() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_maskGreen;
+    return M_IMGDATA_RAW->m_maskGreen;
 }
 
 unsigned char wxImage::GetMaskBlue() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_maskBlue;
+    return M_IMGDATA_RAW->m_maskBlue;
 }
 
 void wxImage::SetMask( bool mask )
@@ -2367,7 +3127,7 @@ bool wxImage::HasMask() const
 {
     wxCHECK_MSG( IsOk(), false, wxT("invalid image") );
 
-    return M_IMGDATA->m_hasMask;
+    return M_IMGDATA_RAW->m_hasMask;
 }
 
 bool wxImage::IsTransparent(int x, int y, unsigned char threshold) const
@@ -2515,14 +3275,14 @@ bool wxImage::HasPalette() const
     if (!IsOk())
         return false;
 
-    return M_IMGDATA->m_palette.IsOk();
+    return M_IMGDATA_RAW->m_palette.IsOk();
 }
 
 const wxPalette& wxImage::GetPalette() const
 {
     wxCHECK_MSG( IsOk(), wxNullPalette, wxT("invalid image") );
 
-    return M_IMGDATA->m_palette;
+    return M_IMGDATA_RAW->m_palette;
 }
 
 void wxImage::SetPalette(const wxPalette& palette)
@@ -2569,11 +3329,11 @@ wxString wxImage::GetOption(const wxString& name) const
     if ( !M_IMGDATA )
         return wxEmptyString;
 
-    int idx = M_IMGDATA->m_optionNames.Index(name, false);
+    int idx = M_IMGDATA_RAW->m_optionNames.Index(name, false);
     if ( idx == wxNOT_FOUND )
         return wxEmptyString;
     else
-        return M_IMGDATA->m_optionValues[idx];
+        return M_IMGDATA_RAW->m_optionValues[idx];
 }
 
 int wxImage::GetOptionInt(const wxString& name) const
@@ -2583,7 +3343,7 @@ int wxImage::GetOptionInt(const wxString& name) const
 
 bool wxImage::HasOption(const wxString& name) const
 {
-    return M_IMGDATA ? M_IMGDATA->m_optionNames.Index(name, false) != wxNOT_FOUND
+    return M_IMGDATA ? M_IMGDATA_RAW->m_optionNames.Index(name, false) != wxNOT_FOUND
                      : false;
 }
 
@@ -2612,7 +3372,7 @@ void wxImage::SetLoadFlags(int flags)
 
 int wxImage::GetLoadFlags() const
 {
-    return M_IMGDATA ? M_IMGDATA->m_loadFlags : wxImageRefData::sm_defaultLoadFlags;
+    return M_IMGDATA ? M_IMGDATA_RAW->m_loadFlags : wxImageRefData::sm_defaultLoadFlags;
 }
 
 // Under Windows we can load wxImage not only from files but also from
@@ -2918,7 +3678,12 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
         const unsigned widthOrig = GetWidth(),
                        heightOrig = GetHeight();
 
-        // this uses the same (trivial) algorithm as the JPEG handler
+        // halve the image size until it fits: the JPEG handler must have
+        // already reduced the image size as much as it could, so for JPEG
+        // images this only does something if they need to be scaled down by
+        // more than 1/8 (note that, unlike the JPEG handler, which rounds up
+        // the scaled size in the same way as libjpeg does, we round it down
+        // here, as we always did)
         unsigned width = widthOrig,
                  height = heightOrig;
         while ( (maxWidth && width > maxWidth) ||
@@ -2950,6 +3715,8 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
 
 bool wxImage::LoadFile( wxInputStream& stream, wxBitmapType type, int index )
 {
+    wxTRACE_ZONE("wxImage::LoadFile");
+
     AllocExclusive();
 
     wxImageHandler *handler;
@@ -3016,6 +3783,8 @@ bool wxImage::LoadFile( wxInputStream& stream, wxBitmapType type, int index )
 
 bool wxImage::LoadFile( wxInputStream& stream, const wxString& mimetype, int index )
 {
+    wxTRACE_ZONE("wxImage::LoadFile");
+
     UnRef();
 
     m_refData = new wxImageRefData;
@@ -3501,6 +4270,42 @@ int wxImageHandler::GetImageCount( wxInputStream& stream )
             CallIfCanSeek(&wxImageHandler::DoGetImageCount, this);
 }
 
+bool wxImageHandler::LoadRows( wxImageRowSink& sink, wxInputStream& stream,
+                               bool verbose, int index )
+{
+    wxImage image;
+
+    // Allow the handlers supporting this to load a smaller image.
+    const wxSize maxSize = sink.GetMaxSize();
+    if ( maxSize.x > 0 )
+        image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, maxSize.x);
+    if ( maxSize.y > 0 )
+        image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, maxSize.y);
+
+    if ( !LoadFile(&image, stream, verbose, index) )
+        return false;
+
+    // The sink only deals with alpha, so convert the mask to it.
+    if ( image.HasMask() && !image.HasAlpha() )
+        image.InitAlpha();
+
+    const int width = image.GetWidth(),
+              height = image.GetHeight();
+    const unsigned char* const data = image.GetData();
+    const unsigned char* const alpha = image.GetAlpha();
+
+    if ( !sink.OnStart(width, height, alpha != nullptr) )
+        return false;
+
+    for ( int y = 0; y < height; y++ )
+    {
+        if ( !sink.OnRow(y, data + y*width*3, alpha ? alpha + y*width : nullptr) )
+            break;
+    }
+
+    return true;
+}
+
 bool wxImageHandler::CanRead( const wxString& name )
 {
     wxImageFileInputStream stream(name);
@@ -3588,12 +4393,14 @@ wxImage::FindFirstUnusedColour(unsigned char *r,
 //
 unsigned long wxImage::CountColours( unsigned long stopafter ) const
 {
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), 0, wxT("invalid image") );
+
     std::unordered_set<unsigned long> h;
 
     unsigned char *p;
     unsigned long size, nentries;
 
-    p = GetData();
+    p = M_IMGDATA->m_data;
     size = static_cast<unsigned long>(GetWidth()) * GetHeight();
     nentries = 0;
 
@@ -3618,7 +4425,9 @@ unsigned long wxImage::CountColours( unsigned long stopafter ) const
 
 unsigned long wxImage::ComputeHistogram( wxImageHistogram &h ) const
 {
-    unsigned char *p = GetData();
+    wxCHECK_MSG( wxImageRefData::HasPlanar(*this), 0, wxT("invalid image") );
+
+    const unsigned char *p = M_IMGDATA->m_data;
     unsigned long nentries = 0;
 
     h.clear();
@@ -3969,9 +4778,24 @@ class wxImageModule: public wxModule
 {
     wxDECLARE_DYNAMIC_CLASS(wxImageModule);
 public:
-    wxImageModule() {}
+    wxImageModule()
+    {
+#if wxUSE_THREADS
+        // The worker threads of the pool must be stopped before the threads
+        // module is cleaned up.
+        AddDependency("wxThreadModule");
+#endif // wxUSE_THREADS
+    }
+
     bool OnInit() override { wxImage::InitStandardHandlers(); return true; }
-    void OnExit() override { wxImage::CleanUpHandlers(); }
+    void OnExit() override
+    {
+#if wxUSE_THREADS
+        wxImageThreadPool::Get().Shutdown();
+#endif // wxUSE_THREADS
+
+        wxImage::CleanUpHandlers();
+    }
 };
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxImageModule, wxModule);
@@ -224,6 +224,64 @@ static inline void wx_cmyk_to_rgb(unsigned char* rgb, const unsigned char* cmyk)
     rgb[2] = (unsigned char)((c > 255) ? 0 : (255 - c));
 }
 
+// Set up the output parameters of the decompressor after reading the header:
+// select the output colour space and scale the picture to fit in the
+// specified max size, if any (0 means no limit), and return the number of
+// bytes per pixel in the output scanlines.
+static int
+wx_jpeg_setup_decompress(j_decompress_ptr cinfo,
+                         unsigned maxWidth,
+                         unsigned maxHeight)
+{
+    int bytesPerPixel;
+    if ((cinfo->out_color_space == JCS_CMYK) || (cinfo->out_color_space == JCS_YCCK))
+    {
+        cinfo->out_color_space = JCS_CMYK;
+        bytesPerPixel = 4;
+    }
+    else // all the rest is treated as RGB
+    {
+        cinfo->out_color_space = JCS_RGB;
+        bytesPerPixel = 3;
+    }
+
+    if ( maxWidth > 0 || maxHeight > 0 )
+    {
+        // Let libjpeg decode the image directly at the reduced size, which is
+        // much faster than decoding it at full size and rescaling it later as
+        // only the low frequency DCT coefficients need to be used then.
+        //
+        // Note that libjpeg rounds the output size up, so do the same here:
+        // otherwise the image would be slightly bigger than the maximal size
+        // and would have to be rescaled again by wxImage::DoLoad().
+        unsigned& scale = cinfo->scale_denom;
+        while ( (maxWidth && ((cinfo->image_width + scale - 1) / scale > maxWidth)) ||
+                    (maxHeight && ((cinfo->image_height + scale - 1) / scale > maxHeight)) )
+        {
+            // Scaling by more than 1/8 is not supported by libjpeg, the rest
+            // of the scaling will be done by wxImage::DoLoad().
+            if ( scale == 8 )
+                break;
+
+            scale *= 2;
+        }
+    }
+
+    return bytesPerPixel;
+}
+
+// Convert a CMYK scanline to RGB.
+static void
+wx_cmyk_row_to_rgb(unsigned char* rgb, const unsigned char* cmyk, size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        wx_cmyk_to_rgb(rgb, cmyk);
+        rgb += 3;
+        cmyk += 4;
+    }
+}
+
 // temporarily disable the warning C4611 (interaction between '_setjmp' and
 // C++ object destruction is non-portable) - I don't see any dtors here
 #ifdef __VISUALC__
@@ -268,28 +326,7 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     wx_jpeg_io_src( &cinfo, stream );
     jpeg_read_header( &cinfo, TRUE );
 
-    int bytesPerPixel;
-    if ((cinfo.out_color_space == JCS_CMYK) || (cinfo.out_color_space == JCS_YCCK))
-    {
-        cinfo.out_color_space = JCS_CMYK;
-        bytesPerPixel = 4;
-    }
-    else // all the rest is treated as RGB
-    {
-        cinfo.out_color_space = JCS_RGB;
-        bytesPerPixel = 3;
-    }
-
-    // scale the picture to fit in the specified max size if necessary
-    if ( maxWidth > 0 || maxHeight > 0 )
-    {
-        unsigned& scale = cinfo.scale_denom;
-        while ( (maxWidth && (cinfo.image_width / scale > maxWidth)) ||
-                    (maxHeight && (cinfo.image_height / scale > maxHeight)) )
-        {
-            scale *= 2;
-        }
-    }
+    const int bytesPerPixel = wx_jpeg_setup_decompress(&cinfo, maxWidth, maxHeight);
 
     jpeg_start_decompress( &cinfo );
 
@@ -316,13 +353,8 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         }
         else // CMYK
         {
-            const unsigned char* inptr = (const unsigned char*) tempbuf[0];
-            for (size_t i = 0; i < cinfo.output_width; i++)
-            {
-                wx_cmyk_to_rgb(ptr, inptr);
-                ptr += 3;
-                inptr += 4;
-            }
+            wx_cmyk_row_to_rgb(ptr, tempbuf[0], cinfo.output_width);
+            ptr += cinfo.output_width * 3;
         }
     }
 
@@ -349,6 +381,93 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxJPEGHandler::LoadRows( wxImageRowSink& sink, wxInputStream& stream, bool verbose, int index )
+{
+    // JPEG files contain a single image only.
+    if ( index != -1 && index != 0 )
+    {
+        if (verbose)
+        {
+            wxLogError(_("JPEG: Invalid image index."));
+        }
+        return false;
+    }
+
+    struct jpeg_decompress_struct cinfo;
+    wx_error_mgr jerr;
+
+    const wxSize maxSize = sink.GetMaxSize();
+
+    cinfo.err = jpeg_std_error( &jerr );
+    jerr.error_exit = wx_error_exit;
+
+    if (!verbose)
+        cinfo.err->output_message = wx_ignore_message;
+
+    /* Establish the setjmp return context for wx_error_exit to use. */
+    if (setjmp(jerr.setjmp_buffer)) {
+      if (verbose)
+      {
+        wxLogError(_("JPEG: Couldn't load - file is probably corrupted."));
+      }
+      (cinfo.src->term_source)(&cinfo);
+      jpeg_destroy_decompress(&cinfo);
+      return false;
+    }
+
+    jpeg_create_decompress( &cinfo );
+    wx_jpeg_io_src( &cinfo, stream );
+    jpeg_read_header( &cinfo, TRUE );
+
+    const int bytesPerPixel = wx_jpeg_setup_decompress
+                              (
+                                &cinfo,
+                                maxSize.x > 0 ? maxSize.x : 0,
+                                maxSize.y > 0 ? maxSize.y : 0
+                              );
+
+    jpeg_start_decompress( &cinfo );
+
+    if ( !sink.OnStart(cinfo.output_width, cinfo.output_height, false) )
+    {
+        (cinfo.src->term_source)(&cinfo);
+        jpeg_destroy_decompress( &cinfo );
+        return false;
+    }
+
+    // Both buffers are freed by jpeg_destroy_decompress() below.
+    const unsigned stride = cinfo.output_width * bytesPerPixel;
+    JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
+                            ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, 1 );
+    JSAMPARRAY rgbbuf = bytesPerPixel == 3
+                            ? tempbuf
+                            : (*cinfo.mem->alloc_sarray)
+                                ((j_common_ptr) &cinfo, JPOOL_IMAGE,
+                                 cinfo.output_width * 3, 1 );
+
+    while ( cinfo.output_scanline < cinfo.output_height )
+    {
+        const int y = cinfo.output_scanline;
+        jpeg_read_scanlines( &cinfo, tempbuf, 1 );
+
+        if ( cinfo.out_color_space == JCS_CMYK )
+            wx_cmyk_row_to_rgb(rgbbuf[0], tempbuf[0], cinfo.output_width);
+
+        if ( !sink.OnRow(y, rgbbuf[0], nullptr) )
+        {
+            // We can't call jpeg_finish_decompress() without reading all
+            // the scanlines, so just abandon decoding.
+            (cinfo.src->term_source)(&cinfo);
+            jpeg_destroy_decompress( &cinfo );
+            return true;
+        }
+    }
+
+    jpeg_finish_decompress( &cinfo );
+    jpeg_destroy_decompress( &cinfo );
+    return true;
+}
+
 typedef struct {
     struct jpeg_destination_mgr pub;
 
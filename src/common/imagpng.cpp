@@ -109,9 +109,11 @@ struct wxPNGImageData
     {
         lines = nullptr;
         m_buf = nullptr;
+        m_splitBuf = nullptr;
         info_ptr = (png_infop) nullptr;
         png_ptr = (png_structp) nullptr;
         ok = false;
+        cancelled = false;
     }
 
     bool Alloc(png_uint_32 width, png_uint_32 height, unsigned char* buf)
@@ -143,6 +145,7 @@ struct wxPNGImageData
 
     ~wxPNGImageData()
     {
+        free(m_splitBuf);
         free(m_buf);
         free( lines );
 
@@ -155,13 +158,33 @@ struct wxPNGImageData
         }
     }
 
+    // Create the libpng structures used for reading, return false on error.
+    bool CreateReadStruct(wxPNGInfoStruct& wxinfo);
+
+    // Read the PNG header and set up the transformations converting the data
+    // to 8 bit RGB or RGBA, which is used if hasAlpha is set to true.
+    //
+    // This must be called after setjmp() as libpng may longjmp() from it.
+    void ReadHeader(png_uint_32& width,
+                    png_uint_32& height,
+                    int& color_type,
+                    int& interlace_type,
+                    bool& hasAlpha);
+
     void DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo);
+    void DoLoadPNGRows(wxImageRowSink& sink, wxPNGInfoStruct& wxinfo);
 
     unsigned char** lines;
     unsigned char* m_buf;
+
+    // buffer for splitting RGBA rows into RGB and alpha in DoLoadPNGRows()
+    unsigned char* m_splitBuf;
     png_infop info_ptr;
     png_structp png_ptr;
     bool ok;
+
+    // set by DoLoadPNGRows() if loading was cancelled by the sink
+    bool cancelled;
 };
 
 } // anonymous namespace
@@ -289,19 +312,8 @@ void CopyDataFromPNG(wxImage *image,
     #pragma warning(disable:4611)
 #endif /* VC++ */
 
-// This function uses wxPNGImageData to store some of its "local" variables in
-// order to avoid clobbering these variables by longjmp(): having them inside
-// the stack frame of the caller prevents this from happening. It also
-// "returns" its result via wxPNGImageData: use its "ok" field to check
-// whether loading succeeded or failed.
-void
-wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
+bool wxPNGImageData::CreateReadStruct(wxPNGInfoStruct& wxinfo)
 {
-    png_uint_32 width, height = 0;
-    int bit_depth, color_type;
-
-    image->Destroy();
-
     png_ptr = png_create_read_struct
                           (
                             PNG_LIBPNG_VER_STRING,
@@ -310,36 +322,65 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
                             wx_PNG_warning
                           );
     if (!png_ptr)
-        return;
+        return false;
 
     // NB: please see the comment near wxPNGInfoStruct declaration for
     //     explanation why this line is mandatory
     png_set_read_fn( png_ptr, &wxinfo, wx_PNG_stream_reader);
 
     info_ptr = png_create_info_struct( png_ptr );
-    if (!info_ptr)
-        return;
 
-    if (setjmp(wxinfo.jmpbuf))
-        return;
+    return info_ptr != nullptr;
+}
+
+void
+wxPNGImageData::ReadHeader(png_uint_32& width,
+                           png_uint_32& height,
+                           int& color_type,
+                           int& interlace_type,
+                           bool& hasAlpha)
+{
+    int bit_depth;
 
     png_read_info( png_ptr, info_ptr );
-    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr );
+    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr );
 
     png_set_expand(png_ptr);
     png_set_gray_to_rgb(png_ptr);
     png_set_strip_16( png_ptr );
     png_set_packing( png_ptr );
 
+    hasAlpha = (color_type & PNG_COLOR_MASK_ALPHA) ||
+                    png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+}
+
+// This function uses wxPNGImageData to store some of its "local" variables in
+// order to avoid clobbering these variables by longjmp(): having them inside
+// the stack frame of the caller prevents this from happening. It also
+// "returns" its result via wxPNGImageData: use its "ok" field to check
+// whether loading succeeded or failed.
+void
+wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
+{
+    png_uint_32 width, height = 0;
+    int color_type, interlace_type;
+    bool needCopy;
+
+    image->Destroy();
+
+    if ( !CreateReadStruct(wxinfo) )
+        return;
+
+    if (setjmp(wxinfo.jmpbuf))
+        return;
+
+    ReadHeader(width, height, color_type, interlace_type, needCopy);
+
     image->Create((int)width, (int)height, (bool) false /* no need to init pixels */);
 
     if (!image->IsOk())
         return;
 
-    const bool needCopy =
-        (color_type & PNG_COLOR_MASK_ALPHA) ||
-        png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
-
     if (!Alloc(width, height, needCopy ? nullptr : image->GetData()))
         return;
 
@@ -455,6 +496,93 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
     ok = true;
 }
 
+// Same as DoLoadPNGFile() but passes the rows to the sink instead of storing
+// them in wxImage, avoiding allocating memory for the entire image unless it
+// is interlaced.
+void
+wxPNGImageData::DoLoadPNGRows(wxImageRowSink& sink, wxPNGInfoStruct& wxinfo)
+{
+    png_uint_32 width, height = 0;
+    int color_type, interlace_type;
+    bool hasAlpha;
+
+    if ( !CreateReadStruct(wxinfo) )
+        return;
+
+    if (setjmp(wxinfo.jmpbuf))
+        return;
+
+    ReadHeader(width, height, color_type, interlace_type, hasAlpha);
+
+    if ( !sink.OnStart((int)width, (int)height, hasAlpha) )
+    {
+        cancelled = true;
+        return;
+    }
+
+    // Interlaced images can't be decoded row by row, all passes need to be
+    // read before any row is complete, so read the entire image in this case.
+    const bool interlaced = interlace_type != PNG_INTERLACE_NONE;
+
+    if (!Alloc(width, interlaced ? height : 1, nullptr))
+        return;
+
+    if ( hasAlpha )
+    {
+        m_splitBuf = static_cast<unsigned char*>(malloc(width * 4));
+        if ( !m_splitBuf )
+            return;
+    }
+
+    if ( interlaced )
+        png_read_image( png_ptr, lines );
+
+    for ( png_uint_32 y = 0; y < height; y++ )
+    {
+        const unsigned char* row;
+        if ( interlaced )
+        {
+            row = lines[y];
+        }
+        else
+        {
+            png_read_row( png_ptr, lines[0], nullptr );
+            row = lines[0];
+        }
+
+        const unsigned char* rgb = row;
+        const unsigned char* alpha = nullptr;
+        if ( hasAlpha )
+        {
+            unsigned char* ptrRGB = m_splitBuf;
+            unsigned char* ptrAlpha = m_splitBuf + width * 3;
+
+            rgb = ptrRGB;
+            alpha = ptrAlpha;
+
+            for ( png_uint_32 x = 0; x < width; x++ )
+            {
+                *ptrRGB++ = *row++;
+                *ptrRGB++ = *row++;
+                *ptrRGB++ = *row++;
+                *ptrAlpha++ = *row++;
+            }
+        }
+
+        if ( !sink.OnRow((int)y, rgb, alpha) )
+        {
+            // Stopping is not an error, there is just no need to read the
+            // rest of the image.
+            ok = true;
+            return;
+        }
+    }
+
+    png_read_end( png_ptr, info_ptr );
+
+    ok = true;
+}
+
 bool
 wxPNGHandler::LoadFile(wxImage *image,
                        wxInputStream& stream,
@@ -486,6 +614,32 @@ wxPNGHandler::LoadFile(wxImage *image,
     return true;
 }
 
+bool
+wxPNGHandler::LoadRows(wxImageRowSink& sink,
+                       wxInputStream& stream,
+                       bool verbose,
+                       int WXUNUSED(index))
+{
+    wxPNGInfoStruct wxinfo;
+    wxinfo.verbose = verbose;
+    wxinfo.stream.in = &stream;
+
+    wxPNGImageData data;
+    data.DoLoadPNGRows(sink, wxinfo);
+
+    if ( !data.ok )
+    {
+        if (verbose && !data.cancelled)
+        {
+           wxLogError(_("Couldn't load a PNG image - file is corrupted or not enough memory."));
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // SaveFile() palette helpers
 // ----------------------------------------------------------------------------
@@ -288,6 +288,31 @@ TIFFwxOpen(wxOutputStream &stream, const char* name, const char* mode)
     return tif;
 }
 
+// Return true if the current TIFF directory has alpha channel, also return the
+// number of extra samples and the photometric interpretation used.
+static bool
+GetTIFFAlphaInfo(TIFF* tif,
+                 wxUint16 samplesPerPixel,
+                 wxUint16* extraSamples,
+                 wxUint16* photometric)
+{
+    wxUint16* samplesInfo;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_EXTRASAMPLES,
+                          extraSamples, &samplesInfo);
+
+    if (!TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, photometric))
+    {
+        *photometric = PHOTOMETRIC_MINISWHITE;
+    }
+
+    return (*extraSamples >= 1
+        && ((samplesInfo[0] == EXTRASAMPLE_UNSPECIFIED)
+            || samplesInfo[0] == EXTRASAMPLE_ASSOCALPHA
+            || samplesInfo[0] == EXTRASAMPLE_UNASSALPHA))
+        || (*extraSamples == 0 && samplesPerPixel == 4
+            && *photometric == PHOTOMETRIC_RGB);
+}
+
 bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int index )
 {
     if (index == -1)
@@ -332,21 +357,9 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     (void) TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
 
     wxUint16 extraSamples;
-    wxUint16* samplesInfo;
-    TIFFGetFieldDefaulted(tif, TIFFTAG_EXTRASAMPLES,
-                          &extraSamples, &samplesInfo);
-
     wxUint16 photometric;
-    if (!TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric))
-    {
-        photometric = PHOTOMETRIC_MINISWHITE;
-    }
-    const bool hasAlpha = (extraSamples >= 1
-        && ((samplesInfo[0] == EXTRASAMPLE_UNSPECIFIED)
-            || samplesInfo[0] == EXTRASAMPLE_ASSOCALPHA
-            || samplesInfo[0] == EXTRASAMPLE_UNASSALPHA))
-        || (extraSamples == 0 && samplesPerPixel == 4
-            && photometric == PHOTOMETRIC_RGB);
+    const bool hasAlpha = GetTIFFAlphaInfo(tif, samplesPerPixel,
+                                           &extraSamples, &photometric);
 
     // guard against integer overflow during multiplication which could result
     // in allocating a too small buffer and then overflowing it
@@ -580,6 +593,160 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxTIFFHandler::LoadRows( wxImageRowSink& sink, wxInputStream& stream, bool verbose, int index )
+{
+    if (index == -1)
+        index = 0;
+
+    // TIFF images can only be read from seekable streams anyhow, so we can
+    // always go back to the start if we need to fall back to LoadFile().
+    const wxFileOffset posStart = stream.TellI();
+
+    TIFF *tif = TIFFwxOpen( stream, "image", "r" );
+
+    if (!tif)
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Error loading image.") );
+        }
+
+        return false;
+    }
+
+    if (!TIFFSetDirectory( tif, (tdir_t)index ))
+    {
+        if (verbose)
+        {
+            wxLogError( _("Invalid TIFF image index.") );
+        }
+
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    wxUint16 samplesPerPixel = 0;
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+
+    wxUint16 extraSamples;
+    wxUint16 photometric;
+    const bool hasAlpha = GetTIFFAlphaInfo(tif, samplesPerPixel,
+                                           &extraSamples, &photometric);
+
+    wxUint16 planarConfig = PLANARCONFIG_CONTIG;
+    (void) TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarConfig);
+
+    // Grey scale images with alpha are handled specially by LoadFile() and
+    // the images not supported by TIFFRGBAImage at all can't be read in
+    // chunks, so just use the default implementation loading the entire
+    // image for them.
+    char msg[1024] = "";
+    TIFFRGBAImage img;
+    if ( (planarConfig == PLANARCONFIG_CONTIG && samplesPerPixel == 2
+            && extraSamples == 1) ||
+            !TIFFRGBAImageOK(tif, msg) ||
+                !TIFFRGBAImageBegin(&img, tif, 0, msg) )
+    {
+        TIFFClose( tif );
+
+        if ( stream.SeekI(posStart) == wxInvalidOffset )
+            return false;
+
+        return wxImageHandler::LoadRows(sink, stream, verbose, index);
+    }
+
+    const wxUint32 w = img.width,
+                   h = img.height;
+
+    // Read the image by chunks of the size of a strip (or a tile) because
+    // this is how the data is stored in the file and reading a part of a
+    // strip is not more efficient than reading all of it. Notice that this
+    // means that images stored as a single strip still need to be read all
+    // at once.
+    wxUint32 rowsPerChunk = 0;
+    if ( TIFFIsTiled(tif) )
+        (void) TIFFGetField(tif, TIFFTAG_TILELENGTH, &rowsPerChunk);
+    else
+        (void) TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerChunk);
+
+    if ( rowsPerChunk == 0 || rowsPerChunk > h )
+        rowsPerChunk = h;
+
+    // guard against integer overflow, as in LoadFile()
+    const double bytesNeeded = (double)w * (double)rowsPerChunk * sizeof(wxUint32);
+    wxUint32* const raster = bytesNeeded < wxUINT32_MAX
+                                ? (wxUint32*) _TIFFmalloc( (wxUint32)bytesNeeded )
+                                : nullptr;
+    if ( !raster )
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Couldn't allocate memory.") );
+        }
+
+        TIFFRGBAImageEnd( &img );
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    bool ok = sink.OnStart( (int)w, (int)h, hasAlpha );
+    bool stop = !ok;
+
+    wxVector<unsigned char> rgb(w * 3),
+                            alpha(hasAlpha ? w : 0);
+
+    img.req_orientation = ORIENTATION_TOPLEFT;
+    img.col_offset = 0;
+
+    for ( wxUint32 row = 0; row < h && !stop; row += rowsPerChunk )
+    {
+        const wxUint32 rows = wxMin(rowsPerChunk, h - row);
+
+        img.row_offset = row;
+        if ( !TIFFRGBAImageGet( &img, raster, w, rows ) )
+        {
+            if (verbose)
+            {
+                wxLogError( _("TIFF: Error reading image.") );
+            }
+
+            ok = false;
+            break;
+        }
+
+        const wxUint32* src = raster;
+        for ( wxUint32 i = 0; i < rows; i++ )
+        {
+            unsigned char* ptr = &rgb[0];
+            for ( wxUint32 j = 0; j < w; j++ )
+            {
+                *(ptr++) = (unsigned char)TIFFGetR(*src);
+                *(ptr++) = (unsigned char)TIFFGetG(*src);
+                *(ptr++) = (unsigned char)TIFFGetB(*src);
+                if ( hasAlpha )
+                    alpha[j] = (unsigned char)TIFFGetA(*src);
+
+                src++;
+            }
+
+            if ( !sink.OnRow( (int)(row + i), &rgb[0],
+                              hasAlpha ? &alpha[0] : nullptr ) )
+            {
+                stop = true;
+                break;
+            }
+        }
+    }
+
+    _TIFFfree( raster );
+    TIFFRGBAImageEnd( &img );
+    TIFFClose( tif );
+
+    return ok;
+}
+
 int wxTIFFHandler::DoGetImageCount( wxInputStream& stream )
 {
     TIFF *tif = TIFFwxOpen( stream, "image", "r" );
@@ -31,6 +31,11 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/thread.h"
+
+#include <map>
+#include <memory>
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -107,7 +112,9 @@ struct regex_t
     size_t re_nsub;
 
     pcre2_code* code;
-    pcre2_match_data* match_data;
+
+    // Number of pairs in the output vector needed for matching this regex.
+    uint32_t ovector_count;
 
     int errorcode;
     regoff_t erroroffset;
@@ -119,6 +126,138 @@ struct regmatch_t
     regoff_t rm_eo;
 };
 
+// PCRE2 objects used for matching which don't depend on the regex being
+// matched and so are reused for all of them instead of being allocated for
+// each regex or each match, but can't be shared between different threads.
+class MatchContext
+{
+public:
+    MatchContext() = default;
+
+    ~MatchContext()
+    {
+        pcre2_match_data_free(m_data);
+        pcre2_match_context_free(m_context);
+        pcre2_jit_stack_free(m_jitStack);
+    }
+
+    // Return the match data with at least the given number of pairs in its
+    // output vector or null if allocating it failed.
+    pcre2_match_data* GetData(uint32_t count)
+    {
+        if ( !m_data || pcre2_get_ovector_count(m_data) < count )
+        {
+            pcre2_match_data_free(m_data);
+            m_data = pcre2_match_data_create(count, nullptr);
+        }
+
+        return m_data;
+    }
+
+    // Return the match context using a bigger JIT stack than the default one,
+    // which is only 32KiB and may be insufficient for matching long strings.
+    //
+    // Returning null from here is not an error, the default context is used
+    // in this case.
+    pcre2_match_context* GetContext()
+    {
+        if ( !m_context )
+        {
+            m_context = pcre2_match_context_create(nullptr);
+            if ( !m_context )
+                return nullptr;
+
+            m_jitStack = pcre2_jit_stack_create(32*1024, 1024*1024, nullptr);
+            if ( m_jitStack )
+                pcre2_jit_stack_assign(m_context, nullptr, m_jitStack);
+        }
+
+        return m_context;
+    }
+
+private:
+    pcre2_match_data* m_data = nullptr;
+    pcre2_match_context* m_context = nullptr;
+    pcre2_jit_stack* m_jitStack = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(MatchContext);
+};
+
+// See UntranslatedStringHolder in translation.cpp for the explanation of the
+// MinGW thread_local bug requiring the first version of this class: the
+// destructor runs after the object's memory has been deallocated, so the
+// contexts are kept in a global map and the destructor only touches globals.
+#if wxUSE_THREADS && defined(__MINGW32__) && \
+    (!defined(__MINGW64_VERSION_MAJOR) || __MINGW64_VERSION_MAJOR < 15)
+
+class MatchContextHolder
+{
+private:
+    static wxCriticalSection ms_criticalSection;
+    static std::map<wxThreadIdType, std::unique_ptr<MatchContext>> ms_contextsMap;
+
+    // This will be set to point to an element of ms_contextsMap.
+    MatchContext* m_context = nullptr;
+
+public:
+    MatchContextHolder() = default;
+
+    MatchContext& Get()
+    {
+        if ( !m_context )
+        {
+            wxCriticalSectionLocker locker(ms_criticalSection);
+            std::unique_ptr<MatchContext>&
+                context = ms_contextsMap[wxThread::GetCurrentId()];
+            if ( !context )
+                context.reset(new MatchContext);
+
+            m_context = context.get();
+        }
+
+        return *m_context;
+    }
+
+    ~MatchContextHolder()
+    {
+        // This code is run after this object memory has been deallocated so we
+        // cannot access any member variables, but we can access global ones.
+        wxCriticalSectionLocker locker(ms_criticalSection);
+        ms_contextsMap.erase(wxThread::GetCurrentId());
+    }
+
+    wxDECLARE_NO_COPY_CLASS(MatchContextHolder);
+};
+
+wxCriticalSection MatchContextHolder::ms_criticalSection;
+
+std::map<wxThreadIdType, std::unique_ptr<MatchContext>>
+    MatchContextHolder::ms_contextsMap;
+
+#else // !__MINGW32__
+
+class MatchContextHolder
+{
+private:
+    MatchContext m_context;
+
+public:
+    MatchContextHolder() = default;
+
+    MatchContext& Get() { return m_context; }
+
+    wxDECLARE_NO_COPY_CLASS(MatchContextHolder);
+};
+
+#endif // __MINGW32__/!__MINGW32__
+
+// Return the context to use for matching in the current thread.
+MatchContext& GetMatchContextForThisThread()
+{
+    thread_local MatchContextHolder wxPerThreadMatchContext;
+    return wxPerThreadMatchContext.Get();
+}
+
 int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
 {
     // PCRE2_UTF is required in order to handle non-ASCII characters when using
@@ -159,7 +298,15 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
         return REG_BADPAT;
     }
 
-    preg->match_data = pcre2_match_data_create_from_pattern(preg->code, nullptr);
+    uint32_t capture_count = 0;
+    pcre2_pattern_info(preg->code, PCRE2_INFO_CAPTURECOUNT, &capture_count);
+    preg->ovector_count = capture_count + 1;
+
+    // Use JIT compilation if it's available, as it makes matching much
+    // faster. If it isn't, e.g. because PCRE2 was built without JIT support
+    // or because the system doesn't allow allocating executable memory, this
+    // fails and the interpreter is used for matching, as before.
+    pcre2_jit_compile(preg->code, PCRE2_JIT_COMPLETE);
 
     return REG_NOERROR;
 }
@@ -177,16 +324,38 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
     if ( eflags & REG_NOTEMPTY )
         options |= PCRE2_NOTEMPTY;
 
-    const int rc = pcre2_match
-                   (
-                        preg->code,
-                        (PCRE2_SPTR)string,
-                        len,
-                        0,                      // start offset
-                        options,
-                        preg->match_data,
-                        nullptr                    // use default context
-                   );
+    MatchContext& context = GetMatchContextForThisThread();
+
+    pcre2_match_data* const match_data = context.GetData(preg->ovector_count);
+    if ( !match_data )
+        return REG_ESPACE;
+
+    int rc = pcre2_match
+             (
+                preg->code,
+                (PCRE2_SPTR)string,
+                len,
+                0,                      // start offset
+                options,
+                match_data,
+                context.GetContext()
+             );
+
+    // Even the bigger JIT stack may be insufficient for some regexes, but the
+    // interpreter doesn't have this limitation, so fall back on it.
+    if ( rc == PCRE2_ERROR_JIT_STACKLIMIT )
+    {
+        rc = pcre2_match
+             (
+                preg->code,
+                (PCRE2_SPTR)string,
+                len,
+                0,                      // start offset
+                options | PCRE2_NO_JIT,
+                match_data,
+                context.GetContext()
+             );
+    }
 
     if ( rc == PCRE2_ERROR_NOMATCH )
         return REG_NOMATCH;
@@ -198,7 +367,7 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
     if ( pmatch )
     {
         const PCRE2_SIZE* const
-            ovector = pcre2_get_ovector_pointer(preg->match_data);
+            ovector = pcre2_get_ovector_pointer(match_data);
 
         const size_t nmatchActual = static_cast<size_t>(rc);
         for ( size_t n = 0; n < nmatch; ++n )
@@ -244,7 +413,6 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
 
 void wx_regfree(regex_t* preg)
 {
-    pcre2_match_data_free(preg->match_data);
     pcre2_code_free(preg->code);
 }
 
@@ -1009,7 +1177,7 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         {
             // we will alloc the array later (only if really needed) but count
             // the number of sub-expressions in the regex right now
-            m_nMatches = pcre2_get_ovector_count(m_RegEx.match_data);
+            m_nMatches = m_RegEx.ovector_count;
         }
 
         m_isCompiled = true;
@@ -1274,6 +1442,16 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
     return m_impl->Matches(textstr, flags, textlen);
 }
 
+bool wxRegEx::MatchesRange(const wxStringCharType* begin,
+                           const wxStringCharType* end,
+                           int flags) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+    wxCHECK_MSG( begin <= end, false, wxT("invalid range") );
+
+    return m_impl->Matches(begin, flags, end - begin);
+}
+
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -29,6 +29,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/display.h"
+#include "wx/tracezone.h"
 #include "wx/vector.h"
 #include "wx/listimpl.cpp"
 #include "wx/private/window.h"
@@ -1292,6 +1293,8 @@ void wxSizer::RecalcSizes()
 
 void wxSizer::Layout()
 {
+    wxTRACE_ZONE("wxSizer::Layout");
+
     // (re)calculates minimums needed for each item and other preparations
     // for layout
     const wxSize minSize = CalcMin();
@@ -49,6 +49,14 @@
 
 #include <unordered_map>
 
+// SSE2 is always available when targeting x86-64 and may be enabled for x86
+// too, use it for processing ASCII characters in UTF-8 conversions if it is.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxUSE_SSE2_FOR_UTF8
+    #include <emmintrin.h>
+#endif
+
 #define TRACE_STRCONV wxT("strconv")
 
 // WC_UTF16 is defined only if sizeof(wchar_t) == 2, otherwise it's supposed to
@@ -385,33 +393,175 @@ size_t wxMBConv::WC2MB(char *outBuff, const wchar_t *inBuff, size_t outLen) cons
     return rc;
 }
 
+namespace
+{
+
+// Return len*factor or wxCONV_FAILED if this overflows.
+inline size_t MultiplyLen(size_t len, size_t factor)
+{
+    return len > (wxCONV_FAILED - 1) / factor ? wxCONV_FAILED : len * factor;
+}
+
+// Return the length in bytes of a NUL-terminated string using the encoding
+// with the given NUL length, including the trailing NUL(s), or wxCONV_FAILED
+// if the NUL length is not supported.
+size_t GetNulTerminatedLength(const char* src, size_t nulLen)
+{
+    switch ( nulLen )
+    {
+        case 1:
+            return strlen(src) + 1;
+
+        case 2:
+        case 4:
+            {
+                const char* p = src;
+                while ( NotAllNULs(p, nulLen) )
+                    p += nulLen;
+
+                return p - src + nulLen;
+            }
+    }
+
+    return wxCONV_FAILED;
+}
+
+// The buffers used for single pass conversions are allocated for the
+// maximal possible output length, which may be much bigger than the actual
+// one, e.g. 4 times bigger when converting ASCII text to UTF-8, so give the
+// unused memory back unless there is only a little of it.
+template <typename T>
+void ShrinkConvBuffer(wxCharTypeBuffer<T>& buf, size_t len)
+{
+    if ( buf.length() - len > len / 4 + 16 && buf.extend(len) )
+        return;
+
+    buf.shrink(len);
+}
+
+} // anonymous namespace
+
+size_t
+wxMBConv::DoConvertMB2WC(wxWCharBuffer& wbuf,
+                         const char* src, size_t srcLen) const
+{
+    // If we know how long the output can be, we can avoid calling ToWChar()
+    // twice by allocating the buffer of the maximal size and shrinking it
+    // later. Check if this is the case before doing anything else to avoid
+    // computing the input length needlessly when it isn't.
+    size_t maxLen = GetMaxWCLen(0);
+    if ( maxLen != wxCONV_FAILED )
+    {
+        const size_t lenMB = srcLen == wxNO_LEN
+                                ? GetNulTerminatedLength(src, GetMBNulLen())
+                                : srcLen;
+        maxLen = lenMB == wxCONV_FAILED ? wxCONV_FAILED : GetMaxWCLen(lenMB);
+    }
+
+    if ( maxLen != wxCONV_FAILED )
+    {
+        wxWCharBuffer buf(maxLen);
+        if ( buf.data() )
+        {
+            const size_t dstLen = ToWChar(buf.data(), maxLen, src, srcLen);
+            if ( dstLen == wxCONV_FAILED )
+                return wxCONV_FAILED;
+
+            ShrinkConvBuffer(buf, dstLen);
+            wbuf = buf;
+
+            return dstLen;
+        }
+    }
+
+    const size_t dstLen = ToWChar(nullptr, 0, src, srcLen);
+    if ( dstLen == wxCONV_FAILED )
+        return wxCONV_FAILED;
+
+    // notice that we allocate space for dstLen+1 wide characters here
+    // because we want the buffer to always be NUL-terminated, even if the
+    // input isn't (as otherwise the caller has no way to know its length)
+    wxWCharBuffer buf(dstLen);
+    if ( ToWChar(buf.data(), dstLen, src, srcLen) == wxCONV_FAILED )
+        return wxCONV_FAILED;
+
+    wbuf = buf;
+
+    return dstLen;
+}
+
+size_t
+wxMBConv::DoConvertWC2MB(wxCharBuffer& buf,
+                         const wchar_t* src, size_t srcLen) const
+{
+    // As in DoConvertMB2WC(), try to convert in a single pass first.
+    size_t maxLen = GetMaxMBLen(0);
+    if ( maxLen != wxCONV_FAILED )
+        maxLen = GetMaxMBLen(srcLen == wxNO_LEN ? wxWcslen(src) + 1 : srcLen);
+
+    if ( maxLen != wxCONV_FAILED && maxLen < wxCONV_FAILED - GetMBNulLen() )
+    {
+        const size_t nulLen = GetMBNulLen();
+
+        wxCharBuffer tmp(maxLen + nulLen - 1);
+        if ( tmp.data() )
+        {
+            const size_t dstLen = FromWChar(tmp.data(), maxLen, src, srcLen);
+            if ( dstLen == wxCONV_FAILED )
+                return wxCONV_FAILED;
+
+            memset(tmp.data() + dstLen, 0, nulLen);
+            ShrinkConvBuffer(tmp, dstLen + nulLen - 1);
+            buf = tmp;
+
+            return dstLen;
+        }
+    }
+
+    size_t dstLen = FromWChar(nullptr, 0, src, srcLen);
+    if ( dstLen == wxCONV_FAILED )
+        return wxCONV_FAILED;
+
+    const size_t nulLen = GetMBNulLen();
+
+    // as above, ensure that the buffer is always NUL-terminated, even if
+    // the input is not
+    wxCharBuffer tmp(dstLen + nulLen - 1);
+    memset(tmp.data() + dstLen, 0, nulLen);
+
+    // Notice that return value of the call to FromWChar() here may be
+    // different from the one above as it could have overestimated the
+    // space needed, while what we get here is the exact length.
+    dstLen = FromWChar(tmp.data(), dstLen, src, srcLen);
+    if ( dstLen == wxCONV_FAILED )
+        return wxCONV_FAILED;
+
+    buf = tmp;
+
+    return dstLen;
+}
+
 wxWCharBuffer
 wxMBConv::cMB2WC(const char *inBuff, size_t inLen, size_t *outLen) const
 {
-    const size_t dstLen = ToWChar(nullptr, 0, inBuff, inLen);
+    wxWCharBuffer wbuf;
+    const size_t dstLen = DoConvertMB2WC(wbuf, inBuff, inLen);
     if ( dstLen != wxCONV_FAILED )
     {
-        // notice that we allocate space for dstLen+1 wide characters here
-        // because we want the buffer to always be NUL-terminated, even if the
-        // input isn't (as otherwise the caller has no way to know its length)
-        wxWCharBuffer wbuf(dstLen);
-        if ( ToWChar(wbuf.data(), dstLen, inBuff, inLen) != wxCONV_FAILED )
+        if ( outLen )
         {
-            if ( outLen )
-            {
-                *outLen = dstLen;
-
-                // we also need to handle NUL-terminated input strings
-                // specially: for them the output is the length of the string
-                // excluding the trailing NUL, however if we're asked to
-                // convert a specific number of characters we return the length
-                // of the resulting output even if it's NUL-terminated
-                if ( inLen == wxNO_LEN )
-                    (*outLen)--;
-            }
+            *outLen = dstLen;
 
-            return wbuf;
+            // we also need to handle NUL-terminated input strings
+            // specially: for them the output is the length of the string
+            // excluding the trailing NUL, however if we're asked to
+            // convert a specific number of characters we return the length
+            // of the resulting output even if it's NUL-terminated
+            if ( inLen == wxNO_LEN )
+                (*outLen)--;
         }
+
+        return wbuf;
     }
 
     if ( outLen )
@@ -423,36 +573,23 @@ wxMBConv::cMB2WC(const char *inBuff, size_t inLen, size_t *outLen) const
 wxCharBuffer
 wxMBConv::cWC2MB(const wchar_t *inBuff, size_t inLen, size_t *outLen) const
 {
-    size_t dstLen = FromWChar(nullptr, 0, inBuff, inLen);
+    wxCharBuffer buf;
+    const size_t dstLen = DoConvertWC2MB(buf, inBuff, inLen);
     if ( dstLen != wxCONV_FAILED )
     {
-        const size_t nulLen = GetMBNulLen();
-
-        // as above, ensure that the buffer is always NUL-terminated, even if
-        // the input is not
-        wxCharBuffer buf(dstLen + nulLen - 1);
-        memset(buf.data() + dstLen, 0, nulLen);
-
-        // Notice that return value of the call to FromWChar() here may be
-        // different from the one above as it could have overestimated the
-        // space needed, while what we get here is the exact length.
-        dstLen = FromWChar(buf.data(), dstLen, inBuff, inLen);
-        if ( dstLen != wxCONV_FAILED )
+        if ( outLen )
         {
-            if ( outLen )
-            {
-                *outLen = dstLen;
+            *outLen = dstLen;
 
-                if ( inLen == wxNO_LEN )
-                {
-                    // in this case both input and output are NUL-terminated
-                    // and we're not supposed to count NUL
-                    *outLen -= nulLen;
-                }
+            if ( inLen == wxNO_LEN )
+            {
+                // in this case both input and output are NUL-terminated
+                // and we're not supposed to count NUL
+                *outLen -= GetMBNulLen();
             }
-
-            return buf;
         }
+
+        return buf;
     }
 
     if ( outLen )
@@ -469,21 +606,17 @@ wxWCharBuffer wxMBConv::DoConvertMB2WC(const char* buf, size_t srcLen) const
     // come from wxScopedCharBuffer.
     if ( srcLen && buf )
     {
-        const size_t dstLen = ToWChar(nullptr, 0, buf, srcLen);
+        wxWCharBuffer wbuf;
+        const size_t dstLen = DoConvertMB2WC(wbuf, buf, srcLen);
         if ( dstLen != wxCONV_FAILED )
         {
-            wxWCharBuffer wbuf(dstLen);
-            wbuf.data()[dstLen] = L'\0';
-            if ( ToWChar(wbuf.data(), dstLen, buf, srcLen) != wxCONV_FAILED )
-            {
-                // If the input string was NUL-terminated, we shouldn't include
-                // the length of the trailing NUL into the length of the return
-                // value.
-                if ( srcLen == wxNO_LEN )
-                    wbuf.shrink(dstLen - 1);
+            // If the input string was NUL-terminated, we shouldn't include
+            // the length of the trailing NUL into the length of the return
+            // value.
+            if ( srcLen == wxNO_LEN )
+                wbuf.shrink(dstLen - 1);
 
-                return wbuf;
-            }
+            return wbuf;
         }
     }
 
@@ -494,20 +627,15 @@ wxCharBuffer wxMBConv::DoConvertWC2MB(const wchar_t* wbuf, size_t srcLen) const
 {
     if ( srcLen && wbuf )
     {
-        const size_t dstLen = FromWChar(nullptr, 0, wbuf, srcLen);
+        wxCharBuffer buf;
+        const size_t dstLen = DoConvertWC2MB(buf, wbuf, srcLen);
         if ( dstLen != wxCONV_FAILED )
         {
-            wxCharBuffer buf(dstLen);
-            buf.data()[dstLen] = '\0';
-            if ( FromWChar(buf.data(), dstLen, wbuf, srcLen) != wxCONV_FAILED )
-            {
-                // As above, in DoConvertMB2WC(), except that the length of the
-                // trailing NUL is variable in this case.
-                if ( srcLen == wxNO_LEN )
-                    buf.shrink(dstLen - GetMBNulLen());
+            // As above, in DoConvertMB2WC(), except that the length of the
+            // trailing NUL is variable in this case.
+            buf.shrink(srcLen == wxNO_LEN ? dstLen - GetMBNulLen() : dstLen);
 
-                return buf;
-            }
+            return buf;
         }
     }
 
@@ -943,6 +1071,137 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+namespace
+{
+
+// Convert the ASCII characters at the start of the given buffer of len bytes
+// to dst, if it's non-null, stopping at the first non-ASCII character.
+//
+// Returns the number of characters processed.
+size_t WidenASCII(wchar_t *dst, const char *src, size_t len)
+{
+    size_t n = 0;
+
+#ifdef wxUSE_SSE2_FOR_UTF8
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; len - n >= 16; n += 16 )
+    {
+        const __m128i
+            bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n));
+
+        // Non-ASCII characters have the most significant bit set.
+        if ( _mm_movemask_epi8(bytes) )
+            break;
+
+        if ( dst )
+        {
+            const __m128i lo = _mm_unpacklo_epi8(bytes, zero),
+                          hi = _mm_unpackhi_epi8(bytes, zero);
+
+            __m128i* const out = reinterpret_cast<__m128i*>(dst + n);
+#ifdef WC_UTF16
+            _mm_storeu_si128(out, lo);
+            _mm_storeu_si128(out + 1, hi);
+#else // !WC_UTF16
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+#endif // WC_UTF16/!WC_UTF16
+        }
+    }
+#else // !wxUSE_SSE2_FOR_UTF8
+    // Check 8 bytes at once, the compiler can vectorize the copying loop.
+    for ( ; len - n >= 8; n += 8 )
+    {
+        wxUint64 word;
+        memcpy(&word, src + n, sizeof(word));
+        if ( word & wxULL(0x8080808080808080) )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t i = n; i < n + 8; i++ )
+                dst[i] = static_cast<unsigned char>(src[i]);
+        }
+    }
+#endif // wxUSE_SSE2_FOR_UTF8/!wxUSE_SSE2_FOR_UTF8
+
+    for ( ; n < len && !(src[n] & 0x80); n++ )
+    {
+        if ( dst )
+            dst[n] = static_cast<unsigned char>(src[n]);
+    }
+
+    return n;
+}
+
+// Convert the ASCII characters at the start of the given buffer of len wide
+// characters to dst, if it's non-null, stopping at the first non-ASCII one.
+//
+// Returns the number of characters processed.
+size_t NarrowASCII(char *dst, const wchar_t *src, size_t len)
+{
+    size_t n = 0;
+
+#ifdef wxUSE_SSE2_FOR_UTF8
+    const __m128i zero = _mm_setzero_si128();
+#ifdef WC_UTF16
+    const __m128i nonASCII = _mm_set1_epi16(static_cast<short>(0xff80));
+    for ( ; len - n >= 16; n += 16 )
+    {
+        const __m128i* const in = reinterpret_cast<const __m128i*>(src + n);
+        const __m128i a = _mm_loadu_si128(in),
+                      b = _mm_loadu_si128(in + 1);
+
+        const __m128i high = _mm_and_si128(_mm_or_si128(a, b), nonASCII);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xffff )
+            break;
+
+        if ( dst )
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n),
+                             _mm_packus_epi16(a, b));
+        }
+    }
+#else // !WC_UTF16
+    const __m128i nonASCII = _mm_set1_epi32(~0x7f);
+    for ( ; len - n >= 16; n += 16 )
+    {
+        const __m128i* const in = reinterpret_cast<const __m128i*>(src + n);
+        const __m128i a = _mm_loadu_si128(in),
+                      b = _mm_loadu_si128(in + 1),
+                      c = _mm_loadu_si128(in + 2),
+                      d = _mm_loadu_si128(in + 3);
+
+        const __m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b),
+                                                        _mm_or_si128(c, d)),
+                                           nonASCII);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xffff )
+            break;
+
+        if ( dst )
+        {
+            // All values are less than 0x80, so saturation never happens.
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n),
+                             _mm_packus_epi16(_mm_packs_epi32(a, b),
+                                              _mm_packs_epi32(c, d)));
+        }
+    }
+#endif // WC_UTF16/!WC_UTF16
+#endif // wxUSE_SSE2_FOR_UTF8
+
+    for ( ; n < len && static_cast<wxUint32>(src[n]) < 0x80; n++ )
+    {
+        if ( dst )
+            dst[n] = static_cast<char>(src[n]);
+    }
+
+    return n;
+}
+
+} // anonymous namespace
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -975,6 +1234,26 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
             return written;
         }
 
+        // Handle all ASCII characters, which are the most common ones, at
+        // once. Notice that srcLen is never wxNO_LEN here.
+        if ( !(*p & 0x80) && (!out || dstLen) )
+        {
+            const size_t
+                n = WidenASCII(out, p, out ? wxMin(srcLen, dstLen) : srcLen);
+
+            srcLen -= n;
+            written += n;
+            if ( out )
+            {
+                out += n;
+                dstLen -= n;
+            }
+
+            // Account for the increment done by the loop.
+            p += n - 1;
+            continue;
+        }
+
         if ( out && !dstLen-- )
             break;
 
@@ -1065,14 +1344,20 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     char *out = dstLen ? dst : nullptr;
     size_t written = 0;
 
-    const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : src + srcLen;
+    // Find the end of NUL-terminated string first to be able to process
+    // several characters at once below.
+    const bool isNulTerminated = srcLen == wxNO_LEN;
+    if ( isNulTerminated )
+        srcLen = wxWcslen(src);
+
+    const wchar_t* const end = src + srcLen;
     for ( const wchar_t *wp = src; ; )
     {
-        if ( end ? wp == end : !*wp )
+        if ( wp == end )
         {
             // all done successfully, just add the trailing NUL if we are not
             // using explicit length
-            if ( srcLen == wxNO_LEN )
+            if ( isNulTerminated )
             {
                 if ( out )
                 {
@@ -1088,6 +1373,24 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
             return written;
         }
 
+        // Handle all ASCII characters at once.
+        if ( static_cast<wxUint32>(*wp) < 0x80 && (!out || dstLen) )
+        {
+            const size_t srcLeft = end - wp;
+            const size_t
+                n = NarrowASCII(out, wp, out ? wxMin(srcLeft, dstLen) : srcLeft);
+
+            wp += n;
+            written += n;
+            if ( out )
+            {
+                out += n;
+                dstLen -= n;
+            }
+
+            continue;
+        }
+
         wxUint32 code;
 #ifdef WC_UTF16
         code = *wp++;
@@ -1095,7 +1398,7 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
         if ( IsSurrogate(code) )
         {
             // Check that we have the second part of the surrogate pair.
-            if ( end ? wp == end : !*wp )
+            if ( wp == end )
                 return wxCONV_FAILED;
 
             code = EncodeSurrogate(code, *wp++);
@@ -1178,6 +1481,61 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     return wxCONV_FAILED;
 }
 
+size_t wxMBConvStrictUTF8::GetMaxWCLen(size_t srcLen) const
+{
+    // Each wide character, or each half of a surrogate pair, takes at least
+    // one byte in UTF-8.
+    return srcLen;
+}
+
+size_t wxMBConvStrictUTF8::GetMaxMBLen(size_t srcLen) const
+{
+#ifdef WC_UTF16
+    // Characters outside of BMP take 2 wide characters and 4 bytes, so the
+    // worst case is 3 bytes for a BMP character.
+    return MultiplyLen(srcLen, 3);
+#else // !WC_UTF16
+    return MultiplyLen(srcLen, 4);
+#endif // WC_UTF16/!WC_UTF16
+}
+
+size_t wxMBConvUTF8::GetMaxWCLen(size_t srcLen) const
+{
+    switch ( m_options )
+    {
+        case MAP_INVALID_UTF8_NOT:
+            break;
+
+        case MAP_INVALID_UTF8_TO_PUA:
+#ifdef WC_UTF16
+            // Invalid bytes are mapped to a character outside of BMP.
+            return MultiplyLen(srcLen, 2);
+#else // !WC_UTF16
+            break;
+#endif // WC_UTF16/!WC_UTF16
+
+        case MAP_INVALID_UTF8_TO_OCTAL:
+            // Invalid bytes are mapped to "\ooo" sequences.
+            return MultiplyLen(srcLen, 4);
+    }
+
+    return wxMBConvStrictUTF8::GetMaxWCLen(srcLen);
+}
+
+size_t wxMBConvUTF8::GetMaxMBLen(size_t srcLen) const
+{
+    if ( m_options == MAP_INVALID_UTF8_NOT )
+        return wxMBConvStrictUTF8::GetMaxMBLen(srcLen);
+
+#ifdef WC_UTF16
+    return MultiplyLen(srcLen, 3);
+#else // !WC_UTF16
+    // Unlike the strict version, we encode any 31 bit values, using up to 6
+    // bytes for them.
+    return MultiplyLen(srcLen, 6);
+#endif // WC_UTF16/!WC_UTF16
+}
+
 size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
                              const char *psz, size_t srcLen) const
 {
@@ -1541,6 +1899,21 @@ size_t wxMBConvUTF16Base::GetLength(const char *src, size_t srcLen)
     return srcLen;
 }
 
+size_t wxMBConvUTF16Base::GetMaxWCLen(size_t srcLen) const
+{
+    return srcLen / BYTES_PER_CHAR;
+}
+
+size_t wxMBConvUTF16Base::GetMaxMBLen(size_t srcLen) const
+{
+#ifdef WC_UTF16
+    return MultiplyLen(srcLen, BYTES_PER_CHAR);
+#else // !WC_UTF16
+    // Characters outside of BMP need a surrogate pair.
+    return MultiplyLen(srcLen, 2*BYTES_PER_CHAR);
+#endif // WC_UTF16/!WC_UTF16
+}
+
 // case when in-memory representation is UTF-16 too
 #ifdef WC_UTF16
 
@@ -1886,6 +2259,21 @@ size_t wxMBConvUTF32Base::GetLength(const char *src, size_t srcLen)
     return srcLen;
 }
 
+size_t wxMBConvUTF32Base::GetMaxWCLen(size_t srcLen) const
+{
+#ifdef WC_UTF16
+    // Characters outside of BMP need a surrogate pair.
+    return 2*(srcLen / BYTES_PER_CHAR);
+#else // !WC_UTF16
+    return srcLen / BYTES_PER_CHAR;
+#endif // WC_UTF16/!WC_UTF16
+}
+
+size_t wxMBConvUTF32Base::GetMaxMBLen(size_t srcLen) const
+{
+    return MultiplyLen(srcLen, BYTES_PER_CHAR);
+}
+
 // case when in-memory representation is UTF-16
 #ifdef WC_UTF16
 
@@ -3324,6 +3712,24 @@ size_t wxCSConv::GetMBNulLen() const
     return 1;
 }
 
+size_t wxCSConv::GetMaxWCLen(size_t srcLen) const
+{
+    if ( m_convReal )
+        return m_convReal->GetMaxWCLen(srcLen);
+
+    // otherwise, we are ISO-8859-1
+    return srcLen;
+}
+
+size_t wxCSConv::GetMaxMBLen(size_t srcLen) const
+{
+    if ( m_convReal )
+        return m_convReal->GetMaxMBLen(srcLen);
+
+    // otherwise, we are ISO-8859-1
+    return srcLen;
+}
+
 bool wxCSConv::IsUTF8() const
 {
     if ( m_convReal )
@@ -461,34 +461,44 @@ const wchar_t *wxString::AsWChar(const wxMBConv& conv) const
     const char * const strMB = m_impl.c_str();
     const size_t lenMB = m_impl.length();
 
-    // find out the size of the buffer needed
-    const size_t lenWC = conv.ToWChar(nullptr, 0, strMB, lenMB);
-    if ( lenWC == wxCONV_FAILED )
-        return nullptr;
-
-    // keep the same buffer if the string size didn't change: this is not only
-    // an optimization but also ensure that code which modifies string
-    // character by character (without changing its length) can continue to use
-    // the pointer returned by a previous wc_str() call even after changing the
+    ConvertedBuffer<wchar_t>& buf = const_cast<wxString *>(this)->m_convertedToWChar;
+
+    // if we know the maximal size of the result, we can convert directly
+    // into a buffer of this size, but if we already have a buffer and it is
+    // not big enough, find out the exact size needed first to avoid
+    // reallocating it if the string size didn't change: this is not only an
+    // optimization but also ensure that code which modifies string character
+    // by character (without changing its length) can continue to use the
+    // pointer returned by a previous wc_str() call even after changing the
     // string
-
-    // TODO-UTF8: we could check for ">" instead of "!=" here as this would
-    //            allow to save on buffer reallocations but at the cost of
-    //            consuming (even) more memory, we should benchmark this to
-    //            determine if it's worth doing
-    if ( !m_convertedToWChar.m_str || lenWC != m_convertedToWChar.m_len )
+    size_t lenWC = conv.GetMaxWCLen(lenMB);
+    if ( lenWC == wxCONV_FAILED || (buf.m_str && lenWC > buf.m_size) )
     {
-        if ( !const_cast<wxString *>(this)->m_convertedToWChar.Extend(lenWC) )
+        lenWC = conv.ToWChar(nullptr, 0, strMB, lenMB);
+        if ( lenWC == wxCONV_FAILED )
             return nullptr;
     }
 
+    const bool extended = !buf.m_str || lenWC > buf.m_size;
+    if ( extended && !buf.Extend(lenWC) )
+        return nullptr;
+
     // finally do convert
-    m_convertedToWChar.m_str[lenWC] = L'\0';
-    if ( conv.ToWChar(m_convertedToWChar.m_str, lenWC,
-                      strMB, lenMB) == wxCONV_FAILED )
+    lenWC = conv.ToWChar(buf.m_str, lenWC, strMB, lenMB);
+    if ( lenWC == wxCONV_FAILED )
         return nullptr;
 
-    return m_convertedToWChar.m_str;
+    if ( extended )
+    {
+        buf.Shrink(lenWC);
+    }
+    else
+    {
+        buf.m_str[lenWC] = L'\0';
+        buf.m_len = lenWC;
+    }
+
+    return buf.m_str;
 }
 
 #endif // !wxUSE_UNICODE_WCHAR
@@ -511,22 +521,36 @@ const char *wxString::AsChar(const wxMBConv& conv) const
     const size_t lenWC = m_impl.length();
 #endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
 
-    const size_t lenMB = conv.FromWChar(nullptr, 0, strWC, lenWC);
-    if ( lenMB == wxCONV_FAILED )
-        return nullptr;
+    ConvertedBuffer<char>& buf = const_cast<wxString *>(this)->m_convertedToChar;
 
-    if ( !m_convertedToChar.m_str || lenMB != m_convertedToChar.m_len )
+    // this is done in the same way as in AsWChar() above
+    size_t lenMB = conv.GetMaxMBLen(lenWC);
+    if ( lenMB == wxCONV_FAILED || (buf.m_str && lenMB > buf.m_size) )
     {
-        if ( !const_cast<wxString *>(this)->m_convertedToChar.Extend(lenMB) )
+        lenMB = conv.FromWChar(nullptr, 0, strWC, lenWC);
+        if ( lenMB == wxCONV_FAILED )
             return nullptr;
     }
 
-    m_convertedToChar.m_str[lenMB] = '\0';
-    if ( conv.FromWChar(m_convertedToChar.m_str, lenMB,
-                        strWC, lenWC) == wxCONV_FAILED )
+    const bool extended = !buf.m_str || lenMB > buf.m_size;
+    if ( extended && !buf.Extend(lenMB) )
         return nullptr;
 
-    return m_convertedToChar.m_str;
+    lenMB = conv.FromWChar(buf.m_str, lenMB, strWC, lenWC);
+    if ( lenMB == wxCONV_FAILED )
+        return nullptr;
+
+    if ( extended )
+    {
+        buf.Shrink(lenMB);
+    }
+    else
+    {
+        buf.m_str[lenMB] = '\0';
+        buf.m_len = lenMB;
+    }
+
+    return buf.m_str;
 }
 
 // ---------------------------------------------------------------------------
@@ -1908,13 +1932,41 @@ wxString wxString::FormatV(const wxString& format, va_list argptr)
     return s;
 }
 
+#if wxUSE_UNICODE_WCHAR
+// Forward declaration of the function defined below.
+static int DoStringFormatV(wxString& str,
+                           const wxChar* format, va_list argptr,
+                           bool append);
+#endif // wxUSE_UNICODE_WCHAR
+
 #if !wxUSE_UTF8_LOCALE_ONLY
 int wxString::DoPrintfWchar(const wxChar *format, ...)
 {
     va_list argptr;
     va_start(argptr, format);
 
+#if wxUSE_UNICODE_WCHAR
+    // avoid creating a temporary wxString for the format
+    int iLen = DoStringFormatV(*this, format, argptr, false);
+#else
     int iLen = PrintfV(format, argptr);
+#endif
+
+    va_end(argptr);
+
+    return iLen;
+}
+
+int wxString::DoAppendFormatWchar(const wxChar *format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+
+#if wxUSE_UNICODE_WCHAR
+    int iLen = DoStringFormatV(*this, format, argptr, true);
+#else
+    int iLen = AppendFormatV(format, argptr);
+#endif
 
     va_end(argptr);
 
@@ -1934,6 +1986,18 @@ int wxString::DoPrintfUtf8(const char *format, ...)
 
     return iLen;
 }
+
+int wxString::DoAppendFormatUtf8(const char *format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+
+    int iLen = AppendFormatV(wxString::FromUTF8(format), argptr);
+
+    va_end(argptr);
+
+    return iLen;
+}
 #endif // wxUSE_UNICODE_UTF8
 
 /*
@@ -2072,6 +2136,70 @@ static int DoStringPrintfV(wxString& str,
     return str.length();
 }
 
+#if wxUSE_UNICODE_WCHAR
+
+// Replace the contents of the string with the formatted output or append it to
+// the string if append is true.
+//
+// Returns the number of characters written or -1 on error.
+static int DoStringFormatV(wxString& str,
+                           const wxChar* format, va_list argptr,
+                           bool append)
+{
+    // Try formatting into a buffer on the stack first: the output is usually
+    // short enough to fit into it, and then we don't need to allocate a big
+    // temporary buffer and shrink the string to the actual size later, as
+    // DoStringPrintfV() does, but can just copy the output to the string,
+    // which grows as needed, so that appending to it many times is efficient.
+    wxChar buf[512];
+
+    int len;
+    {
+        PreserveErrno preserveErrno;
+
+        // Note that we call the CRT function directly instead of using
+        // wxVsnprintf() as the latter takes the format as wxString.
+        va_list argptrcopy;
+        wxVaCopy(argptrcopy, argptr);
+        len = wxCRT_VsnprintfW(buf, WXSIZEOF(buf), format, argptrcopy);
+        va_end(argptrcopy);
+    }
+
+    if ( len >= 0 && static_cast<size_t>(len) < WXSIZEOF(buf) )
+    {
+        // Note that we can only modify the string now, as the arguments could
+        // refer to it.
+        if ( append )
+            str.append(buf, len);
+        else
+            str.assign(buf, len);
+
+        return len;
+    }
+
+    // Either the buffer was too small or an error occurred, in which case we
+    // can't distinguish between the two, so use the slow path which will try
+    // with bigger buffers.
+    wxString tmp;
+    len = DoStringPrintfV(tmp, format, argptr);
+    if ( len < 0 )
+    {
+        if ( !append )
+            str.clear();
+
+        return len;
+    }
+
+    if ( append )
+        str += tmp;
+    else
+        str.swap(tmp);
+
+    return len;
+}
+
+#endif // wxUSE_UNICODE_WCHAR
+
 int wxString::PrintfV(const wxString& format, va_list argptr)
 {
 #if wxUSE_UTF8_LOCALE_ONLY
@@ -2084,11 +2212,26 @@ int wxString::PrintfV(const wxString& format, va_list argptr)
         // wxChar* version
         return DoStringPrintfV<wxStringBuffer>(*this, format, argptr);
     #else
-        return DoStringPrintfV(*this, format, argptr);
+        return DoStringFormatV(*this, format.wc_str(), argptr, false);
     #endif // UTF8/WCHAR
 #endif
 }
 
+int wxString::AppendFormatV(const wxString& format, va_list argptr)
+{
+#if wxUSE_UNICODE_WCHAR
+    return DoStringFormatV(*this, format.wc_str(), argptr, true);
+#else // wxUSE_UNICODE_UTF8
+    // format into a temporary string as the arguments could refer to this one
+    wxString s;
+    const int len = s.PrintfV(format, argptr);
+    if ( len >= 0 )
+        *this += s;
+
+    return len;
+#endif // wxUSE_UNICODE_WCHAR/wxUSE_UNICODE_UTF8
+}
+
 // ----------------------------------------------------------------------------
 // misc other operations
 // ----------------------------------------------------------------------------
@@ -24,6 +24,9 @@
 #include "wx/crt.h"
 #include "wx/private/wxprintf.h"
 
+#include <algorithm>
+#include <string>
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -559,6 +562,151 @@ const wxScopedWCharBuffer wxScanfConvertFormatW(const wchar_t *format)
 #endif // !__WINDOWS__
 
 
+// ----------------------------------------------------------------------------
+// Cache of the recently used format strings
+// ----------------------------------------------------------------------------
+
+// The same format string, typically a literal, is often used many times, so
+// we remember the result of converting it to the form expected by the CRT
+// printf() functions and of validating it to avoid parsing it every time.
+//
+// The cache is per-thread to avoid the need for locking, but this doesn't work
+// with older MinGW versions, see UntranslatedStringHolder in translation.cpp,
+// so just don't use it there.
+#if defined(__MINGW32__) && \
+    (!defined(__MINGW64_VERSION_MAJOR) || __MINGW64_VERSION_MAJOR < 15)
+    #define wxHAS_FORMAT_STRING_CACHE 0
+#else
+    #define wxHAS_FORMAT_STRING_CACHE 1
+#endif
+
+#if wxHAS_FORMAT_STRING_CACHE
+
+namespace
+{
+
+template <typename CharType>
+struct FormatCacheEntry
+{
+    // The address of the format string is used as the key, but it's not
+    // enough to identify it, as the same memory could be reused for another
+    // string, so we also keep a copy of its contents.
+    const CharType* format = nullptr;
+    std::basic_string<CharType> formatCopy;
+
+#if !wxUSE_UTF8_LOCALE_ONLY
+    wxScopedWCharBuffer convertedWChar;
+#endif
+#if !wxUSE_UNICODE_WCHAR
+    wxScopedCharBuffer convertedChar;
+#endif
+
+    // Types of the arguments for which this format was successfully
+    // validated, only valid if "validated" is true.
+    std::vector<int> argTypes;
+    bool validated = false;
+};
+
+class FormatCache
+{
+public:
+    FormatCache() = default;
+
+    // Return the cache for the current thread or null if it's not available
+    // any more because the thread is terminating.
+    static FormatCache* GetForThisThread();
+
+    FormatCacheEntry<char>& Get(const char* format)
+        { return DoGet(m_narrow, format); }
+    FormatCacheEntry<wchar_t>& Get(const wchar_t* format)
+        { return DoGet(m_wide, format); }
+
+private:
+    // The cache is direct-mapped: each format can only be stored in a single
+    // entry, which is simple and fast, and collisions are rare in practice.
+    static constexpr size_t SIZE = 64;
+
+    template <typename CharType>
+    static FormatCacheEntry<CharType>&
+    DoGet(FormatCacheEntry<CharType> (&entries)[SIZE], const CharType* format)
+    {
+        const wxUIntPtr addr = reinterpret_cast<wxUIntPtr>(format);
+        FormatCacheEntry<CharType>& entry = entries[(addr ^ (addr >> 6)) % SIZE];
+        if ( entry.format != format || entry.formatCopy != format )
+        {
+            entry.format = format;
+            entry.formatCopy = format;
+#if !wxUSE_UTF8_LOCALE_ONLY
+            entry.convertedWChar.reset();
+#endif
+#if !wxUSE_UNICODE_WCHAR
+            entry.convertedChar.reset();
+#endif
+            entry.validated = false;
+        }
+
+        return entry;
+    }
+
+    FormatCacheEntry<char> m_narrow[SIZE];
+    FormatCacheEntry<wchar_t> m_wide[SIZE];
+
+    wxDECLARE_NO_COPY_CLASS(FormatCache);
+};
+
+/* static */
+FormatCache* FormatCache::GetForThisThread()
+{
+    // Use trivially destructible variables for the cache pointer itself to
+    // allow using it safely even if wxString::Format() is called from the
+    // destructors of other thread-local objects after it had been destroyed.
+    thread_local FormatCache* s_cache = nullptr;
+    thread_local bool s_destroyed = false;
+
+    if ( !s_cache && !s_destroyed )
+    {
+        struct CacheDeleter
+        {
+            ~CacheDeleter()
+            {
+                delete s_cache;
+                s_cache = nullptr;
+                s_destroyed = true;
+            }
+        };
+
+        thread_local CacheDeleter s_deleter;
+
+        s_cache = new FormatCache;
+    }
+
+    return s_cache;
+}
+
+template <typename CharType>
+FormatCacheEntry<CharType>* GetFormatCacheEntry(const CharType* format)
+{
+    FormatCache* const cache = FormatCache::GetForThisThread();
+
+    return cache ? &cache->Get(format) : nullptr;
+}
+
+template <typename CharType>
+bool IsAsciiFormat(const CharType* format)
+{
+    for ( ; *format; ++format )
+    {
+        if ( static_cast<unsigned>(*format) >= 0x80 )
+            return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+#endif // wxHAS_FORMAT_STRING_CACHE
+
 // ----------------------------------------------------------------------------
 // wxFormatString
 // ----------------------------------------------------------------------------
@@ -589,8 +737,61 @@ const char* wxFormatString::InputAsChar()
 
 const char* wxFormatString::AsChar()
 {
-    if ( !m_convertedChar )
-        m_convertedChar = wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+    if ( m_convertedChar )
+        return m_convertedChar.data();
+
+#if wxHAS_FORMAT_STRING_CACHE
+    // Converting a wide string to char depends on the current locale, so
+    // we can only cache the result for the strings not depending on it.
+    bool cacheable = false;
+    if ( m_char )
+    {
+        const auto entry = GetFormatCacheEntry(m_char.data());
+        if ( entry && entry->convertedChar )
+        {
+            m_convertedChar = entry->convertedChar;
+            return m_convertedChar.data();
+        }
+
+        cacheable = true;
+    }
+    else if ( m_wchar && IsAsciiFormat(m_wchar.data()) )
+    {
+        const auto entry = GetFormatCacheEntry(m_wchar.data());
+        if ( entry && entry->convertedChar )
+        {
+            m_convertedChar = entry->convertedChar;
+            return m_convertedChar.data();
+        }
+
+        cacheable = true;
+    }
+
+    // Remember whether the input was passed as narrow string before calling
+    // InputAsChar() which may set m_char.
+    const bool wasNarrow = m_char.data() != nullptr;
+#endif // wxHAS_FORMAT_STRING_CACHE
+
+    m_convertedChar = wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+
+#if wxHAS_FORMAT_STRING_CACHE
+    if ( cacheable )
+    {
+        // Note that the converted string may be not owned by the buffer, if
+        // it didn't need any changes, so make a copy of it to store it.
+        const wxCharBuffer converted(m_convertedChar.data());
+        if ( wasNarrow )
+        {
+            if ( const auto entry = GetFormatCacheEntry(m_char.data()) )
+                entry->convertedChar = converted;
+        }
+        else
+        {
+            if ( const auto entry = GetFormatCacheEntry(m_wchar.data()) )
+                entry->convertedChar = converted;
+        }
+    }
+#endif // wxHAS_FORMAT_STRING_CACHE
 
     return m_convertedChar.data();
 }
@@ -631,8 +832,59 @@ const wchar_t* wxFormatString::InputAsWChar()
 
 const wchar_t* wxFormatString::AsWChar()
 {
-    if ( !m_convertedWChar )
-        m_convertedWChar = wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+    if ( m_convertedWChar )
+        return m_convertedWChar.data();
+
+#if wxHAS_FORMAT_STRING_CACHE
+    // As in AsChar() above, only cache the strings whose conversion doesn't
+    // depend on the current locale.
+    bool cacheable = false;
+    if ( m_wchar )
+    {
+        const auto entry = GetFormatCacheEntry(m_wchar.data());
+        if ( entry && entry->convertedWChar )
+        {
+            m_convertedWChar = entry->convertedWChar;
+            return m_convertedWChar.data();
+        }
+
+        cacheable = true;
+    }
+    else if ( m_char && IsAsciiFormat(m_char.data()) )
+    {
+        const auto entry = GetFormatCacheEntry(m_char.data());
+        if ( entry && entry->convertedWChar )
+        {
+            m_convertedWChar = entry->convertedWChar;
+            return m_convertedWChar.data();
+        }
+
+        cacheable = true;
+    }
+
+    // Remember whether the input was passed as wide string before calling
+    // InputAsWChar() which may set m_wchar.
+    const bool wasWide = m_wchar.data() != nullptr;
+#endif // wxHAS_FORMAT_STRING_CACHE
+
+    m_convertedWChar = wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+
+#if wxHAS_FORMAT_STRING_CACHE
+    if ( cacheable )
+    {
+        const wxWCharBuffer converted(m_convertedWChar.data());
+        if ( wasWide )
+        {
+            if ( const auto entry = GetFormatCacheEntry(m_wchar.data()) )
+                entry->convertedWChar = converted;
+        }
+        else
+        {
+            if ( const auto entry = GetFormatCacheEntry(m_char.data()) )
+                entry->convertedWChar = converted;
+        }
+    }
+#endif // wxHAS_FORMAT_STRING_CACHE
 
     return m_convertedWChar.data();
 }
@@ -740,8 +992,11 @@ wxFormatString::ArgumentType DoGetArgumentType(const CharType *format,
 #if wxDEBUG_LEVEL
 
 template<typename CharType>
-void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
+bool DoValidateFormat(const CharType* format,
+                      const int* argTypes, size_t numArgTypes)
 {
+    bool ok = true;
+
     wxPrintfConvSpecParser<CharType> parser(format);
 
     // For the reasons mentioned in the comment in DoGetArgumentType() above,
@@ -749,20 +1004,20 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
     // format format specifiers we actually have match the types.
     for ( unsigned n = 0; n < parser.nargs; ++n )
     {
-        if ( n == argTypes.size() )
+        if ( n == numArgTypes )
         {
             wxFAIL_MSG
             (
                 wxString::Format
                 (
                     "Not enough arguments, %zu given but at least %u needed",
-                    argTypes.size(),
+                    numArgTypes,
                     parser.nargs
                 )
             );
 
             // Useless to continue further.
-            return;
+            return false;
         }
 
         auto const pspec = parser.pspec[n];
@@ -777,22 +1032,59 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
                 )
             );
 
+            ok = false;
             continue;
         }
 
         auto const ptype = ArgTypeFromParamType(pspec->m_type);
-        wxASSERT_MSG
-        (
-            (ptype & argTypes[n]) == ptype,
-            wxString::Format
+        if ( (ptype & argTypes[n]) != ptype )
+        {
+            wxFAIL_MSG
             (
-                "Format specifier mismatch for argument %u of \"%s\"",
-                n + 1, format
-            )
-        );
+                wxString::Format
+                (
+                    "Format specifier mismatch for argument %u of \"%s\"",
+                    n + 1, format
+                )
+            );
+
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+// Validate the format string, using the cache to avoid doing it again if it
+// had been already successfully validated for the same argument types.
+template<typename CharType>
+void DoValidateFormatCached(const CharType* format,
+                            const int* argTypes, size_t numArgTypes)
+{
+#if wxHAS_FORMAT_STRING_CACHE
+    const auto entry = GetFormatCacheEntry(format);
+    if ( entry && entry->validated &&
+            entry->argTypes.size() == numArgTypes &&
+                std::equal(argTypes, argTypes + numArgTypes,
+                           entry->argTypes.begin()) )
+        return;
+#endif // wxHAS_FORMAT_STRING_CACHE
+
+    if ( !DoValidateFormat(format, argTypes, numArgTypes) )
+        return;
+
+#if wxHAS_FORMAT_STRING_CACHE
+    // Note that we need to get the entry again, as validating the format
+    // could have formatted other strings and modified the cache.
+    if ( const auto entryNew = GetFormatCacheEntry(format) )
+    {
+        entryNew->argTypes.assign(argTypes, argTypes + numArgTypes);
+        entryNew->validated = true;
     }
+#endif // wxHAS_FORMAT_STRING_CACHE
 }
 
+
 #endif // wxDEBUG_LEVEL
 
 } // anonymous namespace
@@ -816,14 +1108,26 @@ wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 
 void wxFormatString::Validate(const std::vector<int>& argTypes) const
 {
+    DoValidate(argTypes.data(), argTypes.size());
+}
+
+void wxFormatString::Validate(std::initializer_list<int> argTypes) const
+{
+    DoValidate(argTypes.begin(), argTypes.size());
+}
+
+void wxFormatString::DoValidate(const int* types, size_t count) const
+{
+    // Only the strings passed as pointers, which are usually literals, are
+    // cached, as wxStrings are usually different every time.
     if ( m_char )
-        DoValidateFormat(m_char.data(), argTypes);
+        DoValidateFormatCached(m_char.data(), types, count);
     else if ( m_wchar )
-        DoValidateFormat(m_wchar.data(), argTypes);
+        DoValidateFormatCached(m_wchar.data(), types, count);
     else if ( m_str )
-        DoValidateFormat(m_str->wx_str(), argTypes);
+        DoValidateFormat(m_str->wx_str(), types, count);
     else if ( m_cstr )
-        DoValidateFormat(m_cstr->AsInternal(), argTypes);
+        DoValidateFormat(m_cstr->AsInternal(), types, count);
 }
 
 #endif // wxDEBUG_LEVEL
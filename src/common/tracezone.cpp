@@ -0,0 +1,402 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/tracezone.cpp
+// Purpose:     wxTraceZone implementation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/tracezone.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"
+#endif
+
+#include "wx/ffile.h"
+#include "wx/thread.h"
+#include "wx/tls.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// private classes
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Contents of a single record.
+struct TraceZoneData
+{
+    const char* name;
+    wxInt64 start;
+    wxInt64 end;
+};
+
+// Record stored in the buffer: its fields are atomic because they may be read
+// by another thread while being overwritten by the owning one, but such torn
+// reads are detected using the sequence number and discarded.
+struct TraceZoneRecord
+{
+    // 0 while the record is being written, 1 + its number afterwards.
+    std::atomic<size_t> seq{0};
+
+    std::atomic<const char*> name{nullptr};
+    std::atomic<wxInt64> start{0};
+    std::atomic<wxInt64> end{0};
+};
+
+// Ring buffer containing the zones recorded by a single thread at any given
+// moment, but it may be reused by another thread after the thread using it
+// terminates.
+//
+// Only the thread owning the buffer writes to it, so no locking is needed
+// for this, and the other threads only read it when retrieving the trace.
+// All the other operations must be done while holding gs_buffersLock.
+class TraceZoneBuffer
+{
+public:
+    // Number of records in the buffer, when it is full, the oldest records
+    // are overwritten.
+    static constexpr size_t SIZE = 16384;
+
+    explicit TraceZoneBuffer(unsigned long threadId)
+    {
+        m_owners.push_back(Owner{0, threadId});
+    }
+
+    void Add(const char* name, wxInt64 start, wxInt64 end)
+    {
+        const size_t n = m_written.load(std::memory_order_relaxed);
+
+        // This is a "sequence lock": mark the record as being modified before
+        // changing it and as valid again after doing it, see ForEach().
+        TraceZoneRecord& record = m_records[n % SIZE];
+        record.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        record.name.store(name, std::memory_order_relaxed);
+        record.start.store(start, std::memory_order_relaxed);
+        record.end.store(end, std::memory_order_relaxed);
+
+        record.seq.store(n + 1, std::memory_order_release);
+
+        m_written.store(n + 1, std::memory_order_release);
+    }
+
+    // Call the given function with all records in the buffer, from the
+    // oldest to the newest one, and the ID of the thread which wrote them.
+    template <typename F>
+    void ForEach(F func) const
+    {
+        const size_t written = m_written.load(std::memory_order_acquire);
+
+        size_t n = m_cleared;
+        if ( written - n > SIZE )
+            n = written - SIZE;
+
+        auto owner = m_owners.begin();
+        for ( ; n < written; n++ )
+        {
+            const TraceZoneRecord& record = m_records[n % SIZE];
+
+            // If the owning thread has wrapped around and is overwriting this
+            // record while we are reading it, it may be inconsistent, so skip
+            // it: this is the case if its sequence number changes.
+            const size_t seq = n + 1;
+            if ( record.seq.load(std::memory_order_acquire) != seq )
+                continue;
+
+            const TraceZoneData data =
+            {
+                record.name.load(std::memory_order_relaxed),
+                record.start.load(std::memory_order_relaxed),
+                record.end.load(std::memory_order_relaxed)
+            };
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ( record.seq.load(std::memory_order_relaxed) != seq )
+                continue;
+
+            while ( owner + 1 != m_owners.end() && (owner + 1)->first <= n )
+                ++owner;
+
+            func(data, owner->threadId);
+        }
+    }
+
+    void Clear()
+    {
+        m_cleared = m_written.load(std::memory_order_acquire);
+    }
+
+    // Functions used for recycling the buffers of the terminated threads.
+    bool IsInUse() const { return m_inUse; }
+
+    void Release() { m_inUse = false; }
+
+    void Reuse(unsigned long threadId)
+    {
+        // Nobody writes to the buffer when it's not used, so there is no need
+        // for any synchronization here.
+        const size_t written = m_written.load(std::memory_order_relaxed);
+
+        // Forget the owners of the records which were already overwritten.
+        while ( m_owners.size() > 1 && m_owners[1].first + SIZE <= written )
+            m_owners.erase(m_owners.begin());
+
+        m_owners.push_back(Owner{written, threadId});
+        m_inUse = true;
+    }
+
+private:
+    TraceZoneRecord m_records[SIZE];
+
+    // Total number of records ever written, only modified by the owning
+    // thread.
+    std::atomic<size_t> m_written{0};
+
+    // Value of m_written when Clear() was last called.
+    size_t m_cleared = 0;
+
+    // All threads which used this buffer, with the number of the first record
+    // written by each of them.
+    struct Owner
+    {
+        size_t first;
+        unsigned long threadId;
+    };
+    std::vector<Owner> m_owners;
+
+    // False if the thread which used this buffer has terminated.
+    bool m_inUse = true;
+
+    wxDECLARE_NO_COPY_CLASS(TraceZoneBuffer);
+};
+
+// All buffers ever created: they are never deleted, but are reused by the new
+// threads when the threads using them terminate, which still allows to
+// retrieve the zones recorded by the terminated threads until then.
+std::vector<TraceZoneBuffer*> gs_buffers;
+wxCRIT_SECT_DECLARE(gs_buffersLock);
+
+// Buffer used by the current thread.
+wxTHREAD_SPECIFIC_DECL TraceZoneBuffer* gs_threadBuffer = nullptr;
+
+// Set to true when the current thread is terminating after it released its
+// buffer, to avoid acquiring a new one.
+wxTHREAD_SPECIFIC_DECL bool gs_threadBufferReleased = false;
+
+unsigned long GetThisThreadId()
+{
+#if wxUSE_THREADS
+    return static_cast<unsigned long>(wxThread::GetCurrentId());
+#else
+    return 0;
+#endif
+}
+
+// Object used to release the buffer of the current thread when it terminates.
+//
+// See UntranslatedStringHolder in translation.cpp for the explanation of the
+// MinGW thread_local bug: the destructor runs after the thread-specific
+// variables memory has been deallocated, so we can't reset gs_threadBuffer
+// and hence can't allow another thread to reuse the buffer safely. With this
+// compiler, the buffers are simply never reused.
+#if wxUSE_THREADS && defined(__MINGW32__) && \
+    (!defined(__MINGW64_VERSION_MAJOR) || __MINGW64_VERSION_MAJOR < 15)
+
+class TraceZoneBufferReleaser
+{
+public:
+    TraceZoneBufferReleaser() { }
+};
+
+#else // !__MINGW32__
+
+class TraceZoneBufferReleaser
+{
+public:
+    TraceZoneBufferReleaser() = default;
+
+    ~TraceZoneBufferReleaser()
+    {
+        wxCRIT_SECT_LOCKER(lock, gs_buffersLock);
+
+        if ( gs_threadBuffer )
+            gs_threadBuffer->Release();
+
+        gs_threadBuffer = nullptr;
+        gs_threadBufferReleased = true;
+    }
+
+    wxDECLARE_NO_COPY_CLASS(TraceZoneBufferReleaser);
+};
+
+#endif // __MINGW32__/!__MINGW32__
+
+// Return the buffer to use for the current thread, creating it if necessary.
+TraceZoneBuffer* AcquireThreadBuffer()
+{
+    if ( gs_threadBufferReleased )
+        return nullptr;
+
+    // This ensures that the buffer is released when this thread terminates.
+    static wxTHREAD_SPECIFIC_DECL TraceZoneBufferReleaser s_releaser;
+
+    const unsigned long threadId = GetThisThreadId();
+
+    wxCRIT_SECT_LOCKER(lock, gs_buffersLock);
+
+    for ( TraceZoneBuffer* buffer : gs_buffers )
+    {
+        if ( !buffer->IsInUse() )
+        {
+            buffer->Reuse(threadId);
+            gs_threadBuffer = buffer;
+            return buffer;
+        }
+    }
+
+    TraceZoneBuffer* const buffer = new TraceZoneBuffer(threadId);
+    gs_buffers.push_back(buffer);
+    gs_threadBuffer = buffer;
+
+    return buffer;
+}
+
+// Return the zone name, which is supposed to be in UTF-8, quoted and escaped
+// as a JSON string.
+wxString QuoteName(const char* name)
+{
+    std::string quoted(1, '"');
+    for ( const char* p = name; *p; p++ )
+    {
+        const unsigned char ch = static_cast<unsigned char>(*p);
+        if ( ch == '"' || ch == '\\' )
+        {
+            quoted += '\\';
+            quoted += *p;
+        }
+        else if ( ch < 0x20 )
+        {
+            static const char hexDigits[] = "0123456789abcdef";
+
+            quoted += "\\u00";
+            quoted += hexDigits[ch >> 4];
+            quoted += hexDigits[ch & 0xf];
+        }
+        else
+        {
+            quoted += *p;
+        }
+    }
+
+    quoted += '"';
+
+    return wxString::FromUTF8(quoted);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// wxTraceZone implementation
+// ============================================================================
+
+std::atomic<bool> wxTraceZone::ms_enabled{false};
+
+/* static */
+void wxTraceZone::Enable(bool enable)
+{
+    ms_enabled.store(enable, std::memory_order_relaxed);
+}
+
+/* static */
+wxInt64 wxTraceZone::GetTimestamp()
+{
+    using namespace std::chrono;
+
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/* static */
+void wxTraceZone::Record(const char* name, wxInt64 start)
+{
+    const wxInt64 end = GetTimestamp();
+
+    TraceZoneBuffer* buffer = gs_threadBuffer;
+    if ( !buffer )
+    {
+        buffer = AcquireThreadBuffer();
+        if ( !buffer )
+            return;
+    }
+
+    buffer->Add(name, start, end);
+}
+
+/* static */
+wxString wxTraceZone::GetChromeTrace()
+{
+    const unsigned long pid = wxGetProcessId();
+
+    // Chrome uses microseconds for the timestamps, but allows fractional
+    // values, so use them to preserve the full precision.
+    const auto toMicro = [](wxInt64 ns) { return wxString::FromCDouble(ns / 1000., 3); };
+
+    wxString trace = "{\"traceEvents\":[";
+
+    bool first = true;
+
+    wxCRIT_SECT_LOCKER(lock, gs_buffersLock);
+    for ( const TraceZoneBuffer* buffer : gs_buffers )
+    {
+        buffer->ForEach([&](const TraceZoneData& data, unsigned long threadId)
+            {
+                if ( first )
+                    first = false;
+                else
+                    trace += ',';
+
+                trace << "\n{\"name\":" << QuoteName(data.name)
+                      << ",\"ph\":\"X\",\"ts\":" << toMicro(data.start)
+                      << ",\"dur\":" << toMicro(data.end - data.start)
+                      << ",\"pid\":" << pid
+                      << ",\"tid\":" << threadId << '}';
+            });
+    }
+
+    trace += "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    return trace;
+}
+
+/* static */
+bool wxTraceZone::SaveChromeTrace(const wxString& filename)
+{
+    wxFFile file(filename, "w");
+
+    return file.IsOpened() && file.Write(GetChromeTrace(), wxConvUTF8);
+}
+
+/* static */
+void wxTraceZone::Clear()
+{
+    wxCRIT_SECT_LOCKER(lock, gs_buffersLock);
+    for ( TraceZoneBuffer* buffer : gs_buffers )
+        buffer->Clear();
+}
@@ -284,6 +284,15 @@ wxSize TreeSizer::DoGetSizeOf(wxTreeItemId id, int depth) const
         if ( childSize.x > size.x )
             size.x = childSize.x;
         size.y += childSize.y;
+
+        // Virtual children all have the same height and there can be a lot of
+        // them, so don't create all of them just to measure them.
+        if ( treeCtrl->GetVirtualItemIndex(item) != wxNOT_FOUND )
+        {
+            const size_t count = treeCtrl->GetChildrenCount(id, false);
+            size.y += childSize.y * static_cast<int>(count - 1);
+            break;
+        }
     }
 
     return size;
@@ -368,6 +377,10 @@ void wxTreeCtrlBase::ExpandAllChildren(const wxTreeItemId& item)
           idCurr.IsOk();
           idCurr = GetNextChild(item, cookie) )
     {
+        // virtual items never have any children, no need to create them all
+        if ( GetVirtualItemIndex(idCurr) != wxNOT_FOUND )
+            break;
+
         ExpandAllChildren(idCurr);
     }
     Thaw();
@@ -390,6 +403,9 @@ void wxTreeCtrlBase::CollapseAllChildren(const wxTreeItemId& item)
           idCurr.IsOk();
           idCurr = GetNextChild(item, cookie) )
     {
+        if ( GetVirtualItemIndex(idCurr) != wxNOT_FOUND )
+            break;
+
         CollapseAllChildren(idCurr);
     }
 
@@ -400,6 +416,17 @@ void wxTreeCtrlBase::CollapseAllChildren(const wxTreeItemId& item)
     Thaw();
 }
 
+wxString
+wxTreeCtrlBase::OnGetVirtualItemText(const wxTreeItemId& WXUNUSED(parent),
+                                     size_t WXUNUSED(index)) const
+{
+    // this is a pure virtual function, in fact - which is not really pure
+    // because the controls without virtual items don't need to implement it
+    wxFAIL_MSG("wxTreeCtrl::OnGetVirtualItemText not supposed to be called");
+
+    return wxEmptyString;
+}
+
 bool wxTreeCtrlBase::IsEmpty() const
 {
     return !GetRootItem().IsOk();
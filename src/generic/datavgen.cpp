@@ -46,6 +46,7 @@
 #include "wx/dnd.h"
 #include "wx/selstore.h"
 #include "wx/stopwatch.h"
+#include "wx/thread.h"
 #include "wx/weakref.h"
 #include "wx/generic/private/markuptext.h"
 #include "wx/generic/private/rowheightcache.h"
@@ -54,6 +55,16 @@
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 // classes
 //-----------------------------------------------------------------------------
@@ -175,6 +186,21 @@ wxTextCtrl *CreateEditorTextCtrl(wxWindow *parent, const wxRect& labelRect, cons
     return ctrl;
 }
 
+// Return true if the renderer is exactly of the given type and not of a class
+// deriving from it, which could override SetValue() and so must be always
+// given the value by calling it.
+template <typename T>
+bool IsRendererOfExactType(const T& renderer)
+{
+#ifndef wxNO_RTTI
+    return typeid(renderer) == typeid(T);
+#else
+    // We can't check it, so assume the worst.
+    wxUnusedVar(renderer);
+    return false;
+#endif
+}
+
 } // anonymous namespace
 
 //-----------------------------------------------------------------------------
@@ -481,6 +507,14 @@ public:
 
 class wxDataViewMainWindow;
 class wxDataViewTreeNode;
+#if wxUSE_THREADS
+class wxDataViewBackgroundSort;
+#endif // wxUSE_THREADS
+
+namespace
+{
+class wxDataViewNodeSortKeysBase;
+} // anonymous namespace
 
 typedef wxVector<wxDataViewTreeNode*> wxDataViewTreeNodes;
 
@@ -539,6 +573,18 @@ public:
         m_branchData->RemoveChild(index);
     }
 
+    // Replace the child nodes with the given ones, which must include all the
+    // existing children. The new children are considered to be unsorted, as
+    // when using InsertChild() without any sort order.
+    void SetChildNodes(wxDataViewTreeNodes& nodes)
+    {
+        if ( !m_branchData )
+            m_branchData = new BranchNodeData;
+
+        m_branchData->children.swap(nodes);
+        m_branchData->sortOrder = SortOrder();
+    }
+
     // returns position of child node for given item in children list or wxNOT_FOUND
     int FindChildByItem(const wxDataViewItem& item) const
     {
@@ -650,6 +696,17 @@ public:
 
     void Resort(wxDataViewMainWindow* window);
 
+    // Return the order in which the children are currently sorted.
+    SortOrder GetChildrenSortOrder() const
+    {
+        return m_branchData ? m_branchData->sortOrder : SortOrder();
+    }
+
+    // Reorder the children using the keys sorted in the given order, which
+    // must have been extracted from them.
+    void ReorderChildren(const wxDataViewNodeSortKeysBase& keys,
+                         const SortOrder& sortOrder);
+
     // Should be called after changing the item value to update its position in
     // the control if necessary.
     void PutInSortOrder(wxDataViewMainWindow* window)
@@ -733,6 +790,7 @@ public:
 
     // notifications from wxDataViewModel
     bool ItemAdded( const wxDataViewItem &parent, const wxDataViewItem &item );
+    bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items );
     bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item );
     bool ItemChanged( const wxDataViewItem &item )
     {
@@ -742,6 +800,10 @@ public:
     bool Cleared();
     void Resort()
     {
+        // The new sort order replaces the one being applied in the
+        // background, if any.
+        StopBackgroundSorting();
+
         ClearRowHeightCache();
 
         if (!IsVirtualList())
@@ -756,6 +818,24 @@ public:
             m_rowHeightCache->Clear();
     }
 
+    // Background sorting support, see wxDataViewCtrl::SetBackgroundSortingThreshold().
+    void SetBackgroundSortingThreshold(unsigned int minItems)
+        { m_backgroundSortingThreshold = minItems; }
+    bool IsSortingInBackground() const;
+    void CancelBackgroundSorting();
+
+    // Start sorting the children of the given node using the given keys in
+    // a background thread and return true, taking ownership of the keys, or
+    // return false if they should be sorted synchronously.
+    bool StartBackgroundSorting(wxDataViewTreeNode* node,
+                                std::unique_ptr<wxDataViewNodeSortKeysBase>& keys,
+                                const SortOrder& sortOrder);
+
+    // Called in the main thread by the background sorting thread with the
+    // given ID.
+    void OnBackgroundSortingProgress(unsigned int id, int percent);
+    void OnBackgroundSortingDone(unsigned int id);
+
     SortOrder GetSortOrder() const
     {
         wxDataViewColumn* const col = GetOwner()->GetSortingColumn();
@@ -1027,6 +1107,19 @@ private:
     // Helper of public Expand(), must be called with a valid node.
     void DoExpand(wxDataViewTreeNode* node, unsigned int row, bool expandChildren);
 
+    // Stop sorting in the background, if we're doing it, leaving the items
+    // in their current order.
+    void StopBackgroundSorting();
+
+    // Wait until sorting in the background, if we're doing it, completes and
+    // reorder the items. Must be called before changing the items.
+    void FinishBackgroundSorting();
+
+    // Send wxEVT_DATAVIEW_SORTING_PROGRESS and return false if it was vetoed.
+    bool SendSortingProgressEvent(int percent);
+
+    void SendSortingDoneEvent() { SendSortingProgressEvent(100); }
+
 private:
     wxDataViewCtrl             *m_owner;
     int                         m_lineHeight;
@@ -1044,6 +1137,10 @@ private:
     bool                        m_currentColSetByKeyboard;
     HeightCache                *m_rowHeightCache;
 
+    // set if the heights of some rows computed since the last call to
+    // RecalculateDisplay() are different from the default row height
+    mutable bool                m_rowHeightsChanged;
+
 #if wxUSE_DRAG_AND_DROP
     int                         m_dragCount;
     wxPoint                     m_dragStart;
@@ -1075,6 +1172,18 @@ private:
     // Id m_editorCtrl is non-null, pointer to the associated renderer.
     wxDataViewRenderer* m_editorRenderer;
 
+    // Minimal number of items to sort in the background or 0.
+    unsigned int m_backgroundSortingThreshold;
+
+#if wxUSE_THREADS
+    // The thread sorting the items in the background or null.
+    std::unique_ptr<wxDataViewBackgroundSort> m_backgroundSort;
+
+    // The ID of the last thread created, used to ignore the notifications
+    // from the previous ones.
+    unsigned int m_lastBackgroundSortId;
+#endif // wxUSE_THREADS
+
 private:
     wxDECLARE_DYNAMIC_CLASS(wxDataViewMainWindow);
     wxDECLARE_EVENT_TABLE();
@@ -1092,6 +1201,8 @@ public:
 
     virtual bool ItemAdded( const wxDataViewItem & parent, const wxDataViewItem & item ) override
         { return m_mainWindow->ItemAdded( parent , item ); }
+    virtual bool ItemsAdded( const wxDataViewItem & parent, const wxDataViewItemArray & items ) override
+        { return m_mainWindow->ItemsAdded( parent, items ); }
     virtual bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item ) override
         { return m_mainWindow->ItemDeleted( parent, item ); }
     virtual bool ItemChanged( const wxDataViewItem & item ) override
@@ -1257,6 +1368,26 @@ bool wxDataViewTextRenderer::GetValue( wxVariant& WXUNUSED(value) ) const
     return false;
 }
 
+bool wxDataViewTextRenderer::SetValueFromModel(const wxDataViewModel* model,
+                                               const wxDataViewItem& item,
+                                               unsigned column)
+{
+    // Values of other types need to be converted to string by wxVariant and
+    // derived classes may need to get the value in their SetValue().
+    if ( m_variantType != GetDefaultType() || !IsRendererOfExactType(*this) )
+        return false;
+
+    if ( !model->GetValueAsString(m_text, item, column) )
+        return false;
+
+#if wxUSE_MARKUP
+    if ( m_markupText )
+        m_markupText->SetMarkup(m_text);
+#endif // wxUSE_MARKUP
+
+    return true;
+}
+
 #if wxUSE_ACCESSIBILITY
 wxString wxDataViewTextRenderer::GetAccessibleDescription() const
 {
@@ -1522,6 +1653,22 @@ bool wxDataViewProgressRenderer::GetValue( wxVariant &value ) const
     return true;
 }
 
+bool wxDataViewProgressRenderer::SetValueFromModel(const wxDataViewModel* model,
+                                                   const wxDataViewItem& item,
+                                                   unsigned column)
+{
+    if ( m_variantType != GetDefaultType() || !IsRendererOfExactType(*this) )
+        return false;
+
+    long value;
+    if ( !model->GetValueAsLong(value, item, column) )
+        return false;
+
+    m_value = static_cast<int>(wxClip(value, 0, 100));
+
+    return true;
+}
+
 #if wxUSE_ACCESSIBILITY
 wxString wxDataViewProgressRenderer::GetAccessibleDescription() const
 {
@@ -1587,6 +1734,16 @@ bool wxDataViewIconTextRenderer::GetValue( wxVariant& WXUNUSED(value) ) const
     return false;
 }
 
+bool wxDataViewIconTextRenderer::SetValueFromModel(const wxDataViewModel* model,
+                                                   const wxDataViewItem& item,
+                                                   unsigned column)
+{
+    if ( m_variantType != GetDefaultType() || !IsRendererOfExactType(*this) )
+        return false;
+
+    return model->GetValueAsIconText(m_value, item, column);
+}
+
 #if wxUSE_ACCESSIBILITY
 wxString wxDataViewIconTextRenderer::GetAccessibleDescription() const
 {
@@ -1858,8 +2015,352 @@ private:
     const SortOrder m_sortOrder;
 };
 
+// Keys extracted from the values of the nodes to sort them.
+//
+// Sorting the keys doesn't access either the nodes or the model, so it can
+// be done in a background thread.
+class wxDataViewNodeSortKeysBase
+{
+public:
+    // The function called with the sorting progress, in percents, which can
+    // return false to stop sorting.
+    typedef std::function<bool (int)> ProgressFunc;
+
+    virtual ~wxDataViewNodeSortKeysBase() = default;
+
+    // Sort the keys, calling the given function, if it is not empty, to
+    // report the progress. Returns false if sorting was stopped by it.
+    virtual bool Sort(const ProgressFunc& progress) = 0;
+
+    // Reorder the nodes the keys were extracted from, in the same order, as
+    // determined by Sort().
+    void Apply(wxDataViewTreeNodes& nodes) const
+    {
+        wxCHECK_RET( nodes.size() == m_indices.size(),
+                     "nodes must not change while sorting" );
+
+        wxDataViewTreeNodes sorted;
+        sorted.reserve(nodes.size());
+        for ( size_t n : m_indices )
+            sorted.push_back(nodes[n]);
+
+        nodes.swap(sorted);
+    }
+
+protected:
+    // Indices of the keys in the sorted order.
+    std::vector<size_t> m_indices;
+};
+
+template <typename T>
+class wxDataViewNodeSortKeys : public wxDataViewNodeSortKeysBase
+{
+public:
+    wxDataViewNodeSortKeys(size_t count, bool ascending)
+        : m_ascending(ascending)
+    {
+        m_keys.reserve(count);
+        m_ids.reserve(count);
+    }
+
+    void Add(const T& key, const wxDataViewItem& item)
+    {
+        m_keys.push_back(key);
+        m_ids.push_back(wxPtrToUInt(item.GetID()));
+    }
+
+    virtual bool Sort(const ProgressFunc& progress) override
+    {
+        const size_t count = m_keys.size();
+
+        m_indices.resize(count);
+        std::iota(m_indices.begin(), m_indices.end(), 0);
+
+        // The nodes with equal keys are ordered by their item IDs, as done by
+        // the default wxDataViewModel::Compare().
+        const auto less = [this](size_t n1, size_t n2)
+        {
+            if ( !m_ascending )
+                std::swap(n1, n2);
+
+            if ( m_keys[n1] < m_keys[n2] )
+                return true;
+            if ( m_keys[n2] < m_keys[n1] )
+                return false;
+
+            return m_ids[n1] < m_ids[n2];
+        };
+
+        const auto begin = m_indices.begin();
+        if ( !progress || !count )
+        {
+            std::sort(begin, m_indices.end(), less);
+            return true;
+        }
+
+        // Sort the indices in chunks which are then merged together, to be
+        // able to report the progress and stop after each of these steps.
+        const size_t chunkSize = wxMax(count / 16, size_t(4096));
+        const size_t numChunks = (count + chunkSize - 1) / chunkSize;
+
+        // Merging the chunks takes one step less than their number.
+        const size_t numSteps = 2*numChunks - 1;
+        size_t step = 0;
+        const auto doneStep = [&]()
+        {
+            return progress(static_cast<int>(++step * 100 / numSteps));
+        };
+
+        for ( size_t start = 0; start < count; start += chunkSize )
+        {
+            std::sort(begin + start, begin + wxMin(start + chunkSize, count),
+                      less);
+            if ( !doneStep() )
+                return false;
+        }
+
+        for ( size_t width = chunkSize; width < count; width *= 2 )
+        {
+            for ( size_t start = 0; start + width < count; start += 2*width )
+            {
+                std::inplace_merge(begin + start,
+                                   begin + start + width,
+                                   begin + wxMin(start + 2*width, count),
+                                   less);
+                if ( !doneStep() )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    std::vector<T> m_keys;
+    std::vector<wxUIntPtr> m_ids;
+    const bool m_ascending;
+};
+
+// Extracts the keys for sorting the nodes by the values in the given column,
+// using the same order as the default wxDataViewModel::Compare()
+// implementation, but retrieving each value only once instead of doing it for
+// every comparison.
+class wxDataViewNodesByValueSorter
+{
+public:
+    wxDataViewNodesByValueSorter(const wxDataViewModel* model,
+                                 const wxDataViewTreeNodes& nodes,
+                                 const SortOrder& sortOrder)
+        : m_model(model),
+          m_nodes(nodes),
+          m_column(sortOrder.GetColumn()),
+          m_ascending(sortOrder.IsAscending())
+    {
+    }
+
+    // Returns null if the values are not all of the same type supported here.
+    std::unique_ptr<wxDataViewNodeSortKeysBase> ExtractKeys()
+    {
+        if ( m_nodes.empty() || !GetValue(0) )
+            return nullptr;
+
+        if ( m_type == wxS("string") )
+            return ExtractUsing<wxString>(GetString);
+        if ( m_type == wxS("long") )
+            return ExtractUsing<long>(GetLong);
+        if ( m_type == wxS("double") )
+            return ExtractUsing<double>(GetDouble);
+#if wxUSE_DATETIME
+        if ( m_type == wxS("datetime") )
+            return ExtractUsing<wxLongLong>(GetDateTime);
+#endif // wxUSE_DATETIME
+        if ( m_type == wxS("bool") )
+            return ExtractUsing<bool>(GetBool);
+        if ( m_type == wxS("wxDataViewIconText") )
+            return ExtractUsing<wxString>(GetIconText);
+
+        return nullptr;
+    }
+
+private:
+    static wxString GetString(const wxVariant& v) { return v.GetString(); }
+    static long GetLong(const wxVariant& v) { return v.GetLong(); }
+    static double GetDouble(const wxVariant& v) { return v.GetDouble(); }
+#if wxUSE_DATETIME
+    static wxLongLong GetDateTime(const wxVariant& v)
+    {
+        return v.GetDateTime().GetValue();
+    }
+#endif // wxUSE_DATETIME
+    static bool GetBool(const wxVariant& v) { return v.GetBool(); }
+    static wxString GetIconText(const wxVariant& v)
+    {
+        wxDataViewIconText iconText;
+        iconText << v;
+        return iconText.GetText();
+    }
+
+    // Retrieve the value of the given node into m_value and return true if
+    // it's of the expected type.
+    bool GetValue(size_t n)
+    {
+        const wxDataViewItem& item = m_nodes[n]->GetItem();
+        if ( !m_model->HasValue(item, m_column) )
+            return false;
+
+        m_model->GetValue(m_value, item, m_column);
+        if ( n == 0 )
+            m_type = m_value.GetType();
+        else if ( m_value.GetType() != m_type )
+            return false;
+
+        return true;
+    }
+
+    // Extract the keys from all values. The value of the first node must
+    // have been already retrieved.
+    template <typename T>
+    std::unique_ptr<wxDataViewNodeSortKeysBase>
+    ExtractUsing(T (*getKey)(const wxVariant&))
+    {
+        const size_t count = m_nodes.size();
+
+        wxDataViewNodeSortKeys<T>* const
+            keys = new wxDataViewNodeSortKeys<T>(count, m_ascending);
+        std::unique_ptr<wxDataViewNodeSortKeysBase> ptr(keys);
+
+        keys->Add(getKey(m_value), m_nodes[0]->GetItem());
+        for ( size_t n = 1; n < count; n++ )
+        {
+            if ( !GetValue(n) )
+                return nullptr;
+
+            keys->Add(getKey(m_value), m_nodes[n]->GetItem());
+        }
+
+        return ptr;
+    }
+
+    const wxDataViewModel* const m_model;
+    const wxDataViewTreeNodes& m_nodes;
+    const unsigned m_column;
+    const bool m_ascending;
+
+    wxString m_type;
+    wxVariant m_value;
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewNodesByValueSorter);
+};
+
 } // anonymous namespace
 
+#if wxUSE_THREADS
+
+// Thread sorting the keys extracted from the children of a node in the
+// background, see wxDataViewMainWindow::StartBackgroundSorting().
+class wxDataViewBackgroundSort : public wxThread
+{
+public:
+    wxDataViewBackgroundSort(wxDataViewMainWindow* window,
+                             unsigned int id,
+                             std::unique_ptr<wxDataViewNodeSortKeysBase> keys,
+                             const SortOrder& sortOrder)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_window(window),
+          m_id(id),
+          m_keys(std::move(keys)),
+          m_sortOrder(sortOrder),
+          m_stop(false),
+          m_done(false)
+    {
+    }
+
+    unsigned int GetId() const { return m_id; }
+    const SortOrder& GetSortOrder() const { return m_sortOrder; }
+
+    // Only used if the thread couldn't be started.
+    std::unique_ptr<wxDataViewNodeSortKeysBase> ReleaseKeys()
+    {
+        return std::move(m_keys);
+    }
+
+    // Stop the thread, if it's still running, and wait until it terminates.
+    void Stop()
+    {
+        m_stop = true;
+        Wait();
+    }
+
+    // Wait until the thread terminates, after sorting the keys in it if
+    // it's done, or sort them in the calling thread, and return them.
+    const wxDataViewNodeSortKeysBase& Complete()
+    {
+        Stop();
+
+        if ( !m_done )
+            m_keys->Sort(wxDataViewNodeSortKeysBase::ProgressFunc());
+
+        return *m_keys;
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        int lastPercent = 0;
+        const auto progress = [this, &lastPercent](int percent)
+        {
+            if ( m_stop )
+                return false;
+
+            // Don't notify about reaching 100% from here, this is done by
+            // the main window only after reordering the items.
+            if ( percent != lastPercent && percent < 100 )
+            {
+                lastPercent = percent;
+                m_window->CallAfter
+                          (
+                            &wxDataViewMainWindow::OnBackgroundSortingProgress,
+                            m_id,
+                            percent
+                          );
+            }
+
+            return true;
+        };
+
+        if ( m_keys->Sort(progress) )
+        {
+            m_done = true;
+            m_window->CallAfter(&wxDataViewMainWindow::OnBackgroundSortingDone,
+                                m_id);
+        }
+
+        return nullptr;
+    }
+
+private:
+    wxDataViewMainWindow* const m_window;
+    const unsigned int m_id;
+    std::unique_ptr<wxDataViewNodeSortKeysBase> m_keys;
+    const SortOrder m_sortOrder;
+
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_done;
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewBackgroundSort);
+};
+
+#endif // wxUSE_THREADS
+
+void wxDataViewTreeNode::ReorderChildren(const wxDataViewNodeSortKeysBase& keys,
+                                         const SortOrder& sortOrder)
+{
+    wxCHECK_RET( m_branchData, "leaf node doesn't have children" );
+
+    keys.Apply(m_branchData->children);
+    m_branchData->sortOrder = sortOrder;
+}
+
 void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
                                      wxDataViewTreeNode *node, unsigned index)
 {
@@ -1965,9 +2466,31 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            const wxDataViewModel* const model = window->GetModel();
+
+            std::unique_ptr<wxDataViewNodeSortKeysBase> keys;
+            if ( sortOrder.UsesColumn() &&
+                    model->CanSortByValues(sortOrder.GetColumn()) )
+            {
+                keys = wxDataViewNodesByValueSorter(model, nodes, sortOrder).
+                            ExtractKeys();
+            }
+
+            if ( keys )
+            {
+                // The nodes will be reordered later and, as this is only done
+                // for list models, there are no child nodes to sort either.
+                if ( window->StartBackgroundSorting(this, keys, sortOrder) )
+                    return;
+
+                keys->Sort(wxDataViewNodeSortKeysBase::ProgressFunc());
+                keys->Apply(nodes);
+            }
+            else
+            {
+                std::sort(nodes.begin(), nodes.end(),
+                          wxGenericTreeModelNodeCmp(window, sortOrder));
+            }
 
             m_branchData->sortOrder = sortOrder;
         }
@@ -2127,6 +2650,7 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
     {
         m_rowHeightCache = nullptr;
     }
+    m_rowHeightsChanged = false;
 
 #if wxUSE_DRAG_AND_DROP
     m_dragCount = 0;
@@ -2150,6 +2674,11 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
 
     m_root = wxDataViewTreeNode::CreateRootNode();
 
+    m_backgroundSortingThreshold = 0;
+#if wxUSE_THREADS
+    m_lastBackgroundSortId = 0;
+#endif // wxUSE_THREADS
+
     // Make m_count = -1 will cause the class recaculate the real displaying number of rows.
     m_count = -1;
     m_underMouse = nullptr;
@@ -3120,6 +3649,9 @@ Walker(wxDataViewTreeNode * node, DoJob & func, WalkFlags flags = Walk_All)
 
 bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxDataViewItem & item)
 {
+    // The items must be in their final order before changing them.
+    FinishBackgroundSorting();
+
     if (IsVirtualList())
     {
         wxDataViewVirtualListModel *list_model =
@@ -3233,9 +3765,176 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsAdded(const wxDataViewItem& parent,
+                                      const wxDataViewItemArray& items)
+{
+    // There is no need to do anything special for a single item.
+    if ( items.size() < 2 )
+        return items.empty() || ItemAdded(parent, items[0]);
+
+    // The items must be in their final order before changing them.
+    FinishBackgroundSorting();
+
+    // Rows of the new items, only needed if there is a selection to update.
+    std::vector<unsigned> rows;
+
+    if (IsVirtualList())
+    {
+        wxDataViewVirtualListModel *list_model =
+            (wxDataViewVirtualListModel*) GetModel();
+        m_count = list_model->GetCount();
+
+        if ( !m_selection.IsEmpty() )
+        {
+            rows.reserve(items.size());
+            for ( const wxDataViewItem& item : items )
+                rows.push_back(GetRowByItem(item));
+        }
+    }
+    else
+    {
+        ClearRowHeightCache();
+
+        // All the checks below are the same as in ItemAdded(), see the
+        // comments there.
+        const FindNodeResult findResult = FindNode(parent);
+        wxDataViewTreeNode *parentNode = findResult.m_node;
+
+        if ( !findResult.m_subtreeRealized )
+            return true;
+
+        if ( !parentNode )
+            return false;
+
+        if ( !parentNode->HasChildren() )
+        {
+            parentNode->SetHasChildren(true);
+            return true;
+        }
+
+        if ( !parentNode->IsOpen() && parentNode->GetChildNodes().empty() )
+            return true;
+
+        parentNode->SetHasChildren(true);
+
+        std::unordered_set<void*> added;
+        added.reserve(items.size());
+        for ( const wxDataViewItem& item : items )
+            added.insert(item.GetID());
+
+        int numAdded = 0;
+
+        if ( GetSortOrder().IsNone() )
+        {
+            // Instead of looking for the position of each new item among its
+            // siblings, which is linear in the number of siblings and so would
+            // make adding many items quadratic, rebuild the children list in
+            // the model order in a single pass.
+            wxDataViewItemArray modelSiblings;
+            GetModel()->GetChildren(parent, modelSiblings);
+
+            std::unordered_map<void*, wxDataViewTreeNode*> existing;
+            const wxDataViewTreeNodes& oldNodes = parentNode->GetChildNodes();
+            existing.reserve(oldNodes.size());
+            for ( wxDataViewTreeNode* node : oldNodes )
+                existing[node->GetItem().GetID()] = node;
+
+            wxDataViewTreeNodes nodes;
+            nodes.reserve(oldNodes.size() + items.size());
+            for ( const wxDataViewItem& item : modelSiblings )
+            {
+                const auto it = existing.find(item.GetID());
+                if ( it != existing.end() )
+                {
+                    nodes.push_back(it->second);
+                    existing.erase(it);
+                }
+                else if ( added.count(item.GetID()) )
+                {
+                    wxDataViewTreeNode *itemNode = new wxDataViewTreeNode(parentNode, item);
+                    itemNode->SetHasChildren(GetModel()->IsContainer(item));
+                    nodes.push_back(itemNode);
+                    numAdded++;
+                }
+            }
+
+            // The model should still have all the existing items, but don't
+            // lose the nodes if it doesn't.
+            if ( !existing.empty() )
+            {
+                wxFAIL_MSG( "existing items not found in the model" );
+
+                for ( wxDataViewTreeNode* node : oldNodes )
+                {
+                    if ( existing.count(node->GetItem().GetID()) )
+                        nodes.push_back(node);
+                }
+            }
+
+            parentNode->SetChildNodes(nodes);
+        }
+        else
+        {
+            // Each node is inserted in its sorted position.
+            for ( const wxDataViewItem& item : items )
+            {
+                wxDataViewTreeNode *itemNode = new wxDataViewTreeNode(parentNode, item);
+                itemNode->SetHasChildren(GetModel()->IsContainer(item));
+                parentNode->InsertChild(this, itemNode, 0);
+                numAdded++;
+            }
+        }
+
+        parentNode->ChangeSubTreeCount(+numAdded);
+
+        InvalidateCount();
+
+        if ( !m_selection.IsEmpty() )
+        {
+            // Calling GetRowByItem() for each new item would walk the tree
+            // every time, so compute the rows of all of them at once instead:
+            // the row of each child is the row of the previous one plus the
+            // number of the visible rows under it.
+            rows.reserve(numAdded);
+
+            int row = GetRowByItem(parent) + 1;
+            for ( const wxDataViewTreeNode* node : parentNode->GetChildNodes() )
+            {
+                if ( added.count(node->GetItem().GetID()) )
+                    rows.push_back(row);
+
+                row += node->GetSubTreeCount() + 1;
+            }
+        }
+    }
+
+    if ( m_selection.IsEmpty() )
+    {
+        // Positions of the new items don't matter if nothing is selected, so
+        // avoid computing them.
+        m_selection.OnItemsInserted(0, items.size());
+    }
+    else
+    {
+        // Inserting the items in increasing order of their final positions
+        // results in the correct selection.
+        std::sort(rows.begin(), rows.end());
+        for ( unsigned row : rows )
+            m_selection.OnItemsInserted(row, 1);
+    }
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
 bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
                                        const wxDataViewItem& item)
 {
+    // The items must be in their final order before changing them.
+    FinishBackgroundSorting();
+
     if (IsVirtualList())
     {
         wxDataViewVirtualListModel *list_model =
@@ -3358,6 +4057,9 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
 
 bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_column)
 {
+    // The items must be in their final order before changing them.
+    FinishBackgroundSorting();
+
     if ( !IsVirtualList() )
     {
         if ( m_rowHeightCache )
@@ -3443,7 +4145,7 @@ void wxDataViewMainWindow::OnInternalIdle()
 {
     wxWindow::OnInternalIdle();
 
-    if (m_dirty)
+    if (m_dirty || m_rowHeightsChanged)
     {
         RecalculateDisplay();
         m_dirty = false;
@@ -3460,7 +4162,12 @@ void wxDataViewMainWindow::RecalculateDisplay()
     }
 
     int width = GetEndOfLastCol();
+
+    // Note that this doesn't compute the heights of all rows when using
+    // variable line height, but uses the default height for the rows whose
+    // height is not known yet, so we need to do it again when it becomes known.
     int height = GetLineStart( GetRowCount() );
+    m_rowHeightsChanged = false;
 
     SetVirtualSize( width, height );
     GetOwner()->SetScrollRate( FromDIP(10), m_lineHeight );
@@ -3759,28 +4466,10 @@ int wxDataViewMainWindow::GetLineStart( unsigned int row ) const
     if ( !m_rowHeightCache || !GetOwner()->HasFlag(wxDV_VARIABLE_LINE_HEIGHT) )
         return row * m_lineHeight;
 
-    int start = 0;
-    if ( m_rowHeightCache->GetLineStart(row, start) )
-        return start;
-
-    unsigned int r;
-    for (r = 0; r < row; r++)
-    {
-        int height = 0;
-        if ( !m_rowHeightCache->GetLineHeight(r, height) )
-        {
-            // row height not in cache -> get it from the renderer...
-            wxDataViewItem item = GetItemByRow(r);
-            if (!item)
-                break;
-
-            height = QueryAndCacheLineHeight(r, item);
-        }
-
-        start += height;
-    }
-
-    return start;
+    // Don't compute the heights of all the preceding rows, which would be too
+    // slow for big models, but use the default height for the rows whose
+    // height is not known yet.
+    return m_rowHeightCache->GetEstimatedLineStart(row, m_lineHeight);
 }
 
 int wxDataViewMainWindow::GetLineAt( unsigned int y ) const
@@ -3789,50 +4478,27 @@ int wxDataViewMainWindow::GetLineAt( unsigned int y ) const
     if ( !m_rowHeightCache || !GetOwner()->HasFlag(wxDV_VARIABLE_LINE_HEIGHT) )
         return y / m_lineHeight;
 
-    unsigned int row = 0;
-    if ( m_rowHeightCache->GetLineAt(y, row) )
-        return row;
-
-    // OnPaint asks GetLineAt for the very last y position and this is always
-    // below the last item (--> an invalid item). To prevent iterating over all
-    // items, check if y is below the last row.
-    // Because this is done very often (for each repaint) its worth to handle
-    // this special case separately.
-    int height = 0;
-    int start = 0;
-    unsigned int rowCount = GetRowCount();
-    if (rowCount == 0 ||
-        (m_rowHeightCache->GetLineInfo(rowCount - 1, start, height) &&
-         y >= static_cast<unsigned int>(start + height)))
-    {
-        return rowCount;
-    }
+    const unsigned int rowCount = GetRowCount();
 
-    // sum all item heights until y is reached
-    unsigned int yy = 0;
-    for (;;)
+    // Find the row at this position using the known heights and the default
+    // height for the other rows. If the height of the row found is not known
+    // yet, compute it and search again, as the row at this position may have
+    // changed if it's different from the default one.
+    for ( ;; )
     {
-        height = 0;
-        if ( !m_rowHeightCache->GetLineHeight(row, height) )
-        {
-            // row height not in cache -> get it from the renderer...
-            wxDataViewItem item = GetItemByRow(row);
-            if ( !item )
-            {
-                wxASSERT(row >= GetRowCount());
-                break;
-            }
+        const unsigned int row =
+            m_rowHeightCache->GetEstimatedLineAt(y, rowCount, m_lineHeight);
 
-            height = QueryAndCacheLineHeight(row, item);
-        }
+        int height;
+        if ( row == rowCount || m_rowHeightCache->GetLineHeight(row, height) )
+            return row;
 
-        yy += height;
-        if (y < yy)
-            break;
+        const wxDataViewItem item = GetItemByRow(row);
+        if ( !item )
+            return row;
 
-        row++;
+        QueryAndCacheLineHeight(row, item);
     }
-    return row;
 }
 
 int wxDataViewMainWindow::GetLineHeight( unsigned int row ) const
@@ -3877,6 +4543,11 @@ int wxDataViewMainWindow::QueryAndCacheLineHeight(unsigned int row, wxDataViewIt
     // ... and store the height in the cache
     m_rowHeightCache->Put(row, height);
 
+    // The total height estimated using the default height for this row needs
+    // to be updated.
+    if ( height != m_lineHeight )
+        m_rowHeightsChanged = true;
+
     return height;
 }
 
@@ -4483,6 +5154,8 @@ void wxDataViewMainWindow::BuildTree(wxDataViewModel * model)
 
 void wxDataViewMainWindow::DestroyTree()
 {
+    StopBackgroundSorting();
+
     if (!IsVirtualList())
     {
         wxDELETE(m_root);
@@ -4490,6 +5163,143 @@ void wxDataViewMainWindow::DestroyTree()
     }
 }
 
+bool wxDataViewMainWindow::IsSortingInBackground() const
+{
+#if wxUSE_THREADS
+    return m_backgroundSort != nullptr;
+#else // !wxUSE_THREADS
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+bool
+wxDataViewMainWindow::StartBackgroundSorting(wxDataViewTreeNode* node,
+                                             std::unique_ptr<wxDataViewNodeSortKeysBase>& keys,
+                                             const SortOrder& sortOrder)
+{
+#if wxUSE_THREADS
+    // Only the top level items of list models are sorted in the background,
+    // as sorting the children of the tree nodes would change the rows of the
+    // items following them too.
+    if ( !m_backgroundSortingThreshold || node != m_root || !IsList() ||
+            node->GetChildNodes().size() < m_backgroundSortingThreshold )
+        return false;
+
+    // Resort() must have stopped the previous thread, if any.
+    wxASSERT( !m_backgroundSort );
+
+    std::unique_ptr<wxDataViewBackgroundSort>
+        sort(new wxDataViewBackgroundSort(this, ++m_lastBackgroundSortId,
+                                          std::move(keys), sortOrder));
+    if ( sort->Run() != wxTHREAD_NO_ERROR )
+    {
+        // Not a fatal problem, we just sort them synchronously.
+        keys = sort->ReleaseKeys();
+        return false;
+    }
+
+    m_backgroundSort = std::move(sort);
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(node);
+    wxUnusedVar(keys);
+    wxUnusedVar(sortOrder);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+void wxDataViewMainWindow::StopBackgroundSorting()
+{
+#if wxUSE_THREADS
+    if ( m_backgroundSort )
+    {
+        m_backgroundSort->Stop();
+        m_backgroundSort.reset();
+    }
+#endif // wxUSE_THREADS
+}
+
+void wxDataViewMainWindow::FinishBackgroundSorting()
+{
+#if wxUSE_THREADS
+    if ( !m_backgroundSort )
+        return;
+
+    std::unique_ptr<wxDataViewBackgroundSort> sort(std::move(m_backgroundSort));
+    m_root->ReorderChildren(sort->Complete(), sort->GetSortOrder());
+
+    ClearRowHeightCache();
+    UpdateDisplay();
+
+    // Don't send the event from here as we may be called from a model
+    // notification handler and changing the model from the event handler
+    // would be unexpected.
+    CallAfter(&wxDataViewMainWindow::SendSortingDoneEvent);
+#endif // wxUSE_THREADS
+}
+
+void wxDataViewMainWindow::CancelBackgroundSorting()
+{
+    if ( !IsSortingInBackground() )
+        return;
+
+    StopBackgroundSorting();
+
+    // The items remain in their previous order, so use the columns
+    // corresponding to it for sorting.
+    wxDataViewCtrl* const owner = GetOwner();
+    owner->ResetAllSortColumns();
+
+    const SortOrder sortOrder = m_root->GetChildrenSortOrder();
+    if ( sortOrder.UsesColumn() )
+    {
+        const int idx = owner->GetModelColumnIndex(sortOrder.GetColumn());
+        if ( idx != wxNOT_FOUND )
+            owner->GetColumn(idx)->SetSortOrder(sortOrder.IsAscending());
+    }
+}
+
+void wxDataViewMainWindow::OnBackgroundSortingProgress(unsigned int id,
+                                                       int percent)
+{
+#if wxUSE_THREADS
+    // Ignore the notifications from the threads that were already stopped.
+    if ( !m_backgroundSort || m_backgroundSort->GetId() != id )
+        return;
+
+    if ( !SendSortingProgressEvent(percent) )
+        CancelBackgroundSorting();
+#else // !wxUSE_THREADS
+    wxUnusedVar(id);
+    wxUnusedVar(percent);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+void wxDataViewMainWindow::OnBackgroundSortingDone(unsigned int id)
+{
+#if wxUSE_THREADS
+    if ( !m_backgroundSort || m_backgroundSort->GetId() != id )
+        return;
+
+    FinishBackgroundSorting();
+#else // !wxUSE_THREADS
+    wxUnusedVar(id);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+bool wxDataViewMainWindow::SendSortingProgressEvent(int percent)
+{
+    wxDataViewEvent event(wxEVT_DATAVIEW_SORTING_PROGRESS, m_owner,
+                          m_owner->GetSortingColumn());
+    event.SetInt(percent);
+
+    m_owner->ProcessWindowEvent(event);
+
+    return event.IsAllowed();
+}
+
 wxDataViewColumn*
 wxDataViewMainWindow::FindColumnForEditing(const wxDataViewItem& item, wxDataViewCellMode mode) const
 {
@@ -6665,6 +7475,29 @@ void wxDataViewCtrl::ToggleSortByColumn(int column)
     m_headerArea->ToggleSortByColumn(column);
 }
 
+bool wxDataViewCtrl::SetBackgroundSortingThreshold(unsigned int minItems)
+{
+#if wxUSE_THREADS
+    m_clientArea->SetBackgroundSortingThreshold(minItems);
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(minItems);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+bool wxDataViewCtrl::IsSortingInBackground() const
+{
+    return m_clientArea->IsSortingInBackground();
+}
+
+void wxDataViewCtrl::CancelBackgroundSorting()
+{
+    m_clientArea->CancelBackgroundSorting();
+}
+
 void wxDataViewCtrl::DoEnableSystemTheme(bool enable, wxWindow* window)
 {
     typedef wxSystemThemedControl<wxControl> Base;
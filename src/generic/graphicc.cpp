@@ -1753,6 +1753,45 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
                                      const wxImage& image)
     : wxGraphicsBitmapData(renderer)
 {
+    // If the image uses interleaved RGBA data, use it directly instead of
+    // splitting it into RGB and alpha first. We don't bother doing it for the
+    // images with mask, which are not expected to have such data anyhow.
+    const unsigned char* const rgba = image.GetDataRGBA();
+    if ( rgba && !image.HasMask() )
+    {
+        const int stride = InitBuffer(image.GetWidth(), image.GetHeight(),
+                                      CAIRO_FORMAT_ARGB32);
+
+        if ( image.GetRGBAFormat() == wxIMAGE_ARGB32_PREMULTIPLIED )
+        {
+            // This is exactly the format used by Cairo, just copy it.
+            const size_t rowSize = 4*m_width;
+            for ( int y = 0; y < m_height; y++ )
+                memcpy(m_buffer + y*stride, rgba + y*rowSize, rowSize);
+        }
+        else // wxIMAGE_RGBA_STRAIGHT
+        {
+            const unsigned char* src = rgba;
+            for ( int y = 0; y < m_height; y++ )
+            {
+                wxUint32* dst = reinterpret_cast<wxUint32*>(m_buffer + y*stride);
+                for ( int x = 0; x < m_width; x++ )
+                {
+                    const unsigned char a = src[3];
+
+                    *dst++ = a                    << 24 |
+                             ((a * src[0]) / 255) << 16 |
+                             ((a * src[1]) / 255) <<  8 |
+                             ((a * src[2]) / 255);
+                    src += 4;
+                }
+            }
+        }
+
+        InitSurface(CAIRO_FORMAT_ARGB32, stride);
+        return;
+    }
+
     const cairo_format_t bufferFormat = image.HasAlpha() || image.HasMask()
                                             ? CAIRO_FORMAT_ARGB32
                                             : CAIRO_FORMAT_RGB24;
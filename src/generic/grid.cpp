@@ -56,6 +56,7 @@
 #include "wx/generic/gridctrl.h"
 #include "wx/generic/grideditors.h"
 #include "wx/generic/private/grid.h"
+#include "wx/generic/private/widthcalc.h"
 
 const char wxGridNameStr[] = "grid";
 
@@ -167,6 +168,27 @@ wxGrid::CellSpan GetCellSpan(int numRows, int numCols)
     return wxGrid::CellSpan_Main;
 }
 
+// Calculator of the maximal extent of the cells in a row or column using the
+// provided function to measure the cell at the given position.
+template <typename F>
+class wxGridMaxExtentCalculator : public wxMaxWidthCalculatorBase
+{
+public:
+    wxGridMaxExtentCalculator(int colOrRow, F measure)
+        : wxMaxWidthCalculatorBase(colOrRow),
+          m_measure(measure)
+    {
+    }
+
+    virtual void UpdateWithRow(int pos) override
+    {
+        UpdateWithWidth(m_measure(pos));
+    }
+
+private:
+    F m_measure;
+};
+
 } // anonymous namespace
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxGridCellEditorEvtHandler, wxEvtHandler);
@@ -979,6 +1001,17 @@ wxGridCellAttrData::~wxGridCellAttrData()
 
 void wxGridCellAttrData::SetAttr(wxGridCellAttr *attr, int row, int col)
 {
+    // Any attribute set for the block containing this cell is overridden by
+    // this one, or removed if it is null, as the cell attribute must be.
+    if ( !m_blockAttrs.IsEmpty() )
+    {
+        m_blockAttrs.Modify(row, row,
+            [col](wxGridRuns<wxGridCellAttrPtr>& cols)
+            {
+                cols.Set(col, col, wxGridCellAttrPtr());
+            });
+    }
+
     wxGridCoordsToAttrMap::iterator it = FindIndex(row, col);
     if ( it == m_attrs.end() )
     {
@@ -1003,6 +1036,61 @@ void wxGridCellAttrData::SetAttr(wxGridCellAttr *attr, int row, int col)
     }
 }
 
+void
+wxGridCellAttrData::SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block)
+{
+    const wxGridBlockCoords b = block.Canonicalize();
+
+    // The attributes of the individual cells inside the block must be
+    // removed, as they would override the block attribute otherwise. Find
+    // them either by checking all cells of the block or all the existing
+    // attributes, depending on which is faster.
+    const wxLongLong_t numCells =
+        static_cast<wxLongLong_t>(b.GetBottomRow() - b.GetTopRow() + 1) *
+            (b.GetRightCol() - b.GetLeftCol() + 1);
+    if ( numCells < static_cast<wxLongLong_t>(m_attrs.size()) )
+    {
+        for ( int row = b.GetTopRow(); row <= b.GetBottomRow(); row++ )
+        {
+            for ( int col = b.GetLeftCol(); col <= b.GetRightCol(); col++ )
+            {
+                wxGridCoordsToAttrMap::iterator it = FindIndex(row, col);
+                if ( it != m_attrs.end() )
+                {
+                    it->second->DecRef();
+                    m_attrs.erase(it);
+                }
+            }
+        }
+    }
+    else
+    {
+        for ( auto it = m_attrs.begin(); it != m_attrs.end(); )
+        {
+            int row, col;
+            KeyToCoords(it->first, &row, &col);
+            if ( b.Contains(wxGridCellCoords(row, col)) )
+            {
+                it->second->DecRef();
+                it = m_attrs.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Note that this takes ownership of the attribute.
+    const wxGridCellAttrPtr attrPtr(attr);
+
+    m_blockAttrs.Modify(b.GetTopRow(), b.GetBottomRow(),
+        [&b, &attrPtr](wxGridRuns<wxGridCellAttrPtr>& cols)
+        {
+            cols.Set(b.GetLeftCol(), b.GetRightCol(), attrPtr);
+        });
+}
+
 wxGridCellAttr *wxGridCellAttrData::GetAttr(int row, int col) const
 {
     wxGridCellAttr *attr = nullptr;
@@ -1011,8 +1099,18 @@ wxGridCellAttr *wxGridCellAttrData::GetAttr(int row, int col) const
     if ( it != m_attrs.end() )
     {
         attr = it->second;
-        attr->IncRef();
     }
+    else if ( !m_blockAttrs.IsEmpty() )
+    {
+        if ( const wxGridRuns<wxGridCellAttrPtr>* cols = m_blockAttrs.Find(row) )
+        {
+            if ( const wxGridCellAttrPtr* attrPtr = cols->Find(col) )
+                attr = attrPtr->get();
+        }
+    }
+
+    if ( attr )
+        attr->IncRef();
 
     return attr;
 }
@@ -1203,11 +1301,22 @@ void UpdateCellAttrRowsOrCols(wxGridCoordsToAttrMap& attrs, int editPos,
 void wxGridCellAttrData::UpdateAttrRows( size_t pos, int numRows )
 {
     UpdateCellAttrRowsOrCols(m_attrs, static_cast<int>(pos), numRows, 0);
+
+    m_blockAttrs.Update(static_cast<int>(pos), numRows);
 }
 
 void wxGridCellAttrData::UpdateAttrCols( size_t pos, int numCols )
 {
     UpdateCellAttrRowsOrCols(m_attrs, static_cast<int>(pos), 0, numCols);
+
+    if ( !m_blockAttrs.IsEmpty() )
+    {
+        m_blockAttrs.ModifyAll(
+            [pos, numCols](wxGridRuns<wxGridCellAttrPtr>& cols)
+            {
+                cols.Update(static_cast<int>(pos), numCols);
+            });
+    }
 }
 
 wxGridCoordsToAttrMap::iterator
@@ -1220,23 +1329,13 @@ wxGridCellAttrData::FindIndex(int row, int col) const
 // wxGridRowOrColAttrData
 // ----------------------------------------------------------------------------
 
-wxGridRowOrColAttrData::~wxGridRowOrColAttrData()
-{
-    size_t count = m_attrs.GetCount();
-    for ( size_t n = 0; n < count; n++ )
-    {
-        m_attrs[n]->DecRef();
-    }
-}
-
 wxGridCellAttr *wxGridRowOrColAttrData::GetAttr(int rowOrCol) const
 {
     wxGridCellAttr *attr = nullptr;
 
-    int n = m_rowsOrCols.Index(rowOrCol);
-    if ( n != wxNOT_FOUND )
+    if ( const wxGridCellAttrPtr* attrPtr = m_attrs.Find(rowOrCol) )
     {
-        attr = m_attrs[(size_t)n];
+        attr = attrPtr->get();
         attr->IncRef();
     }
 
@@ -1245,70 +1344,18 @@ wxGridCellAttr *wxGridRowOrColAttrData::GetAttr(int rowOrCol) const
 
 void wxGridRowOrColAttrData::SetAttr(wxGridCellAttr *attr, int rowOrCol)
 {
-    int i = m_rowsOrCols.Index(rowOrCol);
-    if ( i == wxNOT_FOUND )
-    {
-        if ( attr )
-        {
-            // store the new attribute, taking its ownership
-            m_rowsOrCols.Add(rowOrCol);
-            m_attrs.Add(attr);
-        }
-        // nothing to remove
-    }
-    else // we have an attribute for this row or column
-    {
-        size_t n = (size_t)i;
-
-        // notice that this code works correctly even when the old attribute is
-        // the same as the new one: as we own of it, we must call DecRef() on
-        // it in any case and this won't result in destruction of the new
-        // attribute if it's the same as old one because it must have ref count
-        // of at least 2 to be passed to us while we keep a reference to it too
-        m_attrs[n]->DecRef();
-
-        if ( attr )
-        {
-            // replace the attribute with the new one
-            m_attrs[n] = attr;
-        }
-        else // remove the attribute
-        {
-            m_rowsOrCols.RemoveAt(n);
-            m_attrs.RemoveAt(n);
-        }
-    }
+    // Note that this takes ownership of the attribute and that it works
+    // correctly even when the old attribute is the same as the new one: as
+    // we own it, we must call DecRef() on it in any case and this won't
+    // result in destruction of the new attribute if it's the same as old one
+    // because it must have ref count of at least 2 to be passed to us while
+    // we keep a reference to it too.
+    m_attrs.Set(rowOrCol, rowOrCol, wxGridCellAttrPtr(attr));
 }
 
 void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols )
 {
-    size_t count = m_attrs.GetCount();
-    for ( size_t n = 0; n < count; n++ )
-    {
-        int & rowOrCol = m_rowsOrCols[n];
-        if ( (size_t)rowOrCol >= pos )
-        {
-            if ( numRowsOrCols > 0 )
-            {
-                // If rows or cols inserted, increment row/col counter where necessary
-                rowOrCol += numRowsOrCols;
-            }
-            else if ( numRowsOrCols < 0)
-            {
-                // If rows/cols deleted, either decrement row/col counter (if row/col still exists)
-                if ((size_t)rowOrCol >= pos - numRowsOrCols)
-                    rowOrCol += numRowsOrCols;
-                else
-                {
-                    m_rowsOrCols.RemoveAt(n);
-                    m_attrs[n]->DecRef();
-                    m_attrs.RemoveAt(n);
-                    n--;
-                    count--;
-                }
-            }
-        }
-    }
+    m_attrs.Update(static_cast<int>(pos), numRowsOrCols);
 }
 
 // ----------------------------------------------------------------------------
@@ -1430,6 +1477,15 @@ void wxGridCellAttrProvider::SetAttr(wxGridCellAttr *attr,
     m_data->m_cellAttrs.SetAttr(attr, row, col);
 }
 
+void wxGridCellAttrProvider::SetAttr(wxGridCellAttr *attr,
+                                     const wxGridBlockCoords& block)
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_cellAttrs.SetAttr(attr, block);
+}
+
 void wxGridCellAttrProvider::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( !m_data )
@@ -1740,6 +1796,23 @@ void wxGridTableBase::SetAttr(wxGridCellAttr* attr, int row, int col)
     }
 }
 
+void wxGridTableBase::SetAttr(wxGridCellAttr* attr,
+                              const wxGridBlockCoords& block)
+{
+    if ( m_attrProvider )
+    {
+        if ( attr )
+            attr->SetKind(wxGridCellAttr::Cell);
+        m_attrProvider->SetAttr(attr, block);
+    }
+    else
+    {
+        // as we take ownership of the pointer and don't store it, we must
+        // free it now
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGridTableBase::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( m_attrProvider )
@@ -2863,6 +2936,11 @@ void wxGridWindow::OnFocus(wxFocusEvent& event)
 #define internalXToCol(x, gridWindowPtr) XToCol(x, true, gridWindowPtr)
 #define internalYToRow(y, gridWindowPtr) YToRow(y, true, gridWindowPtr)
 
+void wxGridLineEndsDeleter::operator()(wxGridLineEnds* ends) const
+{
+    delete ends;
+}
+
 /////////////////////////////////////////////////////////////////////
 
 wxBEGIN_EVENT_TABLE( wxGrid, wxScrolledCanvas )
@@ -3087,9 +3165,9 @@ wxGrid::SetTable(wxGridTableBase *table,
 
         // kill row and column size arrays
         m_colWidths.Empty();
-        m_colRights.Empty();
+        m_colEnds->Clear();
         m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        m_rowEnds->Clear();
     }
 
     if (table)
@@ -3185,6 +3263,9 @@ void wxGrid::Init()
     m_minAcceptableColWidth  =
     m_minAcceptableRowHeight = 0;
 
+    m_rowEnds.reset(new wxGridLineEnds);
+    m_colEnds.reset(new wxGridLineEnds);
+
     m_gridLinesEnabled = true;
     m_gridLinesClipHorz =
     m_gridLinesClipVert = true;
@@ -3259,35 +3340,35 @@ void wxGrid::Init()
 void wxGrid::InitRowHeights()
 {
     m_rowHeights.Empty();
-    m_rowBottoms.Empty();
 
     m_rowHeights.Alloc( m_numRows );
-    m_rowBottoms.Alloc( m_numRows );
 
     m_rowHeights.Add( m_defaultRowHeight, m_numRows );
 
-    for ( int i = 0; i < m_numRows; i++ )
-    {
-        int rowBottom = ( GetRowPos( i ) + 1 ) * m_defaultRowHeight;
-        m_rowBottoms.Add( rowBottom );
-    }
+    UpdateRowEnds();
+}
+
+void wxGrid::UpdateRowEnds()
+{
+    m_rowEnds->Init(m_numRows,
+                    [this](int rowPos) { return GetRowHeight(GetRowAt(rowPos)); });
 }
 
 void wxGrid::InitColWidths()
 {
     m_colWidths.Empty();
-    m_colRights.Empty();
 
     m_colWidths.Alloc( m_numCols );
-    m_colRights.Alloc( m_numCols );
 
     m_colWidths.Add( m_defaultColWidth, m_numCols );
 
-    for ( int i = 0; i < m_numCols; i++ )
-    {
-        int colRight = ( GetColPos( i ) + 1 ) * m_defaultColWidth;
-        m_colRights.Add( colRight );
-    }
+    UpdateColEnds();
+}
+
+void wxGrid::UpdateColEnds()
+{
+    m_colEnds->Init(m_numCols,
+                    [this](int colPos) { return GetColWidth(GetColAt(colPos)); });
 }
 
 int wxGrid::GetColWidth(int col) const
@@ -3301,16 +3382,16 @@ int wxGrid::GetColWidth(int col) const
 
 int wxGrid::GetColLeft(int col) const
 {
-    if ( m_colRights.IsEmpty() )
+    if ( m_colEnds->IsEmpty() )
         return GetColPos( col ) * m_defaultColWidth;
 
-    return m_colRights[col] - GetColWidth(col);
+    return m_colEnds->GetStart(GetColPos(col));
 }
 
 int wxGrid::GetColRight(int col) const
 {
-    return m_colRights.IsEmpty() ? (GetColPos( col ) + 1) * m_defaultColWidth
-                                 : m_colRights[col];
+    return m_colEnds->IsEmpty() ? (GetColPos( col ) + 1) * m_defaultColWidth
+                                : m_colEnds->GetEnd(GetColPos(col));
 }
 
 int wxGrid::GetRowHeight(int row) const
@@ -3325,16 +3406,16 @@ int wxGrid::GetRowHeight(int row) const
 
 int wxGrid::GetRowTop(int row) const
 {
-    if ( m_rowBottoms.IsEmpty() )
+    if ( m_rowEnds->IsEmpty() )
         return GetRowPos( row ) * m_defaultRowHeight;
 
-    return m_rowBottoms[row] - GetRowHeight(row);
+    return m_rowEnds->GetStart(GetRowPos(row));
 }
 
 int wxGrid::GetRowBottom(int row) const
 {
-    return m_rowBottoms.IsEmpty() ? (GetRowPos( row ) + 1) * m_defaultRowHeight
-                                  : m_rowBottoms[row];
+    return m_rowEnds->IsEmpty() ? (GetRowPos( row ) + 1) * m_defaultRowHeight
+                                : m_rowEnds->GetEnd(GetRowPos(row));
 }
 
 void wxGrid::CalcDimensions()
@@ -3505,20 +3586,8 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.Insert( m_defaultRowHeight, pos, numRows );
-                m_rowBottoms.Insert( 0, pos, numRows );
-
-                int bottom = 0;
-                if ( pos > 0 )
-                    bottom = m_rowBottoms[GetRowAt( pos - 1 )];
-
-                int rowPos;
-                for ( rowPos = pos; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
 
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
+                UpdateRowEnds();
             }
 
             UpdateCurrentCellOnRedim();
@@ -3559,20 +3628,8 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.Add( m_defaultRowHeight, numRows );
-                m_rowBottoms.Add( 0, numRows );
 
-                int bottom = 0;
-                if ( oldNumRows > 0 )
-                    bottom = m_rowBottoms[oldNumRows - 1];
-
-                int rowPos;
-                for ( rowPos = oldNumRows; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
-
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
+                UpdateRowEnds();
             }
 
             UpdateCurrentCellOnRedim();
@@ -3612,17 +3669,8 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.RemoveAt( pos, numRows );
-                m_rowBottoms.RemoveAt( pos, numRows );
-
-                int h = 0;
-                int rowPos;
-                for ( rowPos = 0; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
 
-                    h += GetRowHeight(i);
-                    m_rowBottoms[i] = h;
-                }
+                UpdateRowEnds();
             }
 
             UpdateCurrentCellOnRedim();
@@ -3684,20 +3732,8 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.Insert( m_defaultColWidth, pos, numCols );
-                m_colRights.Insert( 0, pos, numCols );
-
-                int right = 0;
-                if ( pos > 0 )
-                    right = m_colRights[GetColAt( pos - 1 )];
 
-                int colPos;
-                for ( colPos = pos; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    right += GetColWidth(i);
-                    m_colRights[i] = right;
-                }
+                UpdateColEnds();
             }
 
             // See comment for wxGRIDTABLE_NOTIFY_COLS_APPENDED case explaining
@@ -3743,20 +3779,8 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.Add( m_defaultColWidth, numCols );
-                m_colRights.Add( 0, numCols );
 
-                int right = 0;
-                if ( oldNumCols > 0 )
-                    right = m_colRights[GetColAt( oldNumCols - 1 )];
-
-                int colPos;
-                for ( colPos = oldNumCols; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    right += GetColWidth(i);
-                    m_colRights[i] = right;
-                }
+                UpdateColEnds();
             }
 
             // Notice that this must be called after updating m_colWidths above
@@ -3802,17 +3826,8 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.RemoveAt( pos, numCols );
-                m_colRights.RemoveAt( pos, numCols );
-
-                int w = 0;
-                int colPos;
-                for ( colPos = 0; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
 
-                    w += GetColWidth(i);
-                    m_colRights[i] = w;
-                }
+                UpdateColEnds();
             }
 
             // See comment for wxGRIDTABLE_NOTIFY_COLS_APPENDED case explaining
@@ -5431,20 +5446,7 @@ void wxGrid::RefreshAfterRowPosChange()
     // unless we calculate them dynamically because all rows heights are the
     // same and it's easy to do
     if ( !m_rowHeights.empty() )
-    {
-        int rowBottom = 0;
-        for ( int rowPos = 0; rowPos < m_numRows; rowPos++ )
-        {
-            int rowID = GetRowAt( rowPos );
-
-            // Ignore the currently hidden rows.
-            const int height = m_rowHeights[rowID];
-            if ( height > 0 )
-                rowBottom += height;
-
-            m_rowBottoms[rowID] = rowBottom;
-        }
-    }
+        UpdateRowEnds();
 
     // and make the changes visible
     RefreshArea(wxGA_Cells | wxGA_RowLabels);
@@ -5532,20 +5534,7 @@ void wxGrid::RefreshAfterColPosChange()
     // unless we calculate them dynamically because all columns widths are the
     // same and it's easy to do
     if ( !m_colWidths.empty() )
-    {
-        int colRight = 0;
-        for ( int colPos = 0; colPos < m_numCols; colPos++ )
-        {
-            int colID = GetColAt( colPos );
-
-            // Ignore the currently hidden columns.
-            const int width = m_colWidths[colID];
-            if ( width > 0 )
-                colRight += width;
-
-            m_colRights[colID] = colRight;
-        }
-    }
+        UpdateColEnds();
 
     int areas = wxGA_Cells;
 
@@ -6076,6 +6065,114 @@ void wxGrid::RefreshBlock(const wxGridCellCoords& coords)
     }
 }
 
+namespace
+{
+
+// Maximal number of separate dirty blocks we keep: if there are more of them,
+// it's simpler and not much slower to just refresh a single block containing
+// all of them.
+const size_t MAX_DIRTY_BLOCKS = 64;
+
+// Return true if the union of the two blocks is a rectangle, i.e. if they
+// overlap or are adjacent and have the same rows or columns.
+bool CanMergeBlocks(const wxGridBlockCoords& b1, const wxGridBlockCoords& b2)
+{
+    if ( b1.GetTopRow() == b2.GetTopRow() &&
+            b1.GetBottomRow() == b2.GetBottomRow() )
+    {
+        return b1.GetLeftCol() <= b2.GetRightCol() + 1 &&
+                b2.GetLeftCol() <= b1.GetRightCol() + 1;
+    }
+
+    if ( b1.GetLeftCol() == b2.GetLeftCol() &&
+            b1.GetRightCol() == b2.GetRightCol() )
+    {
+        return b1.GetTopRow() <= b2.GetBottomRow() + 1 &&
+                b2.GetTopRow() <= b1.GetBottomRow() + 1;
+    }
+
+    return false;
+}
+
+wxGridBlockCoords
+GetBoundingBlock(const wxGridBlockCoords& b1, const wxGridBlockCoords& b2)
+{
+    return wxGridBlockCoords(wxMin(b1.GetTopRow(), b2.GetTopRow()),
+                             wxMin(b1.GetLeftCol(), b2.GetLeftCol()),
+                             wxMax(b1.GetBottomRow(), b2.GetBottomRow()),
+                             wxMax(b1.GetRightCol(), b2.GetRightCol()));
+}
+
+} // anonymous namespace
+
+void wxGrid::MarkBlockDirty(const wxGridBlockCoords& blockToAdd)
+{
+    wxGridBlockCoords block = blockToAdd.Canonicalize();
+    wxCHECK_RET( block.GetTopRow() >= 0 && block.GetLeftCol() >= 0,
+                 "invalid block" );
+
+    // Merge the new block with all the existing ones it can be merged with,
+    // which may make it possible to merge it with other ones, so restart
+    // after each merge.
+    for ( size_t n = 0; n < m_dirtyBlocks.size(); )
+    {
+        const wxGridBlockCoords& dirty = m_dirtyBlocks[n];
+        if ( dirty.Contains(block) )
+            return;
+
+        if ( block.Contains(dirty) || CanMergeBlocks(block, dirty) )
+        {
+            block = GetBoundingBlock(block, dirty);
+            m_dirtyBlocks.erase(m_dirtyBlocks.begin() + n);
+            n = 0;
+        }
+        else
+        {
+            n++;
+        }
+    }
+
+    if ( m_dirtyBlocks.size() == MAX_DIRTY_BLOCKS )
+    {
+        for ( const auto& dirty : m_dirtyBlocks )
+            block = GetBoundingBlock(block, dirty);
+
+        m_dirtyBlocks.clear();
+    }
+
+    m_dirtyBlocks.push_back(block);
+
+    if ( !m_dirtyRefreshPending )
+    {
+        m_dirtyRefreshPending = true;
+        CallAfter(&wxGrid::RefreshDirtyCells);
+    }
+}
+
+void wxGrid::RefreshDirtyCells()
+{
+    m_dirtyRefreshPending = false;
+
+    wxGridBlockCoordsVector blocks;
+    blocks.swap(m_dirtyBlocks);
+
+    // If we're inside a batch, everything will be refreshed when it ends, and
+    // if we're hidden, there is nothing to refresh at all.
+    if ( !ShouldRefresh() )
+        return;
+
+    for ( const auto& block : blocks )
+    {
+        // Rows or columns could have been deleted since the block was marked.
+        if ( block.GetTopRow() >= m_numRows || block.GetLeftCol() >= m_numCols )
+            continue;
+
+        RefreshBlock(block.GetTopRow(), block.GetLeftCol(),
+                     wxMin(block.GetBottomRow(), m_numRows - 1),
+                     wxMin(block.GetRightCol(), m_numCols - 1));
+    }
+}
+
 void wxGrid::RefreshRect(wxRect* rect)
 {
     if ( rect )
@@ -6181,23 +6278,12 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
     // inside InitPixelFields() above).
     if ( !m_rowHeights.empty() )
     {
-        int total = 0;
+        // Note that even hidden rows heights must be scaled to ensure that
+        // they appear in the expected size if they are shown again.
         for ( unsigned i = 0; i < m_rowHeights.size(); ++i )
-        {
-            int height = m_rowHeights[i];
-
-            // Note that even hidden rows heights must be scaled to ensure that
-            // they appear in the expected size if they are shown again.
-            height = event.ScaleY(height);
+            m_rowHeights[i] = event.ScaleY(m_rowHeights[i]);
 
-            m_rowHeights[i] = height;
-
-            // But don't count hidden rows for the total height.
-            if ( height > 0 )
-                total += height;
-
-            m_rowBottoms[i] = total;
-        }
+        UpdateRowEnds();
     }
 
     // Similarly for columns, except that here we need to update the native
@@ -6207,22 +6293,15 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
         colHeader = m_useNativeHeader ? GetGridColHeader() : nullptr;
     if ( !m_colWidths.empty() )
     {
-        int total = 0;
         for ( unsigned i = 0; i < m_colWidths.size(); ++i )
-        {
-            int width = m_colWidths[i];
+            m_colWidths[i] = event.ScaleX(m_colWidths[i]);
 
-            width = event.ScaleX(width);
+        UpdateColEnds();
 
-            m_colWidths[i] = width;
-
-            if ( width > 0 )
-                total += width;
-
-            m_colRights[i] = total;
-
-            if ( colHeader )
-                colHeader->UpdateColumn(i);
+        if ( colHeader )
+        {
+            for ( int col = 0; col < m_numCols; ++col )
+                colHeader->UpdateColumn(col);
         }
     }
     else if ( colHeader )
@@ -8395,9 +8474,8 @@ wxGridCellCoords wxGrid::XYToCell(int x, int y, wxGridWindow *gridWindow) const
 }
 
 // compute row or column from some (unscrolled) coordinate value, using either
-// m_defaultRowHeight/m_defaultColWidth or binary search on array of
-// m_rowBottoms/m_colRights to do it quickly in O(log n) time.
-// NOTE: This may not work correctly for reordered columns.
+// m_defaultRowHeight/m_defaultColWidth or searching in m_rowEnds/m_colEnds
+// to do it quickly in O(log n) time.
 int wxGrid::PosToLinePos(int coord,
                          bool clipToMinMax,
                          const wxGridOperations& oper,
@@ -8411,59 +8489,34 @@ int wxGrid::PosToLinePos(int coord,
     const int defaultLineSize = oper.GetDefaultLineSize(this);
     wxCHECK_MSG( defaultLineSize, -1, "can't have 0 default line size" );
 
-    int maxPos = coord / defaultLineSize;
-    int minPos = oper.GetFirstLine(this, gridWindow);
+    const int minPos = oper.GetFirstLine(this, gridWindow);
+    const int maxPos = numLines + minPos - 1;
 
     // check for the simplest case: if we have no explicit line sizes
     // configured, then we already know the line this position falls in
-    const wxArrayInt& lineEnds = oper.GetLineEnds(this);
-    if ( lineEnds.empty() )
+    const wxGridLineEnds& lineEnds = oper.GetLineEnds(this);
+    if ( lineEnds.IsEmpty() )
     {
-        if ( maxPos < (numLines + minPos) )
-            return maxPos;
+        const int pos = coord / defaultLineSize;
+        if ( pos <= maxPos )
+            return pos;
 
-        return clipToMinMax ? numLines + minPos - 1 : -1;
+        return clipToMinMax ? maxPos : wxNOT_FOUND;
     }
 
-    // binary search is quite efficient and we can't really make any assumptions
-    // on where to start here since row and columns could be of size 0 if they are
-    // hidden. While this could be made more efficient, some profiling will be
-    // necessary to determine if it really is a performance bottleneck
-    maxPos = numLines + minPos - 1;
+    // otherwise find the first line ending after this coordinate, this skips
+    // over any lines of size 0, i.e. hidden ones
+    const int pos = lineEnds.FindPos(coord);
 
-    // check if the position is beyond the last column
-    const int lineAtMaxPos = oper.GetLineAt(this, maxPos);
-    if ( coord >= lineEnds[lineAtMaxPos] )
+    // check if the position is beyond the last line of this window
+    if ( pos > maxPos )
         return clipToMinMax ? maxPos : wxNOT_FOUND;
 
     // or before the first one
-    const int lineAt0 = oper.GetLineAt(this, minPos);
-    if ( coord < oper.GetLineStartPos(this, lineAt0) )
+    if ( pos < minPos )
         return clipToMinMax ? minPos : wxNOT_FOUND;
-    else if ( coord < lineEnds[lineAt0] )
-        return minPos;
-
-    // finally do perform the binary search
-    while ( minPos < maxPos )
-    {
-        wxCHECK_MSG( lineEnds[oper.GetLineAt(this, minPos)] <= coord &&
-                        coord < lineEnds[oper.GetLineAt(this, maxPos)],
-                     -1,
-                     "wxGrid: internal error in PosToLinePos()" );
-
-        if ( coord >= lineEnds[oper.GetLineAt(this, maxPos - 1)] )
-            return maxPos;
-        else
-            maxPos--;
 
-        const int median = minPos + (maxPos - minPos + 1) / 2;
-        if ( coord < lineEnds[oper.GetLineAt(this, median)] )
-            maxPos = median;
-        else
-            minPos = median;
-    }
-
-    return maxPos;
+    return pos;
 }
 
 int
@@ -10188,6 +10241,19 @@ void wxGrid::SetAttr(int row, int col, wxGridCellAttr *attr)
     }
 }
 
+void wxGrid::SetAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr)
+{
+    if ( CanHaveAttributes() )
+    {
+        m_table->SetAttr(attr, block);
+        ClearAttrCache();
+    }
+    else
+    {
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGrid::SetRowAttr(int row, wxGridCellAttr *attr)
 {
     if ( CanHaveAttributes() )
@@ -10455,7 +10521,7 @@ void wxGrid::SetDefaultRowSize( int height, bool resizeExistingRows )
         // arrays (which also allows us to take advantage of
         // some speed optimisations)
         m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        m_rowEnds->Clear();
         CalcDimensions();
     }
 }
@@ -10557,10 +10623,7 @@ void wxGrid::DoSetRowSize( int row, int height )
         return;
 
 
-    for ( int rowPos = GetRowPos(row); rowPos < m_numRows; rowPos++ )
-    {
-        m_rowBottoms[GetRowAt(rowPos)] += diff;
-    }
+    m_rowEnds->Add(GetRowPos(row), diff);
 
     InvalidateBestSize();
 
@@ -10624,7 +10687,7 @@ void wxGrid::SetDefaultColSize( int width, bool resizeExistingCols )
         // arrays (which also allows us to take advantage of
         // some speed optimisations)
         m_colWidths.Empty();
-        m_colRights.Empty();
+        m_colEnds->Clear();
 
         CalcDimensions();
     }
@@ -10705,10 +10768,7 @@ void wxGrid::DoSetColSize( int col, int width )
     }
     //else: will be refreshed when the header is redrawn
 
-    for ( int colPos = GetColPos(col); colPos < m_numCols; colPos++ )
-    {
-        m_colRights[GetColAt(colPos)] += diff;
-    }
+    m_colEnds->Add(GetColPos(col), diff);
 
     InvalidateBestSize();
 
@@ -10862,48 +10922,42 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
 
     AcceptCellEditControlIfShown();
 
-    // initialize both of them just to avoid compiler warnings even if only
-    // really needs to be initialized here
-    int row,
-        col;
-    if ( column )
-    {
-        row = -1;
-        col = colOrRow;
-    }
-    else
-    {
-        row = colOrRow;
-        col = -1;
-    }
-
     // If possible, reuse the same attribute and renderer for all cells: this
     // is an important optimization (resulting in up to 80% speed up of
     // AutoSizeColumns()) as finding the attribute and renderer for the cell
     // are very slow operations, due to the number of steps involved in them.
-    const bool canReuseAttr = column && m_table->CanMeasureColUsingSameAttr(col);
+    const bool canReuseAttr = column && m_table->CanMeasureColUsingSameAttr(colOrRow);
     wxGridCellAttrPtr attr;
     wxGridCellRendererPtr renderer;
 
-    wxCoord extent, extentMax = 0;
-    int max = column ? m_numRows : m_numCols;
-    for ( int rowOrCol = 0; rowOrCol < max; rowOrCol++ )
+    // This is set to true if we can determine the extent without measuring
+    // all the cells.
+    bool done = false;
+
+    // Return the extent of the cell in the row or column at the given
+    // position in the column or row being auto-sized.
+    const auto measureCell = [&](int pos) -> wxCoord
     {
+        if ( done )
+            return 0;
+
+        int row,
+            col;
         if ( column )
         {
-            if ( !IsRowShown(rowOrCol) )
-                continue;
+            row = GetRowAt(pos);
+            if ( !IsRowShown(row) )
+                return 0;
 
-            row = rowOrCol;
             col = colOrRow;
         }
         else
         {
-            if ( !IsColShown(rowOrCol) )
-                continue;
+            col = GetColAt(pos);
+            if ( !IsColShown(col) )
+                return 0;
 
             row = colOrRow;
-            col = rowOrCol;
         }
 
         // we need to account for the cells spanning multiple columns/rows:
@@ -10932,42 +10986,88 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
             {
                 // Try to get the best width for the entire column at once, if
                 // it's supported by the renderer.
-                extent = renderer->GetMaxBestSize(*this, *attr, dc).x;
+                const wxCoord extent = renderer->GetMaxBestSize(*this, *attr, dc).x;
 
                 if ( extent != wxDefaultCoord )
                 {
-                    extentMax = extent;
-
                     // No need to check all the values.
-                    break;
+                    done = true;
+
+                    return extent;
                 }
             }
         }
 
-        if ( renderer )
+        if ( !renderer )
+            return 0;
+
+        wxCoord extent = column
+                    ? renderer->GetBestWidth(*this, *attr, dc, row, col,
+                                             GetRowHeight(row))
+                    : renderer->GetBestHeight(*this, *attr, dc, row, col,
+                                              GetColWidth(col));
+
+        if ( span != CellSpan_None )
         {
-            extent = column
-                        ? renderer->GetBestWidth(*this, *attr, dc, row, col,
-                                                 GetRowHeight(row))
-                        : renderer->GetBestHeight(*this, *attr, dc, row, col,
-                                                  GetColWidth(col));
+            // we spread the size of a spanning cell over all the cells it
+            // covers evenly -- this is probably not ideal but we can't
+            // really do much better here
+            //
+            // notice that numCols and numRows are never 0 as they
+            // correspond to the size of the main cell of the span and not
+            // of the cell inside it
+            extent /= column ? numCols : numRows;
+        }
 
-            if ( span != CellSpan_None )
-            {
-                // we spread the size of a spanning cell over all the cells it
-                // covers evenly -- this is probably not ideal but we can't
-                // really do much better here
-                //
-                // notice that numCols and numRows are never 0 as they
-                // correspond to the size of the main cell of the span and not
-                // of the cell inside it
-                extent /= column ? numCols : numRows;
-            }
+        return extent;
+    };
 
-            if ( extent > extentMax )
-                extentMax = extent;
+    wxGridMaxExtentCalculator<decltype(measureCell)>
+        calculator(colOrRow, measureCell);
+
+    const int count = column ? m_numRows : m_numCols;
+    if ( m_autoSizeSampling )
+    {
+        // Measure only as many cells from the beginning and the end as we
+        // can do quickly, plus all the currently visible ones.
+        const wxSize size = m_gridWin->GetClientSize();
+        int first, last;
+        if ( column )
+        {
+            int top, bottom;
+            CalcGridWindowUnscrolledPosition(0, 0, nullptr, &top, m_gridWin);
+            CalcGridWindowUnscrolledPosition(0, size.y - 1, nullptr, &bottom,
+                                             m_gridWin);
+
+            first = YToPos(top, m_gridWin);
+            last = YToPos(bottom, m_gridWin);
+        }
+        else
+        {
+            int left, right;
+            CalcGridWindowUnscrolledPosition(0, 0, &left, nullptr, m_gridWin);
+            CalcGridWindowUnscrolledPosition(size.x - 1, 0, &right, nullptr,
+                                             m_gridWin);
+
+            first = XToPos(left, m_gridWin);
+            last = XToPos(right, m_gridWin);
         }
+
+        if ( first == wxNOT_FOUND || last == wxNOT_FOUND )
+        {
+            first = 0;
+            last = -1;
+        }
+
+        calculator.ComputeBestColumnWidth(count, first, last + 1);
     }
+    else
+    {
+        for ( int pos = 0; pos < count && !done; pos++ )
+            calculator.UpdateWithRow(pos);
+    }
+
+    wxCoord extentMax = calculator.GetMaxWidth();
 
     // now also compare with the column label extent
     wxCoord extentLabel;
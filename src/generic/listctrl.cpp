@@ -40,6 +40,8 @@
 #include "wx/generic/private/listctrl.h"
 #include "wx/generic/private/widthcalc.h"
 
+#include <algorithm>
+
 #ifdef __WXMAC__
     #include "wx/osx/private.h"
 #endif
@@ -810,8 +812,26 @@ void wxListLineData::DrawTextFormatted(wxDC *dc,
                                        int yMid,
                                        int width)
 {
-    // we don't support displaying multiple lines currently (and neither does
-    // wxMSW FWIW) so just merge all the lines
+    // we only support displaying multiple lines when using variable line
+    // height, as otherwise there is no space for them (and neither does wxMSW
+    // support them FWIW), so just merge all the lines in this case
+    if ( m_owner->HasVariableLineHeight() &&
+            textOrig.find('\n') != wxString::npos )
+    {
+        const wxArrayString lines = wxSplit(textOrig, '\n', '\0');
+        const int lineHeight = dc->GetCharHeight();
+
+        const int numLines = static_cast<int>(lines.size());
+        int y = yMid - (numLines * lineHeight) / 2 + lineHeight / 2;
+        for ( const auto& line : lines )
+        {
+            DrawTextFormatted(dc, line, col, x, y, width);
+            y += lineHeight;
+        }
+
+        return;
+    }
+
     wxString text(textOrig);
     text.Replace(wxT("\n"), wxT(" "));
 
@@ -1546,7 +1566,11 @@ void wxListMainWindow::Init()
     m_linesPerPage = 0;
 
     m_headerWidth =
-    m_lineHeight = 0;
+    m_lineHeight =
+    m_textHeight = 0;
+
+    m_hasVariableLineHeight = false;
+    m_lineHeightsChanged = false;
 
     m_small_images = nullptr;
     m_normal_images = nullptr;
@@ -1702,6 +1726,8 @@ wxCoord wxListMainWindow::GetLineHeight() const
         wxCoord y;
         dc.GetTextExtent(wxT("H"), nullptr, &y);
 
+        self->m_textHeight = y;
+
         if ( m_small_images && m_small_images->GetImageCount() )
         {
             int iw = 0, ih = 0;
@@ -1716,11 +1742,157 @@ wxCoord wxListMainWindow::GetLineHeight() const
     return m_lineHeight;
 }
 
+void wxListMainWindow::ResetLineHeight()
+{
+    m_lineHeight = 0;
+
+    InvalidateLineHeights(0);
+}
+
+void wxListMainWindow::EnableVariableLineHeight(bool enable)
+{
+    if ( enable == HasVariableLineHeight() )
+        return;
+
+    m_hasVariableLineHeight = enable;
+
+    m_lineHeightCache.Clear();
+
+    ResetVisibleLinesRange();
+
+    m_dirty = true;
+}
+
+void wxListMainWindow::InvalidateLineHeights(size_t from)
+{
+    if ( !HasVariableLineHeight() )
+        return;
+
+    m_lineHeightCache.Remove(from);
+}
+
+void wxListMainWindow::UpdateLineHeight(size_t line)
+{
+    if ( !HasVariableLineHeight() )
+        return;
+
+    int oldHeight;
+    if ( !m_lineHeightCache.GetLineHeight(line, oldHeight) )
+        return;
+
+    const wxCoord height = ComputeLineHeight(line);
+    if ( height == oldHeight )
+        return;
+
+    // The cache can't forget the height of a single line, so forget the
+    // heights of all the subsequent lines too, they will be recomputed when
+    // needed.
+    m_lineHeightCache.Remove(line);
+    m_lineHeightCache.Put(line, height);
+
+    // The positions of all the subsequent lines change, so we need to update
+    // them and the scrollbars.
+    ResetVisibleLinesRange();
+
+    m_dirty = true;
+}
+
+wxCoord wxListMainWindow::ComputeLineHeight(size_t line) const
+{
+    // Find the maximal number of lines of text in all columns of this line.
+    size_t numTextLines = 1;
+    const auto updateNumTextLines = [&numTextLines](const wxString& text)
+    {
+        const size_t n = 1 + std::count(text.begin(), text.end(), '\n');
+        if ( n > numTextLines )
+            numTextLines = n;
+    };
+
+    if ( IsVirtual() )
+    {
+        // Don't use GetLine() here as we only need the text of the items.
+        const wxGenericListCtrl* const listctrl = GetListCtrl();
+
+        const int countCol = GetColumnCount();
+        for ( int col = 0; col < countCol; col++ )
+            updateNumTextLines(listctrl->OnGetItemText(line, col));
+    }
+    else
+    {
+        for ( const auto& item : m_lines[line].m_items )
+        {
+            if ( item.HasText() )
+                updateNumTextLines(item.GetText());
+        }
+    }
+
+    // Note that calling GetLineHeight() also ensures that m_textHeight is
+    // initialized.
+    const wxCoord lineHeight = GetLineHeight();
+
+    return wxMax(lineHeight,
+                 static_cast<wxCoord>(numTextLines) * m_textHeight +
+                    EXTRA_HEIGHT + LINE_SPACING);
+}
+
+wxCoord wxListMainWindow::GetLineHeight(size_t line) const
+{
+    if ( !HasVariableLineHeight() || line >= GetItemCount() )
+        return GetLineHeight();
+
+    int height;
+    if ( !m_lineHeightCache.GetLineHeight(line, height) )
+    {
+        height = ComputeLineHeight(line);
+        m_lineHeightCache.Put(line, height);
+
+        // The total height estimated using the default height for this line
+        // needs to be updated.
+        if ( height != GetLineHeight() )
+            m_lineHeightsChanged = true;
+    }
+
+    return height;
+}
+
 wxCoord wxListMainWindow::GetLineY(size_t line) const
 {
     wxASSERT_MSG( InReportView(), wxT("only works in report mode") );
 
-    return LINE_SPACING + line * GetLineHeight();
+    if ( !HasVariableLineHeight() )
+        return LINE_SPACING + line * GetLineHeight();
+
+    // Note that we don't compute the heights of the preceding lines here, but
+    // use the default height for those of them whose height is not known yet,
+    // as is done when computing the total height too.
+    return LINE_SPACING +
+            m_lineHeightCache.GetEstimatedLineStart(line, GetLineHeight());
+}
+
+size_t wxListMainWindow::GetLineAt(wxCoord y) const
+{
+    wxASSERT_MSG( InReportView(), wxT("only works in report mode") );
+
+    if ( !HasVariableLineHeight() )
+        return y / GetLineHeight();
+
+    const size_t count = GetItemCount();
+
+    // Find the line at this position using the known heights and the default
+    // height for the other lines. If the height of the line found is not known
+    // yet, compute it and search again, as the line at this position may have
+    // changed if it's different from the default one.
+    for ( ;; )
+    {
+        const size_t line =
+            m_lineHeightCache.GetEstimatedLineAt(y, count, GetLineHeight());
+
+        int height;
+        if ( line == count || m_lineHeightCache.GetLineHeight(line, height) )
+            return line;
+
+        GetLineHeight(line);
+    }
 }
 
 wxRect wxListMainWindow::GetLineRect(size_t line) const
@@ -1732,7 +1904,7 @@ wxRect wxListMainWindow::GetLineRect(size_t line) const
     rect.x = HEADER_OFFSET_X;
     rect.y = GetLineY(line);
     rect.width = GetHeaderWidth();
-    rect.height = GetLineHeight();
+    rect.height = GetLineHeight(line);
 
     return rect;
 }
@@ -1759,7 +1931,7 @@ wxRect wxListMainWindow::GetLineLabelRect(size_t line) const
     rect.x = image_x + HEADER_OFFSET_X;
     rect.y = GetLineY(line);
     rect.width = GetColumnWidth(0) - image_x;
-    rect.height = GetLineHeight();
+    rect.height = GetLineHeight(line);
 
     return rect;
 }
@@ -1947,7 +2119,7 @@ void wxListMainWindow::RefreshLines( size_t lineFrom, size_t lineTo )
         rect.x = 0;
         rect.y = GetLineY(lineFrom);
         rect.width = GetClientSize().x;
-        rect.height = GetLineY(lineTo) - rect.y + GetLineHeight();
+        rect.height = GetLineY(lineTo) - rect.y + GetLineHeight(lineTo);
 
         GetListCtrl()->CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
         RefreshRect( rect );
@@ -2055,8 +2227,6 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
 
     if ( InReportView() )
     {
-        int lineHeight = GetLineHeight();
-
         size_t visibleFrom, visibleTo;
         const size_t linesPerPage = (unsigned int) m_linesPerPage;
         GetVisibleLinesRange(&visibleFrom, &visibleTo);
@@ -2094,6 +2264,8 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             line <= visibleEnd;
             line++, rectLine.y += rectLine.height)
         {
+            rectLine.height = GetLineHeight(line);
+
             if ( !IsExposed(rectLine) )
             {
                 // don't redraw unaffected lines to avoid flicker
@@ -2130,8 +2302,8 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             size_t i = visibleFrom;
             if (i == 0) i = 1; // Don't draw the first one
 
-            int y = (i - visibleFrom) * lineHeight;
-            for ( ; i <= visibleEnd; i++, y += lineHeight )
+            int y = GetLineY(i) - LINE_SPACING + origin.y;
+            for ( ; i <= visibleEnd; y += GetLineHeight(i++) )
             {
                 dc.SetPen(pen);
                 dc.SetBrush( *wxTRANSPARENT_BRUSH );
@@ -2548,7 +2720,7 @@ void wxListMainWindow::OnMouse( wxMouseEvent &event )
 
     if ( InReportView() )
     {
-        current = y / GetLineHeight();
+        current = GetLineAt(y);
         if ( current < count )
             hitResult = HitTestLine(current, x, y);
     }
@@ -2863,6 +3035,11 @@ bool wxListMainWindow::ScrollList(int WXUNUSED(dx), int dy)
 
     int hLine = GetLineHeight();
 
+    // Note that the scroll position is not the same as the top line index
+    // when using variable line height, as we still scroll by hLine.
+    if ( HasVariableLineHeight() )
+        top = GetListCtrl()->GetScrollPos(wxVERTICAL);
+
     GetListCtrl()->Scroll(-1, top + dy / hLine);
 
 #if defined(__WXMAC__) || defined(__WXUNIVERSAL__)
@@ -3355,7 +3532,7 @@ void wxListMainWindow::SetImages( wxWithImages *images, const int which )
     {
         m_small_images = images;
         m_small_spacing = width + 14;
-        m_lineHeight = 0;  // ensure that the line height will be recalc'd
+        ResetLineHeight();  // ensure that the line height will be recalc'd
     }
 }
 
@@ -3566,6 +3743,9 @@ void wxListMainWindow::SetItem( wxListItem &item )
         wxListLineData *line = GetLine((size_t)id);
         line->SetItem( item.m_col, item );
 
+        if ( item.m_mask & wxLIST_MASK_TEXT )
+            UpdateLineHeight(id);
+
         // Set item state if user wants
         if ( item.m_mask & wxLIST_MASK_STATE )
             SetItemState( item.m_itemId, item.m_state, item.m_state );
@@ -3792,6 +3972,10 @@ void wxListMainWindow::SetItemCount(long count)
     m_selStore.SetItemCount(count);
     m_countVirt = count;
 
+    // Keep the heights of the existing lines, if any, as the items are not
+    // supposed to change when their count does.
+    InvalidateLineHeights((size_t)count);
+
     ResetVisibleLinesRange();
 
     // scrollbars must be reset
@@ -4057,8 +4241,23 @@ void wxListMainWindow::RecalculatePositions()
 
     if ( InReportView() )
     {
-        // all lines have the same height and we scroll one line per step
-        int entireHeight = count * lineHeight + LINE_SPACING;
+        // we scroll one line per step, but the lines may have different
+        // heights if variable line height is used: in this case, don't
+        // compute the heights of all the lines, which would be too slow for
+        // big virtual controls, but use the default height for the lines whose
+        // height is not known yet and update the scrollbars when it becomes
+        // known, see wxGenericListCtrl::OnInternalIdle()
+        int entireHeight;
+        if ( HasVariableLineHeight() )
+        {
+            entireHeight = GetLineY(count);
+
+            m_lineHeightsChanged = false;
+        }
+        else
+        {
+            entireHeight = count * lineHeight + LINE_SPACING;
+        }
 
         m_linesPerPage = clientHeight / lineHeight;
 
@@ -4339,6 +4538,8 @@ void wxListMainWindow::DeleteItem( long lindex )
 
     SendNotify( index, wxEVT_LIST_DELETE_ITEM, wxDefaultPosition );
 
+    InvalidateLineHeights(index);
+
     if ( IsVirtual() )
     {
         m_countVirt--;
@@ -4373,6 +4574,8 @@ void wxListMainWindow::DeleteColumn( int col )
     m_dirty = true;
     m_columns.erase( m_columns.begin() + col );
 
+    InvalidateLineHeights(0);
+
     if ( !IsVirtual() )
     {
         // update all the items
@@ -4442,6 +4645,8 @@ void wxListMainWindow::DoDeleteAllItems()
     if ( InReportView() )
         ResetVisibleLinesRange();
 
+    InvalidateLineHeights(0);
+
     m_lines.clear();
 }
 
@@ -4551,7 +4756,7 @@ long wxListMainWindow::HitTest( int x, int y, int &flags ) const
 
     if ( InReportView() )
     {
-        size_t current = y / GetLineHeight();
+        size_t current = GetLineAt(y);
         if ( current < count )
         {
             flags = HitTestLine(current, x, y);
@@ -4623,12 +4828,14 @@ void wxListMainWindow::InsertItem( wxListItem &item )
             m_small_images->GetImageLogicalSize(this, imageWidth, imageHeight);
 
             if ( imageHeight > m_lineHeight )
-                m_lineHeight = 0;
+                ResetLineHeight();
         }
     }
 
     m_lines.insert( m_lines.begin() + id, std::move(line) );
 
+    InvalidateLineHeights(id);
+
     m_dirty = true;
 
     // If an item is selected at or below the point of insertion, we need to
@@ -4684,6 +4891,8 @@ long wxListMainWindow::InsertColumn( long col, const wxListItem &item )
 
         // invalidate it as it has to be recalculated
         m_headerWidth = 0;
+
+        InvalidateLineHeights(0);
     }
     return idx;
 }
@@ -4746,6 +4955,8 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
 
     std::sort(m_lines.begin(), m_lines.end(), wxListLineComparator(fn, data));
 
+    InvalidateLineHeights(0);
+
     m_dirty = true;
 }
 
@@ -4774,6 +4985,30 @@ void wxListMainWindow::OnScroll(wxScrollWinEvent& event)
 
 int wxListMainWindow::GetCountPerPage() const
 {
+    if ( HasVariableLineHeight() && InReportView() )
+    {
+        // The number of lines fitting into the page depends on their heights,
+        // so count them starting from the first visible one.
+        const wxCoord
+            top = GetListCtrl()->GetScrollPos(wxVERTICAL) * GetLineHeight();
+
+        int linesPerPage = 0;
+        wxCoord available = GetClientSize().y;
+        for ( size_t line = GetLineAt(top); ; line++ )
+        {
+            // Note that this returns the default height for the lines after
+            // the last one, so this loop always terminates.
+            const wxCoord height = GetLineHeight(line);
+            if ( height > available )
+                break;
+
+            available -= height;
+            linesPerPage++;
+        }
+
+        return linesPerPage;
+    }
+
     if ( !m_linesPerPage )
     {
         wxConstCast(this, wxListMainWindow)->
@@ -4792,7 +5027,17 @@ void wxListMainWindow::GetVisibleLinesRange(size_t *from, size_t *to)
         size_t count = GetItemCount();
         if ( count )
         {
-            m_lineFrom = GetListCtrl()->GetScrollPos(wxVERTICAL);
+            const int scrollPos = GetListCtrl()->GetScrollPos(wxVERTICAL);
+            if ( HasVariableLineHeight() )
+            {
+                const wxCoord top = scrollPos * GetLineHeight();
+                m_lineFrom = GetLineAt(top);
+                m_lineTo = GetLineAt(top + GetClientSize().y);
+            }
+            else
+            {
+                m_lineFrom = scrollPos;
+            }
 
             // this may happen if SetScrollbars() hadn't been called yet
             if ( m_lineFrom >= count )
@@ -4800,7 +5045,8 @@ void wxListMainWindow::GetVisibleLinesRange(size_t *from, size_t *to)
 
             // we redraw one extra line but this is needed to make the redrawing
             // logic work when there is a fractional number of lines on screen
-            m_lineTo = m_lineFrom + m_linesPerPage;
+            if ( !HasVariableLineHeight() )
+                m_lineTo = m_lineFrom + m_linesPerPage;
             if ( m_lineTo >= count )
                 m_lineTo = count - 1;
         }
@@ -5056,6 +5302,21 @@ bool wxGenericListCtrl::EnableCheckBoxes(bool enable)
     return m_mainWin->EnableCheckBoxes(enable);
 }
 
+bool wxGenericListCtrl::HasVariableLineHeight() const
+{
+    return m_mainWin && m_mainWin->HasVariableLineHeight();
+}
+
+bool wxGenericListCtrl::EnableVariableLineHeight(bool enable)
+{
+    wxCHECK_MSG( m_mainWin, false, "can't be called before creation" );
+
+    m_mainWin->EnableVariableLineHeight(enable);
+    m_mainWin->Refresh();
+
+    return true;
+}
+
 void wxGenericListCtrl::CheckItem(long item, bool state)
 {
     if (InReportView())
@@ -5654,6 +5915,8 @@ void wxGenericListCtrl::OnInternalIdle()
 
     if (m_mainWin->m_dirty)
         m_mainWin->RecalculatePositionsAndRefresh();
+    else if (m_mainWin->m_lineHeightsChanged)
+        m_mainWin->RecalculatePositions(); // just update the scrollbars
 }
 
 // ----------------------------------------------------------------------------
@@ -5832,11 +6095,18 @@ void wxGenericListCtrl::SetItemCount(long count)
 
 void wxGenericListCtrl::RefreshItem(long item)
 {
+    m_mainWin->UpdateLineHeight(item);
     m_mainWin->RefreshLine(item);
 }
 
 void wxGenericListCtrl::RefreshItems(long itemFrom, long itemTo)
 {
+    if ( m_mainWin->HasVariableLineHeight() )
+    {
+        for ( long item = itemFrom; item <= itemTo; item++ )
+            m_mainWin->UpdateLineHeight(item);
+    }
+
     m_mainWin->RefreshLines(itemFrom, itemTo);
 }
 
@@ -289,6 +289,43 @@ bool HeightCache::GetLineAt(int y, unsigned int &row)
     }
 }
 
+int HeightCache::GetEstimatedLineStart(unsigned int row,
+                                       int defaultHeight) const
+{
+    int start = 0;
+    unsigned int known = 0;
+
+    for ( const auto& kv : m_heightToRowRange )
+    {
+        const unsigned int count = kv.second.CountTo(row);
+        start += kv.first * count;
+        known += count;
+    }
+
+    return start + (row - known) * defaultHeight;
+}
+
+unsigned int
+HeightCache::GetEstimatedLineAt(int y, unsigned int count, int defaultHeight) const
+{
+    if ( y < 0 )
+        return 0;
+
+    // Find the first row ending after the given position.
+    unsigned int lo = 0;
+    unsigned int hi = count;
+    while ( lo < hi )
+    {
+        const unsigned int mid = lo + (hi - lo) / 2;
+        if ( GetEstimatedLineStart(mid + 1, defaultHeight) <= y )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
 void HeightCache::Put(unsigned int row, int height)
 {
     m_heightToRowRange[height].Add(row);
@@ -44,6 +44,9 @@
     #include "wx/osx/private.h"
 #endif
 
+#include <map>
+#include <unordered_map>
+
 // -----------------------------------------------------------------------------
 // array types
 // -----------------------------------------------------------------------------
@@ -52,6 +55,28 @@ class wxGenericTreeItem;
 
 using wxGenericTreeItems = std::vector<wxGenericTreeItem*>;
 
+// the virtual children of an item, see SetItemVirtualChildren()
+struct wxGenericTreeVirtualChildren
+{
+    // total number of children
+    size_t count = 0;
+
+    // the children for which wxGenericTreeItem objects were already created,
+    // indexed by their position: they are never deleted as long as the item
+    // has virtual children, as their ids may be used by the application
+    std::map<size_t, wxGenericTreeItem*> items;
+
+    // the position of each of the items above
+    std::unordered_map<const wxGenericTreeItem*, size_t> indices;
+
+    // position of the first child, set when laying out the tree
+    int x = 0,
+        y = 0;
+
+    // the biggest width of the children which had been shown so far
+    int width = 0;
+};
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -143,6 +168,7 @@ public:
     wxGenericTreeItem()
     {
         m_data = nullptr;
+        m_virtualChildren = nullptr;
         m_widthText =
         m_heightText = -1;
     }
@@ -218,18 +244,24 @@ public:
 
     wxGenericTreeItem *GetParent() const { return m_parent; }
 
-    // sets the items font for the specified DC if it uses any special font or
-    // simply returns false otherwise
-    bool SetFont(wxGenericTreeCtrl *control, wxReadOnlyDC& dc) const
+    // returns the special font used by this item, if any, or an invalid font
+    wxFont GetSpecialFont(const wxGenericTreeCtrl *control) const
     {
-        wxFont font;
-
         wxItemAttr * const attr = GetAttributes();
         if ( attr && attr->HasFont() )
-            font = attr->GetFont();
+            return attr->GetFont();
         else if ( IsBold() )
-            font = control->m_boldFont;
+            return control->m_boldFont;
         else
+            return wxFont();
+    }
+
+    // sets the items font for the specified DC if it uses any special font or
+    // simply returns false otherwise
+    bool SetFont(const wxGenericTreeCtrl *control, wxReadOnlyDC& dc) const
+    {
+        const wxFont font = GetSpecialFont(control);
+        if ( !font.IsOk() )
             return false;
 
         dc.SetFont(font);
@@ -247,6 +279,26 @@ public:
     void Insert(wxGenericTreeItem *child, size_t index)
         { m_children.insert(m_children.begin() + index, child); }
 
+    // virtual children support: an item can have either normal or virtual
+    // children, but not both, and virtual children can't have any children
+    // of their own
+    wxGenericTreeVirtualChildren *GetVirtualChildren()
+        { return m_virtualChildren; }
+    const wxGenericTreeVirtualChildren *GetVirtualChildren() const
+        { return m_virtualChildren; }
+    size_t GetVirtualChildrenCount() const
+        { return m_virtualChildren ? m_virtualChildren->count : 0; }
+    void SetVirtualChildrenCount(size_t count);
+
+    // return the existing virtual child at the given position or nullptr
+    wxGenericTreeItem *FindVirtualChild(size_t n) const;
+
+    // return the index of this item among the virtual children of its parent
+    size_t GetVirtualIndex() const;
+
+    bool IsVirtual() const { return m_isVirtual != 0; }
+    void SetVirtual() { m_isVirtual = true; }
+
     // calculate and cache the item size using either the provided DC (which is
     // supposed to already have wxGenericTreeCtrl font selected into it!) or a
     // wxInfoDC associated with the control
@@ -254,6 +306,11 @@ public:
         { DoCalculateSize(control, dc); }
     void CalculateSize(wxGenericTreeCtrl *control);
 
+    // calculate the size of a virtual item: unlike for the normal items, this
+    // doesn't change the line height of the control, as all virtual items
+    // use the same one, and so can be done when creating them on demand
+    void CalculateVirtualSize(const wxGenericTreeCtrl *control);
+
     void GetSize( int &x, int &y, const wxGenericTreeCtrl* );
 
     void ResetSize() { m_width = 0; }
@@ -275,7 +332,8 @@ public:
     void SetHilight( bool set = true ) { m_hasHilight = set; }
 
     // status inquiries
-    bool HasChildren() const { return !m_children.empty(); }
+    bool HasChildren() const
+        { return !m_children.empty() || GetVirtualChildrenCount() != 0; }
     bool IsSelected()  const { return m_hasHilight != 0; }
     bool IsExpanded()  const { return !m_isCollapsed; }
     bool HasPlus()     const { return m_hasPlus || HasChildren(); }
@@ -318,6 +376,9 @@ private:
     // m_widthText and m_heightText properly
     void DoCalculateSize(wxGenericTreeCtrl *control, wxReadOnlyDC& dc);
 
+    // set m_width and m_height once m_widthText and m_heightText are known
+    void DoCalculateSizeFromText(const wxGenericTreeCtrl *control);
+
     // since there can be very many of these, we save size by chosing
     // the smallest representation for the elements and by ordering
     // the members to avoid padding.
@@ -334,6 +395,8 @@ private:
 
     wxItemAttr     *m_attr;         // attributes???
 
+    wxGenericTreeVirtualChildren *m_virtualChildren; // usually null
+
     // tree ctrl images for the normal, selected, expanded and
     // expanded+selected states
     int                 m_images[wxTreeItemIcon_Max];
@@ -350,6 +413,7 @@ private:
                                           // children but has a [+] button
     unsigned int        m_isBold      :1; // render the label in bold font
     unsigned int        m_ownsAttr    :1; // delete attribute when done
+    unsigned int        m_isVirtual   :1; // one of virtual children
 
     wxDECLARE_NO_COPY_CLASS(wxGenericTreeItem);
 };
@@ -645,6 +709,9 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
     m_attr = nullptr;
     m_ownsAttr = false;
 
+    m_virtualChildren = nullptr;
+    m_isVirtual = false;
+
     // We don't know the height here yet.
     m_width = 0;
     m_height = 0;
@@ -660,7 +727,7 @@ wxGenericTreeItem::~wxGenericTreeItem()
     if (m_ownsAttr)
         delete m_attr;
 
-    wxASSERT_MSG( m_children.empty(),
+    wxASSERT_MSG( m_children.empty() && !m_virtualChildren,
                   "must call DeleteChildren() before deleting the item" );
 }
 
@@ -679,16 +746,66 @@ void wxGenericTreeItem::DeleteChildren(wxGenericTreeCtrl *tree)
     }
 
     m_children.clear();
+
+    if ( m_virtualChildren )
+    {
+        for ( const auto& kv : m_virtualChildren->items )
+        {
+            wxGenericTreeItem *child = kv.second;
+            tree->SendDeleteEvent(child);
+
+            if ( child == tree->m_select_me )
+                tree->m_select_me = nullptr;
+            delete child;
+        }
+
+        delete m_virtualChildren;
+        m_virtualChildren = nullptr;
+    }
+}
+
+void wxGenericTreeItem::SetVirtualChildrenCount(size_t count)
+{
+    wxASSERT_MSG( m_children.empty() && !m_virtualChildren,
+                  "must call DeleteChildren() first" );
+
+    if ( count )
+    {
+        m_virtualChildren = new wxGenericTreeVirtualChildren;
+        m_virtualChildren->count = count;
+    }
+}
+
+wxGenericTreeItem *wxGenericTreeItem::FindVirtualChild(size_t n) const
+{
+    if ( !m_virtualChildren )
+        return nullptr;
+
+    const auto it = m_virtualChildren->items.find(n);
+    return it == m_virtualChildren->items.end() ? nullptr : it->second;
+}
+
+size_t wxGenericTreeItem::GetVirtualIndex() const
+{
+    wxCHECK_MSG( m_isVirtual && m_parent && m_parent->m_virtualChildren,
+                 0, "not a virtual item" );
+
+    const auto& indices = m_parent->m_virtualChildren->indices;
+    const auto it = indices.find(this);
+    wxCHECK_MSG( it != indices.end(), 0, "virtual item not found" );
+
+    return it->second;
 }
 
 size_t wxGenericTreeItem::GetChildrenCount(bool recursively) const
 {
-    size_t count = m_children.size();
+    // virtual children never have any children of their own
+    size_t count = m_children.size() + GetVirtualChildrenCount();
     if ( !recursively )
         return count;
 
     size_t total = count;
-    for (size_t n = 0; n < count; ++n)
+    for (size_t n = 0; n < m_children.size(); ++n)
     {
         total += m_children[n]->GetChildrenCount();
     }
@@ -713,6 +830,18 @@ void wxGenericTreeItem::GetSize( int &x, int &y,
         {
             m_children[n]->GetSize( x, y, theButton );
         }
+
+        if ( m_virtualChildren )
+        {
+            // we only know the width of the children shown so far
+            bottomY = m_virtualChildren->y +
+                        static_cast<int>(m_virtualChildren->count)*theButton->m_lineHeight;
+            if ( y < bottomY )
+                y = bottomY;
+            width = m_virtualChildren->x + m_virtualChildren->width;
+            if ( x < width )
+                x = width;
+        }
     }
 }
 
@@ -819,6 +948,22 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
             return res;
     }
 
+    if ( m_virtualChildren )
+    {
+        // all virtual children have the same height, so we can find the one
+        // containing the point directly
+        const int y = m_virtualChildren->y;
+        const int h = theCtrl->m_lineHeight;
+        if ( point.y > y &&
+                point.y < y + static_cast<int>(m_virtualChildren->count)*h )
+        {
+            wxGenericTreeItem * const
+                child = theCtrl->GetVirtualChild(this, (point.y - y) / h);
+
+            return child->HitTest(point, theCtrl, flags, level + 1);
+        }
+    }
+
     return nullptr;
 }
 
@@ -885,6 +1030,31 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
              dc.SetFont(control->GetFont());
     }
 
+    DoCalculateSizeFromText(control);
+
+    if (m_height > control->m_lineHeight)
+        control->m_lineHeight = m_height;
+}
+
+void wxGenericTreeItem::CalculateVirtualSize(const wxGenericTreeCtrl* control)
+{
+    if ( m_width != 0 )
+        return;
+
+    if ( m_widthText == -1 )
+    {
+        const wxFont font = GetSpecialFont(control);
+        control->GetTextExtent(GetText(), &m_widthText, &m_heightText,
+                               nullptr, nullptr,
+                               font.IsOk() ? &font : nullptr);
+    }
+
+    DoCalculateSizeFromText(control);
+}
+
+void
+wxGenericTreeItem::DoCalculateSizeFromText(const wxGenericTreeCtrl* control)
+{
     int text_h = m_heightText + 2;
 
     int image_h = 0, image_w = 0;
@@ -911,9 +1081,6 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
 
     m_height += control->FromDIP(2); // See CalculateLineHeight().
 
-    if (m_height > control->m_lineHeight)
-        control->m_lineHeight = m_height;
-
     m_width = state_w + image_w + m_widthText + 2;
 }
 
@@ -924,6 +1091,13 @@ void wxGenericTreeItem::RecursiveResetSize()
     const size_t count = m_children.size();
     for (size_t i = 0; i < count; i++ )
         m_children[i]->RecursiveResetSize();
+
+    if ( m_virtualChildren )
+    {
+        m_virtualChildren->width = 0;
+        for ( const auto& kv : m_virtualChildren->items )
+            kv.second->ResetSize();
+    }
 }
 
 void wxGenericTreeItem::RecursiveResetTextSize()
@@ -934,6 +1108,13 @@ void wxGenericTreeItem::RecursiveResetTextSize()
     const size_t count = m_children.size();
     for (size_t i = 0; i < count; i++ )
         m_children[i]->RecursiveResetTextSize();
+
+    if ( m_virtualChildren )
+    {
+        m_virtualChildren->width = 0;
+        for ( const auto& kv : m_virtualChildren->items )
+            kv.second->ResetTextSize();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -1415,7 +1596,8 @@ wxTreeItemId wxGenericTreeCtrl::GetNextChild(const wxTreeItemId& item,
 {
     wxCHECK_MSG( item.IsOk(), wxTreeItemId(), wxT("invalid tree item") );
 
-    wxGenericTreeItems& children = GetItemPtr(item)->GetChildren();
+    wxGenericTreeItem * const parent = GetItemPtr(item);
+    wxGenericTreeItems& children = parent->GetChildren();
 
     // it's ok to cast cookie to size_t, we never have indices big enough to
     // overflow "void *"
@@ -1424,6 +1606,10 @@ wxTreeItemId wxGenericTreeCtrl::GetNextChild(const wxTreeItemId& item,
     {
         return children[(*pIndex)++];
     }
+    else if ( *pIndex < parent->GetVirtualChildrenCount() )
+    {
+        return GetVirtualChild(parent, (*pIndex)++);
+    }
     else
     {
         // there are no more of them
@@ -1435,7 +1621,11 @@ wxTreeItemId wxGenericTreeCtrl::GetLastChild(const wxTreeItemId& item) const
 {
     wxCHECK_MSG( item.IsOk(), wxTreeItemId(), wxT("invalid tree item") );
 
-    wxGenericTreeItems& children = GetItemPtr(item)->GetChildren();
+    wxGenericTreeItem * const parent = GetItemPtr(item);
+    if ( const size_t count = parent->GetVirtualChildrenCount() )
+        return GetVirtualChild(parent, count - 1);
+
+    wxGenericTreeItems& children = parent->GetChildren();
     return children.empty() ? wxTreeItemId() : wxTreeItemId(children.back());
 }
 
@@ -1451,6 +1641,14 @@ wxTreeItemId wxGenericTreeCtrl::GetNextSibling(const wxTreeItemId& item) const
         return wxTreeItemId();
     }
 
+    if ( i->IsVirtual() )
+    {
+        const size_t n = i->GetVirtualIndex() + 1;
+        return n == parent->GetVirtualChildrenCount()
+                ? wxTreeItemId()
+                : wxTreeItemId(GetVirtualChild(parent, n));
+    }
+
     wxGenericTreeItems& siblings = parent->GetChildren();
     const int index = FindItemIndex(siblings, i);
     wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
@@ -1472,6 +1670,13 @@ wxTreeItemId wxGenericTreeCtrl::GetPrevSibling(const wxTreeItemId& item) const
         return wxTreeItemId();
     }
 
+    if ( i->IsVirtual() )
+    {
+        const size_t n = i->GetVirtualIndex();
+        return n == 0 ? wxTreeItemId()
+                      : wxTreeItemId(GetVirtualChild(parent, n - 1));
+    }
+
     wxGenericTreeItems& siblings = parent->GetChildren();
     const int index = FindItemIndex(siblings, i);
     wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
@@ -1501,6 +1706,9 @@ wxGenericTreeCtrl::DoGetNext(const wxTreeItemId& item, int flags) const
         {
              return children.front();
         }
+
+        if ( i->GetVirtualChildrenCount() )
+            return GetVirtualChild(i, 0);
     }
 
      // Try a sibling of this or ancestor instead
@@ -1699,6 +1907,10 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
         return AddRoot(text, image, selImage, data);
     }
 
+    wxCHECK_MSG( !parent->GetVirtualChildren() && !parent->IsVirtual(),
+                 wxTreeItemId(),
+                 "can't add children to virtual items or their parent" );
+
     m_dirty = true;     // do this first so stuff below doesn't cause flicker
 
     wxGenericTreeItem *item =
@@ -1823,12 +2035,69 @@ void wxGenericTreeCtrl::DeleteChildren(const wxTreeItemId& itemId)
     InvalidateBestSize();
 }
 
-void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
+bool
+wxGenericTreeCtrl::SetItemVirtualChildren(const wxTreeItemId& itemId,
+                                          size_t count)
 {
-    m_dirty = true;     // do this first so stuff below doesn't cause flicker
+    wxGenericTreeItem *item = GetItemPtr(itemId);
+    wxCHECK_MSG( item, false, "invalid tree item" );
+    wxCHECK_MSG( !item->IsVirtual(), false,
+                 "virtual items can't have children" );
+
+    DeleteChildren(itemId);
+
+    item->SetVirtualChildrenCount(count);
+
+    return true;
+}
+
+int wxGenericTreeCtrl::GetVirtualItemIndex(const wxTreeItemId& itemId) const
+{
+    wxCHECK_MSG( itemId.IsOk(), wxNOT_FOUND, "invalid tree item" );
+
+    wxGenericTreeItem * const item = GetItemPtr(itemId);
+    if ( !item->IsVirtual() )
+        return wxNOT_FOUND;
 
+    return static_cast<int>(item->GetVirtualIndex());
+}
+
+wxGenericTreeItem *
+wxGenericTreeCtrl::GetVirtualChild(wxGenericTreeItem *parent, size_t n) const
+{
+    wxGenericTreeVirtualChildren * const virt = parent->GetVirtualChildren();
+    wxCHECK_MSG( virt && n < virt->count, nullptr, "invalid virtual child" );
+
+    wxGenericTreeItem *child = parent->FindVirtualChild(n);
+    if ( child )
+        return child;
+
+    child = new wxGenericTreeItem(parent, OnGetVirtualItemText(parent, n),
+                                  OnGetVirtualItemImage(parent, n),
+                                  NO_IMAGE, nullptr);
+    child->SetVirtual();
+
+    // The position of the item is normally set when laying out the tree, but
+    // we need it right now, e.g. for hit testing.
+    child->SetX(virt->x);
+    child->SetY(virt->y + static_cast<int>(n)*m_lineHeight);
+    child->CalculateVirtualSize(this);
+
+    virt->items[n] = child;
+    virt->indices[child] = n;
+
+    return child;
+}
+
+void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
+{
     wxGenericTreeItem *item = GetItemPtr(itemId);
 
+    wxCHECK_RET( !item->IsVirtual(),
+                 "virtual items can't be deleted individually" );
+
+    m_dirty = true;     // do this first so stuff below doesn't cause flicker
+
     if (m_textCtrl != nullptr && IsDescendantOf(item, m_textCtrl->item()))
     {
         // can't delete the item being edited, cancel editing it first
@@ -2056,6 +2325,13 @@ void wxGenericTreeCtrl::UnselectAllChildren(wxGenericTreeItem *item)
         {
             UnselectAllChildren(children[n]);
         }
+
+        // virtual children which don't exist yet can't be selected
+        if ( wxGenericTreeVirtualChildren * const virt = item->GetVirtualChildren() )
+        {
+            for ( const auto& kv : virt->items )
+                UnselectAllChildren(kv.second);
+        }
     }
 }
 
@@ -2081,10 +2357,13 @@ void wxGenericTreeCtrl::SelectChildren(const wxTreeItemId& parent)
         return;
 
 
-    wxGenericTreeItems& children = GetItemPtr(parent)->GetChildren();
-    size_t count = children.size();
+    wxGenericTreeItem * const parentItem = GetItemPtr(parent);
+    wxGenericTreeItems& children = parentItem->GetChildren();
+    const size_t countVirtual = parentItem->GetVirtualChildrenCount();
+    size_t count = countVirtual ? countVirtual : children.size();
 
-    wxGenericTreeItem * item = children[0];
+    wxGenericTreeItem * item = countVirtual ? GetVirtualChild(parentItem, 0)
+                                            : children[0];
     wxTreeEvent event(wxEVT_TREE_SEL_CHANGING, this, item);
     event.m_itemOld = m_current;
 
@@ -2093,11 +2372,14 @@ void wxGenericTreeCtrl::SelectChildren(const wxTreeItemId& parent)
 
     for ( size_t n = 0; n < count; ++n )
     {
-        m_current = m_key_current = children[n];
+        m_current = m_key_current = countVirtual
+                                        ? GetVirtualChild(parentItem, n)
+                                        : children[n];
         m_current->SetHilight(true);
-        RefreshSelected();
     }
 
+    RefreshSelected();
+
 
     event.SetEventType(wxEVT_TREE_SEL_CHANGED);
     GetEventHandler()->ProcessEvent( event );
@@ -2120,6 +2402,19 @@ wxGenericTreeCtrl::TagNextChildren(wxGenericTreeItem *crt_item,
     if (parent == nullptr) // This is root item
         return TagAllChildrenUntilLast(crt_item, last_item, select);
 
+    if ( crt_item->IsVirtual() )
+    {
+        const size_t count = parent->GetVirtualChildrenCount();
+        for ( size_t n = crt_item->GetVirtualIndex() + 1; n < count; ++n )
+        {
+            if ( TagAllChildrenUntilLast(GetVirtualChild(parent, n),
+                                         last_item, select) )
+                return true;
+        }
+
+        return TagNextChildren(parent, last_item, select);
+    }
+
     wxGenericTreeItems& children = parent->GetChildren();
     const int index = FindItemIndex(children, crt_item);
     wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
@@ -2155,6 +2450,14 @@ wxGenericTreeCtrl::TagAllChildrenUntilLast(wxGenericTreeItem *crt_item,
             if (TagAllChildrenUntilLast(children[n], last_item, select))
                 return true;
         }
+
+        const size_t countVirtual = crt_item->GetVirtualChildrenCount();
+        for ( size_t n = 0; n < countVirtual; ++n )
+        {
+            if (TagAllChildrenUntilLast(GetVirtualChild(crt_item, n),
+                                        last_item, select))
+                return true;
+        }
     }
 
   return false;
@@ -2304,6 +2607,12 @@ void wxGenericTreeCtrl::FillArray(wxGenericTreeItem *item,
         size_t count = children.size();
         for ( size_t n = 0; n < count; ++n )
             FillArray(children[n], array);
+
+        if ( wxGenericTreeVirtualChildren * const virt = item->GetVirtualChildren() )
+        {
+            for ( const auto& kv : virt->items )
+                FillArray(kv.second, array);
+        }
     }
 }
 
@@ -2541,7 +2850,9 @@ void wxGenericTreeCtrl::AdjustMyScrollbars()
 
 int wxGenericTreeCtrl::GetLineHeight(wxGenericTreeItem *item) const
 {
-    if (GetWindowStyleFlag() & wxTR_HAS_VARIABLE_ROW_HEIGHT)
+    // virtual items always use the same height, as we need to be able to find
+    // their positions without creating them
+    if ((GetWindowStyleFlag() & wxTR_HAS_VARIABLE_ROW_HEIGHT) && !item->IsVirtual())
         return item->GetHeight();
     else
         return m_lineHeight;
@@ -2776,22 +3087,29 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int origY = y;
         wxGenericTreeItems& children = item->GetChildren();
         int count = children.size();
+        int oldY = -1;
         if (count > 0)
         {
-            int n = 0, oldY;
+            int n = 0;
             do {
                 oldY = y;
                 PaintLevel(children[n], dc, 1, y);
             } while (++n < count);
 
-            if ( !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT)
-                    && count > 0 )
-            {
-                // draw line down to last child
-                origY += GetLineHeight(children[0])>>1;
-                oldY += GetLineHeight(children[n-1])>>1;
-                dc.DrawLine(3, origY, 3, oldY);
-            }
+            origY += GetLineHeight(children[0])>>1;
+            oldY += GetLineHeight(children[n-1])>>1;
+        }
+        else if ( item->GetVirtualChildrenCount() )
+        {
+            oldY = PaintVirtualChildren(item, dc, 1, y) + (m_lineHeight>>1);
+            origY += m_lineHeight>>1;
+        }
+
+        if ( oldY != -1 &&
+                !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT) )
+        {
+            // draw line down to last child
+            dc.DrawLine(3, origY, 3, oldY);
         }
         return;
     }
@@ -2915,42 +3233,111 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
     {
         wxGenericTreeItems& children = item->GetChildren();
         int count = children.size();
+        int oldY = -1;
+        ++level;
         if (count > 0)
         {
-            int n = 0, oldY;
-            ++level;
+            int n = 0;
             do {
                 oldY = y;
                 PaintLevel(children[n], dc, level, y);
             } while (++n < count);
 
-            if (!HasFlag(wxTR_NO_LINES) && count > 0)
-            {
-                // draw line down to last child
-                oldY += GetLineHeight(children[n-1])>>1;
-                if (HasButtons())
-                    y_mid += 5;
-
-                // Only draw the portion of the line that is visible, in case
-                // it is huge
-                wxCoord xOrigin=0, yOrigin=0, width, height;
-                dc.GetDeviceOrigin(&xOrigin, &yOrigin);
-                yOrigin = abs(yOrigin);
-                GetClientSize(&width, &height);
-
-                // Move end points to the beginning/end of the view?
-                if (y_mid < yOrigin)
-                    y_mid = yOrigin;
-                if (oldY > yOrigin + height)
-                    oldY = yOrigin + height;
-
-                // after the adjustments if y_mid is larger than oldY then the
-                // line isn't visible at all so don't draw anything
-                if (y_mid < oldY)
-                    dc.DrawLine(x, y_mid, x, oldY);
-            }
+            oldY += GetLineHeight(children[n-1])>>1;
+        }
+        else if ( item->GetVirtualChildrenCount() )
+        {
+            oldY = PaintVirtualChildren(item, dc, level, y) + (m_lineHeight>>1);
+        }
+
+        if ( oldY != -1 && !HasFlag(wxTR_NO_LINES) )
+        {
+            // draw line down to last child
+            if (HasButtons())
+                y_mid += 5;
+
+            // Only draw the portion of the line that is visible, in case
+            // it is huge
+            wxCoord xOrigin=0, yOrigin=0, width, height;
+            dc.GetDeviceOrigin(&xOrigin, &yOrigin);
+            yOrigin = abs(yOrigin);
+            GetClientSize(&width, &height);
+
+            // Move end points to the beginning/end of the view?
+            if (y_mid < yOrigin)
+                y_mid = yOrigin;
+            if (oldY > yOrigin + height)
+                oldY = yOrigin + height;
+
+            // after the adjustments if y_mid is larger than oldY then the
+            // line isn't visible at all so don't draw anything
+            if (y_mid < oldY)
+                dc.DrawLine(x, y_mid, x, oldY);
+        }
+    }
+}
+
+int
+wxGenericTreeCtrl::PaintVirtualChildren(wxGenericTreeItem *item,
+                                        wxDC& dc,
+                                        int level,
+                                        int &y)
+{
+    wxGenericTreeVirtualChildren * const virt = item->GetVirtualChildren();
+
+    const int h = m_lineHeight;
+    const int count = static_cast<int>(virt->count);
+    const int yStart = y;
+    y += count*h;
+
+    // Only paint the children in the visible part of the window, as there may
+    // be a huge number of them.
+    wxCoord xOrigin = 0, yOrigin = 0, width, height;
+    dc.GetDeviceOrigin(&xOrigin, &yOrigin);
+    yOrigin = abs(yOrigin);
+    GetClientSize(&width, &height);
+
+    const int first = wxMax(0, (yOrigin - yStart) / h);
+    const int last = wxMin(count, (yOrigin + height - yStart) / h + 1);
+
+    bool widthChanged = false;
+    for ( int n = first; n < last; n++ )
+    {
+        int yChild = yStart + n*h;
+
+        // Don't create the items just to paint them, use a temporary one if
+        // the item doesn't exist yet.
+        int widthChild;
+        if ( wxGenericTreeItem * const child = item->FindVirtualChild(n) )
+        {
+            PaintLevel(child, dc, level, yChild);
+
+            widthChild = child->GetWidth();
+        }
+        else
+        {
+            wxGenericTreeItem tmp(item, OnGetVirtualItemText(item, n),
+                                  OnGetVirtualItemImage(item, n), NO_IMAGE,
+                                  nullptr);
+            tmp.SetVirtual();
+
+            PaintLevel(&tmp, dc, level, yChild);
+
+            widthChild = tmp.GetWidth();
+        }
+
+        if ( widthChild > virt->width )
+        {
+            virt->width = widthChild;
+            widthChanged = true;
         }
     }
+
+    // We can't update the scrollbars from here, do it later.
+    if ( widthChanged )
+        m_dirty = true;
+
+    return yStart + (count - 1)*h;
 }
 
 void wxGenericTreeCtrl::DrawDropEffect(wxGenericTreeItem *item)
@@ -4038,6 +4425,27 @@ wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
     ++level;
     for (n = 0; n < count; ++n )
         CalculateLevel( children[n], dc, level, y );  // recurse
+
+    if ( wxGenericTreeVirtualChildren * const virt = item->GetVirtualChildren() )
+    {
+        virt->x = level*indent + spacing;
+        if (!HasFlag(wxTR_HIDE_ROOT))
+            virt->x += indent;
+        virt->y = y;
+
+        // Only the already existing children need to be positioned, the other
+        // ones get their position when they're created.
+        for ( const auto& kv : virt->items )
+        {
+            int yChild = y + static_cast<int>(kv.first)*m_lineHeight;
+            CalculateLevel( kv.second, dc, level, yChild );
+
+            if ( kv.second->GetWidth() > virt->width )
+                virt->width = kv.second->GetWidth();
+        }
+
+        y += static_cast<int>(virt->count)*m_lineHeight;
+    }
 }
 
 void wxGenericTreeCtrl::CalculatePositions()
@@ -4113,6 +4521,12 @@ void wxGenericTreeCtrl::RefreshSelectedUnder(wxGenericTreeItem *item)
     {
         RefreshSelectedUnder(children[n]);
     }
+
+    if ( wxGenericTreeVirtualChildren * const virt = item->GetVirtualChildren() )
+    {
+        for ( const auto& kv : virt->items )
+            RefreshSelectedUnder(kv.second);
+    }
 }
 
 void wxGenericTreeCtrl::DoThaw()
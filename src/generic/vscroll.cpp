@@ -28,6 +28,8 @@
 
 #include "wx/utils.h"   // For wxMin/wxMax().
 
+#include "wx/private/lineends.h"
+
 // ============================================================================
 // wxVarScrollHelperEvtHandler declaration
 // ============================================================================
@@ -53,6 +55,32 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxVarScrollHelperEvtHandler);
 };
 
+// ----------------------------------------------------------------------------
+// wxVarScrollSizeCache: the unit sizes cached by wxVarScrollHelperBase
+// ----------------------------------------------------------------------------
+
+class wxVarScrollSizeCache
+{
+public:
+    wxVarScrollSizeCache() = default;
+
+    void Clear()
+    {
+        m_ends.Clear();
+        m_numKnown = 0;
+    }
+
+    // the sizes of the units [0, m_numKnown), all the other units have size
+    // 0 in it until their size becomes known: this is empty if the sizes of
+    // no units are known yet
+    wxLineEnds m_ends;
+
+    // the number of the first units whose sizes are known
+    size_t m_numKnown = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxVarScrollSizeCache);
+};
+
 // ============================================================================
 // wxVarScrollHelperEvtHandler implementation
 // ============================================================================
@@ -192,6 +220,7 @@ wxVarScrollHelperBase::wxVarScrollHelperBase(wxWindow *win)
     m_unitFirst = 0;
 
     m_physicalScrolling = true;
+    m_sizeCache = nullptr;
     m_handler = nullptr;
 
     // by default, the associated window is also the target window
@@ -201,6 +230,8 @@ wxVarScrollHelperBase::wxVarScrollHelperBase(wxWindow *win)
 wxVarScrollHelperBase::~wxVarScrollHelperBase()
 {
     DeleteEvtHandler();
+
+    delete m_sizeCache;
 }
 
 // ----------------------------------------------------------------------------
@@ -251,13 +282,26 @@ wxCoord wxVarScrollHelperBase::DoEstimateTotalSize() const
     }
     else // too many units to calculate exactly
     {
+        // don't use GetUnitsSize() here as, with the size cache enabled, it
+        // would compute the sizes of all units before the last sampled one
+        const auto sampleSize = [this](size_t unitMin, size_t unitMax)
+        {
+            OnGetUnitsSizeHint(unitMin, unitMax);
+
+            wxCoord size = 0;
+            for ( size_t unit = unitMin; unit < unitMax; ++unit )
+                size += OnGetUnitSize(unit);
+
+            return size;
+        };
+
         // look at some units in the beginning/middle/end
         sizeTotal =
-            GetUnitsSize(0, NUM_UNITS_TO_SAMPLE) +
-                GetUnitsSize(m_unitMax - NUM_UNITS_TO_SAMPLE,
-                             m_unitMax) +
-                    GetUnitsSize(m_unitMax/2 - NUM_UNITS_TO_SAMPLE/2,
-                                 m_unitMax/2 + NUM_UNITS_TO_SAMPLE/2);
+            sampleSize(0, NUM_UNITS_TO_SAMPLE) +
+                sampleSize(m_unitMax - NUM_UNITS_TO_SAMPLE,
+                           m_unitMax) +
+                    sampleSize(m_unitMax/2 - NUM_UNITS_TO_SAMPLE/2,
+                               m_unitMax/2 + NUM_UNITS_TO_SAMPLE/2);
 
         // use the height of the units we looked as the average
         sizeTotal = (wxCoord)
@@ -275,6 +319,9 @@ wxCoord wxVarScrollHelperBase::GetUnitsSize(size_t unitMin, size_t unitMax) cons
         return -GetUnitsSize(unitMax, unitMin);
     //else: unitMin < unitMax
 
+    if ( m_sizeCache )
+        return GetCachedUnitOffset(unitMax) - GetCachedUnitOffset(unitMin);
+
     // let the user code know that we're going to need all these units
     OnGetUnitsSizeHint(unitMin, unitMax);
 
@@ -288,6 +335,52 @@ wxCoord wxVarScrollHelperBase::GetUnitsSize(size_t unitMin, size_t unitMax) cons
     return size;
 }
 
+wxCoord wxVarScrollHelperBase::GetCachedUnitOffset(size_t unit) const
+{
+    wxCHECK_MSG( m_sizeCache, 0, "size cache must be enabled" );
+    wxCHECK_MSG( unit <= m_unitMax, 0, "invalid unit" );
+
+    wxVarScrollSizeCache& cache = *m_sizeCache;
+
+    // compute the sizes of all the units up to this one which are not known
+    // yet, this needs to be done only once
+    if ( unit > cache.m_numKnown )
+    {
+        if ( cache.m_ends.IsEmpty() )
+            cache.m_ends.Init(static_cast<int>(m_unitMax), [](int) { return 0; });
+
+        OnGetUnitsSizeHint(cache.m_numKnown, unit);
+
+        for ( size_t n = cache.m_numKnown; n < unit; ++n )
+            cache.m_ends.Add(static_cast<int>(n), OnGetUnitSize(n));
+
+        cache.m_numKnown = unit;
+    }
+
+    return cache.m_ends.GetStart(static_cast<int>(unit));
+}
+
+void wxVarScrollHelperBase::UpdateCachedUnitsSize(size_t from, size_t to)
+{
+    if ( !m_sizeCache )
+        return;
+
+    wxVarScrollSizeCache& cache = *m_sizeCache;
+
+    // we only need to update the sizes which are already known, the other
+    // ones will be computed when needed
+    const size_t end = wxMin(to + 1, cache.m_numKnown);
+    for ( size_t n = from; n < end; ++n )
+    {
+        const int pos = static_cast<int>(n);
+        const wxCoord sizeOld = cache.m_ends.GetEnd(pos) -
+                                    cache.m_ends.GetStart(pos);
+        const wxCoord sizeNew = OnGetUnitSize(n);
+        if ( sizeNew != sizeOld )
+            cache.m_ends.Add(pos, sizeNew - sizeOld);
+    }
+}
+
 size_t wxVarScrollHelperBase::FindFirstVisibleFromLast(size_t unitLast, bool full) const
 {
     const wxCoord sWindow = GetOrientationTargetSize();
@@ -465,11 +558,23 @@ void wxVarScrollHelperBase::SetTargetWindow(wxWindow *target)
     DoSetTargetWindow(target);
 }
 
+void wxVarScrollHelperBase::EnableSizeCache(bool enable)
+{
+    // free the memory used by the cache if we don't need it any more and
+    // start from scratch if we do
+    delete m_sizeCache;
+    m_sizeCache = enable ? new wxVarScrollSizeCache : nullptr;
+}
+
 void wxVarScrollHelperBase::SetUnitCount(size_t count)
 {
     // save the number of units
     m_unitMax = count;
 
+    // the units are going to change, forget their old sizes
+    if ( m_sizeCache )
+        m_sizeCache->Clear();
+
     // and our estimate for their total height
     m_sizeTotal = EstimateTotalSize();
 
@@ -487,6 +592,9 @@ void wxVarScrollHelperBase::SetUnitCount(size_t count)
 
 void wxVarScrollHelperBase::RefreshUnit(size_t unit)
 {
+    // the size of this unit may have changed
+    UpdateCachedUnitsSize(unit, unit);
+
     // is this unit visible?
     if ( !IsVisible(unit) )
     {
@@ -512,6 +620,8 @@ void wxVarScrollHelperBase::RefreshUnits(size_t from, size_t to)
 {
     wxASSERT_MSG( from <= to, wxT("RefreshUnits(): empty range") );
 
+    UpdateCachedUnitsSize(from, to);
+
     // clump the range to just the visible units -- it is useless to refresh
     // the other ones
     if ( from < GetVisibleBegin() )
@@ -548,6 +658,9 @@ void wxVarScrollHelperBase::RefreshUnits(size_t from, size_t to)
 
 void wxVarScrollHelperBase::RefreshAll()
 {
+    if ( m_sizeCache )
+        m_sizeCache->Clear();
+
     UpdateScrollbar();
 
     m_targetWindow->Refresh();
@@ -577,6 +690,22 @@ bool wxVarScrollHelperBase::ScrollLayout()
 int wxVarScrollHelperBase::VirtualHitTest(wxCoord coord) const
 {
     const size_t unitMax = GetVisibleEnd();
+
+    if ( m_sizeCache && unitMax > GetVisibleBegin() )
+    {
+        // make sure the sizes of all the visible units are known, the units
+        // after them have 0 size in the cache and so are never found
+        const wxCoord pos = coord + GetScrollOffset();
+        GetCachedUnitOffset(unitMax);
+
+        const size_t unit = m_sizeCache->m_ends.FindPos(pos);
+        if ( unit >= unitMax )
+            return wxNOT_FOUND;
+
+        // for consistency with the code below, return the first visible unit
+        // for the positions above it
+        return static_cast<int>(wxMax(unit, GetVisibleBegin()));
+    }
     for ( size_t unit = GetVisibleBegin(); unit < unitMax; ++unit )
     {
         coord -= OnGetUnitSize(unit);
@@ -837,6 +966,9 @@ bool wxVarHVScrollHelper::ScrollToRowColumn(size_t row, size_t column)
 
 void wxVarHVScrollHelper::RefreshRowColumn(size_t row, size_t column)
 {
+    wxVarVScrollHelper::UpdateCachedUnitsSize(row, row);
+    wxVarHScrollHelper::UpdateCachedUnitsSize(column, column);
+
     // is this unit visible?
     if ( !IsRowVisible(row) || !IsColumnVisible(column) )
     {
@@ -886,6 +1018,9 @@ void wxVarHVScrollHelper::RefreshRowsColumns(size_t fromRow, size_t toRow,
     wxASSERT_MSG( fromRow <= toRow || fromColumn <= toColumn,
         wxT("RefreshRowsColumns(): empty range") );
 
+    wxVarVScrollHelper::UpdateCachedUnitsSize(fromRow, toRow);
+    wxVarHScrollHelper::UpdateCachedUnitsSize(fromColumn, toColumn);
+
     // clump the range to just the visible units -- it is useless to refresh
     // the other ones
     if ( fromRow < GetVisibleRowsBegin() )
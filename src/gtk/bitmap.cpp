@@ -592,9 +592,20 @@ void wxBitmap::InitFromImage(const wxImage& image, int depth, double scale)
 
     const int w = image.GetWidth();
     const int h = image.GetHeight();
-    const guchar* alpha = image.GetAlpha();
+
+    // Use interleaved RGBA data directly if the image has it in the same
+    // format as GdkPixbuf, this avoids splitting it into RGB and alpha.
+    const guchar* src = image.GetDataRGBA();
+    const guchar* alpha = nullptr;
+    int srcChannels = 4;
+    if (!src || image.GetRGBAFormat() != wxIMAGE_RGBA_STRAIGHT)
+    {
+        src = image.GetData();
+        alpha = image.GetAlpha();
+        srcChannels = 3;
+    }
     if (depth < 0)
-        depth = alpha ? 32 : 24;
+        depth = alpha || srcChannels == 4 ? 32 : 24;
     else if (depth != 1 && depth != 32)
         depth = 24;
     wxBitmapRefData* bmpData = new wxBitmapRefData(w, h, depth);
@@ -603,11 +614,11 @@ void wxBitmap::InitFromImage(const wxImage& image, int depth, double scale)
     GdkPixbuf* pixbuf_dst = gdk_pixbuf_new(GDK_COLORSPACE_RGB, depth == 32, 8, w, h);
     bmpData->m_pixbufNoMask = pixbuf_dst;
     wxASSERT(bmpData->m_bpp == 32 || !gdk_pixbuf_get_has_alpha(bmpData->m_pixbufNoMask));
-    const guchar* src = image.GetData();
 
     guchar* dst = gdk_pixbuf_get_pixels(pixbuf_dst);
     const int dstStride = gdk_pixbuf_get_rowstride(pixbuf_dst);
-    CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride, src, 3, 3 * w, w, h);
+    CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride,
+                  src, srcChannels, srcChannels * w, w, h);
 
     if (depth == 32 && alpha)
     {
@@ -625,7 +636,7 @@ void wxBitmap::InitFromImage(const wxImage& image, int depth, double scale)
         dst = cairo_image_surface_get_data(surface);
         memset(dst, 0xff, stride * h);
         for (int j = 0; j < h; j++, dst += stride)
-            for (int i = 0; i < w; i++, src += 3)
+            for (int i = 0; i < w; i++, src += srcChannels)
                 if (src[0] == r && src[1] == g && src[2] == b)
                     dst[i] = 0;
         cairo_surface_mark_dirty(surface);
@@ -35,6 +35,7 @@
 #include "wx/fontutil.h"
 #include "wx/recguard.h"
 #include "wx/sysopt.h"
+#include "wx/tracezone.h"
 #ifdef __WXGTK3__
     #include "wx/gtk/dc.h"
 #endif
@@ -5771,6 +5772,8 @@ void wxWindowGTK::GTKSendPaintEvents(cairo_t* cr)
 void wxWindowGTK::GTKSendPaintEvents(const GdkRegion* region)
 #endif
 {
+    wxTRACE_ZONE("wxWindow::SendPaintEvents");
+
 #ifdef __WXGTK3__
     {
         cairo_region_t* region = gdk_window_get_clip_region(gtk_widget_get_window(m_wxwindow));
@@ -60,6 +60,7 @@
 #include "wx/power.h"
 #include "wx/scopeguard.h"
 #include "wx/sysopt.h"
+#include "wx/tracezone.h"
 
 #if wxUSE_DRAG_AND_DROP
     #include "wx/dnd.h"
@@ -5429,6 +5430,8 @@ wxStack<wxMSWImpl::PaintData> wxMSWImpl::paintStack;
 
 bool wxWindowMSW::HandlePaint()
 {
+    wxTRACE_ZONE("wxWindow::HandlePaint");
+
     // Don't bother painting a window that is being destroyed: this is more
     // than optimization, as its state may be partially torn down and event
     // handlers may crash.
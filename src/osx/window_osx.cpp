@@ -40,6 +40,7 @@
 #include "wx/spinbutt.h"
 #include "wx/geometry.h"
 #include "wx/weakref.h"
+#include "wx/tracezone.h"
 
 #if wxUSE_LISTCTRL
     #include "wx/listctrl.h"
@@ -1975,6 +1976,8 @@ void wxWindowMac::MacUpdateClippedRects() const
  */
 bool wxWindowMac::MacDoRedraw( long time )
 {
+    wxTRACE_ZONE("wxWindow::MacDoRedraw");
+
     bool handled = false ;
 #ifndef __WXOSX_IPHONE__
     // iOS draws before the window is visible, I assume into off-screen buffer
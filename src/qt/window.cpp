@@ -33,6 +33,7 @@
 #include "wx/window.h"
 #include "wx/dnd.h"
 #include "wx/tooltip.h"
+#include "wx/tracezone.h"
 #include "wx/qt/private/utils.h"
 #include "wx/qt/private/converter.h"
 #include "wx/qt/private/compat.h"
@@ -1532,6 +1533,8 @@ bool wxWindowQt::IsDoubleBuffered() const
 
 bool wxWindowQt::QtHandlePaintEvent ( QWidget *handler, QPaintEvent *event )
 {
+    wxTRACE_ZONE("wxWindow::QtHandlePaintEvent");
+
     /* If this window has scrollbars, only let wx handle the event if it is
      * for the client area (the scrolled part). Events for the whole window
      * (including scrollbars and maybe status or menu bars are handled by Qt */
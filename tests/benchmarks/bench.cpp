@@ -15,10 +15,9 @@
 // headers
 // ----------------------------------------------------------------------------
 
-#include <float.h>
-
 #include "wx/app.h"
 #include "wx/cmdline.h"
+#include "wx/ffile.h"
 #include "wx/stopwatch.h"
 #include "wx/uilocale.h"
 
@@ -28,6 +27,12 @@
 
 #include "bench.h"
 
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <map>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -40,6 +45,37 @@ static const char OPTION_NUM_RUNS = 'n';
 static const char OPTION_NUMERIC_PARAM = 'p';
 static const char OPTION_STRING_PARAM = 's';
 
+static const char OPTION_WARMUP = 'w';
+static const char OPTION_JSON = 'j';
+static const char OPTION_COMPARE = 'c';
+static const char* const OPTION_THRESHOLD = "threshold";
+
+// ----------------------------------------------------------------------------
+// BenchResult: statistics for a single benchmark
+// ----------------------------------------------------------------------------
+
+struct BenchResult
+{
+    // Compute the statistics from the times of all runs in microseconds.
+    BenchResult(const wxString& name_,
+                std::vector<double> times,
+                const std::vector<double>& cpuTimes);
+
+    wxString name;
+
+    long runs;
+
+    // All times are in microseconds, "cpu" is the CPU time used by the
+    // process while all the other ones are the wall clock times.
+    double mean,
+           stddev,
+           median,
+           p95,
+           min,
+           max,
+           cpu;
+};
+
 // ----------------------------------------------------------------------------
 // BenchApp declaration
 // ----------------------------------------------------------------------------
@@ -74,12 +110,32 @@ private:
     // list all registered benchmarks
     void ListBenchmarks();
 
+    // write m_results to m_jsonFile
+    bool WriteJSON() const;
+
+    // compare the results in the two JSON files given on the command line
+    int CompareResults() const;
+
     // command lines options/parameters
     wxSortedArrayString m_toRun;
     long m_numRuns, // number of times to run a single benchmark or 0
          m_runTime, // minimum time to run a single benchmark if m_numRuns == 0
-         m_numParam;
+         m_numParam,
+         m_numWarmup; // number of runs to perform before measuring
     wxString m_strParam;
+
+    // name of the file to write results to, if not empty
+    wxString m_jsonFile;
+
+    // if m_compare is true, we don't run any benchmarks but compare the
+    // results in the given JSON files and report the regressions exceeding
+    // the threshold, in percents
+    bool m_compare;
+    wxString m_compareOld,
+             m_compareNew;
+    double m_threshold;
+
+    std::vector<BenchResult> m_results;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -102,6 +158,134 @@ wxString Bench::GetStringParameter(const wxString& defVal)
     return !val.empty() ? val : defVal;
 }
 
+// ============================================================================
+// helpers
+// ============================================================================
+
+namespace
+{
+
+// Return the string quoted and escaped as a JSON string.
+wxString JSONString(const wxString& str)
+{
+    wxString quoted('"');
+    for ( const wxUniChar ch : str )
+    {
+        if ( ch == '"' || ch == '\\' )
+            quoted << '\\' << ch;
+        else if ( ch < 0x20 )
+            quoted << wxString::Format("\\u%04x", static_cast<unsigned>(ch));
+        else
+            quoted << ch;
+    }
+
+    return quoted << '"';
+}
+
+// Read the median times of all benchmarks from the file created by
+// BenchApp::WriteJSON().
+//
+// Note that this is not a general JSON parser, it only handles the subset of
+// JSON used by the files we create ourselves.
+bool ReadMedianTimes(const wxString& filename, std::map<wxString, double>& times)
+{
+    wxFFile file(filename, "rb");
+    wxString contents;
+    if ( !file.IsOpened() || !file.ReadAll(&contents, wxConvUTF8) )
+        return false;
+
+    const std::string json = contents.utf8_string();
+
+    // The last string seen, the key of the current value (i.e. the string
+    // before the last colon) and the name of the current benchmark.
+    std::string str, key, name;
+    for ( size_t n = 0; n < json.size(); n++ )
+    {
+        const char ch = json[n];
+        switch ( ch )
+        {
+            case '"':
+                str.clear();
+                for ( n++; n < json.size() && json[n] != '"'; n++ )
+                {
+                    if ( json[n] == '\\' && n + 1 < json.size() )
+                        n++;
+                    str += json[n];
+                }
+
+                if ( key == "name" )
+                    name = str;
+                break;
+
+            case ':':
+                key = str;
+                break;
+
+            case ',':
+            case '{':
+            case '}':
+                key.clear();
+                break;
+
+            default:
+                if ( key == "median_us" && (isdigit(ch) || ch == '-') )
+                {
+                    const size_t start = n;
+                    while ( n + 1 < json.size() &&
+                                strchr("0123456789.eE+-", json[n + 1]) )
+                        n++;
+
+                    double value;
+                    if ( !wxString(json.substr(start, n - start + 1)).ToCDouble(&value) )
+                        return false;
+
+                    times[wxString::FromUTF8(name)] = value;
+                }
+        }
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// BenchResult implementation
+// ============================================================================
+
+BenchResult::BenchResult(const wxString& name_,
+                         std::vector<double> times,
+                         const std::vector<double>& cpuTimes)
+    : name(name_),
+      runs(static_cast<long>(times.size()))
+{
+    mean = 0;
+    for ( const double t : times )
+        mean += t;
+    mean /= runs;
+
+    double sumSquares = 0;
+    for ( const double t : times )
+        sumSquares += (t - mean)*(t - mean);
+    stddev = runs > 1 ? std::sqrt(sumSquares / (runs - 1)) : 0;
+
+    std::sort(times.begin(), times.end());
+    min = times.front();
+    max = times.back();
+
+    const size_t middle = times.size() / 2;
+    median = times.size() % 2 ? times[middle]
+                              : (times[middle - 1] + times[middle]) / 2;
+
+    // Use the nearest rank definition of the percentile.
+    p95 = times[static_cast<size_t>(std::ceil(0.95*runs)) - 1];
+
+    cpu = 0;
+    for ( const double t : cpuTimes )
+        cpu += t;
+    cpu /= runs;
+}
+
 // ============================================================================
 // BenchApp implementation
 // ============================================================================
@@ -111,6 +295,9 @@ BenchApp::BenchApp()
     m_numRuns = 0; // this means to use m_runTime
     m_runTime = 500; // default minimum
     m_numParam = 0;
+    m_numWarmup = 0;
+    m_compare = false;
+    m_threshold = 5.0;
 }
 
 bool BenchApp::OnInit()
@@ -121,6 +308,9 @@ bool BenchApp::OnInit()
     // Some benchmarks are locale-sensitive, so use the current locale.
     wxUILocale::UseDefault();
 
+    if ( m_compare )
+        return true;
+
     wxPrintf("wxWidgets benchmarking program\n"
              "Build: %s\n", WX_BUILD_OPTIONS_SIGNATURE);
 
@@ -176,6 +366,32 @@ void BenchApp::OnInitCmdLine(wxCmdLineParser& parser)
                      "string parameter used by some benchmark functions "
                      "(default: empty)",
                      wxCMD_LINE_VAL_STRING);
+    parser.AddOption(OPTION_WARMUP,
+                     "warmup",
+                     wxString::Format
+                     (
+                         "number of times to run each benchmark before "
+                         "starting to measure it (default: %ld)",
+                         m_numWarmup
+                     ),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(OPTION_JSON,
+                     "json",
+                     "write the results to the given file in JSON format",
+                     wxCMD_LINE_VAL_STRING);
+    parser.AddSwitch(OPTION_COMPARE,
+                     "compare",
+                     "compare the results in the two JSON files given "
+                     "instead of benchmark names");
+    parser.AddOption("",
+                     OPTION_THRESHOLD,
+                     wxString::Format
+                     (
+                         "percentage of the median time increase considered "
+                         "to be a regression when comparing (default: %g)",
+                         m_threshold
+                     ),
+                     wxCMD_LINE_VAL_DOUBLE);
 
     parser.AddParam("benchmark name",
                     wxCMD_LINE_VAL_STRING,
@@ -201,10 +417,29 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
         return false;
     }
 
+    parser.Found(OPTION_THRESHOLD, &m_threshold);
+    if ( parser.Found(OPTION_COMPARE) )
+    {
+        if ( count != 2 )
+        {
+            wxFprintf(stderr, "Exactly two files must be given to compare.\n");
+
+            return false;
+        }
+
+        m_compare = true;
+        m_compareOld = parser.GetParam(0);
+        m_compareNew = parser.GetParam(1);
+
+        return BenchAppBase::OnCmdLineParsed(parser);
+    }
+
     const bool runTimeSpecified = parser.Found(OPTION_RUN_TIME, &m_runTime);
     const bool numRunsSpecified = parser.Found(OPTION_NUM_RUNS, &m_numRuns);
     parser.Found(OPTION_NUMERIC_PARAM, &m_numParam);
     parser.Found(OPTION_STRING_PARAM, &m_strParam);
+    parser.Found(OPTION_WARMUP, &m_numWarmup);
+    parser.Found(OPTION_JSON, &m_jsonFile);
     if ( parser.Found(OPTION_SINGLE) )
     {
         if ( runTimeSpecified || numRunsSpecified )
@@ -248,6 +483,9 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
 
 int BenchApp::OnRun()
 {
+    if ( m_compare )
+        return CompareResults();
+
     int rc = EXIT_SUCCESS;
 
     wxString params;
@@ -277,6 +515,9 @@ int BenchApp::OnRun()
         }
     }
 
+    if ( !m_jsonFile.empty() && !WriteJSON() )
+        rc = EXIT_FAILURE;
+
     return rc;
 }
 
@@ -288,54 +529,31 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
     wxPrintf("%-30s", wxString(func->GetName()) + ':');
     fflush(stdout);
 
-    // We use the algorithm for iteratively computing the mean and the
-    // standard deviation of the sequence of values described in Knuth's
-    // "The Art of Computer Programming, Volume 2: Seminumerical
-    // Algorithms", section 4.2.2.
-    //
-    // The algorithm defines the sequences M(k) and S(k) as follows:
-    //
-    //  M(1) = x(1), M(k) = M(k-1) + (x(k) - M(k-1)) / k
-    //  S(1) = 0,    S(k) = S(k-1) + (x(k) - M(k-1))*(x(k) - M(k))
-    //
-    // where x(k) is the k-th value. Then the mean is simply the last value
-    // of the first sequence M(N) and the standard deviation is
-    // sqrt(S(N)/(N-1)).
-
-    wxStopWatch swTotal;
-    if ( !func->Run() )
-        return false;
-
-    double timeMin = DBL_MAX,
-           timeMax = 0;
+    // Let the benchmark warm up the caches, allocate any memory it needs and
+    // so on without taking the time of these runs into account.
+    for ( long n = 0; n < m_numWarmup; n++ )
+    {
+        if ( !func->Run() )
+            return false;
+    }
 
-    double m = swTotal.TimeInMicro().ToDouble();
-    double s = 0;
+    std::vector<double> times,
+                        cpuTimes;
 
-    long n = 0;
+    wxStopWatch swTotal;
     for ( ;; )
     {
-        // One termination condition is reaching the maximum number of runs.
-        if ( ++n == m_numRuns )
-            break;
-
-        double t;
-        {
-            wxStopWatch swThis;
-            if ( !func->Run() )
-                return false;
-
-            t = swThis.TimeInMicro().ToDouble();
-        }
+        const std::clock_t cpuStart = std::clock();
+        wxStopWatch swThis;
+        if ( !func->Run() )
+            return false;
 
-        if ( t < timeMin )
-            timeMin = t;
-        if ( t > timeMax )
-            timeMax = t;
+        times.push_back(swThis.TimeInMicro().ToDouble());
+        cpuTimes.push_back(1e6*(std::clock() - cpuStart) / CLOCKS_PER_SEC);
 
-        const double lastM = m;
-        m += (t - lastM) / n;
-        s += (t - lastM)*(t - m);
+        // One termination condition is reaching the maximum number of runs.
+        if ( static_cast<long>(times.size()) == m_numRuns )
+            break;
 
         // The other termination condition is that we are running for at least
         // m_runTime milliseconds.
@@ -345,25 +563,29 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 
     func->Done();
 
-    // For a single run there is no standard deviation and min/max don't make
-    // much sense.
-    if ( n == 1 )
+    const BenchResult result(func->GetName(), times, cpuTimes);
+
+    // For a single run there is no standard deviation and the other
+    // statistics don't make much sense.
+    if ( result.runs == 1 )
     {
-        wxPrintf("single run took %.0fus\n", m);
+        wxPrintf("single run took %.0fus\n", result.mean);
     }
     else
     {
-        s = sqrt(s / (n - 1));
-
         wxPrintf
         (
-            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)\n",
-            n, m, s, timeMin, timeMax
+            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max), "
+            "%.0fus median, %.0fus p95, %.0fus CPU avg\n",
+            result.runs, result.mean, result.stddev, result.min, result.max,
+            result.median, result.p95, result.cpu
         );
     }
 
     fflush(stdout);
 
+    m_results.push_back(result);
+
     return true;
 }
 
@@ -387,3 +609,103 @@ void BenchApp::ListBenchmarks()
         wxPrintf("\t%s\n", func->GetName());
     }
 }
+
+bool BenchApp::WriteJSON() const
+{
+    wxFFile file(m_jsonFile, "w");
+    if ( !file.IsOpened() )
+        return false;
+
+    // Don't use Format() for floating point numbers, as they must always use
+    // the period as decimal separator in JSON.
+    const auto num = [](double value) { return wxString::FromCDouble(value, 3); };
+
+    wxString json;
+    json << "{\n"
+         << "  \"build\": " << JSONString(WX_BUILD_OPTIONS_SIGNATURE) << ",\n"
+         << "  \"num_param\": " << m_numParam << ",\n"
+         << "  \"str_param\": " << JSONString(m_strParam) << ",\n"
+         << "  \"benchmarks\": [";
+
+    for ( size_t n = 0; n < m_results.size(); n++ )
+    {
+        const BenchResult& r = m_results[n];
+
+        json << (n ? "," : "") << "\n"
+             << "    {\n"
+             << "      \"name\": " << JSONString(r.name) << ",\n"
+             << "      \"runs\": " << r.runs << ",\n"
+             << "      \"mean_us\": " << num(r.mean) << ",\n"
+             << "      \"stddev_us\": " << num(r.stddev) << ",\n"
+             << "      \"median_us\": " << num(r.median) << ",\n"
+             << "      \"p95_us\": " << num(r.p95) << ",\n"
+             << "      \"min_us\": " << num(r.min) << ",\n"
+             << "      \"max_us\": " << num(r.max) << ",\n"
+             << "      \"cpu_mean_us\": " << num(r.cpu) << "\n"
+             << "    }";
+    }
+
+    json << "\n  ]\n}\n";
+
+    return file.Write(json, wxConvUTF8);
+}
+
+int BenchApp::CompareResults() const
+{
+    std::map<wxString, double> timesOld,
+                               timesNew;
+    if ( !ReadMedianTimes(m_compareOld, timesOld) )
+    {
+        wxFprintf(stderr, "Failed to read results from \"%s\".\n", m_compareOld);
+        return EXIT_FAILURE;
+    }
+
+    if ( !ReadMedianTimes(m_compareNew, timesNew) )
+    {
+        wxFprintf(stderr, "Failed to read results from \"%s\".\n", m_compareNew);
+        return EXIT_FAILURE;
+    }
+
+    wxPrintf("Comparing median times, regression threshold is %g%%\n",
+             m_threshold);
+
+    int numRegressions = 0;
+    for ( const auto& kv : timesNew )
+    {
+        const wxString name = kv.first + ':';
+
+        const auto it = timesOld.find(kv.first);
+        if ( it == timesOld.end() )
+        {
+            wxPrintf("%-30s only in the new results\n", name);
+            continue;
+        }
+
+        const double timeOld = it->second,
+                     timeNew = kv.second;
+        const double change = timeOld > 0 ? 100*(timeNew - timeOld) / timeOld
+                                           : 0;
+
+        const bool isRegression = change > m_threshold;
+        if ( isRegression )
+            numRegressions++;
+
+        wxPrintf("%-30s %10.0fus -> %10.0fus (%+6.1f%%)%s\n",
+                 name, timeOld, timeNew, change,
+                 isRegression ? "  REGRESSION" : "");
+    }
+
+    for ( const auto& kv : timesOld )
+    {
+        if ( timesNew.find(kv.first) == timesNew.end() )
+            wxPrintf("%-30s only in the old results\n", kv.first + ':');
+    }
+
+    if ( numRegressions )
+    {
+        wxPrintf("%d regression(s) found.\n", numRegressions);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -17,3 +17,47 @@ BENCHMARK_FUNC(ParseDate)
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+
+// Typical log timestamp format: it uses "%l" which prevents Format() from
+// using strftime() and so exercises its own formatting code.
+static const char* const LOG_TIMESTAMP_FORMAT = "%Y-%m-%d %H:%M:%S.%l";
+
+static const wxDateTime& GetLogTimestamp()
+{
+    static const wxDateTime s_dt(23, wxDateTime::May, 2011, 12, 34, 56, 789);
+    return s_dt;
+}
+
+BENCHMARK_FUNC(DateTimeFormat)
+{
+    const wxString s = GetLogTimestamp().Format(LOG_TIMESTAMP_FORMAT);
+    return s.length() == 23;
+}
+
+BENCHMARK_FUNC(DateTimeFormatter)
+{
+    static const wxDateTimeFormatter s_formatter(LOG_TIMESTAMP_FORMAT);
+    static wxString s_buf;
+
+    s_buf.clear();
+    s_formatter.FormatTo(s_buf, GetLogTimestamp());
+    return s_buf.length() == 23;
+}
+
+BENCHMARK_FUNC(DateTimeParseFormat)
+{
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return dt.ParseFormat("2011-05-23 12:34:56.789", LOG_TIMESTAMP_FORMAT, &end) &&
+            dt.GetMillisecond() == 789;
+}
+
+BENCHMARK_FUNC(DateTimeFormatterParse)
+{
+    static const wxDateTimeFormatter s_formatter(LOG_TIMESTAMP_FORMAT);
+
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return s_formatter.Parse("2011-05-23 12:34:56.789", dt, &end) &&
+            dt.GetMillisecond() == 789;
+}
@@ -0,0 +1,157 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Benchmarks for queuing and processing events
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+
+#include "bench.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Handler simply counting the events it gets.
+class CountingHandler : public wxEvtHandler
+{
+public:
+    CountingHandler()
+    {
+        Bind(wxEVT_THREAD, [this](wxThreadEvent&) { m_count++; });
+    }
+
+    int m_count = 0;
+};
+
+} // anonymous namespace
+
+// Queue many events from the main thread and then process all of them.
+BENCHMARK_FUNC(QueueEvent)
+{
+    const int numEvents = Bench::GetNumericParameter(10000);
+
+    CountingHandler handler;
+    for ( int n = 0; n < numEvents; n++ )
+        handler.QueueEvent(new wxThreadEvent());
+
+    wxTheApp->ProcessPendingEvents();
+
+    return handler.m_count == numEvents;
+}
+
+// Queue many events with the same id when coalescing them: only the last one
+// is processed.
+BENCHMARK_FUNC(QueueEventCoalesced)
+{
+    const int numEvents = Bench::GetNumericParameter(10000);
+
+    CountingHandler handler;
+    handler.CoalesceQueuedEvents(wxEVT_THREAD);
+    for ( int n = 0; n < numEvents; n++ )
+        handler.QueueEvent(new wxThreadEvent());
+
+    wxTheApp->ProcessPendingEvents();
+
+    return handler.m_count == 1;
+}
+
+// Process an event for a handler having many handlers bound to it, almost all
+// of them for other event types.
+BENCHMARK_FUNC(ProcessEventManyBinds)
+{
+    static const int numBinds = Bench::GetNumericParameter(10000) / 10;
+
+    static CountingHandler handler;
+    static bool s_initialized = false;
+    if ( !s_initialized )
+    {
+        for ( int n = 0; n < numBinds; n++ )
+        {
+            handler.Bind(wxEventTypeTag<wxThreadEvent>(wxNewEventType()),
+                         [](wxThreadEvent&) { });
+        }
+
+        s_initialized = true;
+    }
+
+    wxThreadEvent event;
+    for ( int n = 0; n < 100; n++ )
+        handler.ProcessEvent(event);
+
+    return handler.m_count > 0;
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class QueueingThread : public wxThread
+{
+public:
+    QueueingThread(wxEvtHandler& handler, int numEvents)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_numEvents(numEvents)
+    {
+    }
+
+protected:
+    virtual void* Entry() override
+    {
+        for ( int n = 0; n < m_numEvents; n++ )
+            m_handler.QueueEvent(new wxThreadEvent());
+
+        return nullptr;
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const int m_numEvents;
+};
+
+// Queue events from the given number of worker threads while processing them
+// in the main thread.
+bool QueueEventFromThreads(int numThreads)
+{
+    const int numEvents = Bench::GetNumericParameter(10000);
+
+    CountingHandler handler;
+
+    std::vector<std::unique_ptr<QueueingThread>> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads.emplace_back(new QueueingThread(handler, numEvents));
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    while ( handler.m_count < numThreads*numEvents )
+        wxTheApp->ProcessPendingEvents();
+
+    for ( auto& thread : threads )
+        thread->Wait();
+
+    return true;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(QueueEventOneThread)
+{
+    return QueueEventFromThreads(1);
+}
+
+BENCHMARK_FUNC(QueueEventFourThreads)
+{
+    return QueueEventFromThreads(4);
+}
+
+#endif // wxUSE_THREADS
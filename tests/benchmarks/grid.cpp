@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid benchmarks
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/frame.h"
+#include "wx/grid.h"
+
+#include "bench.h"
+
+#include <random>
+
+namespace
+{
+
+// Table with the given number of rows and columns which doesn't store anything.
+class EmptyTable : public wxGridTableBase
+{
+public:
+    EmptyTable(int numRows, int numCols)
+        : m_numRows(numRows),
+          m_numCols(numCols)
+    {
+    }
+
+    virtual int GetNumberRows() override { return m_numRows; }
+    virtual int GetNumberCols() override { return m_numCols; }
+
+    virtual wxString GetValue(int, int) override { return wxString(); }
+    virtual void SetValue(int, int, const wxString&) override { }
+
+private:
+    const int m_numRows,
+              m_numCols;
+};
+
+// Return the grid with the number of rows given by the benchmark parameter,
+// creating it if necessary.
+wxGrid& GetBigGrid()
+{
+    static wxGrid* s_grid = nullptr;
+    if ( !s_grid )
+    {
+        const int numRows = Bench::GetNumericParameter(1000000);
+
+        wxFrame* const frame = new wxFrame(nullptr, wxID_ANY, "Grid benchmark");
+        s_grid = new wxGrid(frame, wxID_ANY);
+        s_grid->AssignTable(new EmptyTable(numRows, 10));
+    }
+
+    return *s_grid;
+}
+
+std::mt19937 gs_random;
+
+} // anonymous namespace
+
+// Change the height of random rows of a big grid.
+BENCHMARK_FUNC(GridSetRowSize)
+{
+    wxGrid& grid = GetBigGrid();
+    wxGridUpdateLocker lock(&grid);
+
+    std::uniform_int_distribution<int> rows(0, grid.GetNumberRows() - 1);
+    std::uniform_int_distribution<int> heights(10, 50);
+    for ( int n = 0; n < 100; n++ )
+        grid.SetRowSize(rows(gs_random), heights(gs_random));
+
+    return grid.GetRowSize(0) > 0;
+}
+
+// Hide and show back random rows of a big grid.
+BENCHMARK_FUNC(GridHideShowRow)
+{
+    wxGrid& grid = GetBigGrid();
+    wxGridUpdateLocker lock(&grid);
+
+    std::uniform_int_distribution<int> rows(0, grid.GetNumberRows() - 1);
+    for ( int n = 0; n < 100; n++ )
+    {
+        const int row = rows(gs_random);
+        grid.HideRow(row);
+        grid.ShowRow(row);
+    }
+
+    return grid.GetRowSize(0) > 0;
+}
+
+// Find the rows at random positions in a big grid.
+BENCHMARK_FUNC(GridYToRow)
+{
+    wxGrid& grid = GetBigGrid();
+
+    // Ensure that the grid doesn't use the default row height for all rows,
+    // as this would make finding the row trivial.
+    grid.SetRowSize(0, grid.GetDefaultRowSize() + 1);
+
+    const int height = grid.CellToRect(grid.GetNumberRows() - 1, 0).GetBottom();
+
+    std::uniform_int_distribution<int> coords(0, height - 1);
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( grid.YToRow(coords(gs_random)) == wxNOT_FOUND )
+            return false;
+    }
+
+    return true;
+}
@@ -8,6 +8,8 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "wx/image.h"
+#include "wx/mstream.h"
+#include "wx/utils.h"
 
 #include "bench.h"
 
@@ -30,6 +32,71 @@ BENCHMARK_FUNC(LoadJPEG)
     return image.LoadFile("horse.jpg");
 }
 
+// Return a big JPEG image, as would be produced by a typical camera, in memory.
+static const wxMemoryBuffer& GetBigJPEG()
+{
+    static wxMemoryBuffer s_buf;
+    if ( s_buf.IsEmpty() )
+    {
+        if ( !wxImage::FindHandler(wxBITMAP_TYPE_JPEG) )
+            wxImage::AddHandler(new wxJPEGHandler);
+
+        wxImage image(4000, 3000, false);
+        unsigned char* p = image.GetData();
+        for ( int y = 0; y < image.GetHeight(); y++ )
+        {
+            for ( int x = 0; x < image.GetWidth(); x++ )
+            {
+                *p++ = x;
+                *p++ = y;
+                *p++ = x ^ y;
+            }
+        }
+
+        wxMemoryOutputStream mos;
+        image.SaveFile(mos, wxBITMAP_TYPE_JPEG);
+
+        const size_t len = mos.GetLength();
+        mos.CopyTo(s_buf.GetWriteBuf(len), len);
+        s_buf.UngetWriteBuf(len);
+    }
+
+    return s_buf;
+}
+
+// Compare loading a thumbnail using wxIMAGE_OPTION_MAX_WIDTH, which uses
+// reduced size JPEG decoding, with loading the full image and rescaling it.
+BENCHMARK_FUNC(LoadJPEGThumbnail)
+{
+    const wxMemoryBuffer& buf = GetBigJPEG();
+    wxMemoryInputStream mis(buf.GetData(), buf.GetDataLen());
+
+    const int size = Bench::GetNumericParameter(128);
+
+    wxImage image;
+    image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, size);
+    image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, size);
+    return image.LoadFile(mis, wxBITMAP_TYPE_JPEG);
+}
+
+BENCHMARK_FUNC(LoadJPEGAndRescale)
+{
+    const wxMemoryBuffer& buf = GetBigJPEG();
+    wxMemoryInputStream mis(buf.GetData(), buf.GetDataLen());
+
+    const int size = Bench::GetNumericParameter(128);
+
+    wxImage image;
+    if ( !image.LoadFile(mis, wxBITMAP_TYPE_JPEG) )
+        return false;
+
+    const double scale = wxMin(double(size) / image.GetWidth(),
+                               double(size) / image.GetHeight());
+    image.Rescale(scale*image.GetWidth(), scale*image.GetHeight(),
+                  wxIMAGE_QUALITY_HIGH);
+    return image.IsOk();
+}
+
 BENCHMARK_FUNC(LoadPNG)
 {
     static bool s_handlerAdded = false;
@@ -118,3 +185,117 @@ BENCHMARK_FUNC(ShrinkHighQuality)
     return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
                        wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+BENCHMARK_FUNC(ShrinkBilinear)
+{
+    const wxImage& image = GetTestImage();
+    const double factor = Bench::GetNumericParameter(50) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_BILINEAR).IsOk();
+}
+
+BENCHMARK_FUNC(EnlargeBilinear)
+{
+    const wxImage& image = GetTestImage();
+    const double factor = Bench::GetNumericParameter(150) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_BILINEAR).IsOk();
+}
+
+BENCHMARK_FUNC(EnlargeBicubic)
+{
+    const wxImage& image = GetTestImage();
+    const double factor = Bench::GetNumericParameter(150) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_BICUBIC).IsOk();
+}
+
+// Same image as GetTestImage() but with a non-trivial alpha channel, to
+// measure the cost of alpha-weighted resampling.
+static const wxImage& GetTestImageWithAlpha()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        s_image = GetTestImage().Copy();
+        if ( s_image.IsOk() )
+        {
+            s_image.SetAlpha();
+
+            const int width = s_image.GetWidth();
+            const int height = s_image.GetHeight();
+            unsigned char* alpha = s_image.GetAlpha();
+            for ( int y = 0; y < height; y++ )
+            {
+                for ( int x = 0; x < width; x++ )
+                    *alpha++ = static_cast<unsigned char>((x + y) & 0xff);
+            }
+        }
+    }
+
+    return s_image;
+}
+
+BENCHMARK_FUNC(ShrinkBoxAverageAlpha)
+{
+    const wxImage& image = GetTestImageWithAlpha();
+    const double factor = Bench::GetNumericParameter(50) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_BOX_AVERAGE).IsOk();
+}
+
+BENCHMARK_FUNC(EnlargeBilinearAlpha)
+{
+    const wxImage& image = GetTestImageWithAlpha();
+    const double factor = Bench::GetNumericParameter(150) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_BILINEAR).IsOk();
+}
+
+BENCHMARK_FUNC(EnlargeBicubicAlpha)
+{
+    const wxImage& image = GetTestImageWithAlpha();
+    const double factor = Bench::GetNumericParameter(150) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_BICUBIC).IsOk();
+}
+
+// Helper temporarily allowing wxImage to use as many threads as there are CPUs.
+class ImageAllThreadsUser
+{
+public:
+    ImageAllThreadsUser() { wxImage::SetMaxThreads(0); }
+    ~ImageAllThreadsUser() { wxImage::SetMaxThreads(1); }
+};
+
+BENCHMARK_FUNC(EnlargeHighQualityParallel)
+{
+    ImageAllThreadsUser useAllThreads;
+
+    const wxImage& image = GetTestImage();
+    const double factor = Bench::GetNumericParameter(150) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_HIGH).IsOk();
+}
+
+BENCHMARK_FUNC(ShrinkHighQualityParallel)
+{
+    ImageAllThreadsUser useAllThreads;
+
+    const wxImage& image = GetTestImage();
+    const double factor = Bench::GetNumericParameter(50) / 100.;
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       wxIMAGE_QUALITY_HIGH).IsOk();
+}
+
+BENCHMARK_FUNC(Blur)
+{
+    return GetTestImage().Blur(Bench::GetNumericParameter(5)).IsOk();
+}
+
+BENCHMARK_FUNC(BlurParallel)
+{
+    ImageAllThreadsUser useAllThreads;
+
+    return GetTestImage().Blur(Bench::GetNumericParameter(5)).IsOk();
+}
@@ -76,3 +76,98 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+namespace
+{
+
+// The test string repeated many times, either as is or with some of its
+// characters replaced with non-ASCII ones, in both UTF-8 and wide forms.
+struct LongText
+{
+    explicit LongText(bool ascii)
+    {
+        for ( int n = 0; n < 100; n++ )
+            wide += TEST_STRING;
+
+        // Replace Latin "e" and "o" with similarly looking Cyrillic letters.
+        if ( !ascii )
+        {
+            wide.Replace("e", wxString::FromUTF8("\xd0\xb5"));
+            wide.Replace("o", wxString::FromUTF8("\xd0\xbe"));
+        }
+
+        utf8 = wide.utf8_str();
+    }
+
+    wxString wide;
+    wxCharBuffer utf8;
+};
+
+const LongText& GetLongText(bool ascii)
+{
+    static const LongText s_ascii(true);
+    static const LongText s_mixed(false);
+
+    return ascii ? s_ascii : s_mixed;
+}
+
+// Convert the text from UTF-8 into a wide string.
+bool DecodeUTF8(bool ascii)
+{
+    const LongText& text = GetLongText(ascii);
+
+    const size_t len = wxWcslen(text.wide.wc_str()) + 1;
+    wxWCharBuffer buf(len);
+    return wxConvUTF8.ToWChar(buf.data(), len, text.utf8.data()) == len;
+}
+
+// Convert the text from the wide string into UTF-8.
+bool EncodeUTF8(bool ascii)
+{
+    const LongText& text = GetLongText(ascii);
+
+    const size_t len = text.utf8.length() + 1;
+    wxCharBuffer buf(len);
+    return wxConvUTF8.FromWChar(buf.data(), len, text.wide.wc_str()) == len;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(UTF8DecodeASCII)
+{
+    return DecodeUTF8(true);
+}
+
+BENCHMARK_FUNC(UTF8DecodeMixed)
+{
+    return DecodeUTF8(false);
+}
+
+BENCHMARK_FUNC(UTF8EncodeASCII)
+{
+    return EncodeUTF8(true);
+}
+
+BENCHMARK_FUNC(UTF8EncodeMixed)
+{
+    return EncodeUTF8(false);
+}
+
+// Convert the text to newly allocated buffers, as wxString does.
+BENCHMARK_FUNC(UTF8cMB2WC)
+{
+    const LongText& text = GetLongText(false);
+
+    size_t len;
+    return wxConvUTF8.cMB2WC(text.utf8.data(), text.utf8.length(), &len)
+            && len == text.wide.length();
+}
+
+BENCHMARK_FUNC(UTF8cWC2MB)
+{
+    const LongText& text = GetLongText(false);
+
+    size_t len;
+    return wxConvUTF8.cWC2MB(text.wide.wc_str(), text.wide.length(), &len)
+            && len == text.utf8.length();
+}
@@ -132,3 +132,54 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxString formatting
+// ----------------------------------------------------------------------------
+
+// Number of strings formatted by each of the benchmarks below, as formatting
+// a single one takes too little time to be measured reliably.
+static const int NUM_FORMATS = 100;
+
+BENCHMARK_FUNC(StringFormat)
+{
+    for ( int n = 0; n < NUM_FORMATS; n++ )
+    {
+        const wxString s = wxString::Format("This is a short %s string with %d words", "test", n);
+        if ( s.length() < 40 )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(StringFormatLong)
+{
+    for ( int n = 0; n < NUM_FORMATS; n++ )
+    {
+        const wxString s = wxString::Format("Formatting a %s, %d, %.2f", g_verylongString, n, 23.342);
+        if ( s.length() <= g_verylongString.length() )
+            return false;
+    }
+
+    return true;
+}
+
+// Build a log-like string from many lines, as would be done when exporting it.
+BENCHMARK_FUNC(StringFormatAndAppend)
+{
+    wxString s;
+    for ( int n = 0; n < NUM_FORMATS; n++ )
+        s += wxString::Format("Line %d: value=%s (%.1f%%)\n", n, "something", 12.5);
+
+    return !s.empty();
+}
+
+BENCHMARK_FUNC(StringAppendFormat)
+{
+    wxString s;
+    for ( int n = 0; n < NUM_FORMATS; n++ )
+        s.AppendFormat("Line %d: value=%s (%.1f%%)\n", n, "something", 12.5);
+
+    return !s.empty();
+}
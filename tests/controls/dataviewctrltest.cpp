@@ -19,9 +19,7 @@
 #include "wx/dataview.h"
 #include "wx/uiaction.h"
 
-#ifdef __WXGTK__
-    #include "waitfor.h"
-#endif // __WXGTK__
+#include "waitfor.h"
 
 #include "testableframe.h"
 #include "asserthelper.h"
@@ -861,6 +859,528 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+namespace
+{
+
+// List store allowing the control to sort its items by their values.
+class DefaultCompareListStore : public wxDataViewListStore
+{
+public:
+    virtual bool CanSortByValues(unsigned int /* column */) const override
+        { return true; }
+};
+
+// List store sorting its items in the reverse order.
+class ReverseCompareListStore : public wxDataViewListStore
+{
+public:
+    virtual int Compare(const wxDataViewItem& item1,
+                        const wxDataViewItem& item2,
+                        unsigned int column,
+                        bool ascending) const override
+    {
+        return wxDataViewListStore::Compare(item1, item2, column, !ascending);
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
+                 "wxDVC::SortListStore",
+                 "[wxDataViewCtrl][sort]")
+{
+    wxString ascending = "1302",
+             descending = "2031";
+
+    wxDataViewListStore* store = nullptr;
+    SECTION("Default") { }
+    SECTION("Default compare") { store = new DefaultCompareListStore; }
+    SECTION("Custom compare")
+    {
+        store = new ReverseCompareListStore;
+        std::swap(ascending, descending);
+    }
+
+    if ( store )
+    {
+        store->AppendColumn("string");
+        store->AppendColumn("string");
+        m_dvc->AssociateModel(store);
+        store->DecRef();
+    }
+
+    m_dvc->SetSize(400, 300);
+
+    const char* const values[] = { "b", "a", "c", "a" };
+    for ( const char* value : values )
+    {
+        wxVector<wxVariant> data;
+        data.push_back(value);
+        data.push_back(wxString());
+        m_dvc->AppendItem(data);
+    }
+
+    // Return the store rows in the order in which they are shown.
+    const auto getDisplayedRows = [this]()
+    {
+        std::vector<std::pair<int, int>> rows;
+        for ( int row = 0; row < m_dvc->GetItemCount(); row++ )
+            rows.push_back({m_dvc->GetItemRect(m_dvc->RowToItem(row)).y, row});
+
+        std::sort(rows.begin(), rows.end());
+
+        wxString result;
+        for ( const auto& p : rows )
+            result << p.second;
+        return result;
+    };
+
+#ifdef __WXGTK__
+    WaitFor("wxDataViewCtrl to be realized", [this]() {
+        return !m_dvc->GetItemRect(m_dvc->RowToItem(3)).IsEmpty();
+    });
+#endif
+
+    // Items with equal values are ordered by their IDs, i.e. in the order in
+    // which they were added when sorting in ascending order.
+    m_firstColumn->SetSortOrder(true);
+    m_dvc->GetModel()->Resort();
+    CHECK( getDisplayedRows() == ascending );
+
+    m_firstColumn->SetSortOrder(false);
+    m_dvc->GetModel()->Resort();
+    CHECK( getDisplayedRows() == descending );
+}
+
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
+                 "wxDVC::SortInBackground",
+                 "[wxDataViewCtrl][sort]")
+{
+    if ( !m_dvc->SetBackgroundSortingThreshold(2) )
+    {
+        WARN("Skipping test as sorting in background is not supported.");
+        return;
+    }
+
+    wxDataViewListStore* const store = new DefaultCompareListStore;
+    store->AppendColumn("long");
+    store->AppendColumn("string");
+    m_dvc->AssociateModel(store);
+    store->DecRef();
+
+    m_dvc->SetSize(400, 300);
+
+    // Use enough items to sort them in several steps, in a shuffled order,
+    // with 0 being the first one.
+    const long count = 5000;
+    wxVector< wxVector<wxVariant> > rows;
+    for ( long n = 0; n < count; n++ )
+    {
+        wxVector<wxVariant> data;
+        data.push_back((n * 7919) % count);
+        data.push_back(wxString());
+        rows.push_back(data);
+    }
+    m_dvc->AppendItems(std::move(rows));
+
+    // Return the value of the first item shown.
+    const auto getTopValue = [this]()
+    {
+        wxVariant value;
+        m_dvc->GetValue(value, m_dvc->ItemToRow(m_dvc->GetTopItem()), 0);
+        return value.GetLong();
+    };
+
+    REQUIRE( getTopValue() == 0 );
+
+    EventCounter progress(m_dvc, wxEVT_DATAVIEW_SORTING_PROGRESS);
+
+    m_firstColumn->SetSortOrder(false);
+    m_dvc->GetModel()->Resort();
+    CHECK( m_dvc->IsSortingInBackground() );
+
+    SECTION("Complete")
+    {
+        WaitFor("sorting to complete", [this]() {
+            return !m_dvc->IsSortingInBackground();
+        }, 5000);
+
+        CHECK( getTopValue() == count - 1 );
+
+        // The last event is sent after the items are reordered.
+        YieldForAWhile();
+        CHECK( progress.GetCount() > 1 );
+    }
+
+    SECTION("Cancel")
+    {
+        m_dvc->CancelBackgroundSorting();
+        CHECK( !m_dvc->IsSortingInBackground() );
+
+        // The items are left in the old order, which didn't use any column.
+        CHECK( getTopValue() == 0 );
+        CHECK( !m_firstColumn->IsSortKey() );
+    }
+
+    SECTION("Veto")
+    {
+        m_dvc->Bind(wxEVT_DATAVIEW_SORTING_PROGRESS,
+                    [](wxDataViewEvent& event) { event.Veto(); });
+
+        WaitFor("sorting to be cancelled", [this]() {
+            return !m_dvc->IsSortingInBackground();
+        }, 5000);
+
+        CHECK( getTopValue() == 0 );
+        CHECK( !m_firstColumn->IsSortKey() );
+    }
+
+    SECTION("Change")
+    {
+        // Changing the model completes sorting first.
+        wxVector<wxVariant> data;
+        data.push_back(count);
+        data.push_back(wxString());
+        m_dvc->AppendItem(data);
+
+        CHECK( !m_dvc->IsSortingInBackground() );
+        CHECK( getTopValue() == count );
+    }
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
+                 "wxDVC::AppendItems",
+                 "[wxDataViewCtrl][store]")
+{
+    const auto makeRows = [](const char* prefix, int count)
+    {
+        wxVector< wxVector<wxVariant> > rows;
+        for ( int n = 0; n < count; n++ )
+        {
+            wxVector<wxVariant> values;
+            values.push_back(wxString::Format("%s%d", prefix, n));
+            values.push_back(wxString());
+            rows.push_back(values);
+        }
+        return rows;
+    };
+
+    m_dvc->AppendItems(makeRows("a", 100));
+    REQUIRE( m_dvc->GetItemCount() == 100 );
+    CHECK( m_dvc->GetTextValue(0, 0) == "a0" );
+    CHECK( m_dvc->GetTextValue(99, 0) == "a99" );
+
+    m_dvc->SelectRow(50);
+
+    m_dvc->InsertItems(10, makeRows("b", 3));
+    REQUIRE( m_dvc->GetItemCount() == 103 );
+    CHECK( m_dvc->GetTextValue(9, 0) == "a9" );
+    CHECK( m_dvc->GetTextValue(10, 0) == "b0" );
+    CHECK( m_dvc->GetTextValue(12, 0) == "b2" );
+    CHECK( m_dvc->GetTextValue(13, 0) == "a10" );
+
+    // The selected item must have remained the same.
+    CHECK( m_dvc->GetSelectedRow() == 53 );
+    CHECK( m_dvc->GetTextValue(53, 0) == "a50" );
+
+    // Rows with the wrong number of values are not added at all.
+    wxVector< wxVector<wxVariant> > rows = makeRows("c", 2);
+    rows[1].pop_back();
+    WX_ASSERT_FAILS_WITH_ASSERT( m_dvc->AppendItems(std::move(rows)) );
+    CHECK( m_dvc->GetItemCount() == 103 );
+}
+
+TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
+                 "wxDVC::TreeAppendItems",
+                 "[wxDataViewCtrl][store]")
+{
+    // Expand the item before the insertion point to check that the rows of
+    // its children are taken into account when updating the selection.
+    m_dvc->Expand(m_child1);
+    m_dvc->Select(m_child2);
+
+    wxVector<wxString> texts;
+    texts.push_back("a");
+    texts.push_back("b");
+
+    const wxDataViewItemArray items = m_dvc->InsertItems(m_root, m_child2, texts);
+    REQUIRE( items.size() == 2 );
+    CHECK( m_dvc->GetItemText(items[0]) == "a" );
+    CHECK( m_dvc->GetItemText(items[1]) == "b" );
+    CHECK( m_dvc->GetSelection() == m_child2 );
+
+    texts.clear();
+    texts.push_back("c");
+    const wxDataViewItemArray more = m_dvc->AppendItems(m_root, texts);
+    REQUIRE( more.size() == 1 );
+
+    REQUIRE( m_dvc->GetChildCount(m_root) == 5 );
+    CHECK( m_dvc->GetNthChild(m_root, 0) == m_child1 );
+    CHECK( m_dvc->GetNthChild(m_root, 1) == items[0] );
+    CHECK( m_dvc->GetNthChild(m_root, 2) == items[1] );
+    CHECK( m_dvc->GetNthChild(m_root, 3) == m_child2 );
+    CHECK( m_dvc->GetNthChild(m_root, 4) == more[0] );
+
+    CHECK( m_dvc->InsertItems(m_root, m_grandchild, texts).empty() );
+
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+    // Check that the items are shown in the same order as in the store.
+    const int y1 = m_dvc->GetItemRect(m_child1).y;
+    const int ya = m_dvc->GetItemRect(items[0]).y;
+    const int yb = m_dvc->GetItemRect(items[1]).y;
+    const int y2 = m_dvc->GetItemRect(m_child2).y;
+    const int yc = m_dvc->GetItemRect(more[0]).y;
+    CHECK( y1 < ya );
+    CHECK( ya < yb );
+    CHECK( yb < y2 );
+    CHECK( y2 < yc );
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+}
+
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE("wxDVC::TypedValues", "[wxDataViewCtrl][renderer]")
+{
+    // Model with a single row containing a string and a number and counting
+    // the calls to GetValue().
+    class TypedValuesModel : public wxDataViewIndexListModel
+    {
+    public:
+        TypedValuesModel() : wxDataViewIndexListModel(1) { }
+
+        virtual void GetValueByRow(wxVariant& variant,
+                                   unsigned int WXUNUSED(row),
+                                   unsigned int col) const override
+        {
+            m_getValueCount++;
+
+            if ( col == 0 )
+                variant = GetString();
+            else
+                variant = GetLong();
+        }
+
+        virtual bool GetValueAsString(wxString& value,
+                                      const wxDataViewItem& WXUNUSED(item),
+                                      unsigned int col) const override
+        {
+            if ( !m_useTyped || col != 0 )
+                return false;
+
+            value = GetString();
+            return true;
+        }
+
+        virtual bool GetValueAsLong(long& value,
+                                    const wxDataViewItem& WXUNUSED(item),
+                                    unsigned int col) const override
+        {
+            if ( !m_useTyped || col != 1 )
+                return false;
+
+            value = GetLong();
+            return true;
+        }
+
+        virtual bool SetValueByRow(const wxVariant& WXUNUSED(variant),
+                                   unsigned int WXUNUSED(row),
+                                   unsigned int WXUNUSED(col)) override
+        {
+            return false;
+        }
+
+        wxString GetString() const { return "Hello"; }
+        long GetLong() const { return 42; }
+
+        bool m_useTyped = true;
+        mutable int m_getValueCount = 0;
+    };
+
+    // Text renderer remembering the value passed to its SetValue().
+    class SetValueTextRenderer : public wxDataViewTextRenderer
+    {
+    public:
+        virtual bool SetValue(const wxVariant& value) override
+        {
+            m_value = value.GetString();
+            return wxDataViewTextRenderer::SetValue(value);
+        }
+
+        wxString m_value;
+    };
+
+    wxObjectDataPtr<TypedValuesModel> model(new TypedValuesModel());
+    const wxDataViewItem item = model->GetItem(0);
+
+    wxDataViewTextRenderer textRenderer;
+    wxDataViewProgressRenderer progressRenderer;
+    wxVariant value;
+
+    CHECK( textRenderer.PrepareForItem(model.get(), item, 0) );
+#if wxUSE_ACCESSIBILITY
+    CHECK( textRenderer.GetAccessibleDescription() == "Hello" );
+#endif // wxUSE_ACCESSIBILITY
+
+    CHECK( progressRenderer.PrepareForItem(model.get(), item, 1) );
+    CHECK( progressRenderer.GetValue(value) );
+    CHECK( value.GetLong() == 42 );
+
+    CHECK( model->m_getValueCount == 0 );
+
+    // Check that SetValue() overridden in a derived renderer is still called.
+    SetValueTextRenderer setValueRenderer;
+    CHECK( setValueRenderer.PrepareForItem(model.get(), item, 0) );
+    CHECK( setValueRenderer.m_value == "Hello" );
+    CHECK( model->m_getValueCount == 1 );
+
+    // Check that GetValue() is still used if the typed accessors fail.
+    model->m_useTyped = false;
+
+    CHECK( progressRenderer.PrepareForItem(model.get(), item, 1) );
+    CHECK( model->m_getValueCount == 2 );
+}
+
+TEST_CASE("wxDVC::TreeStoreRenderer", "[wxDataViewCtrl][renderer]")
+{
+    // Icon text renderer remembering the value passed to its SetValue().
+    class SetValueIconTextRenderer : public wxDataViewIconTextRenderer
+    {
+    public:
+        virtual bool SetValue(const wxVariant& value) override
+        {
+            m_value << value;
+            return wxDataViewIconTextRenderer::SetValue(value);
+        }
+
+        wxDataViewIconText m_value;
+    };
+
+    wxObjectDataPtr<wxDataViewTreeStore> store(new wxDataViewTreeStore());
+    const wxDataViewItem item = store->AppendItem(wxDataViewItem(), "Item");
+
+    SetValueIconTextRenderer renderer;
+    CHECK( renderer.PrepareForItem(store.get(), item, 0) );
+    CHECK( renderer.m_value.GetText() == "Item" );
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE("wxDVC::ListStoreTypedValues", "[wxDataViewCtrl][store]")
+{
+    wxObjectDataPtr<wxDataViewListStore> store(new wxDataViewListStore());
+    store->AppendColumn("string");
+    store->AppendColumn("long");
+    store->AppendColumn("wxDataViewIconText");
+
+    wxVector<wxVariant> values;
+    values.push_back("Hello");
+    values.push_back(42L);
+    wxVariant iconText;
+    iconText << wxDataViewIconText("Icon");
+    values.push_back(iconText);
+    store->AppendItem(values);
+
+    const wxDataViewItem item = store->GetItem(0);
+
+    wxString s;
+    CHECK( store->GetValueAsString(s, item, 0) );
+    CHECK( s == "Hello" );
+    CHECK( !store->GetValueAsString(s, item, 1) );
+
+    long l = 0;
+    CHECK( store->GetValueAsLong(l, item, 1) );
+    CHECK( l == 42 );
+    CHECK( !store->GetValueAsLong(l, item, 0) );
+
+    wxDataViewIconText it;
+    CHECK( store->GetValueAsIconText(it, item, 2) );
+    CHECK( it.GetText() == "Icon" );
+    CHECK( !store->GetValueAsIconText(it, item, 0) );
+
+    // The values must be updated after changing them.
+    store->SetValueByRow("World", 0, 0);
+    CHECK( store->GetValueAsString(s, item, 0) );
+    CHECK( s == "World" );
+}
+
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE("wxDVC::DerivedStoreValues", "[wxDataViewCtrl][store]")
+{
+    SECTION("List")
+    {
+        // Store returning the values different from the stored ones.
+        class UpperCaseListStore : public wxDataViewListStore
+        {
+        public:
+            virtual void GetValueByRow(wxVariant& value,
+                                       unsigned int row,
+                                       unsigned int col) const override
+            {
+                wxDataViewListStore::GetValueByRow(value, row, col);
+                value = value.GetString().Upper();
+            }
+        };
+
+        wxObjectDataPtr<UpperCaseListStore> store(new UpperCaseListStore());
+        store->AppendColumn("string");
+
+        wxVector<wxVariant> values;
+        values.push_back("Hello");
+        store->AppendItem(values);
+
+        const wxDataViewItem item = store->GetItem(0);
+
+        // The stored value must not be used as it's not the one returned by
+        // the overridden function.
+        wxString s;
+        CHECK( !store->GetValueAsString(s, item, 0) );
+
+        wxDataViewTextRenderer renderer;
+        CHECK( renderer.PrepareForItem(store.get(), item, 0) );
+#if wxUSE_ACCESSIBILITY
+        CHECK( renderer.GetAccessibleDescription() == "HELLO" );
+#endif // wxUSE_ACCESSIBILITY
+    }
+
+    SECTION("Tree")
+    {
+        class UpperCaseTreeStore : public wxDataViewTreeStore
+        {
+        public:
+            virtual void GetValue(wxVariant& variant,
+                                  const wxDataViewItem& item,
+                                  unsigned int col) const override
+            {
+                wxDataViewTreeStore::GetValue(variant, item, col);
+
+                wxDataViewIconText iconText;
+                iconText << variant;
+                iconText.SetText(iconText.GetText().Upper());
+                variant << iconText;
+            }
+        };
+
+        wxObjectDataPtr<UpperCaseTreeStore> store(new UpperCaseTreeStore());
+        const wxDataViewItem item = store->AppendItem(wxDataViewItem(), "Item");
+
+        wxDataViewIconText iconText;
+        CHECK( !store->GetValueAsIconText(iconText, item, 0) );
+
+        wxDataViewIconTextRenderer renderer;
+        CHECK( renderer.PrepareForItem(store.get(), item, 0) );
+#if wxUSE_ACCESSIBILITY
+        CHECK( renderer.GetAccessibleDescription() == "ITEM" );
+#endif // wxUSE_ACCESSIBILITY
+    }
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
@@ -19,6 +19,7 @@
 
 #include "wx/grid.h"
 #include "wx/headerctrl.h"
+#include "wx/generic/private/grid.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -1830,6 +1831,108 @@ void GridTestCase::CheckFirstColAutoSize(int expected)
     CHECK(m_grid->GetColSize(0) == expected);
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeSampling", "[grid]")
+{
+    m_grid->SetCellValue(0, 0, "W");
+    m_grid->SetCellValue(9, 0, "WWWWWWWW");
+
+    m_grid->AutoSizeColumn(0);
+    const int width = m_grid->GetColSize(0);
+
+    m_grid->SetColSize(0, m_grid->GetDefaultColSize());
+
+    CHECK( !m_grid->IsAutoSizeSamplingEnabled() );
+    m_grid->EnableAutoSizeSampling();
+    CHECK( m_grid->IsAutoSizeSamplingEnabled() );
+
+    // All the cells of a small grid are still measured.
+    CheckFirstColAutoSize(width);
+}
+
+namespace
+{
+
+// Renderer measuring all cells as narrow except for the one in the given row.
+// It is also slow enough for AutoSizeColumn() to use sampling.
+class WideRowRenderer : public wxGridCellStringRenderer
+{
+public:
+    enum
+    {
+        NARROW = 100,
+        WIDE = 300
+    };
+
+    explicit WideRowRenderer(int wideRow) : m_wideRow(wideRow) { }
+
+    virtual int GetBestWidth(wxGrid& /*grid*/,
+                             wxGridCellAttr& /*attr*/,
+                             wxDC& /*dc*/,
+                             int row, int /*col*/,
+                             int /*height*/) override
+    {
+        ++m_measured;
+        wxMilliSleep(1);
+
+        return row == m_wideRow ? WIDE : NARROW;
+    }
+
+    virtual wxGridCellRenderer *Clone() const override
+        { return new WideRowRenderer(m_wideRow); }
+
+    int GetMeasuredCount() const { return m_measured; }
+
+private:
+    const int m_wideRow;
+    int m_measured = 0;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeSamplingMany", "[grid]")
+{
+    const int numRows = 1000;
+    m_grid->AppendRows(numRows - m_grid->GetNumberRows());
+    m_grid->EnableAutoSizeSampling();
+
+    // Hardcoded extra margin for the columns used in grid.cpp.
+    const int margin = m_grid->FromDIP(10);
+
+    int wideRow = 0;
+    int expected = 0;
+    SECTION("Off-screen")
+    {
+        // The widest cell is neither visible nor among the first or last
+        // ones, so it is not measured.
+        wideRow = numRows / 2;
+        expected = WideRowRenderer::NARROW;
+    }
+
+    SECTION("Visible")
+    {
+        wideRow = numRows / 2;
+        expected = WideRowRenderer::WIDE;
+        m_grid->MakeCellVisible(wideRow, 0);
+    }
+
+    SECTION("Last")
+    {
+        wideRow = numRows - 1;
+        expected = WideRowRenderer::WIDE;
+    }
+
+    WideRowRenderer* const renderer = new WideRowRenderer(wideRow);
+    wxGridCellAttr* const attr = new wxGridCellAttr;
+    attr->SetRenderer(renderer);
+    m_grid->SetColAttr(0, attr);
+
+    m_grid->AutoSizeColumn(0);
+    CHECK( m_grid->GetColSize(0) == expected + margin );
+
+    // Not all cells were measured.
+    CHECK( renderer->GetMeasuredCount() < numRows );
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumn", "[grid]")
 {
 #ifdef wxHAS_NATIVE_HEADER
@@ -2057,6 +2160,71 @@ TEST_CASE_METHOD(GridTestCase, "Grid::CellAttribute", "[attr][cell][grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::BlockAttribute", "[attr][cell][grid]")
+{
+    SetCellAttr(0, 0);
+    SetCellAttr(2, 1);
+    CHECK_ATTR_COUNT( 2 );
+
+    m_grid->SetAttr(wxGridBlockCoords(1, 0, 3, 1), new wxGridCellAttr);
+    CHECK_ATTR_COUNT( 7 );
+    CHECK( HasCellAttr(0, 0) );
+    CHECK( HasCellAttr(1, 0) );
+    CHECK( HasCellAttr(3, 1) );
+    CHECK( !HasCellAttr(4, 0) );
+
+    // The attribute is shared by all cells of the block and the attribute of
+    // the cell inside it must have been replaced.
+    m_grid->SetCellBackgroundColour(2, 0, *wxRED);
+    CHECK( m_grid->GetCellBackgroundColour(2, 1) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) != *wxRED );
+
+    SECTION("Reset")
+    {
+        m_grid->SetAttr(2, 1, nullptr);
+        CHECK_ATTR_COUNT( 6 );
+        CHECK( !HasCellAttr(2, 1) );
+        CHECK( HasCellAttr(2, 0) );
+
+        m_grid->SetAttr(wxGridBlockCoords(0, 0, 9, 1), nullptr);
+        CHECK_ATTR_COUNT( 0 );
+    }
+
+    SECTION("InsertRows")
+    {
+        m_grid->InsertRows(2, 2);
+        CHECK_ATTR_COUNT( 7 );
+        CHECK( HasCellAttr(1, 1) );
+        CHECK( !HasCellAttr(2, 0) );
+        CHECK( !HasCellAttr(3, 1) );
+        CHECK( HasCellAttr(5, 1) );
+        CHECK( !HasCellAttr(6, 0) );
+        CHECK( m_grid->GetCellBackgroundColour(4, 0) == *wxRED );
+    }
+
+    SECTION("DeleteRows")
+    {
+        m_grid->DeleteRows(0, 2);
+        CHECK_ATTR_COUNT( 4 );
+        CHECK( HasCellAttr(0, 0) );
+        CHECK( HasCellAttr(1, 1) );
+        CHECK( !HasCellAttr(2, 0) );
+    }
+
+    SECTION("Columns")
+    {
+        m_grid->InsertCols(1);
+        CHECK_ATTR_COUNT( 7 );
+        CHECK( HasCellAttr(1, 0) );
+        CHECK( !HasCellAttr(1, 1) );
+        CHECK( HasCellAttr(1, 2) );
+
+        m_grid->DeleteCols(0);
+        CHECK_ATTR_COUNT( 3 );
+        CHECK( HasCellAttr(3, 1) );
+    }
+}
+
 namespace SetTable_ClearAttrCache
 {
 
@@ -2228,6 +2396,35 @@ TEST_CASE_METHOD(GridTestCase, "Grid::SetTable_ClearAttrCache", "[grid]")
 #endif // !__WXOSX__
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::MarkCellDirty", "[grid]")
+{
+    // Fails on OSX for the same reason as the test above.
+#if !defined(__WXOSX__)
+    using namespace SetTable_ClearAttrCache;
+
+    m_grid->SetDefaultRenderer(new Renderer1);
+
+    drawCount1 = 0;
+    UpdateGrid(m_grid);
+    const unsigned int fullCount = drawCount1;
+    INFO("Full redraw draws " << fullCount << " cells");
+
+    drawCount1 = 0;
+    m_grid->MarkCellDirty(0, 0);
+    m_grid->MarkCellDirty(0, 1);
+    m_grid->MarkBlockDirty(wxGridBlockCoords(1, 0, 1, 1));
+    m_grid->RefreshDirtyCells();
+#ifndef __WXQT__
+    m_grid->Update();
+#else
+    wxYield();
+#endif
+
+    CHECK( drawCount1 >= 4 );
+    CHECK( drawCount1 < fullCount );
+#endif // !__WXOSX__
+}
+
 #define CHECK_MULTICELL() CHECK_THAT( *m_grid, HasMulticellOnly(multi) )
 
 #define CHECK_NO_MULTICELL() CHECK_THAT( *m_grid, HasEmptyGrid() )
@@ -2721,6 +2918,108 @@ TEST_CASE("GridBlockCoords::SymDifference", "[grid]")
     }
 }
 
+// wxGridLineEnds is also part of grid sources, so test it here too.
+
+TEST_CASE("GridLineEnds", "[grid]")
+{
+    wxGridLineEnds ends;
+    CHECK( ends.IsEmpty() );
+    CHECK( ends.GetNumberOfLines() == 0 );
+    CHECK( ends.FindPos(0) == 0 );
+
+    // Lines 1, 3 and 4 are hidden, i.e. have zero size.
+    const int sizes[] = { 10, 0, 20, 0, 0, 5 };
+    ends.Init(WXSIZEOF(sizes), [&sizes](int pos) { return sizes[pos]; });
+
+    REQUIRE( !ends.IsEmpty() );
+    CHECK( ends.GetNumberOfLines() == 6 );
+
+    SECTION("GetStart")
+    {
+        CHECK( ends.GetStart(0) == 0 );
+        CHECK( ends.GetStart(1) == 10 );
+        CHECK( ends.GetStart(2) == 10 );
+        CHECK( ends.GetStart(3) == 30 );
+        CHECK( ends.GetStart(4) == 30 );
+        CHECK( ends.GetStart(5) == 30 );
+        CHECK( ends.GetEnd(1) == 10 );
+        CHECK( ends.GetEnd(5) == 35 );
+    }
+
+    SECTION("FindPos")
+    {
+        CHECK( ends.FindPos(0) == 0 );
+        CHECK( ends.FindPos(9) == 0 );
+
+        // Hidden lines must be skipped.
+        CHECK( ends.FindPos(10) == 2 );
+        CHECK( ends.FindPos(29) == 2 );
+        CHECK( ends.FindPos(30) == 5 );
+        CHECK( ends.FindPos(34) == 5 );
+
+        // Coordinates beyond the end give the number of lines.
+        CHECK( ends.FindPos(35) == 6 );
+        CHECK( ends.FindPos(1000) == 6 );
+    }
+
+    SECTION("Add")
+    {
+        // Show the line 1.
+        ends.Add(1, 7);
+        CHECK( ends.GetStart(2) == 17 );
+        CHECK( ends.GetEnd(5) == 42 );
+        CHECK( ends.FindPos(10) == 1 );
+        CHECK( ends.FindPos(16) == 1 );
+        CHECK( ends.FindPos(17) == 2 );
+
+        // Hide the first and the last lines.
+        ends.Add(0, -10);
+        ends.Add(5, -5);
+        CHECK( ends.GetStart(1) == 0 );
+        CHECK( ends.GetStart(5) == 27 );
+        CHECK( ends.GetEnd(5) == 27 );
+        CHECK( ends.FindPos(0) == 1 );
+        CHECK( ends.FindPos(26) == 2 );
+        CHECK( ends.FindPos(27) == 6 );
+    }
+
+    SECTION("AllHidden")
+    {
+        ends.Init(3, [](int) { return 0; });
+        CHECK( ends.GetEnd(2) == 0 );
+        CHECK( ends.FindPos(0) == 3 );
+    }
+
+    SECTION("Many")
+    {
+        // Compare with the naive computation for a bigger number of lines,
+        // with every third one hidden.
+        const int numLines = 100;
+        const auto sizeAt = [](int pos) { return pos % 3 ? pos % 7 + 1 : 0; };
+        ends.Init(numLines, sizeAt);
+
+        int start = 0;
+        for ( int pos = 0; pos < numLines; pos++ )
+        {
+            INFO("Line " << pos);
+            CHECK( ends.GetStart(pos) == start );
+
+            if ( sizeAt(pos) )
+            {
+                CHECK( ends.FindPos(start) == pos );
+                CHECK( ends.FindPos(start + sizeAt(pos) - 1) == pos );
+            }
+
+            start += sizeAt(pos);
+        }
+
+        CHECK( ends.FindPos(start) == numLines );
+    }
+
+    ends.Clear();
+    CHECK( ends.IsEmpty() );
+}
+
 TEST_CASE("wxGrid::Events", "[grid][event]")
 {
     const std::unique_ptr<wxGrid> grid(new wxGrid());
@@ -153,6 +153,54 @@ TEST_CASE_METHOD(ListCtrlTestCase, "ListCtrl::ColumnCount", "[listctrl]")
     CHECK(m_list->GetColumnCount() == 0);
 }
 
+TEST_CASE_METHOD(ListCtrlTestCase, "ListCtrl::VariableLineHeight", "[listctrl]")
+{
+    if ( !m_list->EnableVariableLineHeight() )
+    {
+        WARN("Skipping test not supported by this wxListCtrl implementation.");
+        return;
+    }
+
+    CHECK( m_list->HasVariableLineHeight() );
+
+    m_list->InsertColumn(0, "Column 0");
+    m_list->InsertColumn(1, "Column 1");
+    m_list->InsertItem(0, "First");
+    m_list->InsertItem(1, "Second");
+    m_list->SetItem(1, 1, "Second\nitem\nlines");
+    m_list->InsertItem(2, "Third");
+
+    wxRect rect0, rect1, rect2;
+    REQUIRE( m_list->GetItemRect(0, rect0) );
+    REQUIRE( m_list->GetItemRect(1, rect1) );
+    REQUIRE( m_list->GetItemRect(2, rect2) );
+
+    CHECK( rect1.height > 2*rect0.height );
+    CHECK( rect2.height == rect0.height );
+    CHECK( rect1.y == rect0.GetBottom() + 1 );
+    CHECK( rect2.y == rect1.GetBottom() + 1 );
+
+    // Check that the position of the item in the middle of the tall line is
+    // found correctly.
+    int flags = 0;
+    CHECK( m_list->HitTest(wxPoint(5, rect1.y + rect1.height / 2), flags) == 1 );
+    CHECK( m_list->HitTest(wxPoint(5, rect2.y + 1), flags) == 2 );
+
+    // Changing the text to a single line one must update the height.
+    m_list->SetItem(1, 1, "Single line");
+    REQUIRE( m_list->GetItemRect(1, rect1) );
+    REQUIRE( m_list->GetItemRect(2, rect2) );
+    CHECK( rect1.height == rect0.height );
+    CHECK( rect2.y == rect1.GetBottom() + 1 );
+
+    // And without variable line height all lines have the same height.
+    m_list->SetItem(1, 1, "Second\nitem\nlines");
+    CHECK( m_list->EnableVariableLineHeight(false) );
+    CHECK( !m_list->HasVariableLineHeight() );
+    REQUIRE( m_list->GetItemRect(1, rect1) );
+    CHECK( rect1.height == rect0.height );
+}
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(ListCtrlTestCase, "ListCtrl::ColumnDrag", "[listctrl]")
@@ -23,10 +23,13 @@
 #include "wx/artprov.h"
 #include "wx/imaglist.h"
 #include "wx/treectrl.h"
+#include "wx/generic/treectlg.h"
 #include "wx/uiaction.h"
 #include "testableframe.h"
 #include "waitfor.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -702,4 +705,110 @@ TEST_CASE_METHOD(TreeCtrlTestCase, "wxTreeCtrl::Sort", "[treectrl]")
     CHECK(m_tree->GetNextChild(m_root, cookie) == zitem);
 }
 
+namespace
+{
+
+// Virtual children are only supported by the generic version, so use it
+// explicitly even under the platforms with the native wxTreeCtrl.
+class VirtualTreeCtrl : public wxGenericTreeCtrl
+{
+public:
+    explicit VirtualTreeCtrl(wxWindow* parent)
+        : wxGenericTreeCtrl(parent, wxID_ANY,
+                            wxDefaultPosition, wxSize(400, 200))
+    {
+    }
+
+    // number of times OnGetVirtualItemText() was called
+    mutable int m_textCalls = 0;
+
+protected:
+    virtual wxString
+    OnGetVirtualItemText(const wxTreeItemId& WXUNUSED(parent),
+                         size_t index) const override
+    {
+        m_textCalls++;
+
+        return wxString::Format("item %d", static_cast<int>(index));
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxTreeCtrl::VirtualChildren", "[treectrl]")
+{
+    std::unique_ptr<VirtualTreeCtrl>
+        tree(new VirtualTreeCtrl(wxTheApp->GetTopWindow()));
+
+    const wxTreeItemId root = tree->AddRoot("root");
+    const wxTreeItemId dir = tree->AppendItem(root, "dir");
+    REQUIRE( tree->SetItemVirtualChildren(dir, 300000) );
+
+    CHECK( tree->ItemHasChildren(dir) );
+    CHECK( tree->GetChildrenCount(dir, false) == 300000 );
+    CHECK( tree->GetChildrenCount(root, false) == 1 );
+    CHECK( tree->GetChildrenCount(root) == 300001 );
+    CHECK( tree->GetCount() == 300002 );
+
+    tree->ExpandAll();
+    tree->Refresh();
+    tree->Update();
+
+    // Only the items which were shown should have been queried.
+    CHECK( tree->m_textCalls < 100 );
+
+    const wxTreeItemId last = tree->GetLastChild(dir);
+    REQUIRE( last.IsOk() );
+    CHECK( tree->GetItemText(last) == "item 299999" );
+    CHECK( tree->GetItemParent(last) == dir );
+    CHECK( tree->GetVirtualItemIndex(last) == 299999 );
+    CHECK( tree->GetVirtualItemIndex(dir) == wxNOT_FOUND );
+    CHECK_FALSE( tree->GetNextSibling(last).IsOk() );
+
+    // The same item must be returned when it's accessed again.
+    const wxTreeItemId prev = tree->GetPrevSibling(last);
+    CHECK( tree->GetItemText(prev) == "item 299998" );
+    CHECK( tree->GetNextSibling(prev) == last );
+
+    tree->SelectItem(prev);
+    CHECK( tree->IsSelected(prev) );
+
+    wxRect rect;
+    REQUIRE( tree->GetBoundingRect(prev, rect, true) );
+    CHECK( tree->HitTest(wxPoint(rect.x + 1, rect.y + rect.height / 2)) == prev );
+
+    // Iterating over the children creates the items for them, which are then
+    // kept, so that their ids remain valid and are returned again when
+    // iterating over them again.
+    const auto iterate = [&tree, dir](size_t count)
+    {
+        std::vector<wxTreeItemId> children;
+        wxTreeItemIdValue cookie;
+        wxTreeItemId child = tree->GetFirstChild(dir, cookie);
+        for ( ; children.size() < count && child.IsOk();
+                child = tree->GetNextChild(dir, cookie) )
+            children.push_back(child);
+
+        return children;
+    };
+
+    const std::vector<wxTreeItemId> children = iterate(1000);
+    REQUIRE( children.size() == 1000 );
+
+    const int textCalls = tree->m_textCalls;
+    CHECK( iterate(1000) == children );
+    CHECK( tree->m_textCalls == textCalls );
+    CHECK( tree->GetItemText(children[500]) == "item 500" );
+    CHECK( tree->GetVirtualItemIndex(children[500]) == 500 );
+
+    CHECK( tree->IsSelected(prev) );
+    CHECK( tree->GetItemText(prev) == "item 299998" );
+    CHECK( tree->GetVirtualItemIndex(prev) == 299998 );
+
+    // Changing the number of children deletes the existing ones.
+    REQUIRE( tree->SetItemVirtualChildren(dir, 0) );
+    CHECK_FALSE( tree->ItemHasChildren(dir) );
+    CHECK( tree->GetCount() == 2 );
+}
+
 #endif //wxUSE_TREECTRL
@@ -23,6 +23,8 @@
 #include "testableframe.h"
 #include "wx/uiaction.h"
 
+#include <memory>
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -149,4 +151,71 @@ void VirtListCtrlTestCase::DeselectedEvent()
 #endif
 }
 
+TEST_CASE("VirtListCtrl::VariableLineHeight", "[listctrl]")
+{
+    // Virtual list control with every tenth item much taller than the others
+    // and counting the calls to OnGetItemText().
+    class CountingVirtListCtrl : public wxListCtrl
+    {
+    public:
+        CountingVirtListCtrl()
+            : wxListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                         wxPoint(0, 0), wxSize(400, 200),
+                         wxLC_REPORT | wxLC_VIRTUAL)
+        {
+        }
+
+        mutable int m_getTextCount = 0;
+
+    protected:
+        virtual wxString OnGetItemText(long item, long WXUNUSED(column)) const override
+        {
+            m_getTextCount++;
+
+            return item % 10 ? wxString("Item") : wxString("1\n2\n3\n4\n5");
+        }
+    };
+
+    std::unique_ptr<CountingVirtListCtrl> list(new CountingVirtListCtrl());
+    if ( !list->EnableVariableLineHeight() )
+    {
+        WARN("Skipping test not supported by this wxListCtrl implementation.");
+        return;
+    }
+
+    const int count = 100000;
+    list->AppendColumn("Col0");
+    list->SetItemCount(count);
+
+    list->Refresh();
+    list->Update();
+    wxYield();
+
+    // Only the heights of the visible items should have been computed.
+    CHECK( list->m_getTextCount < count / 10 );
+
+    // And the number of items per page must take their heights into account.
+    wxRect rect;
+    REQUIRE( list->GetItemRect(1, rect) );
+
+    const int perPage = list->GetCountPerPage();
+    CHECK( perPage > 0 );
+    CHECK( perPage < list->GetClientSize().y / rect.height );
+
+    // Showing an item far away from the top shouldn't compute the heights of
+    // all the items before it either, but it still must become visible.
+    const long item = count / 2;
+    list->EnsureVisible(item);
+
+    list->Refresh();
+    list->Update();
+    wxYield();
+
+    CHECK( list->m_getTextCount < count / 10 );
+
+    REQUIRE( list->GetItemRect(item, rect) );
+    CHECK( rect.y >= 0 );
+    CHECK( rect.GetBottom() < list->GetClientSize().y );
+}
+
 #endif // wxUSE_LISTCTRL
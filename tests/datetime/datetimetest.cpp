@@ -1666,6 +1666,102 @@ TEST_CASE("wxDateTime::FormatWeek", "[datetime]")
     }
 }
 
+TEST_CASE("wxDateTimeFormatter", "[datetime]")
+{
+    const wxDateTime dt(29, wxDateTime::Feb, 2024, 13, 5, 7, 89);
+
+    SECTION("Format")
+    {
+        static const char* const formats[] =
+        {
+            "%Y-%m-%d %H:%M:%S.%l",
+            "%F %T",
+            "%d/%m/%y %I:%M %p",
+            "%a %A %b %B %j",
+            "%c",
+            "%x %X",
+            "%G-%V %z",
+            "100%% sure",
+            "%4Y|%-2d",
+            "no specifiers",
+        };
+
+        for ( const char* format : formats )
+        {
+            INFO( "Format: " << format );
+
+            const wxDateTimeFormatter formatter(format);
+            CHECK( formatter.Format(dt) == dt.Format(format) );
+            CHECK( formatter.Format(dt, wxDateTime::UTC) ==
+                    dt.Format(format, wxDateTime::UTC) );
+        }
+
+        // FormatTo() must append to the existing contents.
+        wxString s("Date: ");
+        wxDateTimeFormatter("%Y-%m-%d").FormatTo(s, dt);
+        CHECK( s == "Date: 2024-02-29" );
+
+        // Check that negative years are handled in the same way as by Format().
+        const wxDateTime dtBC(1, wxDateTime::Jan, -44);
+        CHECK( wxDateTimeFormatter("%Y %y").Format(dtBC) ==
+                dtBC.Format("%Y %y") );
+    }
+
+    SECTION("Parse")
+    {
+        static const struct ParseTestData
+        {
+            const char* format;
+            const char* str;
+        } testParse[] =
+        {
+            { "%Y-%m-%d %H:%M:%S.%l",   "2024-02-29 13:05:07.089" },
+            { "%F %T",                  "2024-02-29 13:05:07" },
+            { "%d/%m/%y %I:%M %p",      "29/02/24 01:05 PM" },
+            { "%a %b %d %H:%M:%S %Y",   "Thu Feb 29 13:05:07 2024" },
+            { "%Y%m%d",                 "20240229" },
+            { "%j %Y",                  "060 2024" },
+            { "%Y-%m-%dT%H:%M:%S%z",    "2024-02-29T13:05:07+0100" },
+            { "%-d.%-m.%Y",             "29.2.2024" },
+            { "%Y-%m-%d",               "2024-02-30" },
+            { "%Y-%m-%d",               "2024-2-29x" },
+            { "%H:%M",                  "24:00" },
+            { "%Y",                     "99999999999999999999999" },
+        };
+
+        for ( const auto& td : testParse )
+        {
+            INFO( "Format: " << td.format << ", string: " << td.str );
+
+            const wxString str(td.str);
+
+            wxDateTime dt1;
+            wxString::const_iterator end1;
+            const bool ok1 = dt1.ParseFormat(str, td.format, &end1);
+
+            wxDateTime dt2;
+            wxString::const_iterator end2;
+            const bool ok2 = wxDateTimeFormatter(td.format).Parse(str, dt2, &end2);
+
+            REQUIRE( ok2 == ok1 );
+            if ( ok1 )
+            {
+                CHECK( dt2 == dt1 );
+                CHECK( end2 == end1 );
+            }
+        }
+
+        // Check that the default date is used for the missing fields.
+        const wxDateTime dtDef(1, wxDateTime::Jan, 2000);
+        wxDateTime dtParsed;
+        wxString::const_iterator end;
+        const wxString str("12:34 rest");
+        REQUIRE( wxDateTimeFormatter("%H:%M").Parse(str, dtParsed, dtDef, &end) );
+        CHECK( dtParsed == wxDateTime(1, wxDateTime::Jan, 2000, 12, 34) );
+        CHECK( wxString(end, str.end()) == " rest" );
+    }
+}
+
 TEST_CASE("wxDateTime::TimeArithmetics", "[datetime]")
 {
     static const wxDateSpan testArithmData[] =
@@ -13,7 +13,13 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/event.h"
+#include "wx/evtloop.h"
+#include "wx/thread.h"
+
+#include <memory>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // test events and their handlers
@@ -510,6 +516,320 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+TEST_CASE("Event::BindMany", "[event][bind]")
+{
+    // Use enough handlers to make sure the dynamic event table is indexed.
+    static const int NUM_TYPES = 50;
+
+    struct Counter
+    {
+        void OnEvent(wxThreadEvent&) { m_count++; }
+
+        int m_count = 0;
+    };
+
+    wxEvtHandler handler;
+
+    std::vector<wxEventTypeTag<wxThreadEvent>> types;
+    std::vector<Counter> counters(NUM_TYPES);
+    for ( int n = 0; n < NUM_TYPES; n++ )
+    {
+        types.emplace_back(wxNewEventType());
+        handler.Bind(types[n], &Counter::OnEvent, &counters[n]);
+    }
+
+    // Handlers bound later must still be called before the earlier ones.
+    std::vector<int> order;
+    handler.Bind(types[0], [&order](wxThreadEvent& event)
+        {
+            order.push_back(1);
+            event.Skip();
+        });
+    handler.Bind(types[0], [&order](wxThreadEvent& event)
+        {
+            order.push_back(2);
+            event.Skip();
+        });
+
+    wxThreadEvent event0(types[0]);
+    CHECK( handler.ProcessEvent(event0) );
+    CHECK( counters[0].m_count == 1 );
+    CHECK( order == std::vector<int>{2, 1} );
+
+    wxThreadEvent eventLast(types[NUM_TYPES - 1]);
+    CHECK( handler.ProcessEvent(eventLast) );
+    CHECK( counters[0].m_count == 1 );
+    CHECK( counters[NUM_TYPES - 1].m_count == 1 );
+
+    // Unbinding and binding the handlers after processing the events must
+    // work as well.
+    for ( int n = 0; n < NUM_TYPES; n += 2 )
+        CHECK( handler.Unbind(types[n], &Counter::OnEvent, &counters[n]) );
+
+    wxThreadEvent eventOther(types[1]);
+    CHECK( !handler.ProcessEvent(event0) );
+    CHECK( handler.ProcessEvent(eventOther) );
+    CHECK( counters[0].m_count == 1 );
+    CHECK( counters[1].m_count == 1 );
+
+    handler.Bind(types[0], &Counter::OnEvent, &counters[1]);
+    CHECK( handler.ProcessEvent(event0) );
+    CHECK( counters[0].m_count == 1 );
+    CHECK( counters[1].m_count == 2 );
+}
+
+namespace
+{
+
+// Handler recording the values of all wxThreadEvents it gets.
+class RecordingHandler : public wxEvtHandler
+{
+public:
+    RecordingHandler()
+    {
+        Bind(wxEVT_THREAD, [this](wxThreadEvent& event)
+            {
+                m_values.push_back(event.GetInt());
+            });
+    }
+
+    std::vector<int> m_values;
+};
+
+void QueueIntEvent(wxEvtHandler& handler, int value)
+{
+    wxThreadEvent* const event = new wxThreadEvent();
+    event->SetInt(value);
+    handler.QueueEvent(event);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Event::QueueEvent", "[event][queue]")
+{
+    RecordingHandler handler;
+
+    for ( int n = 0; n < 100; n++ )
+        QueueIntEvent(handler, n);
+
+    // Processing events queued during processing must work too.
+    handler.Bind(wxEVT_THREAD, [&handler](wxThreadEvent& event)
+        {
+            if ( event.GetInt() == 50 )
+                QueueIntEvent(handler, 100);
+
+            event.Skip();
+        });
+
+    CHECK( wxTheApp->HasPendingEvents() );
+    wxTheApp->ProcessPendingEvents();
+    CHECK( !wxTheApp->HasPendingEvents() );
+
+    REQUIRE( handler.m_values.size() == 101 );
+    for ( int n = 0; n <= 100; n++ )
+        CHECK( handler.m_values[n] == n );
+
+    // Check that the handler is added to the list of handlers with pending
+    // events again after processing all of them.
+    QueueIntEvent(handler, 101);
+    CHECK( wxTheApp->HasPendingEvents() );
+    wxTheApp->ProcessPendingEvents();
+    CHECK( handler.m_values.back() == 101 );
+}
+
+TEST_CASE("Event::CoalesceQueuedEvents", "[event][queue]")
+{
+    RecordingHandler handler;
+    handler.CoalesceQueuedEvents(wxEVT_THREAD);
+
+    auto queueEvent = [&handler](int id, int value)
+    {
+        wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, id);
+        event->SetInt(value);
+        handler.QueueEvent(event);
+    };
+
+    SECTION("Replace")
+    {
+        queueEvent(1, 1);
+        queueEvent(2, 2);
+        queueEvent(1, 3);
+        queueEvent(1, 4);
+        wxTheApp->ProcessPendingEvents();
+
+        // The last event with id 1 must have replaced the previous ones but
+        // still be processed before the event with id 2.
+        REQUIRE( handler.m_values.size() == 2 );
+        CHECK( handler.m_values[0] == 4 );
+        CHECK( handler.m_values[1] == 2 );
+    }
+
+    SECTION("AfterProcessing")
+    {
+        // Events queued from the handler itself can't replace the event
+        // being processed, as it's not pending any more.
+        handler.Bind(wxEVT_THREAD, [&queueEvent](wxThreadEvent& event)
+            {
+                if ( event.GetInt() == 1 )
+                    queueEvent(1, 2);
+
+                event.Skip();
+            });
+
+        queueEvent(1, 1);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 2 );
+        CHECK( handler.m_values[0] == 1 );
+        CHECK( handler.m_values[1] == 2 );
+    }
+
+    SECTION("Disable")
+    {
+        queueEvent(1, 1);
+        queueEvent(1, 2);
+        handler.CoalesceQueuedEvents(wxEVT_THREAD, false);
+        queueEvent(1, 3);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 2 );
+        CHECK( handler.m_values[0] == 2 );
+        CHECK( handler.m_values[1] == 3 );
+    }
+
+    SECTION("Delete")
+    {
+        queueEvent(1, 1);
+        wxTheApp->ProcessPendingEvents();
+        queueEvent(1, 2);
+        handler.DeletePendingEvents();
+        queueEvent(1, 3);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 2 );
+        CHECK( handler.m_values[0] == 1 );
+        CHECK( handler.m_values[1] == 3 );
+    }
+}
+
+namespace
+{
+
+// Event loop which only processes the pending events when yielding, this is
+// enough for testing the handling of the events during a selective yield.
+class PendingEventsLoop : public wxEventLoopBase
+{
+public:
+    virtual bool Pending() const override { return false; }
+    virtual bool Dispatch() override { return false; }
+    virtual int DispatchTimeout(unsigned long) override { return -1; }
+    virtual void WakeUp() override { }
+
+protected:
+    virtual int DoRun() override { return 0; }
+    virtual void DoStop(int) override { }
+    virtual void DoYieldFor(long) override { wxTheApp->ProcessPendingEvents(); }
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::QueueEventInsideYield", "[event][queue]")
+{
+    PendingEventsLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    RecordingHandler handler;
+    int uiEvents = 0;
+    handler.Bind(MyEventType, [&uiEvents](MyEvent&) { uiEvents++; });
+
+    wxEvtHandler other;
+    other.Bind(MyEventType, [&handler](MyEvent&)
+        {
+            handler.QueueEvent(new MyEvent);
+        });
+
+    // Thread events are not processed when yielding for the UI events only,
+    // so the first handler is delayed, but the UI event queued for it by the
+    // other one later must still be processed during the same yield.
+    QueueIntEvent(handler, 1);
+    other.QueueEvent(new MyEvent);
+
+    loop.YieldFor(wxEVT_CATEGORY_UI);
+    CHECK( uiEvents == 1 );
+    CHECK( handler.m_values.empty() );
+
+    // And the thread event must be processed once we're not yielding.
+    wxTheApp->ProcessPendingEvents();
+    CHECK( handler.m_values.size() == 1 );
+    CHECK( !wxTheApp->HasPendingEvents() );
+}
+
+#if wxUSE_THREADS
+
+TEST_CASE("Event::QueueEventThreads", "[event][queue][thread]")
+{
+    static const int NUM_THREADS = 4;
+    static const int NUM_EVENTS = 10000;
+
+    class QueueingThread : public wxThread
+    {
+    public:
+        QueueingThread(wxEvtHandler& handler, int first)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_handler(handler),
+              m_first(first)
+        {
+        }
+
+    protected:
+        virtual void* Entry() override
+        {
+            for ( int n = 0; n < NUM_EVENTS; n++ )
+                QueueIntEvent(m_handler, m_first + n);
+
+            return nullptr;
+        }
+
+    private:
+        wxEvtHandler& m_handler;
+        const int m_first;
+    };
+
+    RecordingHandler handler;
+
+    std::vector<std::unique_ptr<QueueingThread>> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.emplace_back(new QueueingThread(handler, n*NUM_EVENTS));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    // Process the events while they're being queued.
+    while ( handler.m_values.size() < NUM_THREADS*NUM_EVENTS )
+        wxTheApp->ProcessPendingEvents();
+
+    for ( auto& thread : threads )
+        thread->Wait();
+
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE( handler.m_values.size() == NUM_THREADS*NUM_EVENTS );
+
+    // The events from each thread must have been processed in order.
+    int last[NUM_THREADS];
+    for ( int n = 0; n < NUM_THREADS; n++ )
+        last[n] = n*NUM_EVENTS - 1;
+
+    for ( int value : handler.m_values )
+    {
+        int& lastFromThread = last[value / NUM_EVENTS];
+        if ( value != lastFromThread + 1 )
+            FAIL_CHECK("Event " << value << " after " << lastFromThread);
+        lastFromThread = value;
+    }
+}
+
+#endif // wxUSE_THREADS
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
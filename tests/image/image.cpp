@@ -963,6 +963,171 @@ static void SetAlpha(wxImage *image)
     }
 }
 
+// Sink reconstructing the image from the rows passed to it.
+class ImageBuildingSink : public wxImageRowSink
+{
+public:
+    explicit ImageBuildingSink(int maxRows = -1, wxSize maxSize = wxDefaultSize)
+        : m_maxRows(maxRows),
+          m_maxSize(maxSize)
+    {
+    }
+
+    bool OnStart(int width, int height, bool hasAlpha) override
+    {
+        m_image.Create(width, height, false);
+        if ( hasAlpha )
+            m_image.SetAlpha();
+
+        return true;
+    }
+
+    bool OnRow(int y, const unsigned char* rgb, const unsigned char* alpha) override
+    {
+        CHECK( y == m_rows );
+
+        const int width = m_image.GetWidth();
+        memcpy(m_image.GetData() + y*width*3, rgb, width*3);
+        if ( alpha )
+            memcpy(m_image.GetAlpha() + y*width, alpha, width);
+
+        return ++m_rows != m_maxRows;
+    }
+
+    wxSize GetMaxSize() const override { return m_maxSize; }
+
+    const wxImage& GetImage() const { return m_image; }
+    int GetRowsCount() const { return m_rows; }
+
+private:
+    const int m_maxRows;
+    const wxSize m_maxSize;
+
+    wxImage m_image;
+    int m_rows = 0;
+};
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadRows", "[image]")
+{
+    for ( size_t i = 0; i < WXSIZEOF(g_testfiles); i++ )
+    {
+        const wxString file(g_testfiles[i].file);
+        INFO("Loading " << file);
+
+        wxImage image;
+        REQUIRE( image.LoadFile(file) );
+
+        // Compare with the same image as LoadRows() would produce.
+        if ( image.HasMask() && !image.HasAlpha() )
+            image.InitAlpha();
+
+        wxImageHandler* const handler = wxImage::FindHandler(g_testfiles[i].type);
+        REQUIRE( handler );
+
+        wxFileInputStream stream(file);
+        REQUIRE( stream.IsOk() );
+
+        ImageBuildingSink sink;
+        REQUIRE( handler->LoadRows(sink, stream) );
+        CHECK( sink.GetRowsCount() == image.GetHeight() );
+
+        // LoadFile() doesn't create alpha channel if all pixels are opaque,
+        // but LoadRows() can't know about it in advance.
+        if ( sink.GetImage().HasAlpha() && !image.HasAlpha() )
+            image.InitAlpha();
+
+        CHECK_THAT( sink.GetImage(), RGBASameAs(image) );
+    }
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadRowsStop", "[image]")
+{
+    wxImageHandler* const handler = wxImage::FindHandler(wxBITMAP_TYPE_PNG);
+    REQUIRE( handler );
+
+    wxFileInputStream stream("horse.png");
+    REQUIRE( stream.IsOk() );
+
+    ImageBuildingSink sink(10);
+    CHECK( handler->LoadRows(sink, stream) );
+    CHECK( sink.GetRowsCount() == 10 );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadRowsIndex", "[image]")
+{
+    wxImageHandler* const handler = wxImage::FindHandler(wxBITMAP_TYPE_JPEG);
+    REQUIRE( handler );
+
+    wxFileInputStream stream("horse.jpg");
+    REQUIRE( stream.IsOk() );
+
+    // JPEG files contain only a single image.
+    ImageBuildingSink sink;
+    CHECK_FALSE( handler->LoadRows(sink, stream, false, 1) );
+    CHECK( sink.GetRowsCount() == 0 );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadRowsScaled", "[image]")
+{
+    wxImage image;
+    image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 50);
+    image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, 50);
+    REQUIRE( image.LoadFile("horse.jpg") );
+
+    wxImageHandler* const handler = wxImage::FindHandler(wxBITMAP_TYPE_JPEG);
+    REQUIRE( handler );
+
+    wxFileInputStream stream("horse.jpg");
+    REQUIRE( stream.IsOk() );
+
+    ImageBuildingSink sink(-1, wxSize(50, 50));
+    REQUIRE( handler->LoadRows(sink, stream) );
+    CHECK( sink.GetImage().GetSize() == image.GetSize() );
+    CHECK_THAT( sink.GetImage(), RGBSameAs(image) );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadMaxSize", "[image]")
+{
+    const wxSize sizeOrig(200, 200);
+
+    const struct
+    {
+        int maxWidth, maxHeight;
+        int width, height;
+    } sizes[] =
+    {
+        {  0,   0, 200, 200 },
+        { 200,  0, 200, 200 },
+        { 199,  0, 100, 100 },
+        {  0, 100, 100, 100 },
+        { 99,  99,  50,  50 },
+        { 26, 200,  25,  25 },
+        { 25,  25,  25,  25 },
+        // This one is too small to be handled by libjpeg alone.
+        { 20,  20,  12,  12 },
+    };
+
+    for ( const auto& s : sizes )
+    {
+        INFO("Max size " << s.maxWidth << "x" << s.maxHeight);
+
+        wxImage image;
+        if ( s.maxWidth )
+            image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, s.maxWidth);
+        if ( s.maxHeight )
+            image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, s.maxHeight);
+
+        REQUIRE( image.LoadFile("horse.jpg") );
+        CHECK( image.GetSize() == wxSize(s.width, s.height) );
+
+        if ( image.GetSize() != sizeOrig )
+        {
+            CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == sizeOrig.x );
+            CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) == sizeOrig.y );
+        }
+    }
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::CompareSavedImage", "[image]")
 {
     wxImage expected24("horse.png");
@@ -2228,6 +2393,52 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::ScaleCompare", "[image]")
                                "image/cross_nearest_neighb_256x256.png");
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::ScaleThreads", "[image][thread]")
+{
+    wxImage original;
+    REQUIRE(original.LoadFile("horse.bmp"));
+
+    // Add alpha channel to check that it's handled correctly too.
+    original.SetAlpha();
+    unsigned char* alpha = original.GetAlpha();
+    const int numPixels = original.GetWidth() * original.GetHeight();
+    for ( int n = 0; n < numPixels; n++ )
+        alpha[n] = static_cast<unsigned char>(n % 253);
+
+    const wxImageResizeQuality qualities[] =
+    {
+        wxIMAGE_QUALITY_NEAREST,
+        wxIMAGE_QUALITY_BILINEAR,
+        wxIMAGE_QUALITY_BICUBIC,
+        wxIMAGE_QUALITY_BOX_AVERAGE,
+        wxIMAGE_QUALITY_NORMAL,
+        wxIMAGE_QUALITY_HIGH,
+    };
+
+    wxImage expected[WXSIZEOF(qualities)];
+    for ( size_t n = 0; n < WXSIZEOF(qualities); n++ )
+        expected[n] = original.Scale(700, 600, qualities[n]);
+
+    // Use a bigger image for blurring to ensure it is split in several bands.
+    const wxImage& big = expected[0];
+    const wxImage expectedBlur = big.Blur(5);
+
+    // Using multiple threads must give exactly the same results.
+    REQUIRE( wxImage::GetMaxThreads() == 1 );
+    wxImage::SetMaxThreads(4);
+
+    for ( size_t n = 0; n < WXSIZEOF(qualities); n++ )
+    {
+        INFO("Quality " << qualities[n]);
+        CHECK_THAT( original.Scale(700, 600, qualities[n]),
+                    RGBASameAs(expected[n]) );
+    }
+
+    CHECK_THAT( big.Blur(5), RGBASameAs(expectedBlur) );
+
+    wxImage::SetMaxThreads(1);
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::CreateBitmapFromCursor", "[image]")
 {
 #if !defined __WXOSX_IPHONE__ && !defined __WXDFB__ && !defined __WXX11__
@@ -3158,6 +3369,139 @@ TEST_CASE("wxImage::Clear", "[image]")
     CHECK( image.GetRed(1, 1) == 0xff );
 }
 
+TEST_CASE("wxImage::RGBA", "[image][rgba]")
+{
+    wxImage image(2, 1);
+    image.SetAlpha();
+    image.SetRGB(0, 0, 200, 100, 0);
+    image.SetAlpha(0, 0, 128);
+    image.SetRGB(1, 0, 10, 20, 30);
+    image.SetAlpha(1, 0, wxALPHA_OPAQUE);
+
+    const wxImage orig = image.Copy();
+
+    SECTION("Straight")
+    {
+        image.ConvertToRGBA(wxIMAGE_RGBA_STRAIGHT);
+
+        const unsigned char* rgba = image.GetDataRGBA();
+        REQUIRE( rgba );
+        CHECK( image.GetRGBAFormat() == wxIMAGE_RGBA_STRAIGHT );
+
+        const unsigned char expected[] = { 200, 100, 0, 128, 10, 20, 30, 255 };
+        CHECK( memcmp(rgba, expected, sizeof(expected)) == 0 );
+
+        // Reading the pixels doesn't affect the interleaved data.
+        CHECK( image.GetRed(0, 0) == 200 );
+        CHECK( image.GetAlpha(0, 0) == 128 );
+        CHECK( image.GetBlue(1, 0) == 30 );
+        CHECK( image.GetDataRGBA() == rgba );
+
+        // But modifying them discards it.
+        image.SetRGB(1, 0, 1, 2, 3);
+        CHECK( !image.GetDataRGBA() );
+        CHECK( image.GetRed(1, 0) == 1 );
+        CHECK( image.GetAlpha(1, 0) == wxALPHA_OPAQUE );
+    }
+
+    SECTION("DirectAccess")
+    {
+        image.ConvertToRGBA();
+        REQUIRE( image.GetDataRGBA() );
+
+        // The pixels could be modified using the returned pointer, so the
+        // interleaved data can't be used any longer.
+        image.GetData()[0] = 42;
+        CHECK( !image.GetDataRGBA() );
+        CHECK( image.GetRed(0, 0) == 42 );
+
+        image.ConvertToRGBA();
+        REQUIRE( image.GetDataRGBA() );
+        CHECK( image.GetDataRGBA()[0] == 42 );
+
+        image.GetAlpha()[0] = 7;
+        CHECK( !image.GetDataRGBA() );
+        CHECK( image.GetAlpha(0, 0) == 7 );
+    }
+
+    SECTION("Premultiplied")
+    {
+        image.ConvertToRGBA(wxIMAGE_ARGB32_PREMULTIPLIED);
+
+        const wxUint32* argb =
+            reinterpret_cast<const wxUint32*>(image.GetDataRGBA());
+        REQUIRE( argb );
+        CHECK( image.GetRGBAFormat() == wxIMAGE_ARGB32_PREMULTIPLIED );
+        CHECK( argb[0] == 0x80643200 );
+        CHECK( argb[1] == 0xff0a141e );
+
+        // Pre-multiplication loses precision for translucent pixels.
+        CHECK( image.GetRed(0, 0) == 199 );
+        CHECK( image.GetAlpha(0, 0) == 128 );
+
+        // Converting it back to the straight format uses the RGB values.
+        image.ConvertToRGBA(wxIMAGE_RGBA_STRAIGHT);
+        REQUIRE( image.GetDataRGBA() );
+        CHECK( image.GetDataRGBA()[0] == 199 );
+        CHECK( image.GetDataRGBA()[7] == wxALPHA_OPAQUE );
+    }
+
+    SECTION("CreatePremultiplied")
+    {
+        wxUint32* const argb = (wxUint32*)malloc(8);
+        argb[0] = 0x80643200;
+        argb[1] = 0xff0a141e;
+
+        wxImage image2;
+        REQUIRE( image2.CreateRGBA(2, 1, reinterpret_cast<unsigned char*>(argb),
+                                   wxIMAGE_ARGB32_PREMULTIPLIED) );
+
+        // Pre-multiplication loses precision for translucent pixels.
+        CHECK( image2.GetRed(0, 0) == 199 );
+        CHECK( image2.GetGreen(0, 0) == 99 );
+        CHECK( image2.GetBlue(0, 0) == 0 );
+        CHECK( image2.GetAlpha(0, 0) == 128 );
+        CHECK( image2.GetRed(1, 0) == 10 );
+        CHECK( image2.GetGreen(1, 0) == 20 );
+        CHECK( image2.GetBlue(1, 0) == 30 );
+        CHECK( image2.GetAlpha(1, 0) == wxALPHA_OPAQUE );
+    }
+
+    SECTION("Create")
+    {
+        unsigned char* const rgba = (unsigned char*)malloc(8);
+        memcpy(rgba, "\x01\x02\x03\x04\x05\x06\x07\x08", 8);
+
+        wxImage image2;
+        REQUIRE( image2.CreateRGBA(2, 1, rgba) );
+        CHECK( image2.GetDataRGBA() == rgba );
+
+        // Copies share the data until one of them is modified.
+        wxImage image3 = image2;
+        image3.SetRGB(0, 0, 0x10, 0x20, 0x30);
+        CHECK( image2.GetDataRGBA() == rgba );
+        CHECK( !image3.GetDataRGBA() );
+
+        CHECK( image2.GetRed(0, 0) == 1 );
+        CHECK( image2.GetAlpha(1, 0) == 8 );
+        CHECK( image3.GetRed(0, 0) == 0x10 );
+        CHECK( image3.GetAlpha(0, 0) == 4 );
+        CHECK( image3.GetBlue(1, 0) == 7 );
+    }
+
+    SECTION("NoAlpha")
+    {
+        image.ClearAlpha();
+        image.ConvertToRGBA();
+        REQUIRE( image.GetDataRGBA() );
+        CHECK( image.GetDataRGBA()[3] == wxALPHA_OPAQUE );
+
+        CHECK_THAT( image, RGBSameAs(orig) );
+        CHECK( image.HasAlpha() );
+        CHECK( image.GetAlpha(0, 0) == wxALPHA_OPAQUE );
+    }
+}
+
 TEST_CASE("wxImage::SizeLimits", "[image]")
 {
 #if SIZEOF_VOID_P == 8
@@ -1501,3 +1501,131 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     // just rejected as an invalid encoded chunk.
     CHECK( wxConvUTF7.cMB2WC("+\xc3").length() == 0 );
 }
+
+namespace
+{
+
+// Check that cWC2MB() and cMB2WC() return the same results as FromWChar() and
+// ToWChar() called with the buffer of the exact size, whether they convert
+// the string in a single pass or not.
+void CheckConvertBuffers(const wxMBConv& conv, const wxString& str)
+{
+    const wchar_t* const wcs = str.wc_str();
+
+    size_t lenMB = 0;
+    const wxCharBuffer mb = conv.cWC2MB(wcs, str.length(), &lenMB);
+    REQUIRE( mb );
+    CHECK( lenMB == conv.FromWChar(nullptr, 0, wcs, str.length()) );
+
+    // The output must be terminated by as many NULs as needed.
+    for ( size_t n = 0; n < conv.GetMBNulLen(); n++ )
+        CHECK( mb.data()[lenMB + n] == '\0' );
+
+    size_t lenWC = 0;
+    const wxWCharBuffer wc = conv.cMB2WC(mb.data(), lenMB, &lenWC);
+    REQUIRE( wc );
+    CHECK( lenWC == str.length() );
+    CHECK( wc.data()[lenWC] == L'\0' );
+    CHECK( wxString(wc.data(), lenWC) == str );
+
+    // Also check the overloads taking NUL-terminated strings.
+    const wxCharBuffer mbNul = conv.cWC2MB(wcs);
+    CHECK( mbNul.length() == lenMB );
+    CHECK( memcmp(mbNul.data(), mb.data(), lenMB) == 0 );
+
+    const wxWCharBuffer wcNul = conv.cMB2WC(mbNul.data());
+    CHECK( wcNul.length() == str.length() );
+    CHECK( wxString(wcNul) == str );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxMBConv::ConvertBuffers", "[mbconv]")
+{
+    const wxString
+        str = wxString::FromUTF8("ASCII, \xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2"
+                                 "\xd0\xb5\xd1\x82, \xe2\x82\xac, \xf0\x9f\x98\x80");
+    const wxString strLatin1 = wxString::FromUTF8("Latin-1: \xc3\xa9t\xc3\xa9");
+
+    SECTION("UTF-8")
+    {
+        CheckConvertBuffers(wxConvUTF8, str);
+        CheckConvertBuffers(wxConvUTF8, wxString(1000, 'x'));
+        CheckConvertBuffers(wxMBConvStrictUTF8(), str);
+    }
+
+    SECTION("UTF-8 with invalid bytes")
+    {
+        const wxMBConvUTF8 convPUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+        const wxMBConvUTF8 convOctal(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL);
+        CheckConvertBuffers(convPUA, str);
+        CheckConvertBuffers(convOctal, str);
+
+        const char* const invalid = "\xff\xfe\xfd";
+        CHECK( wxString(convOctal.cMB2WC(invalid)) == "\\377\\376\\375" );
+        CHECK( strcmp(convPUA.cWC2MB(convPUA.cMB2WC(invalid)), invalid) == 0 );
+    }
+
+    SECTION("UTF-16")
+    {
+        CheckConvertBuffers(wxMBConvUTF16LE(), str);
+        CheckConvertBuffers(wxMBConvUTF16BE(), str);
+    }
+
+    SECTION("UTF-32")
+    {
+        CheckConvertBuffers(wxMBConvUTF32LE(), str);
+        CheckConvertBuffers(wxMBConvUTF32BE(), str);
+    }
+
+    SECTION("Latin-1")
+    {
+        CheckConvertBuffers(wxConvISO8859_1, strLatin1);
+        CheckConvertBuffers(wxCSConv(wxFONTENCODING_ISO8859_1), strLatin1);
+    }
+
+    SECTION("Libc")
+    {
+        // This conversion doesn't know the maximal length of its output and
+        // so still uses two passes.
+        CheckConvertBuffers(wxConvLibc, "Just ASCII");
+    }
+}
+
+TEST_CASE("wxMBConvStrictUTF8::Long", "[mbconv][utf8]")
+{
+    // Check that conversions of long strings, processed in blocks of several
+    // characters at once if they're ASCII, work correctly when non-ASCII
+    // characters appear at different positions.
+    const wxString ascii("0123456789abcdefghijklmnopqrstuvwxyz");
+    const wxString nonASCII = wxString::FromUTF8("\xd0\x9f\xe2\x82\xac\xf0\x9f\x98\x80");
+
+    for ( size_t pos = 0; pos <= ascii.length(); pos++ )
+    {
+        INFO("Non-ASCII characters at " << pos);
+
+        wxString str = ascii + ascii;
+        str.insert(pos, nonASCII);
+
+        const wxScopedCharBuffer utf8 = str.utf8_str();
+        CHECK( wxString::FromUTF8(utf8) == str );
+
+        // Converting to a too small buffer must fail.
+        const size_t len = wxConvUTF8.ToWChar(nullptr, 0, utf8.data());
+        REQUIRE( len != wxCONV_FAILED );
+
+        wxWCharBuffer wbuf(len);
+        CHECK( wxConvUTF8.ToWChar(wbuf.data(), len - 1, utf8.data()) == wxCONV_FAILED );
+        CHECK( wxConvUTF8.ToWChar(wbuf.data(), len, utf8.data()) == len );
+
+        wxCharBuffer buf(utf8.length());
+        CHECK( wxConvUTF8.FromWChar(buf.data(), utf8.length(), wbuf.data()) == wxCONV_FAILED );
+        CHECK( wxConvUTF8.FromWChar(buf.data(), utf8.length() + 1, wbuf.data()) == utf8.length() + 1 );
+        CHECK( strcmp(buf.data(), utf8.data()) == 0 );
+
+        // Invalid sequences must be detected after a run of ASCII characters.
+        wxCharBuffer invalid(utf8.data());
+        invalid.data()[ascii.length() + pos + 1] = '\xff';
+        CHECK( wxConvUTF8.ToWChar(nullptr, 0, invalid.data()) == wxCONV_FAILED );
+    }
+}
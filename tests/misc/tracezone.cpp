@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/misc/tracezone.cpp
+// Purpose:     Test wxTraceZone
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#include "wx/tracezone.h"
+
+#include "wx/thread.h"
+
+namespace
+{
+
+int CountOccurrences(const wxString& str, const wxString& sub)
+{
+    int count = 0;
+    for ( size_t pos = str.find(sub); pos != wxString::npos; pos = str.find(sub, pos + 1) )
+        count++;
+
+    return count;
+}
+
+void DoSomething()
+{
+    wxTraceZone zone("Test \"zone\"");
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxTraceZone", "[tracezone]")
+{
+    wxTraceZone::Clear();
+
+    // Nothing is recorded by default.
+    DoSomething();
+    CHECK( CountOccurrences(wxTraceZone::GetChromeTrace(), "Test") == 0 );
+
+    wxTraceZone::Enable();
+    DoSomething();
+    DoSomething();
+
+#if wxUSE_THREADS
+    class TraceThread : public wxThread
+    {
+    public:
+        TraceThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+    protected:
+        virtual void* Entry() override
+        {
+            DoSomething();
+            return nullptr;
+        }
+    };
+
+    TraceThread thread;
+    REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+    thread.Wait();
+
+    // This thread reuses the buffer of the previous one, but the zones
+    // recorded by it must still be preserved.
+    TraceThread thread2;
+    REQUIRE( thread2.Run() == wxTHREAD_NO_ERROR );
+    thread2.Wait();
+
+    const int expected = 4;
+#else
+    const int expected = 2;
+#endif
+
+    wxTraceZone::Enable(false);
+    DoSomething();
+
+    const wxString trace = wxTraceZone::GetChromeTrace();
+    INFO( trace );
+    CHECK( trace.StartsWith("{\"traceEvents\":[") );
+    CHECK( CountOccurrences(trace, "\"name\":\"Test \\\"zone\\\"\"") == expected );
+    CHECK( CountOccurrences(trace, "\"ph\":\"X\"") >= expected );
+
+    wxTraceZone::Clear();
+    CHECK( CountOccurrences(wxTraceZone::GetChromeTrace(), "Test") == 0 );
+}
+
+TEST_CASE("wxTraceZone::Escape", "[tracezone]")
+{
+    wxTraceZone::Clear();
+    wxTraceZone::Enable();
+
+    {
+        wxTraceZone zone("Tab\tand \xc3\xa9\\");
+    }
+
+    wxTraceZone::Enable(false);
+
+    const wxString trace = wxTraceZone::GetChromeTrace();
+    INFO( trace );
+    CHECK( trace.Contains(wxString::FromUTF8("\"name\":\"Tab\\u0009and \xc3\xa9\\\\\"")) );
+
+    wxTraceZone::Clear();
+}
@@ -134,6 +134,74 @@ TEST_CASE("wxRegEx::Match", "[regex][match]")
         "Fri Jul 13 18:37:52 CEST 2001\tFri\tJul\t13\t2001");
 }
 
+TEST_CASE("wxRegEx::MatchRange", "[regex][match]")
+{
+    const wxString text("foo=1 bar=22 baz=333");
+    const wxStringCharType* const begin = text.wx_str();
+    const wxStringCharType* const end = begin + text.length();
+
+    wxRegEx re("([a-z]+)=([0-9]+)$");
+    REQUIRE( re.IsValid() );
+
+    // Find all matches in the text without copying it.
+    wxRegEx reAll("([a-z]+)=([0-9]+)");
+    REQUIRE( reAll.IsValid() );
+
+    wxArrayString names;
+    for ( const wxStringCharType* p = begin;
+          reAll.MatchesRange(p, end, p == begin ? 0 : wxRE_NOTBOL); )
+    {
+        size_t start, len;
+        REQUIRE( reAll.GetMatch(&start, &len, 1) );
+        names.push_back(wxString(p + start, len));
+
+        REQUIRE( reAll.GetMatch(&start, &len) );
+        p += start + len;
+    }
+
+    CHECK( names == wxArrayString{"foo", "bar", "baz"} );
+
+    // The end of the range is the end of the string for the regex purposes.
+    const wxStringCharType* const bar = begin + text.find("bar");
+    REQUIRE( re.MatchesRange(bar, bar + 6) );
+
+    size_t start, len;
+    REQUIRE( re.GetMatch(&start, &len, 2) );
+    CHECK( start == 4 );
+    CHECK( len == 2 );
+
+    CHECK_FALSE( re.MatchesRange(bar, bar + 6, wxRE_NOTEOL) );
+    CHECK_FALSE( re.MatchesRange(bar, bar) );
+
+    // Using a regex with fewer subexpressions in between shouldn't affect
+    // the results of the one with more of them.
+    wxRegEx reMany("(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)(l)");
+    REQUIRE( reMany.Matches("abcdefghijkl") );
+    REQUIRE( re.Matches(text) );
+    REQUIRE( reMany.GetMatch(&start, &len, 12) );
+    CHECK( start == 11 );
+    CHECK( len == 1 );
+}
+
+TEST_CASE("wxRegEx::MatchCString", "[regex][match]")
+{
+    const wxChar* const text = wxS("foo=1 bar=22 baz=333");
+
+    wxRegEx re("([a-z]+)=([0-9]+)$");
+    REQUIRE( re.IsValid() );
+
+    // Passing 0 as flags must match the entire string and not be interpreted
+    // as the end of a range.
+    REQUIRE( re.Matches(text, 0) );
+
+    size_t start, len;
+    REQUIRE( re.GetMatch(&start, &len, 1) );
+    CHECK( start == 13 );
+    CHECK( len == 3 );
+
+    CHECK_FALSE( re.Matches(text, wxRE_NOTEOL) );
+}
+
 static void
 CheckReplace(const char* pattern,
              const char* original,
@@ -270,3 +270,40 @@ TEST_CASE("RowHeightCacheTestCase::TestHeightCache", "[dataview][heightcache]")
     CHECK(hc.GetLineAt(22180, row) == false);
     CHECK(row == 666);
 }
+
+// ----------------------------------------------------------------------------
+// TestHeightCacheEstimated
+// ----------------------------------------------------------------------------
+TEST_CASE("RowHeightCacheTestCase::TestHeightCacheEstimated", "[dataview][heightcache]")
+{
+    HeightCache hc;
+
+    // Without any rows in the cache, the default height is used for all of
+    // them.
+    CHECK(hc.GetEstimatedLineStart(10, 20) == 200);
+    CHECK(hc.GetEstimatedLineAt(199, 100, 20) == 9);
+    CHECK(hc.GetEstimatedLineAt(200, 100, 20) == 10);
+    CHECK(hc.GetEstimatedLineAt(2000, 100, 20) == 100);
+
+    // Rows with known heights can be anywhere.
+    hc.Put(5, 50);
+    hc.Put(50, 30);
+
+    CHECK(hc.GetEstimatedLineStart(5, 20) == 100);
+    CHECK(hc.GetEstimatedLineStart(6, 20) == 150);
+    CHECK(hc.GetEstimatedLineStart(50, 20) == 1030);
+    CHECK(hc.GetEstimatedLineStart(51, 20) == 1060);
+
+    CHECK(hc.GetEstimatedLineAt(-1, 100, 20) == 0);
+    CHECK(hc.GetEstimatedLineAt(99, 100, 20) == 4);
+    CHECK(hc.GetEstimatedLineAt(100, 100, 20) == 5);
+    CHECK(hc.GetEstimatedLineAt(149, 100, 20) == 5);
+    CHECK(hc.GetEstimatedLineAt(150, 100, 20) == 6);
+    CHECK(hc.GetEstimatedLineAt(1059, 100, 20) == 50);
+    CHECK(hc.GetEstimatedLineAt(2039, 100, 20) == 99);
+    CHECK(hc.GetEstimatedLineAt(2040, 100, 20) == 100);
+
+    hc.Remove(6); // Forget the height of row 50
+
+    CHECK(hc.GetEstimatedLineStart(51, 20) == 1050);
+}
@@ -92,6 +92,43 @@ TEST_CASE("StringFormat", "[wxString]")
             == "4 world hello world 3");
 
     CHECK( wxString::Format("%1$o %1$d %1$x", 20) == "24 20 14" );
+
+    // Formatting the same string repeatedly must work, as must formatting
+    // different strings stored in the same buffer.
+    for ( int n = 0; n < 3; n++ )
+        CHECK( wxString::Format("%d-%s", n, "x") == wxString::Format("%d-x", n) );
+
+    char buf[16];
+    strcpy(buf, "%d+%d");
+    CHECK( wxString::Format(buf, 1, 2) == "1+2" );
+    strcpy(buf, "%d*%d");
+    CHECK( wxString::Format(buf, 1, 2) == "1*2" );
+}
+
+TEST_CASE("StringAppendFormat", "[wxString]")
+{
+    wxString s("Values:");
+    CHECK( s.AppendFormat(" %d", 1) == 2 );
+    CHECK( s.AppendFormat(" %s=%.1f", "pi", 3.14) == 7 );
+    CHECK( s == "Values: 1 pi=3.1" );
+
+    // Appending the string itself must work.
+    s = "abc";
+    s.AppendFormat("-%s", s);
+    CHECK( s == "abc-abc" );
+
+    // Check that long strings are handled correctly too.
+    const wxString longStr('Z', 4097);
+    s = "start";
+    CHECK( s.AppendFormat("[%s]", longStr) == 4099 );
+    CHECK( s == "start[" + longStr + "]" );
+
+    s.clear();
+    for ( int n = 0; n < 100; n++ )
+        s.AppendFormat("%d,", n);
+    CHECK( s.length() == 290 );
+    CHECK( s.StartsWith("0,1,2,") );
+    CHECK( s.EndsWith("98,99,") );
 }
 
 TEST_CASE("StringFormatUnicode", "[wxString]")
@@ -241,6 +241,15 @@ TEST_CASE("ArgsValidation", "[wxString][vararg][error]")
     WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("foo%n", ptr) );
     WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format("foo%i%n", 42, &swritten) );
 
+    // the results of checking the format string are cached, but it must still
+    // be checked when it's used again with different arguments
+    for ( int n = 0; n < 2; n++ )
+    {
+        static const char* const fmt = "%d items";
+        CHECK( wxString::Format(fmt, 3) == "3 items" );
+        WX_ASSERT_FAILS_WITH_ASSERT( wxString::Format(fmt, "three") );
+    }
+
     // %c should accept integers too
     wxString::Format("%c", 80);
     wxString::Format("%c", wxChar(80) + wxChar(1));
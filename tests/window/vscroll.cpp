@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/window/vscroll.cpp
+// Purpose:     Tests for wxVScrolledWindow and related classes
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets development team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/vscroll.h"
+
+#include <memory>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// tests helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Window with rows of different heights which can be changed by the test.
+class VarHeightWindow : public wxVScrolledWindow
+{
+public:
+    VarHeightWindow(wxWindow* parent, size_t count)
+        : wxVScrolledWindow(parent, wxID_ANY,
+                            wxDefaultPosition, wxSize(100, 100)),
+          m_heights(count, 10)
+    {
+    }
+
+    using wxVScrolledWindow::GetScrollOffset;
+
+    std::vector<wxCoord> m_heights;
+
+    // number of times OnGetRowHeight() was called
+    mutable int m_heightCalls = 0;
+
+protected:
+    virtual wxCoord OnGetRowHeight(size_t n) const override
+    {
+        m_heightCalls++;
+
+        return m_heights[n];
+    }
+};
+
+// Every tenth row is 30 pixels high while all the others are 10 pixels high,
+// return the offset of the given row for this layout.
+wxCoord GetRowOffset(size_t row)
+{
+    wxCoord offset = static_cast<wxCoord>(row / 10) * 120;
+    if ( row % 10 )
+        offset += 30 + static_cast<wxCoord>(row % 10 - 1) * 10;
+
+    return offset;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxVScrolledWindow::SizeCache", "[window][vscroll]")
+{
+    const size_t count = 100000;
+
+    std::unique_ptr<VarHeightWindow>
+        win(new VarHeightWindow(wxTheApp->GetTopWindow(), count));
+    win->EnableSizeCache();
+
+    for ( size_t n = 0; n < count; n += 10 )
+        win->m_heights[n] = 30;
+    win->SetRowCount(count);
+
+    const size_t row = 50000;
+    win->ScrollToRow(row);
+    REQUIRE( win->GetVisibleRowsBegin() == row );
+    CHECK( win->GetScrollOffset() == GetRowOffset(row) );
+
+    SECTION("Cached")
+    {
+        // Scrolling elsewhere doesn't need to compute the heights of all the
+        // rows before the first visible one again.
+        win->m_heightCalls = 0;
+
+        win->ScrollToRow(row / 2);
+        CHECK( win->GetScrollOffset() == GetRowOffset(row / 2) );
+
+        win->ScrollToRow(row);
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) );
+
+        CHECK( win->m_heightCalls < 100 );
+    }
+
+    SECTION("HitTest")
+    {
+        CHECK( win->VirtualHitTest(0) == 50000 );
+        CHECK( win->VirtualHitTest(29) == 50000 );
+        CHECK( win->VirtualHitTest(30) == 50001 );
+        CHECK( win->VirtualHitTest(45) == 50002 );
+        CHECK( win->VirtualHitTest(win->GetClientSize().y + 1000) == wxNOT_FOUND );
+    }
+
+    SECTION("Refresh")
+    {
+        // Changing the height of a row before the first visible one changes
+        // the scroll offset once the row is refreshed.
+        win->m_heights[100] = 50;
+        win->RefreshRow(100);
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) + 20 );
+
+        win->m_heights[101] = 5;
+        win->m_heights[102] = 15;
+        win->m_heights[103] = 30;
+        win->RefreshRows(101, 104);
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) + 40 );
+
+        // Changing the height of a visible row affects hit testing.
+        win->m_heights[row] = 10;
+        win->RefreshRow(row);
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) + 40 );
+        CHECK( win->VirtualHitTest(15) == 50001 );
+
+        // Refreshing the rows whose height is not known yet is harmless.
+        win->m_heights[count - 1] = 100;
+        win->RefreshRow(count - 1);
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) + 40 );
+    }
+
+    SECTION("Discard")
+    {
+        // Changing the heights without refreshing the rows is not taken into
+        // account...
+        win->m_heights[0] = 130;
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) );
+
+        // ... until the cache is discarded.
+        win->RefreshAll();
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) + 100 );
+
+        win->m_heights[1] = 110;
+        win->SetRowCount(count);
+        CHECK( win->GetVisibleRowsBegin() == row );
+        CHECK( win->GetScrollOffset() == GetRowOffset(row) + 200 );
+    }
+}